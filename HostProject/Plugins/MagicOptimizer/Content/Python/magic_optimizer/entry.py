@@ -1,4 +1,4 @@
-import os, json, sys, csv
+import os, io, json, sys, csv, atexit, time, contextlib
 try:
     import unreal  # Available when running inside UE embedded Python
 except Exception:
@@ -27,19 +27,75 @@ def _to_bool(s: str) -> bool:
     return str(s).strip().lower() == 'true'
 
 
-def _append_log(line: str):
+@contextlib.contextmanager
+def _append_lock(lock_path: str):
+    """Holds an exclusive lock on lock_path. The editor runs a pass's categories as concurrent processes
+    appending to the same log and knowledge files; a batch written under the lock is not interleaved
+    with another process's, and a CSV header is written once."""
+    f = None
+    try:
+        f = open(lock_path, 'a+b')
+        if os.name == 'nt':
+            import msvcrt
+            f.seek(0)
+            while True:
+                try:
+                    msvcrt.locking(f.fileno(), msvcrt.LK_LOCK, 1)
+                    break
+                except OSError:
+                    pass  # LK_LOCK gives up after about 10 s; keep waiting
+        else:
+            import fcntl
+            fcntl.flock(f.fileno(), fcntl.LOCK_EX)
+    except Exception:
+        # Unlocked appends are still better than none
+        pass
+    try:
+        yield
+    finally:
+        if f is not None:
+            try:
+                if os.name == 'nt':
+                    import msvcrt
+                    f.seek(0)
+                    msvcrt.locking(f.fileno(), msvcrt.LK_UNLCK, 1)
+            except Exception:
+                pass
+            f.close()
+
+
+# Log lines are buffered and written in batches: one open/write per flush instead of per line
+_LOG_PATH = os.environ.get('MAGICOPTIMIZER_LOG')
+_LOG_BUFFER = []
+_LOG_FLUSH_LINES = 256
+
+
+def _flush_log():
+    global _LOG_BUFFER
+    if not _LOG_PATH or not _LOG_BUFFER:
+        return
+    lines, _LOG_BUFFER = _LOG_BUFFER, []
     try:
-        log_path = os.environ.get('MAGICOPTIMIZER_LOG')
-        if not log_path:
-            return
-        os.makedirs(os.path.dirname(log_path), exist_ok=True)
-        with open(log_path, 'a', encoding='utf-8') as f:
-            from datetime import datetime
-            f.write(f"[{datetime.now().strftime('%Y-%m-%d %H:%M:%S')}] PY: {line}\n")
+        os.makedirs(os.path.dirname(_LOG_PATH), exist_ok=True)
+        with _append_lock(_LOG_PATH + '.lock'), open(_LOG_PATH, 'a', encoding='utf-8') as f:
+            f.write(''.join(lines))
     except Exception:
         pass
 
 
+def _append_log(line: str):
+    if not _LOG_PATH:
+        return
+    _LOG_BUFFER.append(f"[{datetime.now().strftime('%Y-%m-%d %H:%M:%S')}] PY: {line}\n")
+    if len(_LOG_BUFFER) >= _LOG_FLUSH_LINES:
+        _flush_log()
+
+
+# Standalone runs exit the interpreter; the embedded interpreter outlives the script, so the end of
+# the script flushes explicitly as well
+atexit.register(_flush_log)
+
+
 def _parse_csv_list(s: str):
     if not s:
         return []
@@ -62,43 +118,106 @@ def _kb_get_dir():
 
 _KB_RUN_ID = datetime.now().strftime('%Y%m%d_%H%M%S')
 
+# Knowledge records are queued per file and appended in batches, one open per file per flush. That
+# batching is what keeps editor runs cheap: the bridge starts this script in an external interpreter
+# that cannot import unreal. Only in-process runs (the commandlet's `py` command) reach the plugin's
+# native write-behind sink.
+_KB_NATIVE = getattr(unreal, 'MagicOptimizerKnowledgeLibrary', None) if unreal is not None else None
+_KB_BUFFERS = {}
+_KB_PENDING = 0
+_KB_FLUSH_RECORDS = 512
+
+
+def _kb_flush():
+    global _KB_BUFFERS, _KB_PENDING
+    if not _KB_PENDING:
+        return
+    buffers, _KB_BUFFERS, _KB_PENDING = _KB_BUFFERS, {}, 0
+    kb_dir = None
+    for file_name, (header, lines) in buffers.items():
+        try:
+            if _KB_NATIVE is not None and _KB_NATIVE.append_knowledge_lines(file_name, lines, header):
+                continue
+        except Exception:
+            pass
+        try:
+            kb_dir = kb_dir or _kb_get_dir()
+            if not kb_dir:
+                return
+            path = os.path.join(kb_dir, file_name)
+            with _append_lock(os.path.join(kb_dir, '.append.lock')):
+                needs_header = header and not (os.path.exists(path) and os.path.getsize(path) > 0)
+                with open(path, 'a', newline='', encoding='utf-8') as f:
+                    if needs_header:
+                        f.write(header + '\n')
+                    f.write('\n'.join(lines) + '\n')
+        except Exception:
+            pass
+
+
+def _kb_queue_line(file_name: str, line: str, header: str = ''):
+    global _KB_PENDING
+    entry = _KB_BUFFERS.get(file_name)
+    if entry is None:
+        entry = _KB_BUFFERS[file_name] = (header, [])
+    entry[1].append(line)
+    _KB_PENDING += 1
+    if _KB_PENDING >= _KB_FLUSH_RECORDS:
+        _kb_flush()
+
+
+def _kb_sync():
+    """Puts every queued record on disk, e.g. before a report reads events.jsonl."""
+    _kb_flush()
+    try:
+        if _KB_NATIVE is not None:
+            _KB_NATIVE.flush_knowledge()
+    except Exception:
+        pass
+
+
+def _kb_finish():
+    _kb_flush()
+    try:
+        if _KB_NATIVE is not None:
+            # Folds only this run's events into the rolling aggregates (and compacts when due)
+            _KB_NATIVE.update_knowledge_aggregates()
+    except Exception:
+        pass
+
+
+atexit.register(_kb_flush)
+
+
+def _kb_csv_line(values: list) -> str:
+    buf = io.StringIO()
+    csv.writer(buf, lineterminator='').writerow(values)
+    return buf.getvalue()
+
+
 # Initialize event logger for self-learning
 _event_logger = None
 if KNOWLEDGE_AVAILABLE:
     try:
         saved_dir = _kb_get_dir()
         if saved_dir:
-            _event_logger = EventLogger(saved_dir)
+            _event_logger = EventLogger(saved_dir, emit_line=lambda line: _kb_queue_line('events.jsonl', line))
     except Exception:
         pass
 
 
 def _kb_write_jsonl(event: dict):
     try:
-        kb_dir = _kb_get_dir()
-        if not kb_dir:
-            return
-        path = os.path.join(kb_dir, 'events.jsonl')
         event = dict(event or {})
         event.setdefault('run_id', _KB_RUN_ID)
-        with open(path, 'a', encoding='utf-8') as f:
-            f.write(json.dumps(event, ensure_ascii=False) + "\n")
+        _kb_queue_line('events.jsonl', json.dumps(event, ensure_ascii=False, separators=(',', ':')))
     except Exception:
         pass
 
 
 def _kb_append_csv(csv_name: str, header_fields: list, row_values: list):
     try:
-        kb_dir = _kb_get_dir()
-        if not kb_dir:
-            return
-        path = os.path.join(kb_dir, csv_name)
-        file_exists = os.path.exists(path)
-        with open(path, 'a', newline='', encoding='utf-8') as f:
-            w = csv.writer(f)
-            if not file_exists:
-                w.writerow(header_fields)
-            w.writerow(row_values)
+        _kb_queue_line(csv_name, _kb_csv_line(row_values), _kb_csv_line(header_fields))
     except Exception:
         pass
 
@@ -118,6 +237,12 @@ def _tokenize_name(name: str):
         return []
 
 
+def _asset_name_tokens(path: str):
+    """Tokens of the short asset name only: '/Game/Rock/T_Rock_N.T_Rock_N' -> ['t', 'rock', 'n']."""
+    name = (path or '').rsplit('/', 1)[-1].split('.', 1)[0]
+    return [t for t in name.lower().split('_') if t]
+
+
 def _kb_emit_texture_observed(path: str, width, height, fmt: str, profile: str):
     try:
         pkg = ''
@@ -298,6 +423,10 @@ p = (phase or '').strip().lower()
 msg = f"{phase} OK ({profile})"
 assets_processed = 10
 assets_modified = 0
+# The editor runs each category as its own process, concurrently; only a Textures node (or a run
+# without categories) may write the texture audit and recommendation CSVs
+cat_list = _parse_csv_list(categories)
+texture_node = not cat_list or 'Textures' in cat_list
 
 # CSV output directory
 csv_dir = None
@@ -311,7 +440,10 @@ try:
 except Exception:
     pass
 
-if p == 'audit':
+if p in ('audit', 'recommend') and not texture_node:
+    assets_processed = 0
+    msg = f"{phase} OK ({profile}) - no {', '.join(cat_list)} checks yet"
+elif p == 'audit':
     msg = f"Audit OK ({profile})"
     textures_info = []
     total_textures = 0
@@ -387,6 +519,8 @@ if p == 'audit':
         for i, path in enumerate(sample_paths):
             try:
                 _append_log(f"Loading texture {i+1}/{len(sample_paths)}: {path}")
+                # Load plus property reads; the native run report keeps the slowest of these
+                t_start = time.perf_counter()
                 asset = unreal.EditorAssetLibrary.load_asset(path)
                 if not asset:
                     _append_log(f"Failed to load asset: {path}")
@@ -548,6 +682,20 @@ if p == 'audit':
                         _append_log(f"Texture {path}: format={fmt}")
                 except Exception as e:
                     _append_log(f"Failed to get compression settings for {path}: {e}")
+
+                # sRGB flag and LOD group (used by the UI query language, e.g. issue:srgb group:ui)
+                srgb = ""
+                lod_group = ""
+                try:
+                    srgb = 1 if tex.get_editor_property('srgb') else 0
+                except Exception:
+                    pass
+                try:
+                    lg = tex.get_editor_property('lod_group')
+                    if lg is not None:
+                        lod_group = lg.name if hasattr(lg, 'name') else str(lg)
+                except Exception:
+                    pass
                 
                 # Update the texture info
                 for r in textures_info:
@@ -555,7 +703,10 @@ if p == 'audit':
                         r.update({
                             "width": width if width is not None else "",
                             "height": height if height is not None else "",
-                            "format": fmt if fmt is not None else ""
+                            "format": fmt if fmt is not None else "",
+                            "srgb": srgb,
+                            "lod_group": lod_group,
+                            "load_ms": round((time.perf_counter() - t_start) * 1000.0, 3)
                         })
                         break
                 
@@ -599,7 +750,7 @@ if p == 'audit':
             csv_path = os.path.join(csv_dir, 'textures.csv')
             with open(csv_path, 'w', newline='', encoding='utf-8') as f:
                 w = csv.writer(f)
-                w.writerow(['path', 'width', 'height', 'format'])
+                w.writerow(['path', 'width', 'height', 'format', 'srgb', 'lod_group', 'load_ms'])
                 
                 # Log what we're writing
                 _append_log(f"Writing CSV with {len(textures_info)} texture rows")
@@ -609,12 +760,15 @@ if p == 'audit':
                     width = row.get('width', '')
                     height = row.get('height', '')
                     fmt = row.get('format', '')
+                    srgb = row.get('srgb', '')
+                    lod_group = row.get('lod_group', '')
+                    load_ms = row.get('load_ms', '')
                     
                     # Log first few rows for debugging
                     if i < 5:
                         _append_log(f"CSV row {i}: path='{path}' width='{width}' height='{height}' format='{fmt}'")
                     
-                    w.writerow([path, width, height, fmt])
+                    w.writerow([path, width, height, fmt, srgb, lod_group, load_ms])
                 
             _append_log(f"CSV written successfully: {csv_path} rows={len(textures_info)} total={total_textures}")
         else:
@@ -675,11 +829,11 @@ elif p == 'recommend':
                         recs.append("Open asset to populate dimensions in CSV, or reimport")
 
                     fmt_lower = fmt.lower()
-                    name_lower = path.lower()
-                    if ('_n' in name_lower or 'normal' in name_lower) and ('normal' not in fmt_lower):
+                    name_tokens = _asset_name_tokens(path)
+                    if ('n' in name_tokens or 'normal' in name_tokens) and ('normal' not in fmt_lower):
                         issues.append("Normal map compression mismatch")
                         recs.append("Set Compression Settings = TC_Normalmap")
-                    if ('orm' in name_lower or 'mask' in name_lower) and ('mask' not in fmt_lower):
+                    if ('orm' in name_tokens or 'mask' in name_tokens) and ('mask' not in fmt_lower):
                         issues.append("Mask/ORM compression mismatch")
                         recs.append("Set Compression Settings = TC_Masks")
                     if not fmt:
@@ -711,6 +865,7 @@ elif p == 'recommend':
         if AUTO_REPORT_AVAILABLE:
             try:
                 if is_auto_reporting_enabled() and should_report_errors():
+                    _kb_sync()
                     success, report_message, issue_url = send_error_report(
                         error_type="RecommendPhaseFailed",
                         error_message=str(e),
@@ -755,6 +910,7 @@ if _event_logger:
 if AUTO_REPORT_AVAILABLE:
     try:
         if is_auto_reporting_enabled() and should_report_optimizations():
+            _kb_sync()
             success, report_message, issue_url = send_optimization_report(
                 phase=phase,
                 profile=profile,
@@ -809,6 +965,7 @@ if _event_logger:
 if AUTO_REPORT_AVAILABLE:
     try:
         if is_auto_reporting_enabled():
+            _kb_sync()
             success, report_message, issue_url = send_optimization_report(
                 phase="SessionEnd",
                 profile=profile,
@@ -823,4 +980,7 @@ if AUTO_REPORT_AVAILABLE:
             else:
                 _append_log(f"Session reporting failed: {report_message}")
     except Exception as report_error:
-        _append_log(f"Session reporting failed: {report_error}")
\ No newline at end of file
+        _append_log(f"Session reporting failed: {report_error}")
+
+_kb_finish()
+_flush_log()
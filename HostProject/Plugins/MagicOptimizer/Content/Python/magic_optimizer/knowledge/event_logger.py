@@ -9,18 +9,21 @@ import os
 import json
 import time
 from datetime import datetime
-from typing import Dict, Any, Optional, List
+from typing import Callable, Dict, Any, Optional, List
 
 
 class EventLogger:
     """Logs events for self-learning and plugin improvement."""
     
-    def __init__(self, project_saved_dir: str):
+    def __init__(self, project_saved_dir: str, emit_line: Optional[Callable[[str], None]] = None):
         """Initialize the event logger.
         
         Args:
             project_saved_dir: Path to the project's Saved directory
+            emit_line: Optional callable taking one serialized event; when set, events are handed
+                to it (e.g. a batching sink) instead of being appended to events.jsonl directly
         """
+        self.emit_line = emit_line
         self.project_saved_dir = project_saved_dir
         self.knowledge_dir = os.path.join(project_saved_dir, "MagicOptimizer", "Knowledge")
         self.run_id = datetime.now().strftime('%Y%m%d_%H%M%S')
@@ -61,8 +64,12 @@ class EventLogger:
                 "data": data
             }
             
-            with open(self.events_file, 'a', encoding='utf-8') as f:
-                f.write(json.dumps(event, ensure_ascii=False) + "\n")
+            line = json.dumps(event, ensure_ascii=False, separators=(',', ':'))
+            if self.emit_line is not None:
+                self.emit_line(line)
+            else:
+                with open(self.events_file, 'a', encoding='utf-8') as f:
+                    f.write(line + "\n")
             
             self.event_count += 1
             
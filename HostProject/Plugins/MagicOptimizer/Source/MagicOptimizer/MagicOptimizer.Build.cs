@@ -20,7 +20,10 @@ public class MagicOptimizer : ModuleRules
 		PrivateDependencyModuleNames.AddRange(new string[] { 
 			"Json", 
 			"JsonUtilities", 
-			"Projects"
+			"Projects",
+			"MeshDescription",
+			"StaticMeshDescription"
+			// Runtime mesh modules, used by the synthetic content commandlet
 			// UE::Tasks and AsyncTask are part of the Core module
 		});
 		
@@ -0,0 +1,490 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  MagicOptimizerCommandlet.cpp
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#include "Commandlets/MagicOptimizerCommandlet.h"
+#include "MagicOptimizerLogging.h"
+#include "MagicOptimizerStats.h"
+#include "OptimizerLogging.h"
+#include "OptimizerSettings.h"
+#include "PythonBridge.h"
+#include "Services/Analysis/TextureInspection.h"
+#include "Services/Csv/TextureCsvReader.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "MagicOptimizerMemory.h"
+
+namespace
+{
+	struct FCommandletOptions
+	{
+		FOptimizerRunParams Run;
+		FString OutDir;
+		int32 Threads = 0;
+		// Inspect the textures natively as well and merge their rows, pixel issue codes included, into the audit
+		bool bNative = false;
+
+		// Budgets; negative means unchecked
+		int32 MaxIssues = -1;
+		double MaxTextureMemoryMB = -1.0;
+		TMap<FString, int32> MaxIssuesByCode;
+	};
+
+	struct FBudgetResult
+	{
+		FString Name;
+		double Limit = 0.0;
+		double Actual = 0.0;
+
+		bool IsExceeded() const { return Actual > Limit; }
+	};
+
+	static FCommandletOptions ParseOptions(const FString& Params, const UOptimizerSettings* Settings)
+	{
+		const TCHAR* Cmd = *Params;
+		FCommandletOptions Options;
+		FOptimizerRunParams& Run = Options.Run;
+		Run.Phase = TEXT("audit");
+		Run.Profile = Settings ? Settings->TargetProfile : TEXT("PC_Balanced");
+		Run.IncludePaths = Settings ? Settings->IncludePathsCsv : FString();
+		Run.ExcludePaths = Settings ? Settings->ExcludePathsCsv : FString();
+		Run.bDryRun = Settings ? Settings->bDryRun : true;
+		Run.MaxChanges = Settings ? Settings->MaxChanges : 100;
+		// There is no editor selection in a commandlet
+		Run.bUseSelection = false;
+
+		FParse::Value(Cmd, TEXT("phase="), Run.Phase);
+		FParse::Value(Cmd, TEXT("profile="), Run.Profile);
+		FParse::Value(Cmd, TEXT("include="), Run.IncludePaths, /*bShouldStopOnSeparator*/ false);
+		FParse::Value(Cmd, TEXT("exclude="), Run.ExcludePaths, /*bShouldStopOnSeparator*/ false);
+		FParse::Bool(Cmd, TEXT("DryRun="), Run.bDryRun);
+		FParse::Value(Cmd, TEXT("MaxChanges="), Run.MaxChanges);
+		Run.Phase = Run.Phase.ToLower();
+
+		FString Categories = TEXT("Textures");
+		FParse::Value(Cmd, TEXT("categories="), Categories, /*bShouldStopOnSeparator*/ false);
+		Categories.ParseIntoArray(Run.Categories, TEXT(","));
+
+		FParse::Value(Cmd, TEXT("out="), Options.OutDir);
+		FParse::Value(Cmd, TEXT("threads="), Options.Threads);
+		Options.bNative = FParse::Param(Cmd, TEXT("native"));
+
+		FParse::Value(Cmd, TEXT("MaxIssues="), Options.MaxIssues);
+		FParse::Value(Cmd, TEXT("MaxTextureMemoryMB="), Options.MaxTextureMemoryMB);
+		FString Budgets;
+		if (FParse::Value(Cmd, TEXT("Budget="), Budgets, /*bShouldStopOnSeparator*/ false))
+		{
+			TArray<FString> Entries;
+			Budgets.ParseIntoArray(Entries, TEXT(","));
+			for (const FString& Entry : Entries)
+			{
+				FString Code, Limit;
+				if (Entry.Split(TEXT(":"), &Code, &Limit))
+				{
+					Options.MaxIssuesByCode.Add(Code.TrimStartAndEnd().ToLower(), FCString::Atoi(*Limit));
+				}
+			}
+		}
+		return Options;
+	}
+
+	static bool IsKnownPhase(const FString& Phase)
+	{
+		return Phase == TEXT("audit") || Phase == TEXT("recommend") || Phase == TEXT("apply") || Phase == TEXT("verify");
+	}
+
+	/**
+	 * Runs entry.py in the editor's embedded interpreter, where the audit can use the asset registry,
+	 * and falls back to the bridge's external interpreter when Python scripting is not loaded.
+	 */
+	static FOptimizerResult RunPythonPhase(const FOptimizerRunParams& Run, const FString& OutDir)
+	{
+		UPythonBridge* Bridge = NewObject<UPythonBridge>();
+		Bridge->Initialize();
+
+		const FString ScriptPath = Bridge->GetPythonScriptPath() / TEXT("entry.py");
+		const FString ResultPath = OutDir / TEXT("result.json");
+		IFileManager::Get().Delete(*ResultPath, /*RequireExists*/ false, /*EvenReadOnly*/ true, /*Quiet*/ true);
+		FPlatformMisc::SetEnvironmentVar(TEXT("MAGICOPTIMIZER_OUTPUT"), *ResultPath);
+
+		// Same argv as UPythonBridge::RunOptimization
+		const TArray<FString> Arguments = {
+			Run.Phase,
+			Run.Profile,
+			Run.bDryRun ? TEXT("true") : TEXT("false"),
+			FString::FromInt(Run.MaxChanges),
+			Run.IncludePaths,
+			Run.ExcludePaths,
+			TEXT("false"),
+			FString::Join(Run.Categories, TEXT(",")),
+		};
+		FString Command = FString::Printf(TEXT("py \"%s\""), *ScriptPath);
+		for (const FString& Argument : Arguments)
+		{
+			Command += FString::Printf(TEXT(" \"%s\""), *Argument);
+		}
+		MagicOptimizerLog::AppendLine(FString::Printf(TEXT("Commandlet: %s"), *Command));
+
+		bool bHandled = false;
+		{
+			MAGICOPT_STAGE_SCOPE(Bridge, MagicOptimizer_CommandletPython);
+			bHandled = GEngine && FPaths::FileExists(ScriptPath) && GEngine->Exec(nullptr, *Command);
+		}
+		if (!bHandled)
+		{
+			UE_LOG(LogMagicOptimizer, Display, TEXT("Commandlet: embedded Python unavailable, using the external interpreter"));
+			return Bridge->RunOptimization(Run);
+		}
+
+		FOptimizerResult Result;
+		FString Json;
+		TSharedPtr<FJsonObject> Root;
+		if (!FFileHelper::LoadFileToString(Json, *ResultPath) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid())
+		{
+			Result.Message = TEXT("entry.py did not write a result");
+			Result.Errors.Add(Result.Message);
+			MAGICOPT_TRACK_ERRORS(1);
+			return Result;
+		}
+		Result.bSuccess = Root->GetBoolField(TEXT("success"));
+		Result.Message = Root->GetStringField(TEXT("message"));
+		Result.AssetsProcessed = (int32)Root->GetNumberField(TEXT("assetsProcessed"));
+		Result.AssetsModified = (int32)Root->GetNumberField(TEXT("assetsModified"));
+		Result.OutputPath = ResultPath;
+		return Result;
+	}
+
+	// Texture2D assets under the include paths (default /Game) and outside the exclude paths
+	static TArray<FSoftObjectPath> FindTexturesToInspect(const FOptimizerRunParams& Run)
+	{
+		TArray<FSoftObjectPath> Paths;
+		IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+		if (!AssetRegistry)
+		{
+			return Paths;
+		}
+		AssetRegistry->WaitForCompletion();
+
+		TArray<FString> Includes;
+		TArray<FString> Excludes;
+		Run.IncludePaths.ParseIntoArray(Includes, TEXT(","));
+		Run.ExcludePaths.ParseIntoArray(Excludes, TEXT(","));
+		// An exclude covers its own package and folder, not siblings that share its prefix
+		for (FString& Exclude : Excludes)
+		{
+			Exclude.TrimStartAndEndInline();
+			while (Exclude.RemoveFromEnd(TEXT("/")))
+			{
+			}
+		}
+		Excludes.RemoveAll([](const FString& Exclude) { return Exclude.IsEmpty(); });
+		FARFilter Filter;
+		for (const FString& Include : Includes)
+		{
+			Filter.PackagePaths.Add(FName(*Include.TrimStartAndEnd()));
+		}
+		if (Filter.PackagePaths.IsEmpty())
+		{
+			Filter.PackagePaths.Add(TEXT("/Game"));
+		}
+		Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+		Filter.bRecursivePaths = true;
+
+		TArray<FAssetData> Assets;
+		AssetRegistry->GetAssets(Filter, Assets);
+		Paths.Reserve(Assets.Num());
+		for (const FAssetData& Asset : Assets)
+		{
+			const FString PackageName = Asset.PackageName.ToString();
+			const bool bExcluded = Excludes.ContainsByPredicate([&PackageName](const FString& Exclude)
+			{
+				return PackageName == Exclude
+					|| (PackageName.StartsWith(Exclude) && PackageName[Exclude.Len()] == TEXT('/'));
+			});
+			if (!bExcluded)
+			{
+				Paths.Add(Asset.GetSoftObjectPath());
+			}
+		}
+		return Paths;
+	}
+
+	// Inspected rows replace the CSV rows of the same package and are added where the CSV has none
+	static void MergeInspectedRows(TArray<FTextureAuditRowPtr>& Rows, TArray<FTextureAuditRowPtr>&& Inspected)
+	{
+		TMap<FString, int32> IndexByPackage;
+		IndexByPackage.Reserve(Rows.Num());
+		for (int32 Index = 0; Index < Rows.Num(); ++Index)
+		{
+			IndexByPackage.Add(FPackageName::ObjectPathToPackageName(Rows[Index]->Path), Index);
+		}
+		for (FTextureAuditRowPtr& Row : Inspected)
+		{
+			if (const int32* Index = IndexByPackage.Find(Row->Path))
+			{
+				Rows[*Index] = MoveTemp(Row);
+			}
+			else
+			{
+				Rows.Add(MoveTemp(Row));
+			}
+		}
+	}
+
+	static FString CsvField(const FString& Value)
+	{
+		return Value.Contains(TEXT(",")) || Value.Contains(TEXT("\"")) ? TEXT("\"") + Value.Replace(TEXT("\""), TEXT("\"\"")) + TEXT("\"") : Value;
+	}
+
+	// The evaluated rows with their derived columns, for the report
+	static bool WriteInspectionCsv(const TArray<FTextureAuditRowPtr>& Rows, const FString& Path)
+	{
+		MAGICOPT_STAGE_SCOPE(ReportWrite, MagicOptimizer_CommandletReport);
+		FString Csv = TEXT("path,width,height,format,lod_group,srgb,type,issues,estimated_bytes\n");
+		for (const FTextureAuditRowPtr& Row : Rows)
+		{
+			Csv += FString::Printf(TEXT("%s,%d,%d,%s,%s,%s,%s,%s,%lld\n"), *CsvField(Row->Path), Row->Width, Row->Height,
+				*CsvField(Row->Format), *CsvField(Row->LODGroup), Row->SRGB < 0 ? TEXT("") : (Row->SRGB ? TEXT("true") : TEXT("false")),
+				*CsvField(Row->Type), *CsvField(Row->Issues), Row->EstimatedBytes);
+		}
+		if (!FFileHelper::SaveStringToFile(Csv, *Path))
+		{
+			UE_LOG(LogMagicOptimizer, Error, TEXT("Commandlet: could not write %s"), *Path);
+			return false;
+		}
+		MAGICOPT_STAT_ASSET(ReportWrite, Path, MagicOptimizerStats::GetFileBytes(Path));
+		return true;
+	}
+
+	static void CopyToReport(const FString& Source, const FString& Dest)
+	{
+		if (!Source.IsEmpty() && FPaths::FileExists(Source) && IFileManager::Get().Copy(*Dest, *Source) != COPY_OK)
+		{
+			UE_LOG(LogMagicOptimizer, Warning, TEXT("Commandlet: could not copy %s to %s"), *Source, *Dest);
+		}
+	}
+
+	static bool WriteJson(const TSharedRef<FJsonObject>& Root, const FString& Path)
+	{
+		MAGICOPT_STAGE_SCOPE(ReportWrite, MagicOptimizer_CommandletReport);
+		FString Json;
+		FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Json));
+		if (!FFileHelper::SaveStringToFile(Json, *Path))
+		{
+			UE_LOG(LogMagicOptimizer, Error, TEXT("Commandlet: could not write %s"), *Path);
+			return false;
+		}
+		MAGICOPT_STAT_ASSET(ReportWrite, Path, MagicOptimizerStats::GetFileBytes(Path));
+		return true;
+	}
+}
+
+UMagicOptimizerCommandlet::UMagicOptimizerCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UMagicOptimizerCommandlet::Main(const FString& Params)
+{
+	MAGICOPT_LLM_SCOPE_ROOT();
+	const UOptimizerSettings* Settings = UOptimizerSettings::Get();
+	const FCommandletOptions Options = ParseOptions(Params, Settings);
+	if (!IsKnownPhase(Options.Run.Phase))
+	{
+		UE_LOG(LogMagicOptimizer, Error, TEXT("Commandlet: unknown -phase=%s (audit, recommend, apply, verify)"), *Options.Run.Phase);
+		return ExitFailed;
+	}
+
+	// entry.py audits through the editor API on the game thread; the worker cap applies to the native
+	// work after it: rule evaluation of the audit rows and the -native inspection
+	if (Options.Threads > 0)
+	{
+		if (IConsoleVariable* MaxWorkerThreads = IConsoleManager::Get().FindConsoleVariable(TEXT("magicopt.MaxWorkerThreads")))
+		{
+			MaxWorkerThreads->Set(Options.Threads, ECVF_SetByCommandline);
+		}
+		UE_LOG(LogMagicOptimizer, Display, TEXT("Commandlet: -threads=%d caps rule evaluation%s; the Python %s phase is single-threaded"),
+			Options.Threads, Options.bNative ? TEXT(" and native inspection") : TEXT(""), *Options.Run.Phase);
+	}
+
+	MagicOptimizerStats::BeginRun(TEXT("CI"));
+	const FString OutDir = Options.OutDir.IsEmpty()
+		? FPaths::GetPath(MagicOptimizerStats::GetReportPath(MagicOptimizerStats::GetRunStats()))
+		: FPaths::ConvertRelativePathToFull(Options.OutDir);
+	IFileManager::Get().MakeDirectory(*OutDir, /*Tree*/ true);
+
+	UE_LOG(LogMagicOptimizer, Display, TEXT("Commandlet: phase=%s profile=%s include='%s' exclude='%s' categories=%s out=%s"),
+		*Options.Run.Phase, *Options.Run.Profile, *Options.Run.IncludePaths, *Options.Run.ExcludePaths,
+		*FString::Join(Options.Run.Categories, TEXT(",")), *OutDir);
+
+	// Wall time per section lands in stats.json; emplacing the next phase ends the previous one
+	TOptional<MagicOptimizerStats::FPhaseScope> Phase;
+	Phase.Emplace(FString::Printf(TEXT("Python %s"), *Options.Run.Phase));
+	const FOptimizerResult PhaseResult = RunPythonPhase(Options.Run, OutDir);
+	if (!PhaseResult.bSuccess)
+	{
+		UE_LOG(LogMagicOptimizer, Error, TEXT("Commandlet: %s phase failed: %s"), *Options.Run.Phase, *PhaseResult.Message);
+	}
+
+	// Read the audit back through the same reader and rules as the editor
+	Phase.Emplace(TEXT("Evaluate"));
+	TArray<FTextureAuditRowPtr> Rows;
+	const bool bWantTextures = Options.Run.Categories.ContainsByPredicate([](const FString& Category) { return Category.Equals(TEXT("Textures"), ESearchCase::IgnoreCase); });
+	const bool bHaveCsv = bWantTextures && TextureCsvReader::ReadAuditCsv(Settings, Rows);
+
+	// Native inspection adds the pixel-based issue codes; it records its own "Inspect Textures" phase
+	int32 NumInspected = 0;
+	if (bWantTextures && Options.bNative)
+	{
+		Phase.Reset();
+		TArray<FTextureAuditRowPtr> Inspected = TextureInspection::InspectTextures(FindTexturesToInspect(Options.Run));
+		NumInspected = Inspected.Num();
+		MergeInspectedRows(Rows, MoveTemp(Inspected));
+		Phase.Emplace(TEXT("Evaluate"));
+	}
+	const bool bHaveAudit = bHaveCsv || NumInspected > 0;
+	if (bWantTextures && !bHaveAudit)
+	{
+		UE_LOG(LogMagicOptimizer, Error, TEXT("Commandlet: no texture audit to evaluate"));
+	}
+
+	int32 RowsWithIssues = 0;
+	int64 EstimatedBytes = 0;
+	TMap<FString, int32> IssueCounts;
+	TArray<FString> Codes;
+	for (const FTextureAuditRowPtr& Row : Rows)
+	{
+		EstimatedBytes += Row->EstimatedBytes;
+		if (Row->Issues.IsEmpty())
+		{
+			continue;
+		}
+		++RowsWithIssues;
+		Codes.Reset();
+		Row->Issues.ParseIntoArrayWS(Codes);
+		for (const FString& Code : Codes)
+		{
+			++IssueCounts.FindOrAdd(Code);
+		}
+	}
+	const double EstimatedMB = EstimatedBytes / (1024.0 * 1024.0);
+
+	TArray<FBudgetResult> Budgets;
+	if (Options.MaxIssues >= 0)
+	{
+		Budgets.Add({ TEXT("issues"), (double)Options.MaxIssues, (double)RowsWithIssues });
+	}
+	if (Options.MaxTextureMemoryMB >= 0.0)
+	{
+		Budgets.Add({ TEXT("texture_memory_mb"), Options.MaxTextureMemoryMB, EstimatedMB });
+	}
+	for (const TPair<FString, int32>& CodeBudget : Options.MaxIssuesByCode)
+	{
+		const int32* Count = IssueCounts.Find(CodeBudget.Key);
+		Budgets.Add({ FString::Printf(TEXT("issue:%s"), *CodeBudget.Key), (double)CodeBudget.Value, Count ? (double)*Count : 0.0 });
+	}
+
+	bool bOverBudget = false;
+	for (const FBudgetResult& Budget : Budgets)
+	{
+		if (Budget.IsExceeded())
+		{
+			bOverBudget = true;
+			UE_LOG(LogMagicOptimizer, Error, TEXT("Commandlet: budget %s exceeded: %.1f > %.1f"), *Budget.Name, Budget.Actual, Budget.Limit);
+		}
+		else
+		{
+			UE_LOG(LogMagicOptimizer, Display, TEXT("Commandlet: budget %s ok: %.1f <= %.1f"), *Budget.Name, Budget.Actual, Budget.Limit);
+		}
+	}
+
+	const bool bFailed = !PhaseResult.bSuccess || (bWantTextures && !bHaveAudit);
+	const int32 ExitCode = bFailed ? ExitFailed : bOverBudget ? ExitOverBudget : ExitSuccess;
+
+	Phase.Emplace(TEXT("Report"));
+
+	// audit.csv makes the run show up in the dock's Reports list
+	if (bHaveCsv)
+	{
+		FString AuditCsv = FPaths::ProjectSavedDir() / (Settings ? Settings->OutputDirectory : FString(TEXT("Saved/MagicOptimizer"))) / TEXT("Audit/textures.csv");
+		if (!FPaths::FileExists(AuditCsv))
+		{
+			AuditCsv = FPaths::ProjectSavedDir() / TEXT("MagicOptimizer/Audit/textures.csv");
+		}
+		CopyToReport(AuditCsv, OutDir / TEXT("audit.csv"));
+	}
+	if (NumInspected > 0)
+	{
+		WriteInspectionCsv(Rows, OutDir / TEXT("inspection.csv"));
+	}
+
+	TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+	Summary->SetStringField(TEXT("phase"), Options.Run.Phase);
+	Summary->SetStringField(TEXT("profile"), Options.Run.Profile);
+	Summary->SetStringField(TEXT("include"), Options.Run.IncludePaths);
+	Summary->SetStringField(TEXT("exclude"), Options.Run.ExcludePaths);
+	Summary->SetStringField(TEXT("categories"), FString::Join(Options.Run.Categories, TEXT(",")));
+	Summary->SetNumberField(TEXT("exit_code"), ExitCode);
+	Summary->SetBoolField(TEXT("phase_success"), PhaseResult.bSuccess);
+	Summary->SetStringField(TEXT("phase_message"), PhaseResult.Message);
+	Summary->SetNumberField(TEXT("assets_modified"), PhaseResult.AssetsModified);
+
+	TSharedRef<FJsonObject> Textures = MakeShared<FJsonObject>();
+	Textures->SetNumberField(TEXT("rows"), Rows.Num());
+	Textures->SetNumberField(TEXT("inspected"), NumInspected);
+	Textures->SetNumberField(TEXT("rows_with_issues"), RowsWithIssues);
+	Textures->SetNumberField(TEXT("estimated_memory_mb"), EstimatedMB);
+	TSharedRef<FJsonObject> IssueObject = MakeShared<FJsonObject>();
+	for (const TPair<FString, int32>& Issue : IssueCounts)
+	{
+		IssueObject->SetNumberField(Issue.Key, Issue.Value);
+	}
+	Textures->SetObjectField(TEXT("issues"), IssueObject);
+	Summary->SetObjectField(TEXT("textures"), Textures);
+
+	TArray<TSharedPtr<FJsonValue>> BudgetValues;
+	for (const FBudgetResult& Budget : Budgets)
+	{
+		TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetStringField(TEXT("name"), Budget.Name);
+		Entry->SetNumberField(TEXT("limit"), Budget.Limit);
+		Entry->SetNumberField(TEXT("actual"), Budget.Actual);
+		Entry->SetBoolField(TEXT("exceeded"), Budget.IsExceeded());
+		BudgetValues.Add(MakeShared<FJsonValueObject>(Entry));
+	}
+	Summary->SetArrayField(TEXT("budgets"), BudgetValues);
+	WriteJson(Summary, OutDir / TEXT("summary.json"));
+	Phase.Reset();
+
+	const MagicOptimizerStats::FRunStats Stats = MagicOptimizerStats::EndRun();
+	// Always this run's: a reused -out folder still holds the previous run's stats.json
+	const FString StatsPath = OutDir / TEXT("stats.json");
+	if (!FFileHelper::SaveStringToFile(Stats.ToJsonString(), *StatsPath))
+	{
+		UE_LOG(LogMagicOptimizer, Error, TEXT("Commandlet: could not write %s"), *StatsPath);
+	}
+
+	UE_LOG(LogMagicOptimizer, Display, TEXT("Commandlet: %d textures, %d with issues, %.1f MB estimated, %.2fs; exit code %d"),
+		Rows.Num(), RowsWithIssues, EstimatedMB, Stats.WallSeconds, ExitCode);
+	MagicOptimizerLog::Flush();
+	return ExitCode;
+}
@@ -0,0 +1,633 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  MagicOptimizerGenerateContentCommandlet.cpp
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#include "Commandlets/MagicOptimizerGenerateContentCommandlet.h"
+#include "MagicOptimizerLogging.h"
+#include "MagicOptimizerStats.h"
+#include "Async/ParallelFor.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Math/Float16Color.h"
+#include "Math/RandomStream.h"
+#include "MeshDescription.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "StaticMeshAttributes.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "UObject/UObjectGlobals.h"
+#include "MagicOptimizerMemory.h"
+
+#if WITH_EDITOR
+namespace
+{
+	enum class EAssetKind : uint32
+	{
+		Texture = 1,
+		Material = 2,
+		Mesh = 3,
+	};
+
+	struct FGenerateOptions
+	{
+		FString Root = TEXT("/Game/MagicOptimizerSynthetic");
+		int32 NumTextures = 1000;
+		int32 NumMaterials = 200;
+		int32 NumMeshes = 200;
+		int32 Seed = 1337;
+		int32 MaxTextureSize = 1024;
+		int32 MinTriangles = 200;
+		int32 MaxTriangles = 20000;
+		int32 MaxLODs = 3;
+		int32 BatchSize = 256;
+		bool bBuild = false;
+		bool bClean = false;
+		FString MaterialParent = TEXT("/Engine/EngineMaterials/DefaultMaterial.DefaultMaterial");
+	};
+
+	struct FGenerateCounts
+	{
+		int32 Saved = 0;
+		int32 Failed = 0;
+		int64 Bytes = 0;
+	};
+
+	// Source payload generated per batch is capped so large textures do not exhaust memory
+	static constexpr int64 MaxBatchPayloadBytes = 256ll * 1024 * 1024;
+	// Assets per sub-folder, as a large project would spread them
+	static constexpr int32 AssetsPerFolder = 500;
+	static const FName MeshSlotName(TEXT("Default"));
+
+	static const TCHAR* AssetWords[] = {
+		TEXT("Rock"), TEXT("Brick"), TEXT("Metal"), TEXT("Wood"), TEXT("Fabric"),
+		TEXT("Foliage"), TEXT("Concrete"), TEXT("Plastic"), TEXT("Glass"), TEXT("Ground"),
+	};
+
+	// Every asset is seeded from (Seed, Kind, Index) only, so output does not depend on batching or threads
+	static uint32 MakeAssetSeed(const FGenerateOptions& Options, EAssetKind Kind, int32 Index)
+	{
+		return HashCombineFast(HashCombineFast(GetTypeHash(Options.Seed), (uint32)Kind), GetTypeHash(Index));
+	}
+
+	static FString MakeFolder(const FGenerateOptions& Options, const TCHAR* KindFolder, int32 Index)
+	{
+		return FString::Printf(TEXT("%s/%s/Set%03d"), *Options.Root, KindFolder, Index / AssetsPerFolder);
+	}
+
+	static FString MakeObjectPath(const FString& PackageName, const FString& AssetName)
+	{
+		return PackageName + TEXT(".") + AssetName;
+	}
+
+	/* ---------- Textures ---------- */
+
+	struct FTextureSpec
+	{
+		FString PackageName;
+		FString AssetName;
+		int32 Width = 0;
+		int32 Height = 0;
+		ETextureSourceFormat Format = TSF_BGRA8;
+		TextureCompressionSettings Compression = TC_Default;
+		TextureGroup LODGroup = TEXTUREGROUP_World;
+		bool bSRGB = true;
+		uint32 PixelSeed = 0;
+
+		static int32 GetBytesPerPixel(ETextureSourceFormat InFormat)
+		{
+			return InFormat == TSF_G8 ? 1 : InFormat == TSF_RGBA16F ? 8 : 4;
+		}
+
+		int64 GetPayloadBytes() const
+		{
+			return (int64)Width * Height * GetBytesPerPixel(Format);
+		}
+	};
+
+	static int32 PickTextureDimension(FRandomStream& Random, int32 MaxSize)
+	{
+		// Weighted toward 256-1024, with a tail of 2K-8K and some non-power-of-two imports
+		static const int32 Sizes[] = { 32, 64, 128, 256, 256, 512, 512, 512, 1024, 1024, 1024, 2048, 2048, 4096, 8192 };
+		int32 Size = FMath::Min(Sizes[Random.RandHelper(UE_ARRAY_COUNT(Sizes))], MaxSize);
+		if (Random.FRand() < 0.1f)
+		{
+			Size = FMath::Max(4, FMath::RoundToInt(Size * Random.FRandRange(0.6f, 0.95f)));
+		}
+		return Size;
+	}
+
+	static FTextureSpec MakeTextureSpec(const FGenerateOptions& Options, int32 Index)
+	{
+		FRandomStream Random(MakeAssetSeed(Options, EAssetKind::Texture, Index));
+		FTextureSpec Spec;
+		Spec.PixelSeed = Random.GetUnsignedInt();
+		Spec.Width = PickTextureDimension(Random, Options.MaxTextureSize);
+		Spec.Height = Random.FRand() < 0.8f ? Spec.Width : PickTextureDimension(Random, Options.MaxTextureSize);
+
+		// Texture role by naming convention; a share of each role gets the wrong sRGB flag so audits have findings
+		const float Role = Random.FRand();
+		const TCHAR* Suffix = TEXT("");
+		if (Role < 0.35f)
+		{
+			Suffix = TEXT("_D");
+			Spec.bSRGB = Random.FRand() >= 0.05f;
+		}
+		else if (Role < 0.60f)
+		{
+			Suffix = TEXT("_N");
+			Spec.Compression = TC_Normalmap;
+			Spec.LODGroup = TEXTUREGROUP_WorldNormalMap;
+			Spec.bSRGB = Random.FRand() < 0.1f;
+		}
+		else if (Role < 0.75f)
+		{
+			Suffix = TEXT("_ORM");
+			Spec.Compression = TC_Masks;
+			Spec.LODGroup = TEXTUREGROUP_WorldSpecular;
+			Spec.bSRGB = Random.FRand() < 0.15f;
+		}
+		else if (Role < 0.80f)
+		{
+			Suffix = TEXT("_M");
+			Spec.Format = TSF_G8;
+			Spec.Compression = TC_Grayscale;
+			Spec.bSRGB = Random.FRand() < 0.15f;
+		}
+		else if (Role < 0.85f)
+		{
+			Suffix = TEXT("_E");
+			Spec.Format = Random.FRand() < 0.5f ? TSF_RGBA16F : TSF_BGRA8;
+			Spec.Compression = Spec.Format == TSF_RGBA16F ? TC_HDR : TC_Default;
+			Spec.bSRGB = Spec.Format != TSF_RGBA16F;
+		}
+		else if (Role < 0.95f)
+		{
+			Suffix = TEXT("_UI");
+			Spec.Compression = Random.FRand() < 0.5f ? TC_EditorIcon : TC_Default;
+			Spec.LODGroup = TEXTUREGROUP_UI;
+		}
+		// Remaining 5% carry no suffix, as unconventional imports do
+
+		Spec.AssetName = FString::Printf(TEXT("T_%s_%06d%s"), AssetWords[Random.RandHelper(UE_ARRAY_COUNT(AssetWords))], Index, Suffix);
+		Spec.PackageName = MakeFolder(Options, TEXT("Textures"), Index) / Spec.AssetName;
+		return Spec;
+	}
+
+	static void FillTexturePixels(const FTextureSpec& Spec, TArray64<uint8>& OutPixels)
+	{
+		OutPixels.SetNumUninitialized(Spec.GetPayloadBytes());
+		FRandomStream Random(Spec.PixelSeed);
+		const int32 CellShift = Random.RandRange(2, 5);
+		const bool bNormal = Spec.Compression == TC_Normalmap;
+		const uint8 BaseB = bNormal ? 255 : (uint8)Random.RandRange(0, 191);
+		const uint8 BaseG = bNormal ? 128 : (uint8)Random.RandRange(0, 191);
+		const uint8 BaseR = bNormal ? 128 : (uint8)Random.RandRange(0, 191);
+		const uint8 NoiseMask = bNormal ? 0x0F : 0x3F;
+
+		uint8* Out = OutPixels.GetData();
+		for (int32 Y = 0; Y < Spec.Height; ++Y)
+		{
+			for (int32 X = 0; X < Spec.Width; ++X)
+			{
+				const uint32 Cell = HashCombineFast((uint32)(X >> CellShift), (uint32)(Y >> CellShift)) ^ Spec.PixelSeed;
+				const uint8 Noise = (uint8)(Cell & NoiseMask);
+				switch (Spec.Format)
+				{
+				case TSF_G8:
+					*Out++ = (uint8)((X * 191) / FMath::Max(1, Spec.Width - 1)) + Noise;
+					break;
+				case TSF_RGBA16F:
+				{
+					const FFloat16Color Color(FLinearColor(BaseR / 64.0f, BaseG / 64.0f, BaseB / 64.0f + Noise / 16.0f, 1.0f));
+					FMemory::Memcpy(Out, &Color, sizeof(Color));
+					Out += sizeof(Color);
+					break;
+				}
+				default:
+					*Out++ = bNormal ? BaseB : (uint8)(BaseB + Noise);
+					*Out++ = (uint8)(BaseG + Noise);
+					*Out++ = (uint8)(BaseR + (bNormal ? 0 : Noise));
+					*Out++ = 255;
+					break;
+				}
+			}
+		}
+	}
+
+	static UObject* CreateTexture(const FGenerateOptions& Options, const FTextureSpec& Spec, const TArray64<uint8>& Pixels)
+	{
+		UPackage* Package = CreatePackage(*Spec.PackageName);
+		UTexture2D* Texture = NewObject<UTexture2D>(Package, FName(*Spec.AssetName), RF_Public | RF_Standalone);
+		Texture->Source.Init(Spec.Width, Spec.Height, /*NewNumSlices*/ 1, /*NewNumMips*/ 1, Spec.Format, Pixels.GetData());
+		Texture->SRGB = Spec.bSRGB;
+		Texture->CompressionSettings = Spec.Compression;
+		Texture->LODGroup = Spec.LODGroup;
+		if (Spec.LODGroup == TEXTUREGROUP_UI)
+		{
+			Texture->MipGenSettings = TMGS_NoMipmaps;
+			Texture->NeverStream = true;
+		}
+		if (Options.bBuild)
+		{
+			Texture->PostEditChange();
+		}
+		return Texture;
+	}
+
+	/* ---------- Materials ---------- */
+
+	struct FMaterialSpec
+	{
+		FString PackageName;
+		FString AssetName;
+		int32 TextureIndex = INDEX_NONE;
+		float Roughness = 0.5f;
+		FLinearColor Tint = FLinearColor::White;
+
+		int64 GetPayloadBytes() const { return 0; }
+	};
+
+	struct FNoPayload
+	{
+	};
+
+	static FMaterialSpec MakeMaterialSpec(const FGenerateOptions& Options, int32 Index)
+	{
+		FRandomStream Random(MakeAssetSeed(Options, EAssetKind::Material, Index));
+		FMaterialSpec Spec;
+		Spec.Roughness = Random.FRand();
+		Spec.Tint = FLinearColor(Random.FRand(), Random.FRand(), Random.FRand(), 1.0f);
+		if (Options.NumTextures > 0)
+		{
+			Spec.TextureIndex = Random.RandHelper(Options.NumTextures);
+		}
+		Spec.AssetName = FString::Printf(TEXT("MI_%s_%06d"), AssetWords[Random.RandHelper(UE_ARRAY_COUNT(AssetWords))], Index);
+		Spec.PackageName = MakeFolder(Options, TEXT("Materials"), Index) / Spec.AssetName;
+		return Spec;
+	}
+
+	static UObject* CreateMaterialInstance(const FGenerateOptions& Options, const FMaterialSpec& Spec, UMaterialInterface* Parent)
+	{
+		UPackage* Package = CreatePackage(*Spec.PackageName);
+		UMaterialInstanceConstant* Instance = NewObject<UMaterialInstanceConstant>(Package, FName(*Spec.AssetName), RF_Public | RF_Standalone);
+		Instance->SetParentEditorOnly(Parent);
+		Instance->SetScalarParameterValueEditorOnly(FMaterialParameterInfo(TEXT("Roughness")), Spec.Roughness);
+		Instance->SetVectorParameterValueEditorOnly(FMaterialParameterInfo(TEXT("Tint")), Spec.Tint);
+		if (Spec.TextureIndex != INDEX_NONE)
+		{
+			const FTextureSpec TextureSpec = MakeTextureSpec(Options, Spec.TextureIndex);
+			if (UTexture* Texture = LoadObject<UTexture>(nullptr, *MakeObjectPath(TextureSpec.PackageName, TextureSpec.AssetName), nullptr, LOAD_NoWarn | LOAD_Quiet))
+			{
+				Instance->SetTextureParameterValueEditorOnly(FMaterialParameterInfo(TEXT("BaseColor")), Texture);
+			}
+		}
+		if (Options.bBuild)
+		{
+			Instance->PostEditChange();
+		}
+		return Instance;
+	}
+
+	/* ---------- Meshes ---------- */
+
+	struct FMeshSpec
+	{
+		FString PackageName;
+		FString AssetName;
+		int32 Triangles = 0;
+		int32 NumLODs = 1;
+		int32 MaterialIndex = INDEX_NONE;
+		uint32 ShapeSeed = 0;
+
+		int64 GetPayloadBytes() const
+		{
+			// Rough size of the mesh descriptions for all LODs
+			return (int64)Triangles * 2 * 160;
+		}
+	};
+
+	static FMeshSpec MakeMeshSpec(const FGenerateOptions& Options, int32 Index)
+	{
+		FRandomStream Random(MakeAssetSeed(Options, EAssetKind::Mesh, Index));
+		FMeshSpec Spec;
+		Spec.ShapeSeed = Random.GetUnsignedInt();
+		// Log-uniform, so most meshes are light and a few are heavy
+		const float LogMin = FMath::Loge((float)Options.MinTriangles);
+		const float LogMax = FMath::Loge((float)FMath::Max(Options.MinTriangles, Options.MaxTriangles));
+		Spec.Triangles = FMath::Max(2, FMath::RoundToInt(FMath::Exp(FMath::Lerp(LogMin, LogMax, Random.FRand()))));
+		Spec.NumLODs = Random.RandRange(1, Options.MaxLODs);
+		if (Options.NumMaterials > 0)
+		{
+			Spec.MaterialIndex = Random.RandHelper(Options.NumMaterials);
+		}
+		Spec.AssetName = FString::Printf(TEXT("SM_%s_%06d"), AssetWords[Random.RandHelper(UE_ARRAY_COUNT(AssetWords))], Index);
+		Spec.PackageName = MakeFolder(Options, TEXT("Meshes"), Index) / Spec.AssetName;
+		return Spec;
+	}
+
+	// Displaced grid of about Triangles triangles
+	static FMeshDescription BuildGridMesh(int32 Triangles, uint32 ShapeSeed)
+	{
+		const int32 Cells = FMath::Max(1, FMath::RoundToInt(FMath::Sqrt(Triangles * 0.5f)));
+		const int32 Side = Cells + 1;
+
+		FMeshDescription Description;
+		FStaticMeshAttributes Attributes(Description);
+		Attributes.Register();
+		TVertexAttributesRef<FVector3f> Positions = Attributes.GetVertexPositions();
+		TVertexInstanceAttributesRef<FVector3f> Normals = Attributes.GetVertexInstanceNormals();
+		TVertexInstanceAttributesRef<FVector2f> UVs = Attributes.GetVertexInstanceUVs();
+		TPolygonGroupAttributesRef<FName> SlotNames = Attributes.GetPolygonGroupMaterialSlotNames();
+
+		Description.ReserveNewVertices(Side * Side);
+		Description.ReserveNewVertexInstances(Side * Side);
+		Description.ReserveNewTriangles(Cells * Cells * 2);
+		Description.ReserveNewPolygons(Cells * Cells * 2);
+		const FPolygonGroupID Group = Description.CreatePolygonGroup();
+		SlotNames[Group] = MeshSlotName;
+
+		FRandomStream Random(ShapeSeed);
+		const float Size = Random.FRandRange(50.0f, 400.0f);
+		const float Amplitude = Size * Random.FRandRange(0.0f, 0.25f);
+		const float Frequency = Random.FRandRange(1.0f, 12.0f);
+		const float Phase = Random.FRandRange(0.0f, UE_TWO_PI);
+
+		TArray<FVertexInstanceID> Instances;
+		Instances.SetNumUninitialized(Side * Side);
+		for (int32 Y = 0; Y < Side; ++Y)
+		{
+			for (int32 X = 0; X < Side; ++X)
+			{
+				const float U = (float)X / Cells;
+				const float V = (float)Y / Cells;
+				const FVertexID Vertex = Description.CreateVertex();
+				Positions[Vertex] = FVector3f((U - 0.5f) * Size, (V - 0.5f) * Size, Amplitude * FMath::Sin(U * Frequency + Phase) * FMath::Cos(V * Frequency + Phase));
+				const FVertexInstanceID Instance = Description.CreateVertexInstance(Vertex);
+				Normals[Instance] = FVector3f::UpVector;
+				UVs.Set(Instance, 0, FVector2f(U, V));
+				Instances[Y * Side + X] = Instance;
+			}
+		}
+
+		for (int32 Y = 0; Y < Cells; ++Y)
+		{
+			for (int32 X = 0; X < Cells; ++X)
+			{
+				const FVertexInstanceID I00 = Instances[Y * Side + X];
+				const FVertexInstanceID I10 = Instances[Y * Side + X + 1];
+				const FVertexInstanceID I01 = Instances[(Y + 1) * Side + X];
+				const FVertexInstanceID I11 = Instances[(Y + 1) * Side + X + 1];
+				const FVertexInstanceID First[3] = { I00, I11, I10 };
+				const FVertexInstanceID Second[3] = { I00, I01, I11 };
+				Description.CreateTriangle(Group, First);
+				Description.CreateTriangle(Group, Second);
+			}
+		}
+		return Description;
+	}
+
+	static TArray<FMeshDescription> BuildMeshLODs(const FMeshSpec& Spec)
+	{
+		TArray<FMeshDescription> LODs;
+		LODs.Reserve(Spec.NumLODs);
+		for (int32 LODIndex = 0; LODIndex < Spec.NumLODs; ++LODIndex)
+		{
+			LODs.Add(BuildGridMesh(FMath::Max(2, Spec.Triangles >> LODIndex), Spec.ShapeSeed));
+		}
+		return LODs;
+	}
+
+	static UObject* CreateStaticMesh(const FGenerateOptions& Options, const FMeshSpec& Spec, TArray<FMeshDescription>& LODs)
+	{
+		UMaterialInterface* Material = nullptr;
+		if (Spec.MaterialIndex != INDEX_NONE)
+		{
+			const FMaterialSpec MaterialSpec = MakeMaterialSpec(Options, Spec.MaterialIndex);
+			Material = LoadObject<UMaterialInterface>(nullptr, *MakeObjectPath(MaterialSpec.PackageName, MaterialSpec.AssetName), nullptr, LOAD_NoWarn | LOAD_Quiet);
+		}
+
+		UPackage* Package = CreatePackage(*Spec.PackageName);
+		UStaticMesh* Mesh = NewObject<UStaticMesh>(Package, FName(*Spec.AssetName), RF_Public | RF_Standalone);
+		Mesh->GetStaticMaterials().Add(FStaticMaterial(Material, MeshSlotName, MeshSlotName));
+		Mesh->SetNumSourceModels(LODs.Num());
+		for (int32 LODIndex = 0; LODIndex < LODs.Num(); ++LODIndex)
+		{
+			FMeshBuildSettings& BuildSettings = Mesh->GetSourceModel(LODIndex).BuildSettings;
+			BuildSettings.bRecomputeNormals = true;
+			BuildSettings.bRecomputeTangents = true;
+			Mesh->CreateMeshDescription(LODIndex, MoveTemp(LODs[LODIndex]));
+			Mesh->CommitMeshDescription(LODIndex);
+		}
+		if (Options.bBuild)
+		{
+			Mesh->Build(/*bInSilent*/ true);
+		}
+		return Mesh;
+	}
+
+	/* ---------- Save and batching ---------- */
+
+	static bool SaveAsset(UObject* Asset, FGenerateCounts& Counts)
+	{
+		MAGICOPT_STAGE_SCOPE(Save, MagicOptimizer_GenerateSave);
+		UPackage* Package = Asset->GetPackage();
+		Package->MarkPackageDirty();
+		const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+		FSavePackageArgs Args;
+		Args.TopLevelFlags = RF_Public | RF_Standalone;
+		Args.SaveFlags = SAVE_NoError | SAVE_Async;
+		Args.Error = GWarn;
+		const FSavePackageResultStruct Result = UPackage::Save(Package, Asset, *Filename, Args);
+		if (Result.Result != ESavePackageResult::Success)
+		{
+			UE_LOG(LogMagicOptimizer, Error, TEXT("GenerateContent: failed to save %s"), *Package->GetName());
+			return false;
+		}
+		Counts.Bytes += Result.TotalFileSize;
+		MAGICOPT_STAT_ASSET(Save, Package->GetName(), Result.TotalFileSize);
+		return true;
+	}
+
+	/**
+	 * Generates payloads for a batch in parallel, then creates and saves the assets on the game thread and
+	 * lets them be collected. Batches are bounded by count and by payload bytes.
+	 */
+	template <typename SpecType, typename PayloadType, typename MakePayloadFunc, typename CreateAssetFunc>
+	static FGenerateCounts GenerateBatched(const TCHAR* Kind, const TArray<SpecType>& Specs, int32 BatchSize, MakePayloadFunc MakePayload, CreateAssetFunc CreateAsset)
+	{
+		FGenerateCounts Counts;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Start = 0; Start < Specs.Num();)
+		{
+			int32 End = Start;
+			int64 PayloadBytes = 0;
+			while (End < Specs.Num() && End - Start < BatchSize && (End == Start || PayloadBytes + Specs[End].GetPayloadBytes() <= MaxBatchPayloadBytes))
+			{
+				PayloadBytes += Specs[End].GetPayloadBytes();
+				++End;
+			}
+
+			TArray<PayloadType> Payloads;
+			Payloads.SetNum(End - Start);
+			ParallelFor(Payloads.Num(), [&](int32 Offset)
+			{
+				MakePayload(Specs[Start + Offset], Payloads[Offset]);
+			});
+
+			TArray<UObject*> Created;
+			Created.Reserve(Payloads.Num());
+			for (int32 Offset = 0; Offset < Payloads.Num(); ++Offset)
+			{
+				UObject* Asset = CreateAsset(Specs[Start + Offset], Payloads[Offset]);
+				Payloads[Offset] = PayloadType();
+				if (Asset && SaveAsset(Asset, Counts))
+				{
+					++Counts.Saved;
+				}
+				else
+				{
+					++Counts.Failed;
+				}
+				if (Asset)
+				{
+					Created.Add(Asset);
+				}
+			}
+
+			for (UObject* Asset : Created)
+			{
+				Asset->ClearFlags(RF_Standalone);
+			}
+			Payloads.Empty();
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+			Start = End;
+			const double Elapsed = FPlatformTime::Seconds() - StartTime;
+			UE_LOG(LogMagicOptimizer, Display, TEXT("GenerateContent: %s %d/%d (%.0f/s)"), Kind, Start, Specs.Num(), Elapsed > 0.0 ? Start / Elapsed : 0.0);
+		}
+
+		// Later kinds load these assets back by path
+		UPackage::WaitForAsyncFileWrites();
+		return Counts;
+	}
+
+	template <typename SpecType, typename MakeSpecFunc>
+	static TArray<SpecType> MakeSpecs(const FGenerateOptions& Options, int32 Count, MakeSpecFunc MakeSpec)
+	{
+		TArray<SpecType> Specs;
+		Specs.SetNum(Count);
+		ParallelFor(Count, [&](int32 Index)
+		{
+			Specs[Index] = MakeSpec(Options, Index);
+		});
+		return Specs;
+	}
+
+	static FGenerateOptions ParseOptions(const FString& Params)
+	{
+		FGenerateOptions Options;
+		const TCHAR* Cmd = *Params;
+		FParse::Value(Cmd, TEXT("Path="), Options.Root);
+		FParse::Value(Cmd, TEXT("Textures="), Options.NumTextures);
+		FParse::Value(Cmd, TEXT("Materials="), Options.NumMaterials);
+		FParse::Value(Cmd, TEXT("Meshes="), Options.NumMeshes);
+		FParse::Value(Cmd, TEXT("Seed="), Options.Seed);
+		FParse::Value(Cmd, TEXT("MaxTextureSize="), Options.MaxTextureSize);
+		FParse::Value(Cmd, TEXT("MinTriangles="), Options.MinTriangles);
+		FParse::Value(Cmd, TEXT("MaxTriangles="), Options.MaxTriangles);
+		FParse::Value(Cmd, TEXT("MaxLODs="), Options.MaxLODs);
+		FParse::Value(Cmd, TEXT("BatchSize="), Options.BatchSize);
+		FParse::Value(Cmd, TEXT("MaterialParent="), Options.MaterialParent);
+		Options.bBuild = FParse::Param(Cmd, TEXT("Build"));
+		Options.bClean = FParse::Param(Cmd, TEXT("Clean"));
+
+		Options.Root.RemoveFromEnd(TEXT("/"));
+		Options.NumTextures = FMath::Max(0, Options.NumTextures);
+		Options.NumMaterials = FMath::Max(0, Options.NumMaterials);
+		Options.NumMeshes = FMath::Max(0, Options.NumMeshes);
+		Options.MaxTextureSize = FMath::Clamp(Options.MaxTextureSize, 4, 8192);
+		Options.MinTriangles = FMath::Max(2, Options.MinTriangles);
+		Options.MaxTriangles = FMath::Max(Options.MinTriangles, Options.MaxTriangles);
+		Options.MaxLODs = FMath::Clamp(Options.MaxLODs, 1, 8);
+		Options.BatchSize = FMath::Max(1, Options.BatchSize);
+		return Options;
+	}
+}
+#endif // WITH_EDITOR
+
+UMagicOptimizerGenerateContentCommandlet::UMagicOptimizerGenerateContentCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UMagicOptimizerGenerateContentCommandlet::Main(const FString& Params)
+{
+	MAGICOPT_LLM_SCOPE_ROOT();
+#if WITH_EDITOR
+	const FGenerateOptions Options = ParseOptions(Params);
+	FText Reason;
+	if (!FPackageName::IsValidLongPackageName(Options.Root, /*bIncludeReadOnlyRoots*/ false, &Reason))
+	{
+		UE_LOG(LogMagicOptimizer, Error, TEXT("GenerateContent: invalid -Path=%s: %s"), *Options.Root, *Reason.ToString());
+		return 1;
+	}
+
+	UMaterialInterface* Parent = LoadObject<UMaterialInterface>(nullptr, *Options.MaterialParent);
+	if (!Parent && Options.NumMaterials > 0)
+	{
+		UE_LOG(LogMagicOptimizer, Error, TEXT("GenerateContent: material parent %s not found"), *Options.MaterialParent);
+		return 1;
+	}
+
+	if (Options.bClean)
+	{
+		const FString Directory = FPackageName::LongPackageNameToFilename(Options.Root + TEXT("/"));
+		UE_LOG(LogMagicOptimizer, Display, TEXT("GenerateContent: deleting %s"), *Directory);
+		IFileManager::Get().DeleteDirectory(*Directory, /*RequireExists*/ false, /*Tree*/ true);
+	}
+
+	UE_LOG(LogMagicOptimizer, Display, TEXT("GenerateContent: %d textures, %d materials, %d meshes into %s (seed %d)"),
+		Options.NumTextures, Options.NumMaterials, Options.NumMeshes, *Options.Root, Options.Seed);
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Textures first: materials reference them, and meshes reference materials
+	const FGenerateCounts Textures = GenerateBatched<FTextureSpec, TArray64<uint8>>(TEXT("textures"),
+		MakeSpecs<FTextureSpec>(Options, Options.NumTextures, MakeTextureSpec), Options.BatchSize,
+		[](const FTextureSpec& Spec, TArray64<uint8>& OutPixels) { FillTexturePixels(Spec, OutPixels); },
+		[&Options](const FTextureSpec& Spec, TArray64<uint8>& Pixels) { return CreateTexture(Options, Spec, Pixels); });
+
+	const FGenerateCounts Materials = GenerateBatched<FMaterialSpec, FNoPayload>(TEXT("materials"),
+		MakeSpecs<FMaterialSpec>(Options, Options.NumMaterials, MakeMaterialSpec), Options.BatchSize,
+		[](const FMaterialSpec&, FNoPayload&) {},
+		[&Options, Parent](const FMaterialSpec& Spec, FNoPayload&) { return CreateMaterialInstance(Options, Spec, Parent); });
+
+	const FGenerateCounts Meshes = GenerateBatched<FMeshSpec, TArray<FMeshDescription>>(TEXT("meshes"),
+		MakeSpecs<FMeshSpec>(Options, Options.NumMeshes, MakeMeshSpec), Options.BatchSize,
+		[](const FMeshSpec& Spec, TArray<FMeshDescription>& OutLODs) { OutLODs = BuildMeshLODs(Spec); },
+		[&Options](const FMeshSpec& Spec, TArray<FMeshDescription>& LODs) { return CreateStaticMesh(Options, Spec, LODs); });
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+	const int32 Saved = Textures.Saved + Materials.Saved + Meshes.Saved;
+	const int32 Failed = Textures.Failed + Materials.Failed + Meshes.Failed;
+	const int64 Bytes = Textures.Bytes + Materials.Bytes + Meshes.Bytes;
+	UE_LOG(LogMagicOptimizer, Display, TEXT("GenerateContent: saved %d assets (%.1f MB) in %.1fs (%.0f assets/s), %d failed"),
+		Saved, Bytes / (1024.0 * 1024.0), Seconds, Seconds > 0.0 ? Saved / Seconds : 0.0, Failed);
+	return Failed > 0 ? 1 : 0;
+#else
+	UE_LOG(LogMagicOptimizer, Error, TEXT("GenerateContent requires an editor build"));
+	return 1;
+#endif
+}
@@ -4,12 +4,18 @@
 #include "MagicOptimizerLogging.h"
 #include "MagicOptimizerCVars.h"
 #include "MagicOptimizerStats.h"
+#include "OptimizerLogging.h"
+#include "Services/Knowledge/KnowledgeEventSink.h"
+#include "Services/Scheduling/GameThreadExecutor.h"
+#include "Services/Scheduling/MemoryGovernor.h"
 #include "Modules/ModuleManager.h"
+#include "MagicOptimizerMemory.h"
 
 #define LOCTEXT_NAMESPACE "FMagicOptimizerModule"
 
 void FMagicOptimizerModule::StartupModule()
 {
+	MAGICOPT_LLM_SCOPE_ROOT();
 	UE_LOG(LogMagicOptimizer, Log, TEXT("MagicOptimizer (Runtime) module startup"));
 	
 	// CVars are automatically registered when this module loads
@@ -19,6 +25,14 @@ void FMagicOptimizerModule::StartupModule()
 void FMagicOptimizerModule::ShutdownModule()
 {
 	UE_LOG(LogMagicOptimizer, Log, TEXT("MagicOptimizer (Runtime) module shutdown"));
+
+	// Time-sliced jobs still queued would run against unloaded code
+	MagicOptimizerGameThread::Shutdown();
+	MagicOptimizerMemoryGovernor::Shutdown();
+
+	// Write out queued plugin log lines and knowledge records, and stop their writer threads before the module unloads
+	MagicOptimizerLog::Shutdown();
+	MagicOptimizerKnowledge::Shutdown();
 }
 
 // The runtime module deliberately contains no editor-only registrations.
@@ -2,9 +2,13 @@
 
 #include "MagicOptimizerCVars.h"
 #include "HAL/IConsoleManager.h"
+#include "Async/TaskGraphInterfaces.h"
 #include "MagicOptimizerSubsystem.h"
 #include "Engine/Engine.h"
 #include "MagicOptimizerLogging.h"
+#include "Services/Knowledge/KnowledgeAggregator.h"
+#include "Services/Scheduling/GameThreadExecutor.h"
+#include "Services/Scheduling/MemoryGovernor.h"
 
 // Console variables for MagicOptimizer runtime control
 namespace MagicOptimizerCVars
@@ -62,6 +66,76 @@ namespace MagicOptimizerCVars
         TEXT("Enable performance tracking (0=disabled, 1=enabled)"),
         FConsoleVariableDelegate(),
         ECVF_Default);
+
+    // Plugin log file rotation
+    static int32 GMagicOptLogMaxFileMB = 16;
+    static FAutoConsoleVariableRef CVarMagicOptLogMaxFileMB(
+        TEXT("magicopt.LogMaxFileMB"),
+        GMagicOptLogMaxFileMB,
+        TEXT("Rotate the plugin log files once they reach this size in MB (0=never rotate, default: 16)"),
+        FConsoleVariableDelegate(),
+        ECVF_Default);
+
+    // Worker parallelism for plugin-side batch work
+    static int32 GMagicOptMaxWorkerThreads = 0;
+    static FAutoConsoleVariableRef CVarMagicOptMaxWorkerThreads(
+        TEXT("magicopt.MaxWorkerThreads"),
+        GMagicOptMaxWorkerThreads,
+        TEXT("Maximum worker threads used by plugin batch work such as rule evaluation (0=all task graph workers, default: 0)"),
+        FConsoleVariableDelegate(),
+        ECVF_Default);
+
+    // Knowledge base compaction
+    static int32 GMagicOptKnowledgeCompactMB = 64;
+    static FAutoConsoleVariableRef CVarMagicOptKnowledgeCompactMB(
+        TEXT("magicopt.KnowledgeCompactMB"),
+        GMagicOptKnowledgeCompactMB,
+        TEXT("Compact the knowledge base once a raw event or CSV file passes this size in MB (0=never, default: 64)"),
+        FConsoleVariableDelegate(),
+        ECVF_Default);
+
+    // Game-thread time slicing for loads, edits and saves
+    static float GMagicOptGameThreadBudgetMs = 8.0f;
+    static FAutoConsoleVariableRef CVarMagicOptGameThreadBudgetMs(
+        TEXT("magicopt.GameThreadBudgetMs"),
+        GMagicOptGameThreadBudgetMs,
+        TEXT("Milliseconds per frame plugin work may spend on the game thread (default: 8.0)"),
+        FConsoleVariableDelegate(),
+        ECVF_Default);
+
+    static float GMagicOptGameThreadInteractiveBudgetMs = 2.0f;
+    static FAutoConsoleVariableRef CVarMagicOptGameThreadInteractiveBudgetMs(
+        TEXT("magicopt.GameThreadInteractiveBudgetMs"),
+        GMagicOptGameThreadInteractiveBudgetMs,
+        TEXT("Per-frame game-thread budget while the user is interacting with the editor (default: 2.0)"),
+        FConsoleVariableDelegate(),
+        ECVF_Default);
+
+    // Run queue: interactive requests preempt background passes
+    static int32 GMagicOptPreemptBackground = 1;
+    static FAutoConsoleVariableRef CVarMagicOptPreemptBackground(
+        TEXT("magicopt.PreemptBackground"),
+        GMagicOptPreemptBackground,
+        TEXT("Cancel and requeue a running background pass when a selection-scoped pass is requested (0=only run it next, 1=preempt, default: 1)"),
+        FConsoleVariableDelegate(),
+        ECVF_Default);
+
+    // Memory governor for load-based audits and applies
+    static int32 GMagicOptMemoryCeilingMB = 0;
+    static FAutoConsoleVariableRef CVarMagicOptMemoryCeilingMB(
+        TEXT("magicopt.MemoryCeilingMB"),
+        GMagicOptMemoryCeilingMB,
+        TEXT("Working set in MB at which load-based batches unload the packages they loaded and collect garbage (0=half of physical memory, default: 0)"),
+        FConsoleVariableDelegate(),
+        ECVF_Default);
+
+    static int32 GMagicOptMaxLoadedPackages = 1000;
+    static FAutoConsoleVariableRef CVarMagicOptMaxLoadedPackages(
+        TEXT("magicopt.MaxLoadedPackages"),
+        GMagicOptMaxLoadedPackages,
+        TEXT("Packages load-based batches may keep loaded before unloading them (0=no limit, default: 1000)"),
+        FConsoleVariableDelegate(),
+        ECVF_Default);
 }
 
 // Console commands for MagicOptimizer
@@ -78,7 +152,7 @@ namespace MagicOptimizerCommands
                 if (UMagicOptimizerSubsystem* Subsystem = GEngine->GetEngineSubsystem<UMagicOptimizerSubsystem>())
                 {
                     Subsystem->RunOptimizationPass();
-                    UE_LOG(LogMagicOptimizer, Display, TEXT("Magic Optimizer pass started via console command"));
+                    UE_LOG(LogMagicOptimizer, Display, TEXT("Magic Optimizer pass requested via console command"));
                 }
                 else
                 {
@@ -98,7 +172,7 @@ namespace MagicOptimizerCommands
                 if (UMagicOptimizerSubsystem* Subsystem = GEngine->GetEngineSubsystem<UMagicOptimizerSubsystem>())
                 {
                     Subsystem->RunTextureOptimization();
-                    UE_LOG(LogMagicOptimizer, Display, TEXT("Magic Optimizer texture optimization started via console command"));
+                    UE_LOG(LogMagicOptimizer, Display, TEXT("Magic Optimizer texture optimization requested via console command"));
                 }
                 else
                 {
@@ -118,7 +192,7 @@ namespace MagicOptimizerCommands
                 if (UMagicOptimizerSubsystem* Subsystem = GEngine->GetEngineSubsystem<UMagicOptimizerSubsystem>())
                 {
                     Subsystem->RunMeshOptimization();
-                    UE_LOG(LogMagicOptimizer, Display, TEXT("Magic Optimizer mesh optimization started via console command"));
+                    UE_LOG(LogMagicOptimizer, Display, TEXT("Magic Optimizer mesh optimization requested via console command"));
                 }
                 else
                 {
@@ -138,7 +212,54 @@ namespace MagicOptimizerCommands
                 if (UMagicOptimizerSubsystem* Subsystem = GEngine->GetEngineSubsystem<UMagicOptimizerSubsystem>())
                 {
                     Subsystem->RunMaterialOptimization();
-                    UE_LOG(LogMagicOptimizer, Display, TEXT("Magic Optimizer material optimization started via console command"));
+                    UE_LOG(LogMagicOptimizer, Display, TEXT("Magic Optimizer material optimization requested via console command"));
+                }
+                else
+                {
+                    UE_LOG(LogMagicOptimizer, Error, TEXT("Magic Optimizer subsystem not found"));
+                }
+            }
+        }));
+
+    // Command to cancel the running pass
+    static FAutoConsoleCommand CmdMagicOptCancel(
+        TEXT("magicopt.Cancel"),
+        TEXT("Cancel the running Magic Optimizer pass"),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            if (GEngine)
+            {
+                if (UMagicOptimizerSubsystem* Subsystem = GEngine->GetEngineSubsystem<UMagicOptimizerSubsystem>())
+                {
+                    if (Subsystem->IsOptimizationRunning())
+                    {
+                        Subsystem->CancelOptimization();
+                        UE_LOG(LogMagicOptimizer, Display, TEXT("Magic Optimizer pass cancellation requested via console command"));
+                    }
+                    else
+                    {
+                        UE_LOG(LogMagicOptimizer, Display, TEXT("Magic Optimizer has no pass running"));
+                    }
+                }
+                else
+                {
+                    UE_LOG(LogMagicOptimizer, Error, TEXT("Magic Optimizer subsystem not found"));
+                }
+            }
+        }));
+
+    // Command to drop the queued passes
+    static FAutoConsoleCommand CmdMagicOptClearQueue(
+        TEXT("magicopt.ClearQueue"),
+        TEXT("Drop the queued Magic Optimizer passes; the running one carries on"),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            if (GEngine)
+            {
+                if (UMagicOptimizerSubsystem* Subsystem = GEngine->GetEngineSubsystem<UMagicOptimizerSubsystem>())
+                {
+                    Subsystem->ClearOptimizationQueue();
+                    UE_LOG(LogMagicOptimizer, Display, TEXT("Magic Optimizer run queue cleared via console command"));
                 }
                 else
                 {
@@ -159,8 +280,21 @@ namespace MagicOptimizerCommands
                 {
                     UE_LOG(LogMagicOptimizer, Display, TEXT("Magic Optimizer Status:"));
                     UE_LOG(LogMagicOptimizer, Display, TEXT("  Running: %s"), Subsystem->IsOptimizationRunning() ? TEXT("Yes") : TEXT("No"));
+                    TArray<FString> QueueLines;
+                    Subsystem->DescribeQueue(QueueLines);
+                    UE_LOG(LogMagicOptimizer, Display, TEXT("  Run Queue: %d passes queued"), Subsystem->GetQueuedPassCount());
+                    for (const FString& Line : QueueLines)
+                    {
+                        UE_LOG(LogMagicOptimizer, Display, TEXT("    %s"), *Line);
+                    }
                     UE_LOG(LogMagicOptimizer, Display, TEXT("  Last Time: %.2f seconds"), Subsystem->GetLastOptimizationTime());
                     UE_LOG(LogMagicOptimizer, Display, TEXT("  Assets Optimized: %d"), Subsystem->GetOptimizedAssetCount());
+                    UE_LOG(LogMagicOptimizer, Display, TEXT("  Game-Thread Queue: %d items (budget %.1f ms)"),
+                        MagicOptimizerGameThread::GetNumQueuedItems(), MagicOptimizerGameThread::GetBudgetSeconds() * 1000.0);
+                    const MagicOptimizerMemoryGovernor::FStatus Memory = MagicOptimizerMemoryGovernor::GetStatus();
+                    UE_LOG(LogMagicOptimizer, Display, TEXT("  Memory: %lld of %lld MB, %d packages loaded by batches, %d unloaded in %d collections"),
+                        Memory.UsedPhysicalBytes / (1024 * 1024), Memory.CeilingBytes / (1024 * 1024), Memory.NumTrackedPackages,
+                        Memory.NumUnloadedPackages, Memory.NumReclaims);
                 }
                 else
                 {
@@ -182,6 +316,54 @@ namespace MagicOptimizerCommands
             UE_LOG(LogMagicOptimizer, Display, TEXT("  magicopt.Verbose: %d"), MagicOptimizerCVars::GMagicOptVerbose);
             UE_LOG(LogMagicOptimizer, Display, TEXT("  magicopt.DryRun: %d"), MagicOptimizerCVars::GMagicOptDryRun);
             UE_LOG(LogMagicOptimizer, Display, TEXT("  magicopt.PerformanceTracking: %d"), MagicOptimizerCVars::GMagicOptPerformanceTracking);
+            UE_LOG(LogMagicOptimizer, Display, TEXT("  magicopt.LogMaxFileMB: %d"), MagicOptimizerCVars::GMagicOptLogMaxFileMB);
+            UE_LOG(LogMagicOptimizer, Display, TEXT("  magicopt.MaxWorkerThreads: %d"), MagicOptimizerCVars::GMagicOptMaxWorkerThreads);
+            UE_LOG(LogMagicOptimizer, Display, TEXT("  magicopt.KnowledgeCompactMB: %d"), MagicOptimizerCVars::GMagicOptKnowledgeCompactMB);
+            UE_LOG(LogMagicOptimizer, Display, TEXT("  magicopt.GameThreadBudgetMs: %.1f"), MagicOptimizerCVars::GMagicOptGameThreadBudgetMs);
+            UE_LOG(LogMagicOptimizer, Display, TEXT("  magicopt.GameThreadInteractiveBudgetMs: %.1f"), MagicOptimizerCVars::GMagicOptGameThreadInteractiveBudgetMs);
+            UE_LOG(LogMagicOptimizer, Display, TEXT("  magicopt.PreemptBackground: %d"), MagicOptimizerCVars::GMagicOptPreemptBackground);
+            UE_LOG(LogMagicOptimizer, Display, TEXT("  magicopt.MemoryCeilingMB: %d"), MagicOptimizerCVars::GMagicOptMemoryCeilingMB);
+            UE_LOG(LogMagicOptimizer, Display, TEXT("  magicopt.MaxLoadedPackages: %d"), MagicOptimizerCVars::GMagicOptMaxLoadedPackages);
+        }));
+
+    static void LogTopCounts(const TCHAR* Label, const MagicOptimizerKnowledge::FCountMap& Counts, int32 MaxEntries = 5)
+    {
+        TArray<TPair<FString, int64>> Sorted = Counts.Array();
+        Sorted.Sort([](const TPair<FString, int64>& A, const TPair<FString, int64>& B) { return A.Value > B.Value; });
+        TArray<FString> Entries;
+        for (int32 Index = 0; Index < FMath::Min(MaxEntries, Sorted.Num()); ++Index)
+        {
+            Entries.Add(FString::Printf(TEXT("%s=%lld"), *Sorted[Index].Key, Sorted[Index].Value));
+        }
+        UE_LOG(LogMagicOptimizer, Display, TEXT("  %s: %s"), Label, Entries.Num() > 0 ? *FString::Join(Entries, TEXT(", ")) : TEXT("-"));
+    }
+
+    // Command to fold new knowledge events and show the aggregates
+    static FAutoConsoleCommand CmdMagicOptKnowledge(
+        TEXT("magicopt.Knowledge"),
+        TEXT("Fold new knowledge base events into the aggregates and show the top counts"),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            const int64 Folded = MagicOptimizerKnowledge::UpdateAggregates();
+            const MagicOptimizerKnowledge::FKnowledgeAggregates Aggregates = MagicOptimizerKnowledge::LoadAggregates();
+            UE_LOG(LogMagicOptimizer, Display, TEXT("Magic Optimizer Knowledge: %lld events (%lld new, %lld compacted), %lld runs"),
+                Aggregates.Events, FMath::Max<int64>(0, Folded), Aggregates.CompactedEvents, Aggregates.Runs);
+            LogTopCounts(TEXT("Event types"), Aggregates.ByEventType);
+            LogTopCounts(TEXT("Profiles"), Aggregates.ByProfile);
+            LogTopCounts(TEXT("Formats"), Aggregates.ByFormat);
+            LogTopCounts(TEXT("Tokens"), Aggregates.ByToken);
+            LogTopCounts(TEXT("Issues"), Aggregates.ByIssue);
+            LogTopCounts(TEXT("Recommendations"), Aggregates.ByRecommendation);
+        }));
+
+    // Command to compact the knowledge base now
+    static FAutoConsoleCommand CmdMagicOptKnowledgeCompact(
+        TEXT("magicopt.KnowledgeCompact"),
+        TEXT("Fold and compact the knowledge base raw files now"),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            const bool bCompacted = MagicOptimizerKnowledge::Compact();
+            UE_LOG(LogMagicOptimizer, Display, TEXT("Magic Optimizer Knowledge compaction %s"), bCompacted ? TEXT("done") : TEXT("failed"));
         }));
 }
 
@@ -194,4 +376,22 @@ namespace MagicOptimizerCVars
     bool IsVerbose() { return GMagicOptVerbose != 0; }
     bool IsDryRun() { return GMagicOptDryRun != 0; }
     bool IsPerformanceTrackingEnabled() { return GMagicOptPerformanceTracking != 0; }
+    int64 GetLogMaxFileBytes() { return (int64)FMath::Max(0, GMagicOptLogMaxFileMB) * 1024 * 1024; }
+
+    int64 GetKnowledgeCompactBytes() { return (int64)FMath::Max(0, GMagicOptKnowledgeCompactMB) * 1024 * 1024; }
+    bool ShouldPreemptBackground() { return GMagicOptPreemptBackground != 0; }
+    int64 GetMemoryCeilingBytes() { return (int64)FMath::Max(0, GMagicOptMemoryCeilingMB) * 1024 * 1024; }
+    int32 GetMaxLoadedPackages() { return FMath::Max(0, GMagicOptMaxLoadedPackages); }
+
+    double GetGameThreadBudgetSeconds(bool bUserInteracting)
+    {
+        const float BudgetMs = FMath::Max(0.1f, GMagicOptGameThreadBudgetMs);
+        return (bUserInteracting ? FMath::Clamp(GMagicOptGameThreadInteractiveBudgetMs, 0.1f, BudgetMs) : BudgetMs) / 1000.0;
+    }
+
+    int32 GetWorkerThreadCount()
+    {
+        const int32 Available = FTaskGraphInterface::IsRunning() ? FTaskGraphInterface::Get().GetNumWorkerThreads() + 1 : 1;
+        return GMagicOptMaxWorkerThreads > 0 ? FMath::Min(GMagicOptMaxWorkerThreads, Available) : Available;
+    }
 }
@@ -0,0 +1,35 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#include "MagicOptimizerKnowledgeLibrary.h"
+#include "Services/Knowledge/KnowledgeAggregator.h"
+#include "Services/Knowledge/KnowledgeEventSink.h"
+
+bool UMagicOptimizerKnowledgeLibrary::AppendKnowledgeLines(const FString& FileName, const TArray<FString>& Lines, const FString& Header)
+{
+	return MagicOptimizerKnowledge::AppendLines(FileName, Lines, Header);
+}
+
+void UMagicOptimizerKnowledgeLibrary::FlushKnowledge()
+{
+	MagicOptimizerKnowledge::Flush();
+}
+
+FString UMagicOptimizerKnowledgeLibrary::GetKnowledgeDir()
+{
+	return MagicOptimizerKnowledge::GetKnowledgeDir();
+}
+
+int64 UMagicOptimizerKnowledgeLibrary::UpdateKnowledgeAggregates()
+{
+	return MagicOptimizerKnowledge::UpdateAggregates();
+}
+
+FString UMagicOptimizerKnowledgeLibrary::GetKnowledgeAggregatesJson()
+{
+	return MagicOptimizerKnowledge::LoadAggregates().ToJsonString();
+}
+
+bool UMagicOptimizerKnowledgeLibrary::CompactKnowledge()
+{
+	return MagicOptimizerKnowledge::Compact();
+}
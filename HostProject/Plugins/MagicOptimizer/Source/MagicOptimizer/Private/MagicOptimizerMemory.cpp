@@ -0,0 +1,57 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#include "MagicOptimizerMemory.h"
+
+// Underscores become the hierarchy separator: MagicOptimizer_Bridge is MagicOptimizer/Bridge
+LLM_DEFINE_TAG(MagicOptimizer);
+LLM_DEFINE_TAG(MagicOptimizer_Bridge);
+LLM_DEFINE_TAG(MagicOptimizer_AuditStore);
+LLM_DEFINE_TAG(MagicOptimizer_Views);
+LLM_DEFINE_TAG(MagicOptimizer_Thumbnails);
+LLM_DEFINE_TAG(MagicOptimizer_Apply);
+
+namespace MagicOptimizerMemory
+{
+	static const TCHAR* const TagNames[NumTags] =
+	{
+		TEXT("MagicOptimizer"),
+		TEXT("MagicOptimizer/Bridge"),
+		TEXT("MagicOptimizer/AuditStore"),
+		TEXT("MagicOptimizer/Views"),
+		TEXT("MagicOptimizer/Thumbnails"),
+		TEXT("MagicOptimizer/Apply"),
+	};
+
+	const TCHAR* GetTagName(int32 Index)
+	{
+		return TagNames[FMath::Clamp(Index, 0, NumTags - 1)];
+	}
+
+	bool IsTracking()
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		return FLowLevelMemTracker::IsEnabled();
+#else
+		return false;
+#endif
+	}
+
+	bool GetTagAmounts(int64 (&OutBytes)[NumTags])
+	{
+		FMemory::Memzero(OutBytes);
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		if (!IsTracking())
+		{
+			return false;
+		}
+		FLowLevelMemTracker& Tracker = FLowLevelMemTracker::Get();
+		for (int32 Index = 0; Index < NumTags; ++Index)
+		{
+			OutBytes[Index] = Tracker.GetTagAmountForTracker(ELLMTracker::Default, FName(TagNames[Index]), ELLMTagSet::None);
+		}
+		return true;
+#else
+		return false;
+#endif
+	}
+}
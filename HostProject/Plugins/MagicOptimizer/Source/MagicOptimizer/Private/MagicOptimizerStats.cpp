@@ -0,0 +1,660 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#include "MagicOptimizerStats.h"
+#include "MagicOptimizerLogging.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectGlobals.h"
+#include "MagicOptimizerMemory.h"
+#include <atomic>
+
+DEFINE_STAT(STAT_MagicOpt_PassTime);
+DEFINE_STAT(STAT_MagicOpt_TextureTime);
+DEFINE_STAT(STAT_MagicOpt_MeshTime);
+DEFINE_STAT(STAT_MagicOpt_MaterialTime);
+
+DEFINE_STAT(STAT_MagicOpt_Stage_RegistryQuery);
+DEFINE_STAT(STAT_MagicOpt_Stage_AssetLoad);
+DEFINE_STAT(STAT_MagicOpt_Stage_Analyze);
+DEFINE_STAT(STAT_MagicOpt_Stage_RuleEvaluation);
+DEFINE_STAT(STAT_MagicOpt_Stage_CsvRead);
+DEFINE_STAT(STAT_MagicOpt_Stage_CsvWrite);
+DEFINE_STAT(STAT_MagicOpt_Stage_ReportRead);
+DEFINE_STAT(STAT_MagicOpt_Stage_ReportWrite);
+DEFINE_STAT(STAT_MagicOpt_Stage_Apply);
+DEFINE_STAT(STAT_MagicOpt_Stage_Save);
+DEFINE_STAT(STAT_MagicOpt_Stage_LogWrite);
+DEFINE_STAT(STAT_MagicOpt_Stage_Bridge);
+
+DEFINE_STAT(STAT_MagicOpt_Run_RegistryQueryMs);
+DEFINE_STAT(STAT_MagicOpt_Run_AssetLoadMs);
+DEFINE_STAT(STAT_MagicOpt_Run_AnalyzeMs);
+DEFINE_STAT(STAT_MagicOpt_Run_RuleEvaluationMs);
+DEFINE_STAT(STAT_MagicOpt_Run_CsvReadMs);
+DEFINE_STAT(STAT_MagicOpt_Run_CsvWriteMs);
+DEFINE_STAT(STAT_MagicOpt_Run_ReportReadMs);
+DEFINE_STAT(STAT_MagicOpt_Run_ReportWriteMs);
+DEFINE_STAT(STAT_MagicOpt_Run_ApplyMs);
+DEFINE_STAT(STAT_MagicOpt_Run_SaveMs);
+DEFINE_STAT(STAT_MagicOpt_Run_LogWriteMs);
+DEFINE_STAT(STAT_MagicOpt_Run_BridgeMs);
+
+DEFINE_STAT(STAT_MagicOpt_RunSeconds);
+DEFINE_STAT(STAT_MagicOpt_AssetsPerSecond);
+DEFINE_STAT(STAT_MagicOpt_ReadMBPerSecond);
+DEFINE_STAT(STAT_MagicOpt_MBRead);
+DEFINE_STAT(STAT_MagicOpt_MBWritten);
+
+DEFINE_STAT(STAT_MagicOpt_AssetsProcessed);
+DEFINE_STAT(STAT_MagicOpt_AssetsOptimized);
+
+DEFINE_STAT(STAT_MagicOpt_EstimatedMemory);
+DEFINE_STAT(STAT_MagicOpt_MemorySaved);
+
+DEFINE_STAT(STAT_MagicOpt_Errors);
+DEFINE_STAT(STAT_MagicOpt_Warnings);
+
+namespace
+{
+	using MagicOptimizerStats::EStage;
+	using MagicOptimizerStats::NumStages;
+
+	// Live stats are republished at most this often while a run is recording
+	static constexpr double PublishIntervalSeconds = 0.25;
+
+	struct FStageCounters
+	{
+		std::atomic<uint64> Cycles{ 0 };
+		std::atomic<int64> Count{ 0 };
+		std::atomic<int64> Bytes{ 0 };
+	};
+
+	struct FRunState
+	{
+		FStageCounters Stages[NumStages];
+		std::atomic<int64> AssetsProcessed{ 0 };
+		std::atomic<int64> AssetsOptimized{ 0 };
+		std::atomic<int64> Errors{ 0 };
+		std::atomic<int64> Warnings{ 0 };
+		std::atomic<int64> EstimatedMemoryBytes{ 0 };
+		std::atomic<int64> MemorySavedBytes{ 0 };
+		std::atomic<int64> PeakWorkingSetBytes{ 0 };
+		std::atomic<int64> PeakUObjectCount{ 0 };
+		std::atomic<int64> GCPasses{ 0 };
+		std::atomic<int64> PeakTagBytes[MagicOptimizerMemory::NumTags] = {};
+		std::atomic<uint64> StartCycles{ FPlatformTime::Cycles64() };
+		std::atomic<uint64> NextPublishCycles{ 0 };
+
+		// Written by BeginRun and EndRun only
+		FCriticalSection LabelLock;
+		FString Label = TEXT("Session");
+		FDateTime StartTime = FDateTime::Now();
+		// Runs begun and not ended; the ones after the first join its report
+		int32 ActiveRuns = 0;
+		bool bAnyCancelled = false;
+
+		// Phases and the slowest assets; SlowestHeap is a min-heap on Seconds, so its head is the
+		// entry the next slower asset replaces once it holds MaxSlowestAssets
+		FCriticalSection DetailLock;
+		TArray<MagicOptimizerStats::FPhaseStats> Phases;
+		TArray<MagicOptimizerStats::FAssetTiming> SlowestHeap;
+		// Time an asset must beat to enter a full list; lets fast assets skip the lock
+		std::atomic<double> SlowestThreshold{ 0.0 };
+	};
+
+	static FRunState& GetState()
+	{
+		static FRunState State;
+		return State;
+	}
+
+	// Innermost open stage scope on this thread
+	static thread_local MagicOptimizerStats::FStageScope* GCurrentStageScope = nullptr;
+
+	static TStatId GetStageStatId(EStage Stage)
+	{
+#if STATS
+		switch (Stage)
+		{
+		case EStage::RegistryQuery: return GET_STATID(STAT_MagicOpt_Stage_RegistryQuery);
+		case EStage::AssetLoad: return GET_STATID(STAT_MagicOpt_Stage_AssetLoad);
+		case EStage::Analyze: return GET_STATID(STAT_MagicOpt_Stage_Analyze);
+		case EStage::RuleEvaluation: return GET_STATID(STAT_MagicOpt_Stage_RuleEvaluation);
+		case EStage::CsvRead: return GET_STATID(STAT_MagicOpt_Stage_CsvRead);
+		case EStage::CsvWrite: return GET_STATID(STAT_MagicOpt_Stage_CsvWrite);
+		case EStage::ReportRead: return GET_STATID(STAT_MagicOpt_Stage_ReportRead);
+		case EStage::ReportWrite: return GET_STATID(STAT_MagicOpt_Stage_ReportWrite);
+		case EStage::Apply: return GET_STATID(STAT_MagicOpt_Stage_Apply);
+		case EStage::Save: return GET_STATID(STAT_MagicOpt_Stage_Save);
+		case EStage::LogWrite: return GET_STATID(STAT_MagicOpt_Stage_LogWrite);
+		case EStage::Bridge: return GET_STATID(STAT_MagicOpt_Stage_Bridge);
+		default: break;
+		}
+#endif
+		return TStatId();
+	}
+
+#if STATS
+	static FName GetStageMsStatName(EStage Stage)
+	{
+		switch (Stage)
+		{
+		case EStage::RegistryQuery: return GET_STATFNAME(STAT_MagicOpt_Run_RegistryQueryMs);
+		case EStage::AssetLoad: return GET_STATFNAME(STAT_MagicOpt_Run_AssetLoadMs);
+		case EStage::Analyze: return GET_STATFNAME(STAT_MagicOpt_Run_AnalyzeMs);
+		case EStage::RuleEvaluation: return GET_STATFNAME(STAT_MagicOpt_Run_RuleEvaluationMs);
+		case EStage::CsvRead: return GET_STATFNAME(STAT_MagicOpt_Run_CsvReadMs);
+		case EStage::CsvWrite: return GET_STATFNAME(STAT_MagicOpt_Run_CsvWriteMs);
+		case EStage::ReportRead: return GET_STATFNAME(STAT_MagicOpt_Run_ReportReadMs);
+		case EStage::ReportWrite: return GET_STATFNAME(STAT_MagicOpt_Run_ReportWriteMs);
+		case EStage::Apply: return GET_STATFNAME(STAT_MagicOpt_Run_ApplyMs);
+		case EStage::Save: return GET_STATFNAME(STAT_MagicOpt_Run_SaveMs);
+		case EStage::LogWrite: return GET_STATFNAME(STAT_MagicOpt_Run_LogWriteMs);
+		case EStage::Bridge: return GET_STATFNAME(STAT_MagicOpt_Run_BridgeMs);
+		default: return NAME_None;
+		}
+	}
+#endif
+
+	static double ToMB(int64 Bytes)
+	{
+		return (double)Bytes / (1024.0 * 1024.0);
+	}
+
+	static void UpdateMax(std::atomic<int64>& Peak, int64 Value)
+	{
+		int64 Current = Peak.load(std::memory_order_relaxed);
+		while (Value > Current && !Peak.compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	// Working set, live UObjects and the plugin's LLM tags; sampled with the throughput stats, at phase edges and before each GC
+	static void SampleResources()
+	{
+		FRunState& State = GetState();
+		UpdateMax(State.PeakWorkingSetBytes, (int64)FPlatformMemory::GetStats().UsedPhysical);
+		UpdateMax(State.PeakUObjectCount, (int64)GUObjectArray.GetObjectArrayNumMinusAvailable());
+
+		int64 TagBytes[MagicOptimizerMemory::NumTags];
+		if (MagicOptimizerMemory::GetTagAmounts(TagBytes))
+		{
+			for (int32 Index = 0; Index < MagicOptimizerMemory::NumTags; ++Index)
+			{
+				UpdateMax(State.PeakTagBytes[Index], TagBytes[Index]);
+			}
+		}
+	}
+
+	static void OnPreGarbageCollect()
+	{
+		GetState().GCPasses.fetch_add(1, std::memory_order_relaxed);
+		SampleResources();
+	}
+
+	// Counters only; the label and start time are filled in by the callers that need them
+	static MagicOptimizerStats::FRunStats SnapshotCounters()
+	{
+		FRunState& State = GetState();
+		MagicOptimizerStats::FRunStats Stats;
+		Stats.WallSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - State.StartCycles.load(std::memory_order_relaxed));
+		for (int32 Index = 0; Index < NumStages; ++Index)
+		{
+			MagicOptimizerStats::FStageStats& Stage = Stats.Stages[Index];
+			Stage.Seconds = FPlatformTime::ToSeconds64(State.Stages[Index].Cycles.load(std::memory_order_relaxed));
+			Stage.Count = State.Stages[Index].Count.load(std::memory_order_relaxed);
+			Stage.Bytes = State.Stages[Index].Bytes.load(std::memory_order_relaxed);
+			if (MagicOptimizerTrace::IsReadStage((EStage)Index))
+			{
+				Stats.BytesRead += Stage.Bytes;
+			}
+			else if (MagicOptimizerTrace::IsWriteStage((EStage)Index))
+			{
+				Stats.BytesWritten += Stage.Bytes;
+			}
+		}
+		Stats.AssetsProcessed = State.AssetsProcessed.load(std::memory_order_relaxed);
+		Stats.AssetsOptimized = State.AssetsOptimized.load(std::memory_order_relaxed);
+		Stats.Errors = State.Errors.load(std::memory_order_relaxed);
+		Stats.Warnings = State.Warnings.load(std::memory_order_relaxed);
+		Stats.EstimatedMemoryBytes = State.EstimatedMemoryBytes.load(std::memory_order_relaxed);
+		Stats.MemorySavedBytes = State.MemorySavedBytes.load(std::memory_order_relaxed);
+		Stats.PeakWorkingSetBytes = State.PeakWorkingSetBytes.load(std::memory_order_relaxed);
+		Stats.PeakUObjectCount = State.PeakUObjectCount.load(std::memory_order_relaxed);
+		Stats.GCPasses = State.GCPasses.load(std::memory_order_relaxed);
+		for (int32 Index = 0; Index < MagicOptimizerMemory::NumTags; ++Index)
+		{
+			Stats.PeakTagBytes[Index] = State.PeakTagBytes[Index].load(std::memory_order_relaxed);
+		}
+		return Stats;
+	}
+
+	// Derived stats (rates and totals); the per-stage and count stats are updated as they change
+	static void PublishThroughput(const MagicOptimizerStats::FRunStats& Stats)
+	{
+		SET_FLOAT_STAT(STAT_MagicOpt_RunSeconds, Stats.WallSeconds);
+		SET_FLOAT_STAT(STAT_MagicOpt_AssetsPerSecond, Stats.GetAssetsPerSecond());
+		SET_FLOAT_STAT(STAT_MagicOpt_ReadMBPerSecond, Stats.GetReadMBPerSecond());
+		SET_FLOAT_STAT(STAT_MagicOpt_MBRead, ToMB(Stats.BytesRead));
+		SET_FLOAT_STAT(STAT_MagicOpt_MBWritten, ToMB(Stats.BytesWritten));
+	}
+
+	static void MaybePublishThroughput()
+	{
+		FRunState& State = GetState();
+		const uint64 Now = FPlatformTime::Cycles64();
+		uint64 Next = State.NextPublishCycles.load(std::memory_order_relaxed);
+		if (Now >= Next && State.NextPublishCycles.compare_exchange_strong(Next, Now + (uint64)(PublishIntervalSeconds / FPlatformTime::GetSecondsPerCycle64())))
+		{
+			SampleResources();
+#if STATS
+			PublishThroughput(SnapshotCounters());
+#endif
+		}
+	}
+
+	static void AddStageCycles(EStage Stage, uint64 Cycles)
+	{
+		if ((int32)Stage >= NumStages)
+		{
+			return;
+		}
+		GetState().Stages[(int32)Stage].Cycles.fetch_add(Cycles, std::memory_order_relaxed);
+#if STATS
+		INC_FLOAT_STAT_BY_FName(GetStageMsStatName(Stage), FPlatformTime::ToMilliseconds64(Cycles));
+#endif
+		MaybePublishThroughput();
+	}
+}
+
+namespace MagicOptimizerStats
+{
+	double FRunStats::GetAssetsPerSecond() const
+	{
+		return WallSeconds > 0.0 ? (double)AssetsProcessed / WallSeconds : 0.0;
+	}
+
+	double FRunStats::GetReadMBPerSecond() const
+	{
+		return WallSeconds > 0.0 ? ToMB(BytesRead) / WallSeconds : 0.0;
+	}
+
+	FString FRunStats::ToJsonString() const
+	{
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetStringField(TEXT("label"), Label);
+		Root->SetStringField(TEXT("start_time"), StartTime.ToIso8601());
+		Root->SetNumberField(TEXT("wall_seconds"), WallSeconds);
+		Root->SetBoolField(TEXT("cancelled"), bCancelled);
+		Root->SetNumberField(TEXT("assets_processed"), (double)AssetsProcessed);
+		Root->SetNumberField(TEXT("assets_optimized"), (double)AssetsOptimized);
+		Root->SetNumberField(TEXT("errors"), (double)Errors);
+		Root->SetNumberField(TEXT("warnings"), (double)Warnings);
+		Root->SetNumberField(TEXT("assets_per_second"), GetAssetsPerSecond());
+		Root->SetNumberField(TEXT("bytes_read"), (double)BytesRead);
+		Root->SetNumberField(TEXT("bytes_written"), (double)BytesWritten);
+		Root->SetNumberField(TEXT("read_mb_per_second"), GetReadMBPerSecond());
+		Root->SetNumberField(TEXT("estimated_memory_bytes"), (double)EstimatedMemoryBytes);
+		Root->SetNumberField(TEXT("memory_saved_bytes"), (double)MemorySavedBytes);
+
+		// Only stages the run went through
+		TSharedRef<FJsonObject> StageObject = MakeShared<FJsonObject>();
+		for (int32 Index = 0; Index < NumStages; ++Index)
+		{
+			const FStageStats& Stage = Stages[Index];
+			if (Stage.Seconds <= 0.0 && Stage.Count == 0)
+			{
+				continue;
+			}
+			TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+			Entry->SetNumberField(TEXT("seconds"), Stage.Seconds);
+			Entry->SetNumberField(TEXT("count"), (double)Stage.Count);
+			Entry->SetNumberField(TEXT("bytes"), (double)Stage.Bytes);
+			StageObject->SetObjectField(MagicOptimizerTrace::GetStageName((EStage)Index), Entry);
+		}
+		Root->SetObjectField(TEXT("stages"), StageObject);
+
+		Root->SetNumberField(TEXT("peak_working_set_bytes"), (double)PeakWorkingSetBytes);
+		Root->SetNumberField(TEXT("peak_uobject_count"), (double)PeakUObjectCount);
+		Root->SetNumberField(TEXT("gc_passes"), (double)GCPasses);
+
+		// Only with -llm; an empty object otherwise
+		TSharedRef<FJsonObject> TagObject = MakeShared<FJsonObject>();
+		for (int32 Index = 0; Index < MagicOptimizerMemory::NumTags; ++Index)
+		{
+			if (PeakTagBytes[Index] > 0)
+			{
+				TagObject->SetNumberField(MagicOptimizerMemory::GetTagName(Index), (double)PeakTagBytes[Index]);
+			}
+		}
+		Root->SetObjectField(TEXT("llm_peak_bytes"), TagObject);
+
+		TArray<TSharedPtr<FJsonValue>> PhaseArray;
+		for (const FPhaseStats& Phase : Phases)
+		{
+			TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+			Entry->SetStringField(TEXT("name"), Phase.Name);
+			Entry->SetNumberField(TEXT("start_seconds"), Phase.StartSeconds);
+			Entry->SetNumberField(TEXT("seconds"), Phase.Seconds);
+			PhaseArray.Add(MakeShared<FJsonValueObject>(Entry));
+		}
+		Root->SetArrayField(TEXT("phases"), PhaseArray);
+
+		TArray<TSharedPtr<FJsonValue>> SlowestArray;
+		for (const FAssetTiming& Asset : SlowestAssets)
+		{
+			TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+			Entry->SetStringField(TEXT("path"), Asset.Path);
+			Entry->SetStringField(TEXT("stage"), MagicOptimizerTrace::GetStageName(Asset.Stage));
+			Entry->SetNumberField(TEXT("seconds"), Asset.Seconds);
+			SlowestArray.Add(MakeShared<FJsonValueObject>(Entry));
+		}
+		Root->SetArrayField(TEXT("slowest_assets"), SlowestArray);
+
+		FString Json;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(Root, Writer);
+		return Json;
+	}
+
+	void BeginRun(const FString& Label)
+	{
+		FRunState& State = GetState();
+		{
+			FScopeLock Lock(&State.LabelLock);
+			if (State.ActiveRuns++ > 0)
+			{
+				// Resetting here would wipe the counters of the run still recording
+				UE_LOG(LogMagicOptimizer, Log, TEXT("%s run started while the %s run is recording; its numbers go into that run's report"), *Label, *State.Label);
+				return;
+			}
+			State.Label = Label;
+			State.StartTime = FDateTime::Now();
+			State.bAnyCancelled = false;
+		}
+		{
+			FScopeLock Lock(&State.DetailLock);
+			State.Phases.Reset();
+			State.SlowestHeap.Reset();
+			State.SlowestThreshold.store(0.0, std::memory_order_relaxed);
+		}
+
+		// Registered on the first run; the counter only reports GC passes between BeginRun and EndRun
+		static const FDelegateHandle PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddStatic(&OnPreGarbageCollect);
+		for (FStageCounters& Stage : State.Stages)
+		{
+			Stage.Cycles.store(0, std::memory_order_relaxed);
+			Stage.Count.store(0, std::memory_order_relaxed);
+			Stage.Bytes.store(0, std::memory_order_relaxed);
+		}
+		State.AssetsProcessed.store(0, std::memory_order_relaxed);
+		State.AssetsOptimized.store(0, std::memory_order_relaxed);
+		State.Errors.store(0, std::memory_order_relaxed);
+		State.Warnings.store(0, std::memory_order_relaxed);
+		State.EstimatedMemoryBytes.store(0, std::memory_order_relaxed);
+		State.MemorySavedBytes.store(0, std::memory_order_relaxed);
+		State.PeakWorkingSetBytes.store(0, std::memory_order_relaxed);
+		State.PeakUObjectCount.store(0, std::memory_order_relaxed);
+		State.GCPasses.store(0, std::memory_order_relaxed);
+		for (std::atomic<int64>& TagPeak : State.PeakTagBytes)
+		{
+			TagPeak.store(0, std::memory_order_relaxed);
+		}
+		State.StartCycles.store(FPlatformTime::Cycles64(), std::memory_order_relaxed);
+		SampleResources();
+
+#if STATS
+		for (int32 Index = 0; Index < NumStages; ++Index)
+		{
+			SET_FLOAT_STAT_FName(GetStageMsStatName((EStage)Index), 0.0);
+		}
+		SET_DWORD_STAT(STAT_MagicOpt_AssetsProcessed, 0);
+		SET_DWORD_STAT(STAT_MagicOpt_AssetsOptimized, 0);
+		SET_DWORD_STAT(STAT_MagicOpt_Errors, 0);
+		SET_DWORD_STAT(STAT_MagicOpt_Warnings, 0);
+		SET_MEMORY_STAT(STAT_MagicOpt_EstimatedMemory, 0);
+		SET_MEMORY_STAT(STAT_MagicOpt_MemorySaved, 0);
+		PublishThroughput(FRunStats());
+#endif
+	}
+
+	FRunStats GetRunStats()
+	{
+		FRunState& State = GetState();
+		FRunStats Stats = SnapshotCounters();
+		{
+			FScopeLock Lock(&State.DetailLock);
+			Stats.Phases = State.Phases;
+			Stats.SlowestAssets = State.SlowestHeap;
+		}
+		Stats.Phases.Sort([](const FPhaseStats& A, const FPhaseStats& B) { return A.StartSeconds < B.StartSeconds; });
+		Stats.SlowestAssets.Sort([](const FAssetTiming& A, const FAssetTiming& B) { return A.Seconds > B.Seconds; });
+		FScopeLock Lock(&State.LabelLock);
+		Stats.Label = State.Label;
+		Stats.StartTime = State.StartTime;
+		return Stats;
+	}
+
+	FString GetReportPath(const FRunStats& Stats)
+	{
+		const FString RunName = FPaths::MakeValidFileName(FString::Printf(TEXT("%s_%s"), *Stats.Label, *Stats.StartTime.ToString(TEXT("%Y%m%d_%H%M%S"))));
+		return FPaths::ProjectSavedDir() / TEXT("MagicOptimizer/Reports") / RunName / TEXT("stats.json");
+	}
+
+	FRunStats EndRun(bool bCancelled)
+	{
+		MAGICOPT_LLM_SCOPE_ROOT();
+		SampleResources();
+		FRunState& State = GetState();
+		bool bLastRun = true;
+		{
+			FScopeLock Lock(&State.LabelLock);
+			State.bAnyCancelled |= bCancelled;
+			bCancelled = State.bAnyCancelled;
+			if (State.ActiveRuns > 0)
+			{
+				bLastRun = --State.ActiveRuns == 0;
+			}
+		}
+		FRunStats Stats = GetRunStats();
+		Stats.bCancelled = bCancelled;
+		if (!bLastRun)
+		{
+			// A joined run ended; the first run's EndRun writes the report
+			return Stats;
+		}
+		PublishThroughput(Stats);
+
+		MAGICOPT_TRACE_SCOPE(MagicOptimizer_WriteRunStats);
+		const FString ReportPath = GetReportPath(Stats);
+		const FString Json = Stats.ToJsonString();
+		if (!FFileHelper::SaveStringToFile(Json, *ReportPath))
+		{
+			UE_LOG(LogMagicOptimizer, Warning, TEXT("Could not write run stats to %s"), *ReportPath);
+		}
+		MAGICOPT_TRACE_ASSET(ReportWrite, ReportPath, GetFileBytes(ReportPath));
+
+		UE_LOG(LogMagicOptimizer, Log, TEXT("%s run%s: %.2fs, %lld assets (%.1f/s), %.1f MB read (%.1f MB/s), peak %.0f MB / %lld UObjects, %lld GC"),
+			*Stats.Label, Stats.bCancelled ? TEXT(" (cancelled)") : TEXT(""), Stats.WallSeconds, Stats.AssetsProcessed, Stats.GetAssetsPerSecond(), ToMB(Stats.BytesRead), Stats.GetReadMBPerSecond(),
+			ToMB(Stats.PeakWorkingSetBytes), Stats.PeakUObjectCount, Stats.GCPasses);
+		if (MagicOptimizerMemory::IsTracking())
+		{
+			UE_LOG(LogMagicOptimizer, Log, TEXT("%s run: LLM peaks MB: plugin %.1f, bridge %.1f, audit store %.1f, views %.1f, thumbnails %.1f, apply %.1f"),
+				*Stats.Label, ToMB(Stats.PeakTagBytes[0]), ToMB(Stats.PeakTagBytes[1]), ToMB(Stats.PeakTagBytes[2]),
+				ToMB(Stats.PeakTagBytes[3]), ToMB(Stats.PeakTagBytes[4]), ToMB(Stats.PeakTagBytes[5]));
+		}
+		return Stats;
+	}
+
+	void RecordAsset(EStage Stage, int64 Bytes)
+	{
+		if ((int32)Stage >= NumStages)
+		{
+			return;
+		}
+		FStageCounters& Counters = GetState().Stages[(int32)Stage];
+		Counters.Count.fetch_add(1, std::memory_order_relaxed);
+		Counters.Bytes.fetch_add(FMath::Max<int64>(0, Bytes), std::memory_order_relaxed);
+		MaybePublishThroughput();
+	}
+
+	void AddAssetsProcessed(int64 Count)
+	{
+		GetState().AssetsProcessed.fetch_add(Count, std::memory_order_relaxed);
+		INC_DWORD_STAT_BY(STAT_MagicOpt_AssetsProcessed, (uint32)Count);
+		MaybePublishThroughput();
+	}
+
+	void AddAssetsOptimized(int64 Count)
+	{
+		GetState().AssetsOptimized.fetch_add(Count, std::memory_order_relaxed);
+		INC_DWORD_STAT_BY(STAT_MagicOpt_AssetsOptimized, (uint32)Count);
+	}
+
+	void AddErrors(int64 Count)
+	{
+		GetState().Errors.fetch_add(Count, std::memory_order_relaxed);
+		INC_DWORD_STAT_BY(STAT_MagicOpt_Errors, (uint32)Count);
+	}
+
+	void AddWarnings(int64 Count)
+	{
+		GetState().Warnings.fetch_add(Count, std::memory_order_relaxed);
+		INC_DWORD_STAT_BY(STAT_MagicOpt_Warnings, (uint32)Count);
+	}
+
+	void AddMemorySaved(int64 Bytes)
+	{
+		GetState().MemorySavedBytes.fetch_add(Bytes, std::memory_order_relaxed);
+		INC_MEMORY_STAT_BY(STAT_MagicOpt_MemorySaved, Bytes);
+	}
+
+	void SetEstimatedMemory(int64 Bytes)
+	{
+		GetState().EstimatedMemoryBytes.store(Bytes, std::memory_order_relaxed);
+		SET_MEMORY_STAT(STAT_MagicOpt_EstimatedMemory, Bytes);
+	}
+
+	void RecordAssetTime(EStage Stage, FStringView Path, double Seconds)
+	{
+		FRunState& State = GetState();
+		if (Seconds <= State.SlowestThreshold.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		FScopeLock Lock(&State.DetailLock);
+		TArray<FAssetTiming>& Heap = State.SlowestHeap;
+		const auto IsFaster = [](const FAssetTiming& A, const FAssetTiming& B) { return A.Seconds < B.Seconds; };
+
+		// The same asset reported twice in a run (e.g. the audit CSV read again) keeps its slowest time
+		const int32 Existing = Heap.IndexOfByPredicate([Stage, Path](const FAssetTiming& Entry) { return Entry.Stage == Stage && Path.Equals(Entry.Path, ESearchCase::CaseSensitive); });
+		if (Existing != INDEX_NONE)
+		{
+			if (Seconds > Heap[Existing].Seconds)
+			{
+				Heap[Existing].Seconds = Seconds;
+				Heap.Heapify(IsFaster);
+			}
+		}
+		else if (Heap.Num() >= MaxSlowestAssets)
+		{
+			if (Seconds <= Heap.HeapTop().Seconds)
+			{
+				return;
+			}
+			FAssetTiming Dropped;
+			Heap.HeapPop(Dropped, IsFaster, EAllowShrinking::No);
+			Heap.HeapPush(FAssetTiming{ FString(Path), Stage, Seconds }, IsFaster);
+		}
+		else
+		{
+			Heap.HeapPush(FAssetTiming{ FString(Path), Stage, Seconds }, IsFaster);
+		}
+		if (Heap.Num() >= MaxSlowestAssets)
+		{
+			State.SlowestThreshold.store(Heap.HeapTop().Seconds, std::memory_order_relaxed);
+		}
+	}
+
+	int64 GetFileBytes(const FString& Filename)
+	{
+		return FMath::Max<int64>(0, IFileManager::Get().FileSize(*Filename));
+	}
+
+	FPhaseScope::FPhaseScope(FStringView InName)
+		: Name(InName)
+		, StartCycles(FPlatformTime::Cycles64())
+	{
+		SampleResources();
+	}
+
+	FPhaseScope::~FPhaseScope()
+	{
+		const uint64 Now = FPlatformTime::Cycles64();
+		SampleResources();
+
+		FRunState& State = GetState();
+		FPhaseStats Phase;
+		Phase.Name = MoveTemp(Name);
+		Phase.StartSeconds = StartCycles > State.StartCycles.load(std::memory_order_relaxed)
+			? FPlatformTime::ToSeconds64(StartCycles - State.StartCycles.load(std::memory_order_relaxed))
+			: 0.0;
+		Phase.Seconds = FPlatformTime::ToSeconds64(Now - StartCycles);
+
+		FScopeLock Lock(&State.DetailLock);
+		State.Phases.Add(MoveTemp(Phase));
+	}
+
+	FAssetTimer::FAssetTimer(EStage InStage, FStringView InPath)
+		: Stage(InStage)
+		, Path(InPath)
+		, StartCycles(FPlatformTime::Cycles64())
+	{
+	}
+
+	FAssetTimer::~FAssetTimer()
+	{
+		RecordAssetTime(Stage, Path, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles));
+	}
+
+	FStageScope::FStageScope(EStage InStage)
+		: Stage(InStage)
+		, CycleCounter(GetStageStatId(InStage))
+	{
+		const uint64 Now = FPlatformTime::Cycles64();
+		Parent = GCurrentStageScope;
+		if (Parent)
+		{
+			// The outer stage stops counting while this one runs
+			Parent->EndSlice(Now);
+		}
+		GCurrentStageScope = this;
+		SliceStartCycles = Now;
+	}
+
+	FStageScope::~FStageScope()
+	{
+		const uint64 Now = FPlatformTime::Cycles64();
+		EndSlice(Now);
+		GCurrentStageScope = Parent;
+		if (Parent)
+		{
+			Parent->SliceStartCycles = Now;
+		}
+	}
+
+	void FStageScope::EndSlice(uint64 NowCycles)
+	{
+		AddStageCycles(Stage, NowCycles - SliceStartCycles);
+		SliceStartCycles = NowCycles;
+	}
+}
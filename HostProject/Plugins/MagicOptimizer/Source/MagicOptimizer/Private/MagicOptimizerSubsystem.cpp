@@ -4,6 +4,8 @@
 #include "OptimizerSettings.h"
 #include "MagicOptimizerCVars.h"
 #include "MagicOptimizerStats.h"
+#include "PythonBridge.h"
+#include "Services/Pipeline/OptimizationPipeline.h"
 #include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "Engine/AssetManager.h"
@@ -14,6 +16,127 @@
 #include "Misc/Paths.h"
 #include "Misc/FileHelper.h"
 #include "MagicOptimizerLogging.h"
+#include "MagicOptimizerMemory.h"
+
+namespace
+{
+    // Cycle stat a category's pipeline nodes are timed under
+    TStatId GetCategoryStatId(const FString& Category)
+    {
+        if (!MagicOptimizerCVars::IsPerformanceTrackingEnabled())
+        {
+            return TStatId();
+        }
+        if (Category == TEXT("Textures"))
+        {
+            return GET_STATID(STAT_MagicOpt_TextureTime);
+        }
+        if (Category == TEXT("Meshes"))
+        {
+            return GET_STATID(STAT_MagicOpt_MeshTime);
+        }
+        if (Category == TEXT("Materials"))
+        {
+            return GET_STATID(STAT_MagicOpt_MaterialTime);
+        }
+        return GET_STATID(STAT_MagicOpt_PassTime);
+    }
+
+    // Categories a pass of the given type covers; a full pass takes them from the settings' CategoryMask
+    TArray<FString> GetPassCategories(const FString& OptimizationType, const UOptimizerSettings* Settings)
+    {
+        if (OptimizationType == TEXT("Texture"))
+        {
+            return { TEXT("Textures") };
+        }
+        if (OptimizationType == TEXT("Mesh"))
+        {
+            return { TEXT("Meshes") };
+        }
+        if (OptimizationType == TEXT("Material"))
+        {
+            return { TEXT("Materials") };
+        }
+        return MagicOptimizerPipeline::GetCategories(Settings ? Settings->CategoryMask : (uint8)EOptimizerCategory::Textures);
+    }
+
+    // Requests with the same key treat the assets they cover the same way, whatever their paths and categories
+    FString GetSettingsKey(const FOptimizerRunParams& Params)
+    {
+        return FString::Printf(TEXT("%s|%d|%d|%d"), *Params.Profile, Params.bDryRun ? 1 : 0, Params.MaxChanges,
+            Params.bUseSelection ? 1 : 0);
+    }
+
+    // Trimmed, without trailing slashes or blanks, sorted so equal lists compare equal
+    TArray<FString> ParsePathList(const FString& PathsCsv)
+    {
+        TArray<FString> Paths;
+        PathsCsv.ParseIntoArray(Paths, TEXT(","));
+        for (FString& Path : Paths)
+        {
+            Path.TrimStartAndEndInline();
+            while (Path.RemoveFromEnd(TEXT("/")))
+            {
+            }
+        }
+        Paths.RemoveAll([](const FString& Path) { return Path.IsEmpty(); });
+        Paths.Sort();
+        return Paths;
+    }
+
+    // Path is Folder or lies under it
+    bool IsUnderPath(const FString& Path, const FString& Folder)
+    {
+        return Path == Folder || (Path.StartsWith(Folder) && Path[Folder.Len()] == TEXT('/'));
+    }
+
+    // Every asset Inner's paths select, Outer's select too; no include paths means the whole project
+    bool ScopeContains(const FOptimizerRunParams& Outer, const FOptimizerRunParams& Inner)
+    {
+        if (GetSettingsKey(Outer) != GetSettingsKey(Inner))
+        {
+            return false;
+        }
+        // Outer's excludes must not drop anything Inner keeps; only the same excludes, or none, are known not to
+        const TArray<FString> OuterExcludes = ParsePathList(Outer.ExcludePaths);
+        if (OuterExcludes.Num() > 0 && OuterExcludes != ParsePathList(Inner.ExcludePaths))
+        {
+            return false;
+        }
+        const TArray<FString> OuterIncludes = ParsePathList(Outer.IncludePaths);
+        const TArray<FString> InnerIncludes = ParsePathList(Inner.IncludePaths);
+        if (OuterIncludes.IsEmpty())
+        {
+            return true;
+        }
+        if (InnerIncludes.IsEmpty())
+        {
+            return false;
+        }
+        for (const FString& Include : InnerIncludes)
+        {
+            if (!OuterIncludes.ContainsByPredicate([&Include](const FString& Folder) { return IsUnderPath(Include, Folder); }))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Union of both, in pipeline order
+    TArray<FString> MergeCategories(const TArray<FString>& A, const TArray<FString>& B)
+    {
+        TArray<FString> Merged;
+        for (const FString& Category : MagicOptimizerPipeline::GetCategories(MAX_uint8))
+        {
+            if (A.Contains(Category) || B.Contains(Category))
+            {
+                Merged.Add(Category);
+            }
+        }
+        return Merged;
+    }
+}
 
 UMagicOptimizerSubsystem::UMagicOptimizerSubsystem()
 {
@@ -22,10 +145,12 @@ UMagicOptimizerSubsystem::UMagicOptimizerSubsystem()
     OptimizedAssetCount = 0;
     OptimizationStartTime = 0.0;
     CurrentOptimizationType = TEXT("");
+    PythonBridge = nullptr;
 }
 
 void UMagicOptimizerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+    MAGICOPT_LLM_SCOPE_ROOT();
     Super::Initialize(Collection);
     
     UE_LOG(LogMagicOptimizer, Log, TEXT("MagicOptimizer Subsystem initialized"));
@@ -49,10 +174,14 @@ void UMagicOptimizerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 void UMagicOptimizerSubsystem::Deinitialize()
 {
-    // Ensure any running optimizations are stopped
+    // The pipeline's nodes use the bridge, so stop the running pass and wait for it before it goes away;
+    // nothing queued may start after this
+    PassQueue.Reset();
     if (bOptimizationRunning)
     {
-        UE_LOG(LogMagicOptimizer, Warning, TEXT("MagicOptimizer Subsystem deinitializing while optimization is running"));
+        UE_LOG(LogMagicOptimizer, Warning, TEXT("MagicOptimizer Subsystem deinitializing while optimization is running; cancelling the pass"));
+        CancelOptimization();
+        PassTask.Wait();
     }
     
     Super::Deinitialize();
@@ -62,151 +191,287 @@ void UMagicOptimizerSubsystem::Deinitialize()
 
 void UMagicOptimizerSubsystem::RunOptimizationPass()
 {
-    if (!MagicOptimizerCVars::IsEnabled())
+    RequestOptimization(TEXT("Full"));
+}
+
+void UMagicOptimizerSubsystem::RunTextureOptimization()
+{
+    RequestOptimization(TEXT("Texture"));
+}
+
+void UMagicOptimizerSubsystem::RunMeshOptimization()
+{
+    RequestOptimization(TEXT("Mesh"));
+}
+
+void UMagicOptimizerSubsystem::RunMaterialOptimization()
+{
+    RequestOptimization(TEXT("Material"));
+}
+
+void UMagicOptimizerSubsystem::CancelOptimization()
+{
+    if (!bOptimizationRunning || !PassCancelToken.IsValid())
     {
-        UE_LOG(LogMagicOptimizer, Warning, TEXT("MagicOptimizer is disabled via CVar"));
         return;
     }
-    
-    if (bOptimizationRunning)
+    // A preempted pass the user then cancels is not requeued
+    bPreemptingPass = false;
+    if (PassCancelToken->IsCancelled())
     {
-        UE_LOG(LogMagicOptimizer, Warning, TEXT("Optimization already running, skipping request"));
         return;
     }
-
-    CurrentOptimizationType = TEXT("Full");
-    ExecuteOptimizationPass();
+    UE_LOG(LogMagicOptimizer, Log, TEXT("Cancelling %s optimization pass"), *CurrentOptimizationType);
+    PassCancelToken->Cancel();
 }
 
-void UMagicOptimizerSubsystem::RunTextureOptimization()
+void UMagicOptimizerSubsystem::ClearOptimizationQueue()
 {
-    if (!MagicOptimizerCVars::IsEnabled())
+    if (PassQueue.Num() > 0)
     {
-        UE_LOG(LogMagicOptimizer, Warning, TEXT("MagicOptimizer is disabled via CVar"));
-        return;
+        UE_LOG(LogMagicOptimizer, Log, TEXT("Dropping %d queued optimization passes"), PassQueue.Num());
+        PassQueue.Reset();
     }
-    
+}
+
+void UMagicOptimizerSubsystem::DescribeQueue(TArray<FString>& OutLines) const
+{
+    const double Now = FPlatformTime::Seconds();
+    auto Describe = [Now](const FPassRequest& Request)
+    {
+        FString Line = FString::Printf(TEXT("%s [%s] %s, requested %.1f s ago"), *Request.Type, *FString::Join(Request.Categories, TEXT(", ")),
+            Request.bInteractive ? TEXT("interactive") : TEXT("background"), Now - Request.RequestTime);
+        if (Request.NumRequests > 1)
+        {
+            Line += FString::Printf(TEXT(", %d requests merged"), Request.NumRequests);
+        }
+        if (Request.NumPreemptions > 0)
+        {
+            Line += FString::Printf(TEXT(", preempted %d times"), Request.NumPreemptions);
+        }
+        return Line;
+    };
+
     if (bOptimizationRunning)
     {
-        UE_LOG(LogMagicOptimizer, Warning, TEXT("Optimization already running, skipping request"));
-        return;
+        OutLines.Add(FString::Printf(TEXT("running: %s%s"), *Describe(RunningPass), bPreemptingPass ? TEXT(" (preempting)") : TEXT("")));
+    }
+    for (int32 Index = 0; Index < PassQueue.Num(); ++Index)
+    {
+        OutLines.Add(FString::Printf(TEXT("%d. %s"), Index + 1, *Describe(PassQueue[Index])));
     }
-
-    CurrentOptimizationType = TEXT("Texture");
-    ExecuteOptimizationPass();
 }
 
-void UMagicOptimizerSubsystem::RunMeshOptimization()
+void UMagicOptimizerSubsystem::RequestOptimization(const FString& OptimizationType)
 {
     if (!MagicOptimizerCVars::IsEnabled())
     {
         UE_LOG(LogMagicOptimizer, Warning, TEXT("MagicOptimizer is disabled via CVar"));
         return;
     }
-    
-    if (bOptimizationRunning)
+
+    // Settings are read here on the game thread; a queued pass runs with them as they were now
+    const UOptimizerSettings* Settings = GetOptimizerSettings();
+    FPassRequest Request;
+    Request.Type = OptimizationType;
+    Request.Categories = GetPassCategories(OptimizationType, Settings);
+    Request.BaseParams.Profile = Settings ? Settings->TargetProfile : TEXT("PC_Balanced");
+    Request.BaseParams.bDryRun = Settings ? Settings->bDryRun : true;
+    Request.BaseParams.MaxChanges = Settings ? Settings->MaxChanges : 100;
+    Request.BaseParams.IncludePaths = Settings ? Settings->IncludePathsCsv : TEXT("");
+    Request.BaseParams.ExcludePaths = Settings ? Settings->ExcludePathsCsv : TEXT("");
+    Request.BaseParams.bUseSelection = Settings ? Settings->bUseSelection : false;
+    Request.bInteractive = Request.BaseParams.bUseSelection;
+    Request.RequestTime = FPlatformTime::Seconds();
+
+    if (!bOptimizationRunning)
     {
-        UE_LOG(LogMagicOptimizer, Warning, TEXT("Optimization already running, skipping request"));
+        ExecuteOptimizationPass(MoveTemp(Request));
         return;
     }
 
-    CurrentOptimizationType = TEXT("Mesh");
-    ExecuteOptimizationPass();
-}
-
-void UMagicOptimizerSubsystem::RunMaterialOptimization()
-{
-    if (!MagicOptimizerCVars::IsEnabled())
+    // Same scope as a queued pass: one pass covering both requests' categories. A queued pass whose
+    // scope contains this one's, and already runs its categories, covers it as it is; widening it to
+    // new categories would run them over more assets than were asked for
+    if (FPassRequest* Queued = PassQueue.FindByPredicate([&Request](const FPassRequest& Other)
+        {
+            return ScopeContains(Other.BaseParams, Request.BaseParams)
+                && (ScopeContains(Request.BaseParams, Other.BaseParams)
+                    || MergeCategories(Other.Categories, Request.Categories).Num() == Other.Categories.Num());
+        }))
     {
-        UE_LOG(LogMagicOptimizer, Warning, TEXT("MagicOptimizer is disabled via CVar"));
+        const TArray<FString> Merged = MergeCategories(Queued->Categories, Request.Categories);
+        if (Merged.Num() != Queued->Categories.Num())
+        {
+            Queued->Type += TEXT("+") + Request.Type;
+            Queued->Categories = Merged;
+        }
+        ++Queued->NumRequests;
+        UE_LOG(LogMagicOptimizer, Log, TEXT("%s optimization request merged into the queued %s pass"), *Request.Type, *Queued->Type);
         return;
     }
-    
-    if (bOptimizationRunning)
+
+    // Interactive requests go after the other interactive ones, ahead of every background pass
+    const int32 InsertIndex = Request.bInteractive
+        ? PassQueue.IndexOfByPredicate([](const FPassRequest& Other) { return !Other.bInteractive; })
+        : INDEX_NONE;
+    const bool bInteractive = Request.bInteractive;
+    UE_LOG(LogMagicOptimizer, Log, TEXT("%s optimization queued behind the running %s pass (%s)"), *Request.Type, *CurrentOptimizationType,
+        bInteractive ? TEXT("interactive") : TEXT("background"));
+    PassQueue.Insert(MoveTemp(Request), InsertIndex == INDEX_NONE ? PassQueue.Num() : InsertIndex);
+
+    // Quick selection checks should not wait for a project-wide scan; the scan resumes afterwards with
+    // the categories it did not finish
+    if (bInteractive && !RunningPass.bInteractive && MagicOptimizerCVars::ShouldPreemptBackground()
+        && PassCancelToken.IsValid() && !PassCancelToken->IsCancelled())
     {
-        UE_LOG(LogMagicOptimizer, Warning, TEXT("Optimization already running, skipping request"));
-        return;
+        UE_LOG(LogMagicOptimizer, Log, TEXT("Preempting the background %s pass for an interactive request"), *CurrentOptimizationType);
+        bPreemptingPass = true;
+        PassCancelToken->Cancel();
     }
+}
 
-    CurrentOptimizationType = TEXT("Material");
-    ExecuteOptimizationPass();
+void UMagicOptimizerSubsystem::StartNextQueuedPass()
+{
+    if (!bOptimizationRunning && PassQueue.Num() > 0 && MagicOptimizerCVars::IsEnabled())
+    {
+        FPassRequest Request = MoveTemp(PassQueue[0]);
+        PassQueue.RemoveAt(0);
+        ExecuteOptimizationPass(MoveTemp(Request));
+    }
 }
 
-void UMagicOptimizerSubsystem::ExecuteOptimizationPass()
+void UMagicOptimizerSubsystem::ExecuteOptimizationPass(FPassRequest Request)
 {
+    MAGICOPT_LLM_SCOPE_ROOT();
     bOptimizationRunning = true;
+    bPreemptingPass = false;
+    RunningPass = MoveTemp(Request);
+    CurrentOptimizationType = RunningPass.Type;
     StartPerformanceTracking();
-    
-    UE_LOG(LogMagicOptimizer, Log, TEXT("Starting %s optimization pass"), *CurrentOptimizationType);
-    
-    // Track assets processed
-    MAGICOPT_TRACK_ASSETS_PROCESSED(1);
-    
-    // Launch optimization work on background thread using UE5.6 Task system
-    UE::Tasks::Launch(UE_SOURCE_LOCATION, [this]()
+
+    if (!PythonBridge)
     {
-        // Simulate heavy optimization work (replace with actual optimization logic)
-        FPlatformProcess::Sleep(2.0f); // Simulate work
-        
+        PythonBridge = NewObject<UPythonBridge>(this);
+        PythonBridge->Initialize();
+    }
+
+    // The nodes only see copies of the request's settings
+    FOptimizerRunParams BaseParams = RunningPass.BaseParams;
+    PassCancelToken = MakeShared<FOptimizerCancellationToken, ESPMode::ThreadSafe>();
+    BaseParams.CancelToken = PassCancelToken;
+
+    MagicOptimizerPipeline::FPassDesc Pass;
+    Pass.CancelToken = PassCancelToken;
+    Pass.Categories = RunningPass.Categories;
+    UE_LOG(LogMagicOptimizer, Log, TEXT("Starting %s optimization pass: %s"), *CurrentOptimizationType, *FString::Join(Pass.Categories, TEXT(", ")));
+
+    // Each node is its own entry.py process; only a Textures node writes the texture CSVs, and the
+    // appends every node makes to the knowledge files and log take a file lock
+
+    // The bridge is held by this subsystem, and Deinitialize waits for the pass
+    UPythonBridge* Bridge = PythonBridge;
+    Pass.RunNode = [Bridge, BaseParams](MagicOptimizerPipeline::EPhase Phase, const FString& Category)
+    {
+        FScopeCycleCounter CategoryCycleCounter(GetCategoryStatId(Category));
+        FOptimizerRunParams Params = BaseParams;
+        Params.Phase = MagicOptimizerPipeline::GetPhaseName(Phase);
+        Params.Categories = { Category };
+        const FOptimizerResult Result = Bridge->RunOptimization(Params);
+
+        MagicOptimizerPipeline::FNodeResult NodeResult;
+        NodeResult.bSuccess = Result.bSuccess;
+        NodeResult.bCancelled = Result.bCancelled;
+        NodeResult.Message = Result.Errors.Num() > 0 ? Result.Errors[0].Left(200) : Result.Message;
+        return NodeResult;
+    };
+
+    UE::Tasks::TTask<MagicOptimizerPipeline::FPassResult> Graph = MagicOptimizerPipeline::LaunchPass(MoveTemp(Pass));
+    TWeakObjectPtr<UMagicOptimizerSubsystem> WeakThis(this);
+    const FString OptimizationType = CurrentOptimizationType;
+    const FOptimizerCancellationTokenPtr CancelToken = PassCancelToken;
+    PassTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Graph, WeakThis, OptimizationType, CancelToken]() mutable
+    {
+        const MagicOptimizerPipeline::FPassResult& Result = Graph.GetResult();
+        const bool bSuccess = Result.IsSuccess();
+        const bool bCancelled = Result.WasCancelled();
+        FString Message = FString::Printf(TEXT("%s optimization %s: %s"), *OptimizationType,
+            bSuccess ? TEXT("completed") : (bCancelled ? TEXT("cancelled") : TEXT("failed")), *Result.GetSummary());
+        TArray<FString> UnfinishedCategories;
+        if (bCancelled)
+        {
+            Message += FString::Printf(TEXT(" (stopped %.0f ms after the request)"), CancelToken->GetSecondsSinceCancel() * 1000.0);
+            for (const MagicOptimizerPipeline::FCategoryResult& Category : Result.Categories)
+            {
+                if (Category.bCancelled)
+                {
+                    UnfinishedCategories.Add(Category.Category);
+                }
+            }
+        }
+
         // Marshal back to game thread for completion
-        AsyncTask(ENamedThreads::GameThread, [this]()
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, bSuccess, bCancelled, Message, UnfinishedCategories]()
         {
-            OnOptimizationComplete(true, FString::Printf(TEXT("%s optimization completed successfully"), *CurrentOptimizationType));
+            if (UMagicOptimizerSubsystem* Subsystem = WeakThis.Get())
+            {
+                Subsystem->OnOptimizationComplete(bSuccess, bCancelled, Message, UnfinishedCategories);
+            }
         });
-    });
+    }, UE::Tasks::Prerequisites(Graph));
 }
 
-void UMagicOptimizerSubsystem::OnOptimizationComplete(bool bSuccess, const FString& ResultMessage)
+void UMagicOptimizerSubsystem::OnOptimizationComplete(bool bSuccess, bool bCancelled, const FString& ResultMessage, const TArray<FString>& UnfinishedCategories)
 {
-    EndPerformanceTracking();
+    if (!bSuccess && !bCancelled)
+    {
+        MAGICOPT_TRACK_ERRORS(1);
+    }
+    EndPerformanceTracking(bCancelled);
     bOptimizationRunning = false;
+    PassCancelToken.Reset();
     
-    if (bSuccess)
+    if (bSuccess || bCancelled)
     {
-        OptimizedAssetCount += 10; // Simulate optimized assets
-        MAGICOPT_TRACK_ASSETS_OPTIMIZED(10);
-        MAGICOPT_TRACK_MEMORY_SAVED(5); // Simulate 5MB saved
-        
         UE_LOG(LogMagicOptimizer, Log, TEXT("%s"), *ResultMessage);
     }
     else
     {
-        MAGICOPT_TRACK_ERRORS(1);
         UE_LOG(LogMagicOptimizer, Error, TEXT("Optimization failed: %s"), *ResultMessage);
     }
+
+    // A preempted pass goes back ahead of the other background passes, for what it did not finish
+    if (bPreemptingPass && bCancelled && UnfinishedCategories.Num() > 0)
+    {
+        FPassRequest Resumed = MoveTemp(RunningPass);
+        Resumed.Categories = UnfinishedCategories;
+        ++Resumed.NumPreemptions;
+        const int32 InsertIndex = PassQueue.IndexOfByPredicate([](const FPassRequest& Other) { return !Other.bInteractive; });
+        UE_LOG(LogMagicOptimizer, Log, TEXT("Requeued the preempted %s pass for %s"), *Resumed.Type, *FString::Join(Resumed.Categories, TEXT(", ")));
+        PassQueue.Insert(MoveTemp(Resumed), InsertIndex == INDEX_NONE ? PassQueue.Num() : InsertIndex);
+    }
+    bPreemptingPass = false;
+    RunningPass = FPassRequest();
+
+    StartNextQueuedPass();
 }
 
 void UMagicOptimizerSubsystem::StartPerformanceTracking()
 {
     OptimizationStartTime = FPlatformTime::Seconds();
-    
-    // Start cycle counter based on optimization type
-    if (MagicOptimizerCVars::IsPerformanceTrackingEnabled())
-    {
-        if (CurrentOptimizationType == TEXT("Texture"))
-        {
-            MAGICOPT_SCOPE_CYCLE_COUNTER(STAT_MagicOpt_TextureTime);
-        }
-        else if (CurrentOptimizationType == TEXT("Mesh"))
-        {
-            MAGICOPT_SCOPE_CYCLE_COUNTER(STAT_MagicOpt_MeshTime);
-        }
-        else if (CurrentOptimizationType == TEXT("Material"))
-        {
-            MAGICOPT_SCOPE_CYCLE_COUNTER(STAT_MagicOpt_MaterialTime);
-        }
-        else
-        {
-            MAGICOPT_SCOPE_CYCLE_COUNTER(STAT_MagicOpt_PassTime);
-        }
-    }
+
+    // The pass's cycle stat is scoped around the work itself (see ExecuteOptimizationPass); this
+    // starts the run whose stage times, counts and throughput end up in the run report
+    MagicOptimizerStats::BeginRun(CurrentOptimizationType);
 }
 
-void UMagicOptimizerSubsystem::EndPerformanceTracking()
+void UMagicOptimizerSubsystem::EndPerformanceTracking(bool bCancelled)
 {
     if (OptimizationStartTime > 0.0)
     {
-        LastOptimizationTime = (float)(FPlatformTime::Seconds() - OptimizationStartTime);
+        const MagicOptimizerStats::FRunStats RunStats = MagicOptimizerStats::EndRun(bCancelled);
+        LastOptimizationTime = (float)RunStats.WallSeconds;
+        OptimizedAssetCount += (int32)RunStats.AssetsOptimized;
         OptimizationStartTime = 0.0;
     }
 }
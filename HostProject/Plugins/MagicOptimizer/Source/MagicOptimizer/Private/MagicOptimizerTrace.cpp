@@ -0,0 +1,82 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#include "MagicOptimizerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(MagicOptimizerChannel)
+
+UE_TRACE_EVENT_BEGIN(MagicOptimizer, AssetEvent)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint8, Stage)
+	UE_TRACE_EVENT_FIELD(int64, Bytes)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Path)
+UE_TRACE_EVENT_END()
+
+TRACE_DECLARE_MEMORY_COUNTER(MagicOptimizer_BytesRead, TEXT("MagicOptimizer/BytesRead"));
+TRACE_DECLARE_MEMORY_COUNTER(MagicOptimizer_BytesWritten, TEXT("MagicOptimizer/BytesWritten"));
+
+namespace MagicOptimizerTrace
+{
+	const TCHAR* GetStageName(EStage Stage)
+	{
+		switch (Stage)
+		{
+		case EStage::RegistryQuery:
+			return TEXT("RegistryQuery");
+		case EStage::AssetLoad:
+			return TEXT("AssetLoad");
+		case EStage::Analyze:
+			return TEXT("Analyze");
+		case EStage::RuleEvaluation:
+			return TEXT("RuleEvaluation");
+		case EStage::CsvRead:
+			return TEXT("CsvRead");
+		case EStage::CsvWrite:
+			return TEXT("CsvWrite");
+		case EStage::ReportRead:
+			return TEXT("ReportRead");
+		case EStage::ReportWrite:
+			return TEXT("ReportWrite");
+		case EStage::Apply:
+			return TEXT("Apply");
+		case EStage::Save:
+			return TEXT("Save");
+		case EStage::LogWrite:
+			return TEXT("LogWrite");
+		case EStage::Bridge:
+			return TEXT("Bridge");
+		default:
+			return TEXT("");
+		}
+	}
+
+	bool IsReadStage(EStage Stage)
+	{
+		return Stage == EStage::AssetLoad || Stage == EStage::CsvRead || Stage == EStage::ReportRead;
+	}
+
+	bool IsWriteStage(EStage Stage)
+	{
+		return Stage == EStage::CsvWrite || Stage == EStage::ReportWrite || Stage == EStage::Save || Stage == EStage::LogWrite;
+	}
+
+	void OutputAssetEvent(EStage Stage, FStringView Path, int64 Bytes)
+	{
+#if UE_TRACE_ENABLED
+		UE_TRACE_LOG(MagicOptimizer, AssetEvent, MagicOptimizerChannel)
+			<< AssetEvent.Cycle(FPlatformTime::Cycles64())
+			<< AssetEvent.Stage((uint8)Stage)
+			<< AssetEvent.Bytes(Bytes)
+			<< AssetEvent.Path(Path.GetData(), Path.Len());
+
+		if (Bytes > 0 && IsReadStage(Stage))
+		{
+			TRACE_COUNTER_ADD(MagicOptimizer_BytesRead, Bytes);
+		}
+		else if (Bytes > 0 && IsWriteStage(Stage))
+		{
+			TRACE_COUNTER_ADD(MagicOptimizer_BytesWritten, Bytes);
+		}
+#endif
+	}
+}
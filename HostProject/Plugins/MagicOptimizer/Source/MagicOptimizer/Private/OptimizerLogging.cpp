@@ -4,15 +4,30 @@
   Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
 */
 #include "OptimizerLogging.h"
+#include "MagicOptimizerCVars.h"
+#include "Services/Logging/AsyncLogWriter.h"
 #include "Misc/Paths.h"
-#include "Misc/FileHelper.h"
-#include "HAL/PlatformFilemanager.h"
 
 namespace MagicOptimizerLog
 {
-	static FString GetTimestamp()
+	enum ELogTarget : int32
 	{
-		return FDateTime::Now().ToString(TEXT("yyyy-MM-dd HH:mm:ss"));
+		RuntimeLog,
+		BacklogLog
+	};
+
+	// Created on first use; lines are written on the writer's own thread through open handles
+	static FAsyncLogWriter& GetWriter()
+	{
+		static FAsyncLogWriter Writer({ GetLogFilePath(), GetBacklogFilePath() });
+		return Writer;
+	}
+
+	static void Enqueue(ELogTarget Target, const FString& Line)
+	{
+		FAsyncLogWriter& Writer = GetWriter();
+		Writer.SetMaxFileBytes(MagicOptimizerCVars::GetLogMaxFileBytes());
+		Writer.Enqueue(Target, Line);
 	}
 
 	FString GetLogFilePath()
@@ -29,21 +44,21 @@ namespace MagicOptimizerLog
 
 	void AppendLine(const FString& Line)
 	{
-		const FString FilePath = GetLogFilePath();
-		IPlatformFile& PF = FPlatformFileManager::Get().GetPlatformFile();
-		PF.CreateDirectoryTree(*FPaths::GetPath(FilePath));
-		const FString WithTs = FString::Printf(TEXT("[%s] %s\n"), *GetTimestamp(), *Line);
-		FFileHelper::SaveStringToFile(WithTs, *FilePath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+		Enqueue(RuntimeLog, Line);
 	}
 
 	void AppendBacklog(const FString& Line)
 	{
-		const FString FilePath = GetBacklogFilePath();
-		IPlatformFile& PF = FPlatformFileManager::Get().GetPlatformFile();
-		PF.CreateDirectoryTree(*FPaths::GetPath(FilePath));
-		const FString WithTs = FString::Printf(TEXT("[%s] %s\n"), *GetTimestamp(), *Line);
-		FFileHelper::SaveStringToFile(WithTs, *FilePath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+		Enqueue(BacklogLog, Line);
 	}
-}
 
+	void Flush()
+	{
+		GetWriter().Flush();
+	}
 
+	void Shutdown()
+	{
+		GetWriter().Shutdown();
+	}
+}
@@ -9,6 +9,9 @@
 #include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "Async/Async.h"
+#include "Tasks/Task.h"
+#include "UObject/StrongObjectPtr.h"
+#include "MagicOptimizerMemory.h"
 
 UOptimizerRun::UOptimizerRun()
 {
@@ -29,6 +32,7 @@ UOptimizerRun::UOptimizerRun()
 
 void UOptimizerRun::Run(const FString& Phase, const TArray<FString>& Categories)
 {
+	MAGICOPT_LLM_SCOPE_ROOT();
 	if (Status == EOptimizerRunStatus::Running)
 	{
 		UE_LOG(LogMagicOptimizer, Warning, TEXT("OptimizerRun: Already running, cannot start new run"));
@@ -41,6 +45,7 @@ void UOptimizerRun::Run(const FString& Phase, const TArray<FString>& Categories)
 	SelectedCategories = Categories;
 	StartTime = FDateTime::Now();
 	bCancelled = false;
+	CancelToken = MakeShared<FOptimizerCancellationToken, ESPMode::ThreadSafe>();
 
 	// Reset progress
 	Progress = FOptimizerRunProgress();
@@ -52,40 +57,47 @@ void UOptimizerRun::Run(const FString& Phase, const TArray<FString>& Categories)
 
 	UE_LOG(LogMagicOptimizer, Log, TEXT("OptimizerRun: Starting %s phase for categories: %s"), *Phase, *FString::Join(Categories, TEXT(", ")));
 
-	// Run optimization asynchronously
-	Async(EAsyncExecution::TaskGraphMainThread, [this, Phase, Categories]()
-	{
-		if (bCancelled)
-		{
-			CancelRun();
-			return;
-		}
-
-		// Update progress - starting
-		UpdateProgress(0.0f, Phase, TEXT("Initializing..."), 0, Progress.TotalAssets);
+	// Update progress - starting
+	UpdateProgress(0.0f, Phase, TEXT("Initializing..."), 0, Progress.TotalAssets);
 
-		// Check if Python bridge is available
-		if (!PythonBridge || !PythonBridge->IsPythonAvailable())
-		{
-			UE_LOG(LogMagicOptimizer, Error, TEXT("OptimizerRun: Python bridge not available"));
-			CompleteRun(false);
-			return;
-		}
+	// Check if Python bridge is available
+	if (!PythonBridge || !PythonBridge->IsPythonAvailable())
+	{
+		UE_LOG(LogMagicOptimizer, Error, TEXT("OptimizerRun: Python bridge not available"));
+		CompleteRun(false);
+		return;
+	}
 
-		// Run optimization phase
-		FOptimizerResult Result = PythonBridge->RunPhase(Phase, Categories);
+	// Settings are read here; the phase runs on a worker, so the game thread stays free to call Cancel
+	FOptimizerRunParams Params = PythonBridge->MakePhaseParams(Phase, Categories);
+	Params.CancelToken = CancelToken;
+	TStrongObjectPtr<UPythonBridge> Bridge(PythonBridge);
+	TWeakObjectPtr<UOptimizerRun> WeakThis(this);
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Bridge = MoveTemp(Bridge), Params, WeakThis, Phase]() mutable
+	{
+		MAGICOPT_LLM_SCOPE_ROOT();
+		const FOptimizerResult Result = Bridge->RunOptimization(Params);
 
-		if (bCancelled)
+		// The bridge reference is released on the game thread
+		AsyncTask(ENamedThreads::GameThread, [Bridge = MoveTemp(Bridge), WeakThis, Phase, Result]()
 		{
-			CancelRun();
-			return;
-		}
-
-		// Update progress - completed
-		UpdateProgress(100.0f, Phase, TEXT("Completed"), Progress.TotalAssets, Progress.TotalAssets);
-
-		// Complete run
-		CompleteRun(Result.bSuccess);
+			UOptimizerRun* Run = WeakThis.Get();
+			if (!Run)
+			{
+				return;
+			}
+			if (Result.bCancelled || Run->bCancelled)
+			{
+				Run->CancelRun();
+				return;
+			}
+
+			// Update progress - completed
+			Run->UpdateProgress(100.0f, Phase, TEXT("Completed"), Run->Progress.TotalAssets, Run->Progress.TotalAssets);
+
+			// Complete run
+			Run->CompleteRun(Result.bSuccess);
+		});
 	});
 }
 
@@ -94,6 +106,10 @@ void UOptimizerRun::Cancel()
 	if (Status == EOptimizerRunStatus::Running)
 	{
 		bCancelled = true;
+		if (CancelToken.IsValid())
+		{
+			CancelToken->Cancel();
+		}
 		UE_LOG(LogMagicOptimizer, Log, TEXT("OptimizerRun: Cancellation requested"));
 	}
 }
@@ -163,7 +179,8 @@ void UOptimizerRun::CancelRun()
 	EndTime = FDateTime::Now();
 	SetStatus(EOptimizerRunStatus::Cancelled);
 	
-	UE_LOG(LogMagicOptimizer, Log, TEXT("OptimizerRun: Run cancelled after %s"), *GetDuration().ToString());
+	UE_LOG(LogMagicOptimizer, Log, TEXT("OptimizerRun: Run cancelled after %s (stopped %.0f ms after the request)"),
+		*GetDuration().ToString(), CancelToken.IsValid() ? CancelToken->GetSecondsSinceCancel() * 1000.0 : 0.0);
 
 	// Broadcast cancellation event
 	OnCancelled.Broadcast(true);
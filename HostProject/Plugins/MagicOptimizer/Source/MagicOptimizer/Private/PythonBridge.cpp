@@ -21,7 +21,24 @@
 #include "JsonObjectConverter.h"
 #include "OptimizerLogging.h"
 #include "MagicOptimizerLogging.h"
+#include "MagicOptimizerStats.h"
 #include "Interfaces/IPluginManager.h"
+#include "MagicOptimizerMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/ScopeLock.h"
+#include "Services/Knowledge/KnowledgeAggregator.h"
+#include <atomic>
+
+namespace
+{
+	// How often a running Python process is checked for output and cancellation
+	static constexpr float CancelPollSeconds = 0.01f;
+
+	// Counted from before the launch until the process is closed, over every bridge instance; changed
+	// only under ProcessGate, so a RunWithoutProcesses caller sees either no process or all of them
+	static std::atomic<int32> NumRunningProcesses{ 0 };
+	static FCriticalSection ProcessGate;
+}
 
 UPythonBridge::UPythonBridge()
 {
@@ -33,6 +50,7 @@ UPythonBridge::UPythonBridge()
 
 bool UPythonBridge::Initialize()
 {
+	MAGICOPT_LLM_SCOPE(Bridge);
 	if (bPythonInitialized)
 	{
 		return true;
@@ -71,6 +89,8 @@ bool UPythonBridge::IsPythonAvailable() const
 
 FOptimizerResult UPythonBridge::RunOptimization(const FOptimizerRunParams& Params)
 {
+	MAGICOPT_LLM_SCOPE(Bridge);
+	MAGICOPT_TRACE_SCOPE(MagicOptimizer_RunOptimization);
 	FOptimizerResult Result;
 
 	if (!bPythonInitialized)
@@ -140,10 +160,21 @@ FOptimizerResult UPythonBridge::RunOptimization(const FOptimizerRunParams& Param
 		UE_LOG(LogMagicOptimizer, Log, TEXT("Running system Python script: %s"), *ScriptPath);
 		MagicOptimizerLog::AppendLine(FString::Printf(TEXT("PythonBridge: Exec system Python: %s"), *ScriptPath));
 		MagicOptimizerLog::AppendBacklog(FString::Printf(TEXT("SystemPython Exec: %s Args=[%s]"), *ScriptPath, *FString::Join(Arguments, TEXT(","))));
-		bRan = ExecutePythonScript(ScriptPath, Arguments, Output, Error);
+		bRan = RunScript(ScriptPath, Arguments, Params.CancelToken, Output, Error);
 	}
 
-	if (bRan)
+	if (Params.CancelToken.IsValid() && Params.CancelToken->IsCancelled())
+	{
+		// Whatever the script wrote before it was terminated is kept for the log
+		Result.bSuccess = false;
+		Result.bCancelled = true;
+		Result.Message = TEXT("Optimization cancelled");
+		Result.StdOut = Output;
+		Result.StdErr = Error;
+		MagicOptimizerLog::AppendLine(FString::Printf(TEXT("PythonBridge: Cancelled (Phase=%s, stopped %.0f ms after the request)"),
+			*Params.Phase, Params.CancelToken->GetSecondsSinceCancel() * 1000.0));
+	}
+	else if (bRan)
 	{
 		Result.bSuccess = true;
 		Result.Message = TEXT("Optimization completed successfully");
@@ -168,14 +199,27 @@ FOptimizerResult UPythonBridge::RunOptimization(const FOptimizerRunParams& Param
 			Result.Errors.Add(Error);
 			Result.StdErr = Error;
 		}
+		MAGICOPT_TRACK_ERRORS(1);
 		MagicOptimizerLog::AppendLine(FString::Printf(TEXT("PythonBridge: Execution failed. Error=%s"), *Error.Left(2000)));
 		MagicOptimizerLog::AppendBacklog(FString::Printf(TEXT("Execution FAILED. Error=%s"), *Error.Left(2000)));
 	}
 
+	// Editor runs write knowledge events from an external interpreter; fold them once it has exited
+	if (bHasScript)
+	{
+		MagicOptimizerKnowledge::UpdateAggregates();
+	}
+
 	return Result;
 }
 
 FOptimizerResult UPythonBridge::RunPhase(const FString& Phase, const TArray<FString>& Categories)
+{
+	MAGICOPT_LLM_SCOPE(Bridge);
+	return RunOptimization(MakePhaseParams(Phase, Categories));
+}
+
+FOptimizerRunParams UPythonBridge::MakePhaseParams(const FString& Phase, const TArray<FString>& Categories) const
 {
 	FOptimizerRunParams Params;
 	Params.Phase = Phase;
@@ -186,8 +230,7 @@ FOptimizerResult UPythonBridge::RunPhase(const FString& Phase, const TArray<FStr
 	Params.IncludePaths = OptimizerSettings ? OptimizerSettings->IncludePathsCsv : TEXT("");
 	Params.ExcludePaths = OptimizerSettings ? OptimizerSettings->ExcludePathsCsv : TEXT("");
 	Params.bUseSelection = OptimizerSettings ? OptimizerSettings->bUseSelection : false;
-
-	return RunOptimization(Params);
+	return Params;
 }
 
 FString UPythonBridge::GetPythonScriptPath() const
@@ -245,6 +288,12 @@ void UPythonBridge::SetPythonScriptPath(const FString& NewPath)
 
 bool UPythonBridge::ExecutePythonScript(const FString& ScriptPath, const TArray<FString>& Arguments, FString& Output, FString& Error)
 {
+	return RunScript(ScriptPath, Arguments, nullptr, Output, Error);
+}
+
+bool UPythonBridge::RunScript(const FString& ScriptPath, const TArray<FString>& Arguments, const FOptimizerCancellationTokenPtr& CancelToken, FString& Output, FString& Error)
+{
+	MAGICOPT_LLM_SCOPE(Bridge);
 	// Check if script exists
 	if (!ValidatePythonScript(ScriptPath))
 	{
@@ -259,18 +308,18 @@ bool UPythonBridge::ExecutePythonScript(const FString& ScriptPath, const TArray<
 	// The script will be executed through UE's Python interpreter, not system python
 	
 	// Build command line for UE embedded Python
-	FString CommandLine = FString::Printf(TEXT("py \"%s\""), *ScriptPath);
+	FString Params = FString::Printf(TEXT("\"%s\""), *ScriptPath);
 	for (const FString& Arg : Arguments)
 	{
-		CommandLine += TEXT(" \"") + Arg + TEXT("\"");
+		Params += TEXT(" \"") + Arg + TEXT("\"");
 	}
 
-	UE_LOG(LogMagicOptimizer, Log, TEXT("Executing Python script via UE embedded Python: %s"), *CommandLine);
+	UE_LOG(LogMagicOptimizer, Log, TEXT("Executing Python script via UE embedded Python: py %s"), *Params);
 	MagicOptimizerLog::AppendLine(FString::Printf(TEXT("PythonBridge: Exec UE embedded Python: %s"), *ScriptPath));
 	MagicOptimizerLog::AppendBacklog(FString::Printf(TEXT("EmbeddedPython Exec: %s Args=[%s]"), *ScriptPath, *FString::Join(Arguments, TEXT(","))));
 
 	// Execute command using UE's Python system
-	return ExecutePythonCommand(CommandLine, Output, Error);
+	return ExecutePythonCommand(TEXT("py"), Params, CancelToken, Output, Error);
 }
 
 FString UPythonBridge::GetPythonVersion() const
@@ -280,6 +329,7 @@ FString UPythonBridge::GetPythonVersion() const
 
 bool UPythonBridge::IsPythonModuleAvailable(const FString& ModuleName) const
 {
+	MAGICOPT_LLM_SCOPE(Bridge);
 	if (!bPythonInitialized)
 	{
 		return false;
@@ -309,6 +359,7 @@ UOptimizerSettings* UPythonBridge::GetOptimizerSettings() const
 
 bool UPythonBridge::InitializePythonEnvironment()
 {
+	MAGICOPT_LLM_SCOPE(Bridge);
 	// Use UE's embedded Python instead of system Python
 	// This avoids the system PATH dependency that was causing failures
 	
@@ -331,16 +382,71 @@ bool UPythonBridge::InitializePythonEnvironment()
 	return true;
 }
 
-bool UPythonBridge::ExecutePythonCommand(const FString& Command, FString& Output, FString& Error)
+bool UPythonBridge::ExecutePythonCommand(const FString& Executable, const FString& Params, const FOptimizerCancellationTokenPtr& CancelToken, FString& Output, FString& Error)
 {
-	int32 ReturnCode = 0;
+	MAGICOPT_LLM_SCOPE(Bridge);
+	// The whole Python run (interpreter start, registry scan, per-asset analysis) is inside this scope
+	MAGICOPT_STAGE_SCOPE(Bridge, MagicOptimizer_BridgeLaunch);
+	if (CancelToken.IsValid() && CancelToken->IsCancelled())
+	{
+		return false;
+	}
+	void* StdOutRead = nullptr;
+	void* StdOutWrite = nullptr;
+	void* StdErrRead = nullptr;
+	void* StdErrWrite = nullptr;
+	FPlatformProcess::CreatePipe(StdOutRead, StdOutWrite);
+	FPlatformProcess::CreatePipe(StdErrRead, StdErrWrite);
+	{
+		FScopeLock Lock(&ProcessGate);
+		++NumRunningProcesses;
+	}
+	FProcHandle Process = FPlatformProcess::CreateProc(*Executable, *Params, false, true, true, nullptr, 0, nullptr, StdOutWrite, nullptr, StdErrWrite);
+
 	FString StdOut, StdErr;
-	const bool bSuccess = FPlatformProcess::ExecProcess(*Command, nullptr, &ReturnCode, &StdOut, &StdErr);
+	bool bCancelled = false;
+	int32 ReturnCode = -1;
+	const bool bLaunched = Process.IsValid();
+	if (bLaunched)
+	{
+		// Pipes are drained while waiting, or a chatty script would block on a full pipe
+		while (FPlatformProcess::IsProcRunning(Process))
+		{
+			StdOut += FPlatformProcess::ReadPipe(StdOutRead);
+			StdErr += FPlatformProcess::ReadPipe(StdErrRead);
+			if (CancelToken.IsValid() && CancelToken->IsCancelled())
+			{
+				FPlatformProcess::TerminateProc(Process, /*KillTree*/ true);
+				bCancelled = true;
+				break;
+			}
+			FPlatformProcess::SleepNoStats(CancelPollSeconds);
+		}
+		StdOut += FPlatformProcess::ReadPipe(StdOutRead);
+		StdErr += FPlatformProcess::ReadPipe(StdErrRead);
+		if (!bCancelled)
+		{
+			FPlatformProcess::GetProcReturnCode(Process, &ReturnCode);
+		}
+		FPlatformProcess::CloseProc(Process);
+	}
+	{
+		FScopeLock Lock(&ProcessGate);
+		--NumRunningProcesses;
+	}
+	FPlatformProcess::ClosePipe(StdOutRead, StdOutWrite);
+	FPlatformProcess::ClosePipe(StdErrRead, StdErrWrite);
+
 	Output = StdOut;
 	Error = StdErr;
-	if (!bSuccess || ReturnCode != 0)
+	if (bCancelled)
+	{
+		UE_LOG(LogMagicOptimizer, Log, TEXT("Python command cancelled: %s %s"), *Executable, *Params);
+		return false;
+	}
+	if (!bLaunched || ReturnCode != 0)
 	{
-		UE_LOG(LogMagicOptimizer, Error, TEXT("Python command failed: %s (Return code: %d)"), *Command, ReturnCode);
+		UE_LOG(LogMagicOptimizer, Error, TEXT("Python command failed: %s %s (Return code: %d)"), *Executable, *Params, ReturnCode);
 		if (!Error.IsEmpty())
 		{
 			UE_LOG(LogMagicOptimizer, Error, TEXT("Error: %s"), *Error);
@@ -350,6 +456,22 @@ bool UPythonBridge::ExecutePythonCommand(const FString& Command, FString& Output
 	return true;
 }
 
+int32 UPythonBridge::GetNumRunningProcesses()
+{
+	return NumRunningProcesses.load();
+}
+
+bool UPythonBridge::RunWithoutProcesses(TFunctionRef<void()> Fn)
+{
+	FScopeLock Lock(&ProcessGate);
+	if (NumRunningProcesses.load() > 0)
+	{
+		return false;
+	}
+	Fn();
+	return true;
+}
+
 bool UPythonBridge::ValidatePythonScript(const FString& ScriptPath) const
 {
 	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
@@ -0,0 +1,213 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  TextureInspection.cpp
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#include "Services/Analysis/TextureInspection.h"
+#include "Services/Csv/TextureCsvReader.h"
+#include "Services/Scheduling/MemoryGovernor.h"
+#include "MagicOptimizerLogging.h"
+#include "MagicOptimizerStats.h"
+#include "Engine/Texture.h"
+#include "Engine/Texture2D.h"
+
+namespace
+{
+	// Tangent-space normals average to about (0.5, 0.5, 1) once encoded
+	static constexpr int32 NormalChannelTolerance = 16;
+	static constexpr int32 NormalMinMeanBlue = 200;
+
+	struct FPixelStats
+	{
+		bool bValid = false;
+		uint8 MinAlpha = 255;
+		bool bConstant = true;
+		double MeanR = 0.0;
+		double MeanG = 0.0;
+		double MeanB = 0.0;
+	};
+
+	static FPixelStats ComputePixelStats(const TextureInspection::FTextureExtract& Extract)
+	{
+		FPixelStats Stats;
+		const int64 NumPixels = (int64)Extract.PixelWidth * Extract.PixelHeight;
+		if (NumPixels <= 0 || Extract.Pixels.Num() < NumPixels * Extract.BytesPerPixel)
+		{
+			return Stats;
+		}
+
+		const uint8* Data = Extract.Pixels.GetData();
+		if (Extract.BytesPerPixel == 1)
+		{
+			uint64 Sum = 0;
+			for (int64 Index = 0; Index < NumPixels; ++Index)
+			{
+				Sum += Data[Index];
+				Stats.bConstant &= Data[Index] == Data[0];
+			}
+			Stats.MeanR = Stats.MeanG = Stats.MeanB = (double)Sum / NumPixels;
+		}
+		else if (Extract.BytesPerPixel == 4)
+		{
+			// BGRA8
+			uint64 SumB = 0, SumG = 0, SumR = 0;
+			const uint32 First = FPlatformMemory::ReadUnaligned<uint32>(Data);
+			for (int64 Index = 0; Index < NumPixels; ++Index)
+			{
+				const uint8* Pixel = Data + Index * 4;
+				SumB += Pixel[0];
+				SumG += Pixel[1];
+				SumR += Pixel[2];
+				Stats.MinAlpha = FMath::Min(Stats.MinAlpha, Pixel[3]);
+				Stats.bConstant &= FPlatformMemory::ReadUnaligned<uint32>(Pixel) == First;
+			}
+			Stats.MeanB = (double)SumB / NumPixels;
+			Stats.MeanG = (double)SumG / NumPixels;
+			Stats.MeanR = (double)SumR / NumPixels;
+		}
+		else
+		{
+			return Stats;
+		}
+		Stats.bValid = true;
+		return Stats;
+	}
+}
+
+namespace TextureInspection
+{
+	bool ExtractTexture(const FSoftObjectPath& Path, FTextureExtract& OutExtract, int32 MaxPixelDim)
+	{
+		check(IsInGameThread());
+		// Load plus copy, source pixel decode included: everything the game thread spends per texture
+		MAGICOPT_STAGE_SCOPE(AssetLoad, MagicOptimizer_InspectExtract);
+		const FString PathString = Path.ToString();
+		MagicOptimizerStats::FAssetTimer AssetTimer(MagicOptimizerTrace::EStage::AssetLoad, PathString);
+		UTexture* Texture = Cast<UTexture>(MagicOptimizerMemoryGovernor::LoadAsset(Path));
+		if (!Texture)
+		{
+			return false;
+		}
+
+		OutExtract.Path = Path.GetLongPackageName();
+		OutExtract.Format = StaticEnum<TextureCompressionSettings>()->GetNameStringByValue((int64)Texture->CompressionSettings);
+		OutExtract.LODGroup = StaticEnum<TextureGroup>()->GetNameStringByValue((int64)Texture->LODGroup);
+		OutExtract.bSRGB = Texture->SRGB;
+
+#if WITH_EDITORONLY_DATA
+		OutExtract.Width = (int32)Texture->Source.GetSizeX();
+		OutExtract.Height = (int32)Texture->Source.GetSizeY();
+
+		const ETextureSourceFormat SourceFormat = Texture->Source.GetFormat();
+		const int32 BytesPerPixel = SourceFormat == TSF_BGRA8 ? 4 : (SourceFormat == TSF_G8 ? 1 : 0);
+		if (BytesPerPixel > 0 && OutExtract.Width <= MaxPixelDim && OutExtract.Height <= MaxPixelDim
+			&& Texture->Source.GetMipData(OutExtract.Pixels, 0, 0, 0))
+		{
+			OutExtract.PixelWidth = OutExtract.Width;
+			OutExtract.PixelHeight = OutExtract.Height;
+			OutExtract.BytesPerPixel = BytesPerPixel;
+			OutExtract.bSourceHasAlpha = BytesPerPixel == 4 && !Texture->CompressionNoAlpha;
+			MAGICOPT_STAT_ASSET(AssetLoad, PathString, OutExtract.Pixels.Num());
+		}
+#else
+		if (const UTexture2D* Texture2D = Cast<UTexture2D>(Texture))
+		{
+			OutExtract.Width = Texture2D->GetSizeX();
+			OutExtract.Height = Texture2D->GetSizeY();
+		}
+#endif
+		return true;
+	}
+
+	FTextureAuditRowPtr AnalyzeTexture(FTextureExtract&& Extract)
+	{
+		MAGICOPT_STAGE_SCOPE(Analyze, MagicOptimizer_InspectAnalyze);
+		MagicOptimizerStats::FAssetTimer AssetTimer(MagicOptimizerTrace::EStage::Analyze, Extract.Path);
+
+		FTextureAuditRowPtr Row = MakeShared<FTextureAuditRow>();
+		Row->Path = Extract.Path;
+		Row->Width = Extract.Width;
+		Row->Height = Extract.Height;
+		Row->Format = Extract.Format;
+		Row->LODGroup = Extract.LODGroup;
+		Row->SRGB = Extract.bSRGB ? 1 : 0;
+		{
+			MAGICOPT_STAGE_SCOPE(RuleEvaluation, MagicOptimizer_InspectRules);
+			TextureCsvReader::ClassifyTexture(*Row);
+		}
+
+		const FPixelStats Pixels = ComputePixelStats(Extract);
+		if (Pixels.bValid)
+		{
+			TArray<FString> Codes;
+			if (!Row->Issues.IsEmpty())
+			{
+				Codes.Add(Row->Issues);
+			}
+			if (Extract.bSourceHasAlpha && Pixels.MinAlpha == 255)
+			{
+				Codes.Add(TEXT("unused_alpha"));
+			}
+			if (Pixels.bConstant)
+			{
+				Codes.Add(TEXT("constant_color"));
+			}
+			else if (Row->Type != TEXT("normal") && Extract.BytesPerPixel == 4
+				&& FMath::Abs(Pixels.MeanR - 128.0) <= NormalChannelTolerance
+				&& FMath::Abs(Pixels.MeanG - 128.0) <= NormalChannelTolerance
+				&& Pixels.MeanB >= NormalMinMeanBlue)
+			{
+				Codes.Add(TEXT("unmarked_normal"));
+			}
+			Row->Issues = FString::Join(Codes, TEXT(" "));
+		}
+
+		MAGICOPT_TRACK_ASSETS_PROCESSED(1);
+		return Row;
+	}
+
+	TUniquePtr<FScheduler> MakeScheduler(int32 MaxPixelDim)
+	{
+		return MakeUnique<FScheduler>(
+			[MaxPixelDim](const FSoftObjectPath& Path, FTextureExtract& OutExtract)
+			{
+				return ExtractTexture(Path, OutExtract, MaxPixelDim);
+			},
+			[](FTextureExtract&& Extract)
+			{
+				return AnalyzeTexture(MoveTemp(Extract));
+			},
+			[](const FTextureExtract& Extract)
+			{
+				return (int64)Extract.Pixels.Num() + sizeof(FTextureExtract);
+			});
+	}
+
+	TArray<FTextureAuditRowPtr> InspectTextures(const TArray<FSoftObjectPath>& Paths, int64 MaxInFlightMB, const FOptimizerCancellationTokenPtr& CancelToken)
+	{
+		MAGICOPT_LLM_SCOPE(AuditStore);
+		MagicOptimizerStats::FPhaseScope Phase(TEXT("Inspect Textures"));
+
+		TUniquePtr<FScheduler> Scheduler = MakeScheduler();
+		FScheduler::FSettings Settings;
+		Settings.MaxInFlightBytes = FMath::Max<int64>(0, MaxInFlightMB) * 1024 * 1024;
+		Settings.CancelToken = CancelToken;
+		Scheduler->Start(Paths, Settings);
+		Scheduler->RunToCompletion();
+
+		TArray<FTextureAuditRowPtr> Rows;
+		Rows.Reserve(Paths.Num());
+		for (TOptional<FTextureAuditRowPtr>& Result : Scheduler->TakeResults())
+		{
+			if (Result.IsSet() && Result.GetValue().IsValid())
+			{
+				Rows.Add(MoveTemp(Result.GetValue()));
+			}
+		}
+		UE_LOG(LogMagicOptimizer, Log, TEXT("Inspected %d of %d textures%s"), Rows.Num(), Paths.Num(),
+			CancelToken.IsValid() && CancelToken->IsCancelled() ? TEXT(" (cancelled)") : TEXT(""));
+		return Rows;
+	}
+}
@@ -0,0 +1,85 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  TextureApply.cpp
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#include "Services/Apply/TextureApply.h"
+#include "Services/Scheduling/MemoryGovernor.h"
+#include "MagicOptimizerMemory.h"
+#include "MagicOptimizerStats.h"
+#include "Engine/Texture.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_EDITOR
+
+namespace TextureApply
+{
+	// On-disk size of a package, for the run stats and trace byte counters
+	static int64 GetPackageFileBytes(const UPackage* Package)
+	{
+		FString Filename;
+		if (!Package || !FPackageName::TryConvertLongPackageNameToFilename(Package->GetName(), Filename, FPackageName::GetAssetPackageExtension()))
+		{
+			return 0;
+		}
+		return MagicOptimizerStats::GetFileBytes(Filename);
+	}
+
+	void AddSetSrgbItems(TArray<MagicOptimizerGameThread::FWorkItem>& OutItems, const FString& ObjPath, bool bSRGB,
+		TFunction<void(bool bPreviousSRGB)> OnEdited, TFunction<void(bool bSaved)> OnSaved, FSavePackage SavePackage)
+	{
+		const TSharedRef<TStrongObjectPtr<UTexture>> Loaded = MakeShared<TStrongObjectPtr<UTexture>>();
+		OutItems.Add([Loaded, ObjPath, bSRGB, OnEdited = MoveTemp(OnEdited)]()
+		{
+			MAGICOPT_LLM_SCOPE(Apply);
+			MAGICOPT_STAGE_SCOPE(Apply, MagicOptimizer_ApplyAsset);
+			MagicOptimizerStats::FAssetTimer AssetTimer(MagicOptimizerTrace::EStage::Apply, ObjPath);
+			UTexture* Texture = nullptr;
+			{
+				MAGICOPT_STAGE_SCOPE(AssetLoad, MagicOptimizer_LoadAsset);
+				Texture = Cast<UTexture>(MagicOptimizerMemoryGovernor::LoadAsset(FSoftObjectPath(ObjPath)));
+			}
+			if (!Texture) { return; }
+			const bool bPreviousSRGB = Texture->SRGB;
+			Texture->Modify();
+			Texture->SRGB = bSRGB;
+			Texture->PostEditChange();
+			Texture->MarkPackageDirty();
+			Loaded->Reset(Texture);
+			MAGICOPT_STAT_ASSET(Apply, ObjPath, 0);
+			if (OnEdited)
+			{
+				OnEdited(bPreviousSRGB);
+			}
+		});
+		OutItems.Add([Loaded, ObjPath, OnSaved = MoveTemp(OnSaved), SavePackage = MoveTemp(SavePackage)]()
+		{
+			MAGICOPT_LLM_SCOPE(Apply);
+			const bool bLoaded = Loaded->IsValid();
+			if (bLoaded)
+			{
+				UPackage* Package = Loaded->Get()->GetOutermost();
+				if (SavePackage && Package != GetTransientPackage())
+				{
+					{
+						MAGICOPT_STAGE_SCOPE(Save, MagicOptimizer_SavePackage);
+						SavePackage(Package);
+					}
+					MAGICOPT_STAT_ASSET(Save, ObjPath, GetPackageFileBytes(Package));
+				}
+				Loaded->Reset();
+			}
+			if (OnSaved)
+			{
+				OnSaved(bLoaded);
+			}
+		});
+	}
+}
+
+#endif
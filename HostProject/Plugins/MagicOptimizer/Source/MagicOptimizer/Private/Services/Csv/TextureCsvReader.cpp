@@ -4,12 +4,22 @@
   Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
 */
 #include "Services/Csv/TextureCsvReader.h"
+#include "Services/Facets/TextureFacets.h"
+#include "Services/Paging/CsvLineIndex.h"
 #include "OptimizerSettings.h"
+#include "MagicOptimizerCVars.h"
+#include "MagicOptimizerStats.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "MagicOptimizerMemory.h"
 
 namespace
 {
+	// Below this many rows per worker, classification is cheaper than waking the worker
+	static constexpr int32 MinRowsPerChunk = 2048;
+
 	static FString BuildAuditCsvPath(const UOptimizerSettings* Settings)
 	{
 		const FString SavedDir = FPaths::ProjectSavedDir();
@@ -36,13 +46,159 @@ namespace
 		}
 		return S;
 	}
+
+	// Column index by header name, or INDEX_NONE
+	static int32 FindHeader(const TArray<FString>& Header, const TCHAR* Name)
+	{
+		return Header.IndexOfByPredicate([Name](const FString& Cell) { return Cell.Equals(Name, ESearchCase::IgnoreCase); });
+	}
+
+	static FString CellAt(const TArray<FString>& Cells, int32 Index)
+	{
+		return Cells.IsValidIndex(Index) ? TrimCell(Cells[Index]) : FString();
+	}
+
+	static FTextureRecRowPtr ParseRecommendationLine(const FString& Line)
+	{
+		if (Line.TrimStartAndEnd().IsEmpty())
+		{
+			return nullptr;
+		}
+		TArray<FString> Cells;
+		Line.ParseIntoArray(Cells, TEXT(","), /*CullEmpty*/ false);
+		FTextureRecRowPtr Row = MakeShared<FTextureRecRow>();
+		Row->Path = Cells.Num() > 0 ? TrimCell(Cells[0]) : TEXT("");
+		Row->Width = Cells.Num() > 1 ? FCString::Atoi(*TrimCell(Cells[1])) : 0;
+		Row->Height = Cells.Num() > 2 ? FCString::Atoi(*TrimCell(Cells[2])) : 0;
+		Row->Format = Cells.Num() > 3 ? TrimCell(Cells[3]) : TEXT("");
+		Row->Issues = Cells.Num() > 4 ? TrimCell(Cells[4]) : TEXT("");
+		Row->Recommendations = Cells.Num() > 5 ? TrimCell(Cells[5]) : TEXT("");
+		return Row;
+	}
+
+	static FString FindRecommendCsv(const UOptimizerSettings* Settings)
+	{
+		FString CsvPath = BuildRecommendCsvPath(Settings);
+		if (!FPaths::FileExists(CsvPath))
+		{
+			CsvPath = FPaths::ProjectSavedDir() / TEXT("MagicOptimizer/Audit/textures_recommend.csv");
+			if (!FPaths::FileExists(CsvPath))
+			{
+				return FString();
+			}
+		}
+		return CsvPath;
+	}
+
+	// Recommendation rows parsed from the CSV a page at a time; only line offsets stay in memory
+	class FRecommendationCsvSource : public TAssetRowSource<FTextureRecRow>
+	{
+	public:
+		bool Open(const FString& CsvPath)
+		{
+			return Lines.Build(CsvPath, TEXT("path"));
+		}
+
+		virtual int32 Num() const override { return Lines.Num(); }
+
+		virtual void FetchRows(int32 Start, int32 Count, TArray<FTextureRecRowPtr>& OutRows) const override
+		{
+			MAGICOPT_STAGE_SCOPE(CsvRead, MagicOptimizer_FetchRecommendationRows);
+			TArray<FString> Text;
+			Lines.ReadLines(Start, Count, Text);
+			for (const FString& Line : Text)
+			{
+				// Index positions must stay stable, so an unparsable line still yields a row
+				FTextureRecRowPtr Row = ParseRecommendationLine(Line);
+				OutRows.Add(Row ? Row : MakeShared<FTextureRecRow>());
+			}
+		}
+
+		virtual bool CanFetchAsync() const override { return true; }
+
+	private:
+		FCsvLineIndex Lines;
+	};
 }
 
 namespace TextureCsvReader
 {
+	TArray<FString> GetAssetNameTokens(const FString& Path)
+	{
+		// "/Game/Rock/T_Rock_N.T_Rock_N" -> "t_rock_n" -> t, rock, n
+		FString Name = Path;
+		int32 Index = INDEX_NONE;
+		if (Name.FindLastChar(TEXT('/'), Index))
+		{
+			Name.RightChopInline(Index + 1);
+		}
+		if (Name.FindChar(TEXT('.'), Index))
+		{
+			Name.LeftInline(Index);
+		}
+		TArray<FString> Tokens;
+		Name.ToLower().ParseIntoArray(Tokens, TEXT("_"));
+		return Tokens;
+	}
+
+	void ClassifyTexture(FTextureAuditRow& Row)
+	{
+		const FString PathLower = Row.Path.ToLower();
+		const FString FormatLower = Row.Format.ToLower();
+		const FString GroupLower = Row.LODGroup.ToLower();
+
+		// Name tokens only, so folders such as /Platform/ or names such as T_Nature_D do not match
+		const TArray<FString> NameTokens = GetAssetNameTokens(Row.Path);
+		const bool bNormalName = NameTokens.Contains(TEXT("n")) || NameTokens.Contains(TEXT("normal"));
+		const bool bMaskName = NameTokens.Contains(TEXT("orm")) || NameTokens.Contains(TEXT("mask"));
+
+		if (bNormalName || FormatLower.Contains(TEXT("normal")))
+		{
+			Row.Type = TEXT("normal");
+		}
+		else if (bMaskName || FormatLower.Contains(TEXT("mask")))
+		{
+			Row.Type = TEXT("mask");
+		}
+		else if (PathLower.Contains(TEXT("/ui/")) || GroupLower.Contains(TEXT("ui")) || FormatLower.Contains(TEXT("userinterface")))
+		{
+			Row.Type = TEXT("ui");
+		}
+		else
+		{
+			Row.Type = TEXT("color");
+		}
+
+		TArray<FString> Codes;
+		if (Row.Width <= 0 || Row.Height <= 0)
+		{
+			Codes.Add(TEXT("missing_dims"));
+		}
+		else if (!FMath::IsPowerOfTwo(Row.Width) || !FMath::IsPowerOfTwo(Row.Height))
+		{
+			Codes.Add(TEXT("npot"));
+		}
+		if (Row.Type == TEXT("normal") && !FormatLower.Contains(TEXT("normal")))
+		{
+			Codes.Add(TEXT("normal_format"));
+		}
+		if (Row.Type == TEXT("mask") && !FormatLower.Contains(TEXT("mask")))
+		{
+			Codes.Add(TEXT("mask_format"));
+		}
+		if (Row.SRGB == 1 && (Row.Type == TEXT("normal") || Row.Type == TEXT("mask")))
+		{
+			Codes.Add(TEXT("srgb"));
+		}
+		Row.Issues = FString::Join(Codes, TEXT(" "));
+
+		Row.SizeBucket = TextureFacets::GetSizeBucket(Row.Width, Row.Height);
+		Row.EstimatedBytes = TextureFacets::EstimateMemoryBytes(Row.Width, Row.Height, Row.Format);
+	}
+
 	bool ReadAuditCsv(const UOptimizerSettings* OptimizerSettings, TArray<FTextureAuditRowPtr>& OutRows)
 	{
-		OutRows.Empty();
+		MAGICOPT_LLM_SCOPE(AuditStore);
 		FString CsvPath = BuildAuditCsvPath(OptimizerSettings);
 		if (!FPaths::FileExists(CsvPath))
 		{
@@ -50,15 +206,45 @@ namespace TextureCsvReader
 			CsvPath = FPaths::ProjectSavedDir() / TEXT("MagicOptimizer/Audit/textures.csv");
 			if (!FPaths::FileExists(CsvPath))
 			{
+				OutRows.Empty();
 				return false;
 			}
 		}
+		return ReadAuditCsvFile(CsvPath, OutRows);
+	}
+
+	bool ReadAuditCsvFile(const FString& CsvPath, TArray<FTextureAuditRowPtr>& OutRows)
+	{
+		MAGICOPT_LLM_SCOPE(AuditStore);
+		MAGICOPT_STAGE_SCOPE(CsvRead, MagicOptimizer_ReadAuditCsv);
+		OutRows.Empty();
 		TArray<FString> Lines;
 		if (!FFileHelper::LoadFileToStringArray(Lines, *CsvPath))
 		{
 			return false;
 		}
-		int32 StartIndex = (Lines.Num() > 0 && Lines[0].StartsWith(TEXT("path"), ESearchCase::IgnoreCase)) ? 1 : 0;
+		MAGICOPT_STAT_ASSET(CsvRead, CsvPath, IFileManager::Get().FileSize(*CsvPath));
+
+		// Map columns by header name so optional columns can be added without breaking older CSVs
+		int32 PathCol = 0, WidthCol = 1, HeightCol = 2, FormatCol = 3, GroupCol = INDEX_NONE, SrgbCol = INDEX_NONE, LoadMsCol = INDEX_NONE;
+		int32 StartIndex = 0;
+		if (Lines.Num() > 0 && Lines[0].StartsWith(TEXT("path"), ESearchCase::IgnoreCase))
+		{
+			TArray<FString> Header;
+			Lines[0].ParseIntoArray(Header, TEXT(","), /*CullEmpty*/ false);
+			for (FString& Cell : Header)
+			{
+				Cell = TrimCell(Cell);
+			}
+			PathCol = FindHeader(Header, TEXT("path"));
+			WidthCol = FindHeader(Header, TEXT("width"));
+			HeightCol = FindHeader(Header, TEXT("height"));
+			FormatCol = FindHeader(Header, TEXT("format"));
+			GroupCol = FindHeader(Header, TEXT("lod_group"));
+			SrgbCol = FindHeader(Header, TEXT("srgb"));
+			LoadMsCol = FindHeader(Header, TEXT("load_ms"));
+			StartIndex = 1;
+		}
 		for (int32 i = StartIndex; i < Lines.Num(); ++i)
 		{
 			const FString& Line = Lines[i];
@@ -68,54 +254,94 @@ namespace TextureCsvReader
 			if (Cells.Num() >= 1)
 			{
 				FTextureAuditRowPtr Row = MakeShared<FTextureAuditRow>();
-				Row->Path = TrimCell(Cells[0]);
-				Row->Width = Cells.Num() > 1 ? FCString::Atoi(*TrimCell(Cells[1])) : 0;
-				Row->Height = Cells.Num() > 2 ? FCString::Atoi(*TrimCell(Cells[2])) : 0;
-				Row->Format = Cells.Num() > 3 ? TrimCell(Cells[3]) : TEXT("");
+				Row->Path = CellAt(Cells, PathCol);
+				Row->Width = FCString::Atoi(*CellAt(Cells, WidthCol));
+				Row->Height = FCString::Atoi(*CellAt(Cells, HeightCol));
+				Row->Format = CellAt(Cells, FormatCol);
+				Row->LODGroup = CellAt(Cells, GroupCol);
+				if (SrgbCol != INDEX_NONE)
+				{
+					const FString SrgbCell = CellAt(Cells, SrgbCol);
+					Row->SRGB = SrgbCell.IsEmpty() ? -1 : (FCString::ToBool(*SrgbCell) ? 1 : 0);
+				}
+				if (LoadMsCol != INDEX_NONE)
+				{
+					// Python's per-texture load time; feeds the run report's slowest assets
+					const FString LoadMsCell = CellAt(Cells, LoadMsCol);
+					if (!LoadMsCell.IsEmpty())
+					{
+						MagicOptimizerStats::RecordAssetTime(MagicOptimizerTrace::EStage::AssetLoad, Row->Path, FCString::Atod(*LoadMsCell) / 1000.0);
+					}
+				}
 				OutRows.Add(Row);
 			}
 		}
+
+		int64 EstimatedBytes = 0;
+		{
+			// Rows are independent; split them into one contiguous chunk per allowed worker
+			MAGICOPT_STAGE_SCOPE(RuleEvaluation, MagicOptimizer_EvaluateRules);
+			const int32 NumChunks = FMath::Clamp(OutRows.Num() / MinRowsPerChunk, 1, MagicOptimizerCVars::GetWorkerThreadCount());
+			const int32 RowsPerChunk = FMath::DivideAndRoundUp(OutRows.Num(), NumChunks);
+			TArray<int64> ChunkBytes;
+			ChunkBytes.SetNumZeroed(NumChunks);
+			ParallelFor(NumChunks, [&OutRows, &ChunkBytes, RowsPerChunk](int32 Chunk)
+			{
+				MAGICOPT_LLM_SCOPE(AuditStore);
+				const int32 End = FMath::Min(OutRows.Num(), (Chunk + 1) * RowsPerChunk);
+				for (int32 Index = Chunk * RowsPerChunk; Index < End; ++Index)
+				{
+					ClassifyTexture(*OutRows[Index]);
+					ChunkBytes[Chunk] += OutRows[Index]->EstimatedBytes;
+					MagicOptimizerStats::RecordAsset(MagicOptimizerTrace::EStage::RuleEvaluation, 0);
+				}
+			}, NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+			for (const int64 Bytes : ChunkBytes)
+			{
+				EstimatedBytes += Bytes;
+			}
+		}
+		MAGICOPT_TRACK_ASSETS_PROCESSED(OutRows.Num());
+		MagicOptimizerStats::SetEstimatedMemory(EstimatedBytes);
 		return true;
 	}
 
 	bool ReadRecommendationsCsv(const UOptimizerSettings* OptimizerSettings, TArray<FTextureRecRowPtr>& OutRows)
 	{
+		MAGICOPT_LLM_SCOPE(AuditStore);
+		MAGICOPT_STAGE_SCOPE(CsvRead, MagicOptimizer_ReadRecommendationsCsv);
 		OutRows.Empty();
-		FString CsvPath = BuildRecommendCsvPath(OptimizerSettings);
-		if (!FPaths::FileExists(CsvPath))
-		{
-			CsvPath = FPaths::ProjectSavedDir() / TEXT("MagicOptimizer/Audit/textures_recommend.csv");
-			if (!FPaths::FileExists(CsvPath))
-			{
-				return false;
-			}
-		}
+		const FString CsvPath = FindRecommendCsv(OptimizerSettings);
 		TArray<FString> Lines;
-		if (!FFileHelper::LoadFileToStringArray(Lines, *CsvPath))
+		if (CsvPath.IsEmpty() || !FFileHelper::LoadFileToStringArray(Lines, *CsvPath))
 		{
 			return false;
 		}
+		MAGICOPT_STAT_ASSET(CsvRead, CsvPath, IFileManager::Get().FileSize(*CsvPath));
 		int32 StartIndex = (Lines.Num() > 0 && Lines[0].StartsWith(TEXT("path"), ESearchCase::IgnoreCase)) ? 1 : 0;
 		for (int32 i = StartIndex; i < Lines.Num(); ++i)
 		{
-			const FString& Line = Lines[i];
-			if (Line.TrimStartAndEnd().IsEmpty()) { continue; }
-			TArray<FString> Cells;
-			Line.ParseIntoArray(Cells, TEXT(","), /*CullEmpty*/ false);
-			if (Cells.Num() >= 1)
+			if (FTextureRecRowPtr Row = ParseRecommendationLine(Lines[i]))
 			{
-				FTextureRecRowPtr Row = MakeShared<FTextureRecRow>();
-				Row->Path = TrimCell(Cells[0]);
-				Row->Width = Cells.Num() > 1 ? FCString::Atoi(*TrimCell(Cells[1])) : 0;
-				Row->Height = Cells.Num() > 2 ? FCString::Atoi(*TrimCell(Cells[2])) : 0;
-				Row->Format = Cells.Num() > 3 ? TrimCell(Cells[3]) : TEXT("");
-				Row->Issues = Cells.Num() > 4 ? TrimCell(Cells[4]) : TEXT("");
-				Row->Recommendations = Cells.Num() > 5 ? TrimCell(Cells[5]) : TEXT("");
 				OutRows.Add(Row);
 			}
 		}
 		return true;
 	}
-}
-
 
+	TSharedPtr<const TAssetRowSource<FTextureRecRow>, ESPMode::ThreadSafe> OpenRecommendationsSource(const UOptimizerSettings* OptimizerSettings)
+	{
+		MAGICOPT_LLM_SCOPE(AuditStore);
+		const FString CsvPath = FindRecommendCsv(OptimizerSettings);
+		if (CsvPath.IsEmpty())
+		{
+			return nullptr;
+		}
+		TSharedRef<FRecommendationCsvSource, ESPMode::ThreadSafe> Source = MakeShared<FRecommendationCsvSource, ESPMode::ThreadSafe>();
+		if (!Source->Open(CsvPath))
+		{
+			return nullptr;
+		}
+		return Source;
+	}
+}
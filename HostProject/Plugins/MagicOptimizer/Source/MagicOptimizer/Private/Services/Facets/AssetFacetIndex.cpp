@@ -0,0 +1,202 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  AssetFacetIndex.cpp
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#include "Services/Facets/AssetFacetIndex.h"
+#include "MagicOptimizerMemory.h"
+
+namespace
+{
+	static constexpr uint32 BucketBits = 24;
+	static constexpr uint32 BucketMask = (1u << BucketBits) - 1;
+}
+
+void FAssetFacetIndex::Reset()
+{
+	for (FFacetBuckets& Facet : Facets)
+	{
+		Facet.Ids.Reset();
+		Facet.Buckets.Reset();
+	}
+	RowBuckets.Reset();
+	RowBytes.Reset();
+	RowPresent.Reset();
+	RowFiltered.Reset();
+	NumRows = 0;
+	NumFilteredRows = 0;
+	TotalBytes = 0;
+	FilteredBytes = 0;
+}
+
+void FAssetFacetIndex::SetRow(int32 RowId, const FAssetFacetRow& Row)
+{
+	MAGICOPT_LLM_SCOPE(AuditStore);
+	check(RowId >= 0);
+	if (RowId >= RowBuckets.Num())
+	{
+		RowBuckets.SetNum(RowId + 1);
+		RowBytes.SetNumZeroed(RowId + 1);
+		RowPresent.Add(false, RowId + 1 - RowPresent.Num());
+		RowFiltered.Add(false, RowId + 1 - RowFiltered.Num());
+	}
+
+	const bool bFiltered = RowFiltered[RowId];
+	if (RowPresent[RowId])
+	{
+		if (bFiltered)
+		{
+			AddToFiltered(RowId, -1);
+		}
+		AddToTotals(RowId, -1);
+	}
+
+	TArray<uint32, TInlineAllocator<6>>& Buckets = RowBuckets[RowId];
+	Buckets.Reset();
+	for (const TPair<EAssetFacet, FString>& Value : Row.Values)
+	{
+		if (Value.Value.IsEmpty())
+		{
+			continue;
+		}
+		FFacetBuckets& Facet = Facets[(int32)Value.Key];
+		int32& BucketIndex = Facet.Ids.FindOrAdd(Value.Value, INDEX_NONE);
+		if (BucketIndex == INDEX_NONE)
+		{
+			BucketIndex = Facet.Buckets.Num();
+			Facet.Buckets.AddDefaulted_GetRef().Value = Value.Value;
+		}
+		Buckets.AddUnique(((uint32)Value.Key << BucketBits) | (uint32)BucketIndex);
+	}
+	RowBytes[RowId] = Row.Bytes;
+	RowPresent[RowId] = true;
+
+	AddToTotals(RowId, 1);
+	if (bFiltered)
+	{
+		AddToFiltered(RowId, 1);
+	}
+}
+
+void FAssetFacetIndex::RemoveRow(int32 RowId)
+{
+	if (!RowPresent.IsValidIndex(RowId) || !RowPresent[RowId])
+	{
+		return;
+	}
+	if (RowFiltered[RowId])
+	{
+		AddToFiltered(RowId, -1);
+		RowFiltered[RowId] = false;
+	}
+	AddToTotals(RowId, -1);
+	RowPresent[RowId] = false;
+	RowBuckets[RowId].Reset();
+	RowBytes[RowId] = 0;
+}
+
+void FAssetFacetIndex::SetFilteredRows(TConstArrayView<int32> RowIds)
+{
+	MAGICOPT_LLM_SCOPE(AuditStore);
+	TBitArray<> NewFiltered(false, RowPresent.Num());
+	for (const int32 RowId : RowIds)
+	{
+		if (RowPresent.IsValidIndex(RowId) && RowPresent[RowId])
+		{
+			NewFiltered[RowId] = true;
+		}
+	}
+
+	// Only rows that left or joined the filtered set change the aggregates
+	for (TConstSetBitIterator<> It(RowFiltered); It; ++It)
+	{
+		if (!NewFiltered[It.GetIndex()])
+		{
+			AddToFiltered(It.GetIndex(), -1);
+		}
+	}
+	for (TConstSetBitIterator<> It(NewFiltered); It; ++It)
+	{
+		if (!RowFiltered[It.GetIndex()])
+		{
+			AddToFiltered(It.GetIndex(), 1);
+		}
+	}
+	RowFiltered = MoveTemp(NewFiltered);
+}
+
+TArray<FAssetFacetBucket> FAssetFacetIndex::GetBuckets(EAssetFacet Facet) const
+{
+	MAGICOPT_LLM_SCOPE(AuditStore);
+	TArray<FAssetFacetBucket> Result;
+	for (const FAssetFacetBucket& Bucket : Facets[(int32)Facet].Buckets)
+	{
+		if (Bucket.Count > 0)
+		{
+			Result.Add(Bucket);
+		}
+	}
+	Result.Sort([](const FAssetFacetBucket& A, const FAssetFacetBucket& B)
+	{
+		if (A.FilteredBytes != B.FilteredBytes)
+		{
+			return A.FilteredBytes > B.FilteredBytes;
+		}
+		return A.FilteredCount > B.FilteredCount;
+	});
+	return Result;
+}
+
+const FAssetFacetBucket* FAssetFacetIndex::FindBucket(EAssetFacet Facet, const FString& Value) const
+{
+	const FFacetBuckets& Buckets = Facets[(int32)Facet];
+	const int32* BucketIndex = Buckets.Ids.Find(Value);
+	return BucketIndex ? &Buckets.Buckets[*BucketIndex] : nullptr;
+}
+
+const TCHAR* FAssetFacetIndex::GetFacetName(EAssetFacet Facet)
+{
+	switch (Facet)
+	{
+	case EAssetFacet::Format:
+		return TEXT("Format");
+	case EAssetFacet::SizeBucket:
+		return TEXT("Size");
+	case EAssetFacet::LODGroup:
+		return TEXT("LOD Group");
+	case EAssetFacet::Folder:
+		return TEXT("Folder");
+	case EAssetFacet::Issue:
+		return TEXT("Issue");
+	default:
+		return TEXT("");
+	}
+}
+
+void FAssetFacetIndex::AddToTotals(int32 RowId, int32 Sign)
+{
+	const int64 Bytes = RowBytes[RowId];
+	for (const uint32 Packed : RowBuckets[RowId])
+	{
+		FAssetFacetBucket& Bucket = Facets[Packed >> BucketBits].Buckets[Packed & BucketMask];
+		Bucket.Count += Sign;
+		Bucket.Bytes += Sign * Bytes;
+	}
+	NumRows += Sign;
+	TotalBytes += Sign * Bytes;
+}
+
+void FAssetFacetIndex::AddToFiltered(int32 RowId, int32 Sign)
+{
+	const int64 Bytes = RowBytes[RowId];
+	for (const uint32 Packed : RowBuckets[RowId])
+	{
+		FAssetFacetBucket& Bucket = Facets[Packed >> BucketBits].Buckets[Packed & BucketMask];
+		Bucket.FilteredCount += Sign;
+		Bucket.FilteredBytes += Sign * Bytes;
+	}
+	NumFilteredRows += Sign;
+	FilteredBytes += Sign * Bytes;
+}
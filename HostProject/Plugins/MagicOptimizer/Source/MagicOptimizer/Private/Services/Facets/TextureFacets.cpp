@@ -0,0 +1,111 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  TextureFacets.cpp
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#include "Services/Facets/TextureFacets.h"
+#include "ViewModels/TextureModels.h"
+
+namespace
+{
+	// Bits per pixel of the platform format each compression setting typically cooks to on desktop
+	static int32 GetBitsPerPixel(const FString& Format)
+	{
+		struct FFormatBits
+		{
+			const TCHAR* Name;
+			int32 Bits;
+		};
+		static const FFormatBits Table[] =
+		{
+			{ TEXT("TC_Default"), 4 },
+			{ TEXT("TC_Masks"), 4 },
+			{ TEXT("TC_Alpha"), 4 },
+			{ TEXT("TC_Normalmap"), 8 },
+			{ TEXT("TC_BC7"), 8 },
+			{ TEXT("TC_Grayscale"), 8 },
+			{ TEXT("TC_Displacementmap"), 8 },
+			{ TEXT("TC_DistanceFieldFont"), 8 },
+			{ TEXT("TC_HDR_Compressed"), 8 },
+			{ TEXT("TC_HalfFloat"), 16 },
+			{ TEXT("TC_LQ"), 16 },
+			{ TEXT("TC_UserInterface2D"), 32 },
+			{ TEXT("TC_EditorIcon"), 32 },
+			{ TEXT("TC_VectorDisplacementmap"), 32 },
+			{ TEXT("TC_SingleFloat"), 32 },
+			{ TEXT("TC_HDR"), 64 },
+			{ TEXT("TC_HDR_F32"), 128 },
+		};
+		for (const FFormatBits& Entry : Table)
+		{
+			if (Format.Equals(Entry.Name, ESearchCase::IgnoreCase))
+			{
+				return Entry.Bits;
+			}
+		}
+		return 4;
+	}
+}
+
+namespace TextureFacets
+{
+	int64 EstimateMemoryBytes(int32 Width, int32 Height, const FString& Format)
+	{
+		if (Width <= 0 || Height <= 0)
+		{
+			return 0;
+		}
+		// A full mip chain adds a third on top of the top mip
+		const int64 TopMipBits = (int64)Width * (int64)Height * GetBitsPerPixel(Format);
+		return TopMipBits * 4 / 3 / 8;
+	}
+
+	FString GetSizeBucket(int32 Width, int32 Height)
+	{
+		const int32 MaxDim = FMath::Max(Width, Height);
+		if (MaxDim <= 0)
+		{
+			return FString();
+		}
+		if (MaxDim <= 512)
+		{
+			return TEXT("512");
+		}
+		const uint32 Rounded = FMath::RoundUpToPowerOfTwo((uint32)MaxDim);
+		return Rounded >= 16384 ? TEXT("16K") : FString::Printf(TEXT("%dK"), Rounded / 1024);
+	}
+
+	FString GetFolder(const FString& Path)
+	{
+		TArray<FString> Segments;
+		Path.ParseIntoArray(Segments, TEXT("/"), /*CullEmpty*/ true);
+		if (Segments.Num() <= 1)
+		{
+			return Segments.Num() == 1 ? TEXT("/") : FString();
+		}
+		// The last segment is the asset itself
+		return Segments.Num() == 2
+			? FString::Printf(TEXT("/%s"), *Segments[0])
+			: FString::Printf(TEXT("/%s/%s"), *Segments[0], *Segments[1]);
+	}
+
+	FAssetFacetRow MakeRow(const FTextureAuditRow& Row)
+	{
+		FAssetFacetRow Facets;
+		Facets.Bytes = Row.EstimatedBytes;
+		Facets.Values.Emplace(EAssetFacet::Format, Row.Format);
+		Facets.Values.Emplace(EAssetFacet::SizeBucket, Row.SizeBucket);
+		Facets.Values.Emplace(EAssetFacet::LODGroup, Row.LODGroup);
+		Facets.Values.Emplace(EAssetFacet::Folder, GetFolder(Row.Path));
+
+		TArray<FString> Codes;
+		Row.Issues.ParseIntoArrayWS(Codes);
+		for (FString& Code : Codes)
+		{
+			Facets.Values.Emplace(EAssetFacet::Issue, MoveTemp(Code));
+		}
+		return Facets;
+	}
+}
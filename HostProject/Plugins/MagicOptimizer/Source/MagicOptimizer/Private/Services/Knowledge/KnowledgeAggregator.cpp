@@ -0,0 +1,499 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  KnowledgeAggregator.cpp
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#include "Services/Knowledge/KnowledgeAggregator.h"
+#include "Services/Knowledge/KnowledgeEventSink.h"
+#include "MagicOptimizerCVars.h"
+#include "MagicOptimizerLogging.h"
+#include "MagicOptimizerStats.h"
+#include "PythonBridge.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/Archive.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "MagicOptimizerMemory.h"
+
+namespace MagicOptimizerKnowledge
+{
+	static const TCHAR* const EventsFile = TEXT("events.jsonl");
+	static const TCHAR* const CsvFiles[] = { TEXT("kb_textures.csv"), TEXT("kb_texture_recs.csv") };
+
+	static constexpr int64 ReadChunkBytes = 1024 * 1024;
+	// CSVs keep at least this much of their newest rows when compacted
+	static constexpr int64 MinCsvKeepBytes = 1024 * 1024;
+	static constexpr int32 AggregatesVersion = 1;
+
+	// Serializes updates and compaction
+	static FCriticalSection AggregatesLock;
+
+	static int64 GetFileSize(const FString& Path)
+	{
+		return FMath::Max<int64>(0, IFileManager::Get().FileSize(*Path));
+	}
+
+	// Writes next to Path first so a crash never leaves a half-written file in its place
+	static bool SaveFileReplacing(const FString& Path, TConstArrayView<uint8> Bytes)
+	{
+		const FString TempPath = Path + TEXT(".tmp");
+		return FFileHelper::SaveArrayToFile(Bytes, *TempPath)
+			&& IFileManager::Get().Move(*Path, *TempPath, /*Replace*/ true, /*EvenIfReadOnly*/ true);
+	}
+
+	static bool SaveStringReplacing(const FString& Path, const FString& Text)
+	{
+		const FTCHARToUTF8 Utf8(*Text);
+		return SaveFileReplacing(Path, TConstArrayView<uint8>((const uint8*)Utf8.Get(), Utf8.Length()));
+	}
+
+	static bool ReadRange(FArchive& Reader, int64 Start, int64 Length, TArray<uint8>& Out)
+	{
+		Out.SetNumUninitialized((int32)Length);
+		Reader.Seek(Start);
+		Reader.Serialize(Out.GetData(), Length);
+		return !Reader.IsError();
+	}
+
+	static TSharedRef<FJsonObject> CountsToJson(const FCountMap& Counts)
+	{
+		TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		for (const TPair<FString, int64>& Pair : Counts)
+		{
+			Object->SetNumberField(Pair.Key, (double)Pair.Value);
+		}
+		return Object;
+	}
+
+	static void CountsFromJson(const FJsonObject& Root, const TCHAR* Field, FCountMap& Out)
+	{
+		Out.Reset();
+		const TSharedPtr<FJsonObject>* Object = nullptr;
+		if (Root.TryGetObjectField(Field, Object))
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*Object)->Values)
+			{
+				Out.Add(Pair.Key, (int64)Pair.Value->AsNumber());
+			}
+		}
+	}
+
+	static void Count(FCountMap& Counts, const FString& Key)
+	{
+		if (!Key.IsEmpty())
+		{
+			++Counts.FindOrAdd(Key);
+		}
+	}
+
+	static void CountArray(FCountMap& Counts, const FJsonObject& Event, const TCHAR* Field)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+		if (Event.TryGetArrayField(Field, Values))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *Values)
+			{
+				Count(Counts, Value->AsString());
+			}
+		}
+	}
+
+	// Audit and recommend events carry their fields at the top level; EventLogger nests them under "data"
+	static FString GetEventString(const FJsonObject& Event, const TCHAR* Field)
+	{
+		FString Value;
+		if (!Event.TryGetStringField(Field, Value))
+		{
+			const TSharedPtr<FJsonObject>* Data = nullptr;
+			if (Event.TryGetObjectField(TEXT("data"), Data))
+			{
+				(*Data)->TryGetStringField(Field, Value);
+			}
+		}
+		return Value;
+	}
+
+	static void FoldEvent(const FJsonObject& Event, FKnowledgeAggregates& Aggregates)
+	{
+		FString Type;
+		if (!Event.TryGetStringField(TEXT("type"), Type))
+		{
+			Event.TryGetStringField(TEXT("event_type"), Type);
+		}
+		const FString RunId = GetEventString(Event, TEXT("run_id"));
+		const FString Profile = GetEventString(Event, TEXT("profile"));
+
+		++Aggregates.Events;
+		if (!RunId.IsEmpty() && RunId != Aggregates.LastRunId)
+		{
+			++Aggregates.Runs;
+			Aggregates.LastRunId = RunId;
+		}
+		Count(Aggregates.ByEventType, Type);
+		Count(Aggregates.ByProfile, Profile);
+		Count(Aggregates.ByFormat, GetEventString(Event, TEXT("format")));
+		CountArray(Aggregates.ByToken, Event, TEXT("tokens"));
+		CountArray(Aggregates.ByIssue, Event, TEXT("issues"));
+		CountArray(Aggregates.ByRecommendation, Event, TEXT("recommendations"));
+		Count(Aggregates.PendingGroups, FString::Printf(TEXT("%s|%s|%s"), *RunId, *Type, *Profile));
+	}
+
+	static bool FoldLine(const uint8* Data, int32 Length, FKnowledgeAggregates& Aggregates)
+	{
+		while (Length > 0 && (Data[Length - 1] == '\r' || Data[Length - 1] == ' '))
+		{
+			--Length;
+		}
+		if (Length <= 0)
+		{
+			return false;
+		}
+		const FUTF8ToTCHAR Converted((const ANSICHAR*)Data, Length);
+		const FString Line(Converted.Length(), Converted.Get());
+		TSharedPtr<FJsonObject> Event;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+		if (!FJsonSerializer::Deserialize(Reader, Event) || !Event.IsValid())
+		{
+			// A malformed record is skipped, not retried
+			return false;
+		}
+		FoldEvent(*Event, Aggregates);
+		return true;
+	}
+
+	// Folds every complete line from Offset on; returns the offset just past the last complete line
+	static int64 FoldNewEvents(const FString& Path, int64 Offset, FKnowledgeAggregates& Aggregates, int64& OutFolded)
+	{
+		OutFolded = 0;
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path, FILEREAD_AllowWrite | FILEREAD_Silent));
+		if (!Reader)
+		{
+			return 0;
+		}
+		const int64 Size = Reader->TotalSize();
+		if (Size < Offset)
+		{
+			// Replaced or truncated outside the plugin; fold the new content from the start
+			Offset = 0;
+		}
+		Reader->Seek(Offset);
+
+		// Bytes from Consumed up to ReadEnd; a trailing partial line waits for the next update
+		TArray<uint8> Buffer;
+		int64 Consumed = Offset;
+		int64 ReadEnd = Offset;
+		while (ReadEnd < Size && !Reader->IsError())
+		{
+			const int64 ToRead = FMath::Min(ReadChunkBytes, Size - ReadEnd);
+			const int32 ScanStart = Buffer.Num();
+			Buffer.AddUninitialized((int32)ToRead);
+			Reader->Serialize(Buffer.GetData() + ScanStart, ToRead);
+			ReadEnd += ToRead;
+
+			int32 LineStart = 0;
+			for (int32 Index = ScanStart; Index < Buffer.Num(); ++Index)
+			{
+				if (Buffer[Index] == '\n')
+				{
+					OutFolded += FoldLine(Buffer.GetData() + LineStart, Index - LineStart, Aggregates) ? 1 : 0;
+					LineStart = Index + 1;
+				}
+			}
+			Consumed += LineStart;
+			Buffer.RemoveAt(0, LineStart, EAllowShrinking::No);
+		}
+		MAGICOPT_STAT_ASSET(ReportRead, Path, ReadEnd - Offset);
+		return Consumed;
+	}
+
+	static bool SaveAggregates(const FKnowledgeAggregates& Aggregates)
+	{
+		const FString Path = GetAggregatesPath();
+		if (!SaveStringReplacing(Path, Aggregates.ToJsonString()))
+		{
+			UE_LOG(LogMagicOptimizer, Warning, TEXT("Could not save knowledge aggregates to %s"), *Path);
+			return false;
+		}
+		return true;
+	}
+
+	// Appends the pending per-run groups as rows of the columnar summary
+	static bool AppendCompactedGroups(const FKnowledgeAggregates& Aggregates)
+	{
+		const FString Path = GetCompactedPath();
+		TSharedPtr<FJsonObject> Root;
+		FString Existing;
+		if (FFileHelper::LoadFileToString(Existing, *Path))
+		{
+			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Existing);
+			FJsonSerializer::Deserialize(Reader, Root);
+		}
+		if (!Root.IsValid())
+		{
+			Root = MakeShared<FJsonObject>();
+		}
+
+		static const TCHAR* const ColumnNames[] = { TEXT("run_id"), TEXT("event_type"), TEXT("profile"), TEXT("count") };
+		TArray<TSharedPtr<FJsonValue>> Columns[UE_ARRAY_COUNT(ColumnNames)];
+		const TSharedPtr<FJsonObject>* ExistingColumns = nullptr;
+		if (Root->TryGetObjectField(TEXT("columns"), ExistingColumns))
+		{
+			for (int32 Column = 0; Column < UE_ARRAY_COUNT(ColumnNames); ++Column)
+			{
+				const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+				if ((*ExistingColumns)->TryGetArrayField(ColumnNames[Column], Values))
+				{
+					Columns[Column] = *Values;
+				}
+			}
+		}
+
+		TArray<FString> Keys;
+		for (const TPair<FString, int64>& Group : Aggregates.PendingGroups)
+		{
+			Keys.Reset();
+			Group.Key.ParseIntoArray(Keys, TEXT("|"), /*CullEmpty*/ false);
+			Keys.SetNum(3);
+			Columns[0].Add(MakeShared<FJsonValueString>(Keys[0]));
+			Columns[1].Add(MakeShared<FJsonValueString>(Keys[1]));
+			Columns[2].Add(MakeShared<FJsonValueString>(Keys[2]));
+			Columns[3].Add(MakeShared<FJsonValueNumber>((double)Group.Value));
+		}
+
+		TSharedRef<FJsonObject> ColumnObject = MakeShared<FJsonObject>();
+		for (int32 Column = 0; Column < UE_ARRAY_COUNT(ColumnNames); ++Column)
+		{
+			ColumnObject->SetArrayField(ColumnNames[Column], Columns[Column]);
+		}
+		Root->SetNumberField(TEXT("version"), AggregatesVersion);
+		Root->SetNumberField(TEXT("events"), (double)Aggregates.CompactedEvents);
+		Root->SetObjectField(TEXT("columns"), ColumnObject);
+
+		FString Json;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+		return SaveStringReplacing(Path, Json);
+	}
+
+	// Drops the bytes before Offset
+	static bool DropPrefix(const FString& Path, int64 Offset)
+	{
+		const int64 Size = GetFileSize(Path);
+		if (Offset <= 0 || Size <= 0)
+		{
+			return true;
+		}
+		TArray<uint8> Tail;
+		if (Size > Offset)
+		{
+			TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path));
+			if (!Reader || !ReadRange(*Reader, Offset, Size - Offset, Tail))
+			{
+				return false;
+			}
+		}
+		return SaveFileReplacing(Path, Tail);
+	}
+
+	// Keeps the header line and the newest whole rows within KeepBytes
+	static bool TrimCsvToTail(const FString& Path, int64 KeepBytes)
+	{
+		const int64 Size = GetFileSize(Path);
+		if (Size <= KeepBytes)
+		{
+			return true;
+		}
+		TArray<uint8> Header;
+		TArray<uint8> Tail;
+		{
+			TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path));
+			if (!Reader
+				|| !ReadRange(*Reader, 0, FMath::Min<int64>(Size, 64 * 1024), Header)
+				|| !ReadRange(*Reader, Size - KeepBytes, KeepBytes, Tail))
+			{
+				return false;
+			}
+		}
+		const int32 HeaderEnd = Header.IndexOfByKey('\n');
+		Header.SetNum(HeaderEnd == INDEX_NONE ? 0 : HeaderEnd + 1);
+		const int32 FirstRow = Tail.IndexOfByKey('\n');
+		Tail.RemoveAt(0, FirstRow == INDEX_NONE ? Tail.Num() : FirstRow + 1);
+		Header.Append(Tail);
+		return SaveFileReplacing(Path, Header);
+	}
+
+	static bool IsOverCompactionLimit()
+	{
+		const int64 Limit = MagicOptimizerCVars::GetKnowledgeCompactBytes();
+		if (Limit <= 0)
+		{
+			return false;
+		}
+		const FString Dir = GetKnowledgeDir();
+		if (GetFileSize(Dir / EventsFile) > Limit)
+		{
+			return true;
+		}
+		for (const TCHAR* CsvFile : CsvFiles)
+		{
+			if (GetFileSize(Dir / CsvFile) > Limit)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Caller holds AggregatesLock and saves the aggregates afterwards
+	static bool CompactLocked(FKnowledgeAggregates& Aggregates)
+	{
+		MAGICOPT_STAGE_SCOPE(ReportWrite, MagicOptimizer_CompactKnowledge);
+		bool bCompacted = false;
+		auto Rewrite = [&Aggregates, &bCompacted]()
+		{
+			const FString Dir = GetKnowledgeDir();
+			int64 PendingEvents = 0;
+			for (const TPair<FString, int64>& Group : Aggregates.PendingGroups)
+			{
+				PendingEvents += Group.Value;
+			}
+			Aggregates.CompactedEvents += PendingEvents;
+			if (!AppendCompactedGroups(Aggregates))
+			{
+				Aggregates.CompactedEvents -= PendingEvents;
+				return;
+			}
+			Aggregates.PendingGroups.Reset();
+
+			if (!DropPrefix(Dir / EventsFile, Aggregates.EventsOffset))
+			{
+				return;
+			}
+			Aggregates.EventsOffset = 0;
+
+			const int64 KeepBytes = FMath::Max(MagicOptimizerCVars::GetKnowledgeCompactBytes() / 4, MinCsvKeepBytes);
+			bCompacted = true;
+			for (const TCHAR* CsvFile : CsvFiles)
+			{
+				bCompacted &= TrimCsvToTail(Dir / CsvFile, KeepBytes);
+			}
+		};
+		// Bridge processes append to the raw files directly; none may run, or start, during the rewrite
+		const bool bNoWriters = UPythonBridge::RunWithoutProcesses([&Rewrite]() { WithFilesClosed(Rewrite); });
+		if (!bNoWriters)
+		{
+			UE_LOG(LogMagicOptimizer, Log, TEXT("Knowledge compaction deferred: Python runs are still writing"));
+			return false;
+		}
+		UE_CLOG(!bCompacted, LogMagicOptimizer, Warning, TEXT("Knowledge compaction did not complete; raw files are kept"));
+		return bCompacted;
+	}
+
+	FString FKnowledgeAggregates::ToJsonString() const
+	{
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetNumberField(TEXT("version"), AggregatesVersion);
+		Root->SetNumberField(TEXT("events"), (double)Events);
+		Root->SetNumberField(TEXT("runs"), (double)Runs);
+		Root->SetStringField(TEXT("last_run_id"), LastRunId);
+		Root->SetObjectField(TEXT("by_event_type"), CountsToJson(ByEventType));
+		Root->SetObjectField(TEXT("by_profile"), CountsToJson(ByProfile));
+		Root->SetObjectField(TEXT("by_format"), CountsToJson(ByFormat));
+		Root->SetObjectField(TEXT("by_token"), CountsToJson(ByToken));
+		Root->SetObjectField(TEXT("by_issue"), CountsToJson(ByIssue));
+		Root->SetObjectField(TEXT("by_recommendation"), CountsToJson(ByRecommendation));
+		Root->SetNumberField(TEXT("events_offset"), (double)EventsOffset);
+		Root->SetNumberField(TEXT("compacted_events"), (double)CompactedEvents);
+		Root->SetObjectField(TEXT("pending_groups"), CountsToJson(PendingGroups));
+
+		FString Json;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(Root, Writer);
+		return Json;
+	}
+
+	bool FKnowledgeAggregates::FromJsonString(const FString& Json)
+	{
+		TSharedPtr<FJsonObject> Root;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+		if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+		{
+			return false;
+		}
+		*this = FKnowledgeAggregates();
+		Events = (int64)Root->GetNumberField(TEXT("events"));
+		Runs = (int64)Root->GetNumberField(TEXT("runs"));
+		Root->TryGetStringField(TEXT("last_run_id"), LastRunId);
+		CountsFromJson(*Root, TEXT("by_event_type"), ByEventType);
+		CountsFromJson(*Root, TEXT("by_profile"), ByProfile);
+		CountsFromJson(*Root, TEXT("by_format"), ByFormat);
+		CountsFromJson(*Root, TEXT("by_token"), ByToken);
+		CountsFromJson(*Root, TEXT("by_issue"), ByIssue);
+		CountsFromJson(*Root, TEXT("by_recommendation"), ByRecommendation);
+		EventsOffset = (int64)Root->GetNumberField(TEXT("events_offset"));
+		CompactedEvents = (int64)Root->GetNumberField(TEXT("compacted_events"));
+		CountsFromJson(*Root, TEXT("pending_groups"), PendingGroups);
+		return true;
+	}
+
+	FString GetAggregatesPath()
+	{
+		return GetKnowledgeDir() / TEXT("kb_aggregates.json");
+	}
+
+	FString GetCompactedPath()
+	{
+		return GetKnowledgeDir() / TEXT("kb_compacted.json");
+	}
+
+	FKnowledgeAggregates LoadAggregates()
+	{
+		FKnowledgeAggregates Aggregates;
+		FString Json;
+		if (FFileHelper::LoadFileToString(Json, *GetAggregatesPath()) && !Aggregates.FromJsonString(Json))
+		{
+			UE_LOG(LogMagicOptimizer, Warning, TEXT("Knowledge aggregates at %s are unreadable; rebuilding from the raw events"), *GetAggregatesPath());
+		}
+		return Aggregates;
+	}
+
+	int64 UpdateAggregates()
+	{
+		MAGICOPT_LLM_SCOPE_ROOT();
+		MAGICOPT_STAGE_SCOPE(ReportRead, MagicOptimizer_UpdateKnowledge);
+		FScopeLock Lock(&AggregatesLock);
+
+		// Records still queued in the sink belong to this update
+		Flush();
+
+		FKnowledgeAggregates Aggregates = LoadAggregates();
+		int64 Folded = 0;
+		Aggregates.EventsOffset = FoldNewEvents(GetKnowledgeDir() / EventsFile, Aggregates.EventsOffset, Aggregates, Folded);
+		if (IsOverCompactionLimit())
+		{
+			CompactLocked(Aggregates);
+		}
+		return SaveAggregates(Aggregates) ? Folded : INDEX_NONE;
+	}
+
+	bool Compact()
+	{
+		MAGICOPT_LLM_SCOPE_ROOT();
+		FScopeLock Lock(&AggregatesLock);
+		Flush();
+
+		// Fold first, so only events already counted are dropped
+		FKnowledgeAggregates Aggregates = LoadAggregates();
+		int64 Folded = 0;
+		Aggregates.EventsOffset = FoldNewEvents(GetKnowledgeDir() / EventsFile, Aggregates.EventsOffset, Aggregates, Folded);
+		const bool bCompacted = CompactLocked(Aggregates);
+		return SaveAggregates(Aggregates) && bCompacted;
+	}
+}
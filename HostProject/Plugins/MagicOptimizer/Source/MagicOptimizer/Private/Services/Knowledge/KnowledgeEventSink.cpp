@@ -0,0 +1,117 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  KnowledgeEventSink.cpp
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#include "Services/Knowledge/KnowledgeEventSink.h"
+#include "Services/Logging/AsyncLogWriter.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "MagicOptimizerMemory.h"
+
+namespace MagicOptimizerKnowledge
+{
+	// Order defines the writer target index
+	static const TCHAR* const KnownFiles[] =
+	{
+		TEXT("events.jsonl"),
+		TEXT("kb_textures.csv"),
+		TEXT("kb_texture_recs.csv"),
+	};
+	static constexpr int32 NumKnownFiles = UE_ARRAY_COUNT(KnownFiles);
+
+	// Roughly one audit batch of events per file before producers wait on the writer
+	static constexpr uint32 SinkCapacity = 16384;
+
+	static int32 FindTarget(const FString& FileName)
+	{
+		for (int32 Index = 0; Index < NumKnownFiles; ++Index)
+		{
+			if (FileName.Equals(KnownFiles[Index], ESearchCase::IgnoreCase))
+			{
+				return Index;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	static TArray<FString> GetKnownFilePaths()
+	{
+		TArray<FString> Paths;
+		for (const TCHAR* File : KnownFiles)
+		{
+			Paths.Add(GetKnowledgeDir() / File);
+		}
+		return Paths;
+	}
+
+	// Created on first use; records are written on the writer's own thread through open handles
+	static FAsyncLogWriter& GetWriter()
+	{
+		static FAsyncLogWriter Writer(GetKnownFilePaths(), SinkCapacity, /*bInTimestampLines*/ false);
+		return Writer;
+	}
+
+	// Headers are decided once per file per process, before the first record is queued
+	static FCriticalSection HeaderLock;
+	static bool HeaderChecked[NumKnownFiles] = {};
+
+	FString GetKnowledgeDir()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("MagicOptimizer/Knowledge");
+	}
+
+	bool IsKnownFile(const FString& FileName)
+	{
+		return FindTarget(FileName) != INDEX_NONE;
+	}
+
+	bool AppendLines(const FString& FileName, const TArray<FString>& Lines, const FString& Header)
+	{
+		MAGICOPT_LLM_SCOPE_ROOT();
+		const int32 Target = FindTarget(FileName);
+		if (Target == INDEX_NONE)
+		{
+			return false;
+		}
+
+		FAsyncLogWriter& Writer = GetWriter();
+		// Knowledge files are append-only history; they are never rotated
+		Writer.SetMaxFileBytes(0);
+		if (!Header.IsEmpty())
+		{
+			FScopeLock Lock(&HeaderLock);
+			if (!HeaderChecked[Target])
+			{
+				HeaderChecked[Target] = true;
+				if (IFileManager::Get().FileSize(*(GetKnowledgeDir() / KnownFiles[Target])) <= 0)
+				{
+					Writer.Enqueue(Target, Header);
+				}
+			}
+		}
+		for (const FString& Line : Lines)
+		{
+			Writer.Enqueue(Target, Line);
+		}
+		return true;
+	}
+
+	void Flush()
+	{
+		GetWriter().Flush();
+	}
+
+	void WithFilesClosed(TFunctionRef<void()> Fn)
+	{
+		GetWriter().WithFilesClosed(Fn);
+	}
+
+	void Shutdown()
+	{
+		GetWriter().Shutdown();
+	}
+}
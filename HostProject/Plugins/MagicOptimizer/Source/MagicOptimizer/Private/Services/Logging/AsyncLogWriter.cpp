@@ -0,0 +1,291 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  AsyncLogWriter.cpp
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#include "Services/Logging/AsyncLogWriter.h"
+#include "MagicOptimizerStats.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "MagicOptimizerMemory.h"
+
+namespace
+{
+	static FString GetRotatedPath(const FString& Path, int32 Index)
+	{
+		return FPaths::GetPath(Path) / FString::Printf(TEXT("%s.%d%s"), *FPaths::GetBaseFilename(Path), Index, *FPaths::GetExtension(Path, /*bIncludeDot*/ true));
+	}
+}
+
+FAsyncLogWriter::FAsyncLogWriter(TArray<FString> InFilePaths, uint32 InCapacity, bool bInTimestampLines)
+	: bTimestampLines(bInTimestampLines)
+{
+	const uint32 Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max(2u, InCapacity));
+	Slots = MakeUnique<FSlot[]>(Capacity);
+	for (uint32 Index = 0; Index < Capacity; ++Index)
+	{
+		Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+	}
+	Mask = Capacity - 1;
+
+	for (FString& Path : InFilePaths)
+	{
+		Targets.AddDefaulted_GetRef().Path = MoveTemp(Path);
+	}
+
+	SystemErrorHandle = FCoreDelegates::OnHandleSystemError.AddRaw(this, &FAsyncLogWriter::HandleSystemError);
+	if (FPlatformProcess::SupportsMultithreading())
+	{
+		WakeEvent = FPlatformProcess::GetSynchEventFromPool(/*bIsManualReset*/ false);
+		Thread = FRunnableThread::Create(this, TEXT("MagicOptimizerLogWriter"), 0, TPri_BelowNormal);
+	}
+}
+
+FAsyncLogWriter::~FAsyncLogWriter()
+{
+	Shutdown();
+	if (WakeEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	}
+}
+
+void FAsyncLogWriter::Enqueue(int32 Target, FString Line)
+{
+	MAGICOPT_LLM_SCOPE_ROOT();
+	if (!Targets.IsValidIndex(Target))
+	{
+		return;
+	}
+	const int64 Ticks = FDateTime::Now().GetTicks();
+	while (!TryEnqueue(Target, Ticks, Line))
+	{
+		// Full: wait for the writer, or drain here when there is no writer thread
+		if (WakeEvent && !bStopping.load(std::memory_order_relaxed))
+		{
+			WakeEvent->Trigger();
+			FPlatformProcess::Yield();
+		}
+		else
+		{
+			FScopeLock Lock(&DrainLock);
+			DrainLocked();
+		}
+	}
+
+	if (!WakeEvent || bStopping.load(std::memory_order_relaxed))
+	{
+		FScopeLock Lock(&DrainLock);
+		DrainLocked();
+	}
+}
+
+bool FAsyncLogWriter::TryEnqueue(int32 Target, int64 Ticks, FString& Line)
+{
+	// Bounded MPMC ring (Vyukov): a slot is free for position P when its sequence equals P, and
+	// holds a published line when it equals P + 1
+	uint64 Pos = EnqueuePos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		FSlot& Slot = Slots[Pos & Mask];
+		const uint64 Sequence = Slot.Sequence.load(std::memory_order_acquire);
+		const int64 Diff = (int64)Sequence - (int64)Pos;
+		if (Diff == 0)
+		{
+			if (EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+			{
+				Slot.Target = Target;
+				Slot.Ticks = Ticks;
+				Slot.Text = MoveTemp(Line);
+				Slot.Sequence.store(Pos + 1, std::memory_order_release);
+
+				// Wake the writer early every half ring of lines, so bursts do not fill it
+				if (WakeEvent && (Pos & (Mask >> 1)) == 0)
+				{
+					WakeEvent->Trigger();
+				}
+				return true;
+			}
+		}
+		else if (Diff < 0)
+		{
+			return false;
+		}
+		else
+		{
+			Pos = EnqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+void FAsyncLogWriter::Flush()
+{
+	const uint64 Target = EnqueuePos.load(std::memory_order_acquire);
+	for (;;)
+	{
+		{
+			FScopeLock Lock(&DrainLock);
+			DrainLocked();
+			if (DequeuePos >= Target)
+			{
+				return;
+			}
+		}
+		// A producer has claimed a slot but not published it yet
+		FPlatformProcess::Yield();
+	}
+}
+
+void FAsyncLogWriter::Shutdown()
+{
+	// Lines queued from now on are written by their producer
+	bStopping.store(true, std::memory_order_relaxed);
+	if (Thread)
+	{
+		WakeEvent->Trigger();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+	if (SystemErrorHandle.IsValid())
+	{
+		FCoreDelegates::OnHandleSystemError.Remove(SystemErrorHandle);
+		SystemErrorHandle.Reset();
+	}
+	Flush();
+
+	FScopeLock Lock(&DrainLock);
+	for (FTargetFile& File : Targets)
+	{
+		File.Writer.Reset();
+	}
+}
+
+void FAsyncLogWriter::WithFilesClosed(TFunctionRef<void()> Fn)
+{
+	Flush();
+	FScopeLock Lock(&DrainLock);
+	DrainLocked();
+	for (FTargetFile& File : Targets)
+	{
+		File.Writer.Reset();
+	}
+	Fn();
+}
+
+uint32 FAsyncLogWriter::Run()
+{
+	MAGICOPT_LLM_SCOPE_ROOT();
+	while (!bStopping.load(std::memory_order_relaxed))
+	{
+		WakeEvent->Wait(FlushIntervalMs);
+		FScopeLock Lock(&DrainLock);
+		DrainLocked();
+	}
+	FScopeLock Lock(&DrainLock);
+	DrainLocked();
+	return 0;
+}
+
+void FAsyncLogWriter::Stop()
+{
+	bStopping.store(true, std::memory_order_relaxed);
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+void FAsyncLogWriter::DrainLocked()
+{
+	for (;;)
+	{
+		FSlot& Slot = Slots[DequeuePos & Mask];
+		if (Slot.Sequence.load(std::memory_order_acquire) != DequeuePos + 1)
+		{
+			break;
+		}
+
+		TArray<ANSICHAR>& Pending = Targets[Slot.Target].Pending;
+		if (bTimestampLines)
+		{
+			const FString Stamped = FString::Printf(TEXT("[%s] %s\n"), *FDateTime(Slot.Ticks).ToString(TEXT("%Y-%m-%d %H:%M:%S")), *Slot.Text);
+			const FTCHARToUTF8 Utf8(*Stamped);
+			Pending.Append(Utf8.Get(), Utf8.Length());
+		}
+		else
+		{
+			const FTCHARToUTF8 Utf8(*Slot.Text);
+			Pending.Append(Utf8.Get(), Utf8.Length());
+			Pending.Add('\n');
+		}
+
+		Slot.Text.Empty();
+		Slot.Sequence.store(DequeuePos + Mask + 1, std::memory_order_release);
+		++DequeuePos;
+	}
+
+	for (FTargetFile& File : Targets)
+	{
+		if (File.Pending.Num() > 0)
+		{
+			WriteTarget(File);
+		}
+	}
+}
+
+void FAsyncLogWriter::WriteTarget(FTargetFile& File)
+{
+	MAGICOPT_STAGE_SCOPE(LogWrite, MagicOptimizer_WriteLog);
+	MAGICOPT_STAT_ASSET(LogWrite, File.Path, File.Pending.Num());
+	if (!File.Writer)
+	{
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(File.Path), /*Tree*/ true);
+		File.Writer.Reset(IFileManager::Get().CreateFileWriter(*File.Path, FILEWRITE_Append | FILEWRITE_AllowRead));
+	}
+	const int64 MaxBytes = MaxFileBytes.load(std::memory_order_relaxed);
+	if (File.Writer && MaxBytes > 0 && File.Writer->TotalSize() > 0 && File.Writer->TotalSize() + File.Pending.Num() > MaxBytes)
+	{
+		RotateTarget(File);
+	}
+	if (File.Writer)
+	{
+		File.Writer->Serialize(File.Pending.GetData(), File.Pending.Num());
+		File.Writer->Flush();
+	}
+	File.Pending.Reset();
+}
+
+void FAsyncLogWriter::RotateTarget(FTargetFile& File)
+{
+	File.Writer.Reset();
+	IFileManager& FileManager = IFileManager::Get();
+	FileManager.Delete(*GetRotatedPath(File.Path, MaxRotatedFiles), /*RequireExists*/ false, /*EvenReadOnly*/ true, /*Quiet*/ true);
+	for (int32 Index = MaxRotatedFiles - 1; Index >= 1; --Index)
+	{
+		const FString From = GetRotatedPath(File.Path, Index);
+		if (FileManager.FileExists(*From))
+		{
+			FileManager.Move(*GetRotatedPath(File.Path, Index + 1), *From, /*Replace*/ true, /*EvenIfReadOnly*/ true);
+		}
+	}
+	FileManager.Move(*GetRotatedPath(File.Path, 1), *File.Path, /*Replace*/ true, /*EvenIfReadOnly*/ true);
+	File.Writer.Reset(FileManager.CreateFileWriter(*File.Path, FILEWRITE_Append | FILEWRITE_AllowRead));
+}
+
+void FAsyncLogWriter::HandleSystemError()
+{
+	// The writer may be the thread that crashed; never wait on it here
+	if (DrainLock.TryLock())
+	{
+		DrainLocked();
+		DrainLock.Unlock();
+	}
+}
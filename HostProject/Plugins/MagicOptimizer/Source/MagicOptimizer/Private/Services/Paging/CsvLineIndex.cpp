@@ -0,0 +1,139 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  CsvLineIndex.cpp
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#include "Services/Paging/CsvLineIndex.h"
+#include "MagicOptimizerStats.h"
+#include "HAL/FileManager.h"
+#include "Templates/UniquePtr.h"
+#include "MagicOptimizerMemory.h"
+
+namespace
+{
+	static constexpr int64 ScanChunkBytes = 1024 * 1024;
+
+	static bool IsLineSpace(uint8 Byte)
+	{
+		return Byte == ' ' || Byte == '\t' || Byte == '\r';
+	}
+
+	static FString DecodeLine(const uint8* Bytes, int64 Num)
+	{
+		// Strip the line ending and any blank lines the range picked up after it
+		while (Num > 0 && (Bytes[Num - 1] == '\n' || IsLineSpace(Bytes[Num - 1])))
+		{
+			--Num;
+		}
+		const FUTF8ToTCHAR Converted((const ANSICHAR*)Bytes, (int32)Num);
+		return FString(Converted.Length(), Converted.Get());
+	}
+}
+
+bool FCsvLineIndex::Build(const FString& InPath, const TCHAR* HeaderPrefix)
+{
+	MAGICOPT_LLM_SCOPE(AuditStore);
+	MAGICOPT_STAGE_SCOPE(CsvRead, MagicOptimizer_IndexCsv);
+	Path = InPath;
+	Header.Reset();
+	LineStarts.Reset();
+	FileSize = 0;
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path));
+	if (!Reader)
+	{
+		return false;
+	}
+	FileSize = Reader->TotalSize();
+
+	TArray<uint8> Chunk;
+	int64 LineStart = 0;
+	bool bLineHasContent = false;
+	for (int64 Offset = 0; Offset < FileSize; Offset += Chunk.Num())
+	{
+		Chunk.SetNumUninitialized((int32)FMath::Min(ScanChunkBytes, FileSize - Offset));
+		Reader->Serialize(Chunk.GetData(), Chunk.Num());
+		if (Reader->IsError())
+		{
+			LineStarts.Reset();
+			return false;
+		}
+		for (int32 Index = 0; Index < Chunk.Num(); ++Index)
+		{
+			const uint8 Byte = Chunk[Index];
+			if (Byte == '\n')
+			{
+				if (bLineHasContent)
+				{
+					LineStarts.Add(LineStart);
+				}
+				LineStart = Offset + Index + 1;
+				bLineHasContent = false;
+			}
+			else if (!IsLineSpace(Byte))
+			{
+				bLineHasContent = true;
+			}
+		}
+	}
+	if (bLineHasContent)
+	{
+		LineStarts.Add(LineStart);
+	}
+	LineStarts.Shrink();
+	MAGICOPT_STAT_ASSET(CsvRead, Path, FileSize);
+
+	if (HeaderPrefix && LineStarts.Num() > 0)
+	{
+		TArray<FString> First;
+		ReadLines(0, 1, First);
+		FString Trimmed = First[0].TrimStart();
+		// Skip a UTF-8 byte order mark
+		Trimmed.RemoveFromStart(TEXT("\xFEFF"));
+		if (Trimmed.StartsWith(HeaderPrefix, ESearchCase::IgnoreCase))
+		{
+			Header = MoveTemp(First[0]);
+			LineStarts.RemoveAt(0);
+		}
+	}
+	return true;
+}
+
+void FCsvLineIndex::ReadLines(int32 Start, int32 Count, TArray<FString>& OutLines) const
+{
+	MAGICOPT_LLM_SCOPE(AuditStore);
+	Start = FMath::Max(0, Start);
+	const int32 End = FMath::Min(LineStarts.Num(), Start + Count);
+	if (Start >= End)
+	{
+		return;
+	}
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path));
+	if (!Reader)
+	{
+		return;
+	}
+
+	// The whole range is contiguous in the file, so it is one read
+	const int64 RangeStart = LineStarts[Start];
+	const int64 RangeEnd = End < LineStarts.Num() ? LineStarts[End] : FileSize;
+	TArray<uint8> Bytes;
+	Bytes.SetNumUninitialized((int32)(RangeEnd - RangeStart));
+	Reader->Seek(RangeStart);
+	Reader->Serialize(Bytes.GetData(), Bytes.Num());
+	if (Reader->IsError())
+	{
+		return;
+	}
+	MAGICOPT_STAT_ASSET(CsvRead, Path, Bytes.Num());
+
+	OutLines.Reserve(OutLines.Num() + End - Start);
+	for (int32 Line = Start; Line < End; ++Line)
+	{
+		const int64 LineEnd = Line + 1 < LineStarts.Num() ? LineStarts[Line + 1] : FileSize;
+		OutLines.Add(DecodeLine(Bytes.GetData() + (LineStarts[Line] - RangeStart), LineEnd - LineStarts[Line]));
+	}
+}
@@ -0,0 +1,186 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  OptimizationPipeline.cpp
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#include "Services/Pipeline/OptimizationPipeline.h"
+#include "OptimizerSettings.h"
+#include "MagicOptimizerLogging.h"
+#include "MagicOptimizerMemory.h"
+#include "MagicOptimizerStats.h"
+#include "HAL/PlatformTime.h"
+#include "Tasks/Pipe.h"
+
+namespace MagicOptimizerPipeline
+{
+	namespace
+	{
+		struct FPassState
+		{
+			FRunNode RunNode;
+			FOptimizerCancellationTokenPtr CancelToken;
+			// Outlives its tasks: the final task holds the state and only runs once every chain, Apply
+			// nodes included, has completed
+			UE::Tasks::FPipe ApplyPipe{ TEXT("MagicOptimizer.Apply") };
+			// One entry per category, each written only by that category's chain
+			TArray<FCategoryResult> Results;
+			uint64 StartCycles = 0;
+		};
+
+		using FPassStateRef = TSharedRef<FPassState, ESPMode::ThreadSafe>;
+
+		void ExecuteNode(FPassState& State, int32 CategoryIndex, EPhase Phase)
+		{
+			MAGICOPT_LLM_SCOPE_ROOT();
+			FCategoryResult& Result = State.Results[CategoryIndex];
+			if (!Result.bSuccess)
+			{
+				return;
+			}
+			if (State.CancelToken.IsValid() && State.CancelToken->IsCancelled())
+			{
+				Result.bSuccess = false;
+				Result.bCancelled = true;
+				Result.LastPhase = Phase;
+				return;
+			}
+
+			MAGICOPT_TRACE_SCOPE(MagicOptimizer_PipelineNode);
+			MagicOptimizerStats::FPhaseScope PhaseScope(FString::Printf(TEXT("%s %s"), *Result.Category, GetPhaseName(Phase)));
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			const FNodeResult NodeResult = State.RunNode(Phase, Result.Category);
+			Result.Seconds += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+			Result.LastPhase = Phase;
+			Result.Message = NodeResult.Message;
+			if (NodeResult.bCancelled)
+			{
+				Result.bSuccess = false;
+				Result.bCancelled = true;
+			}
+			else if (!NodeResult.bSuccess)
+			{
+				Result.bSuccess = false;
+				UE_LOG(LogMagicOptimizer, Warning, TEXT("Pipeline: %s %s failed, skipping its later phases: %s"),
+					*Result.Category, GetPhaseName(Phase), *NodeResult.Message);
+			}
+		}
+	}
+
+	const TCHAR* GetPhaseName(EPhase Phase)
+	{
+		switch (Phase)
+		{
+		case EPhase::Audit: return TEXT("audit");
+		case EPhase::Recommend: return TEXT("recommend");
+		case EPhase::Apply: return TEXT("apply");
+		case EPhase::Verify: return TEXT("verify");
+		}
+		return TEXT("unknown");
+	}
+
+	TArray<FString> GetCategories(uint8 CategoryMask)
+	{
+		TArray<FString> Categories;
+		if (CategoryMask & (uint8)EOptimizerCategory::Textures)
+		{
+			Categories.Add(TEXT("Textures"));
+		}
+		if (CategoryMask & (uint8)EOptimizerCategory::Meshes)
+		{
+			Categories.Add(TEXT("Meshes"));
+		}
+		if (CategoryMask & (uint8)EOptimizerCategory::Materials)
+		{
+			Categories.Add(TEXT("Materials"));
+		}
+		if (CategoryMask & (uint8)EOptimizerCategory::Audio)
+		{
+			Categories.Add(TEXT("Audio"));
+		}
+		return Categories;
+	}
+
+	bool FPassResult::IsSuccess() const
+	{
+		for (const FCategoryResult& Category : Categories)
+		{
+			if (!Category.bSuccess)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool FPassResult::WasCancelled() const
+	{
+		for (const FCategoryResult& Category : Categories)
+		{
+			if (Category.bCancelled)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	FString FPassResult::GetSummary() const
+	{
+		TArray<FString> Parts;
+		for (const FCategoryResult& Category : Categories)
+		{
+			if (Category.bCancelled)
+			{
+				Parts.Add(FString::Printf(TEXT("%s cancelled in %s"), *Category.Category, GetPhaseName(Category.LastPhase)));
+				continue;
+			}
+			Parts.Add(Category.bSuccess
+				? FString::Printf(TEXT("%s ok (%.1fs)"), *Category.Category, Category.Seconds)
+				: FString::Printf(TEXT("%s failed in %s (%s)"), *Category.Category, GetPhaseName(Category.LastPhase), *Category.Message));
+		}
+		return FString::Printf(TEXT("%s in %.1fs"), Parts.Num() ? *FString::Join(Parts, TEXT(", ")) : TEXT("nothing to run"), WallSeconds);
+	}
+
+	UE::Tasks::TTask<FPassResult> LaunchPass(FPassDesc Desc)
+	{
+		FPassStateRef State = MakeShared<FPassState, ESPMode::ThreadSafe>();
+		State->RunNode = MoveTemp(Desc.RunNode);
+		State->CancelToken = MoveTemp(Desc.CancelToken);
+		State->StartCycles = FPlatformTime::Cycles64();
+		for (const FString& Category : Desc.Categories)
+		{
+			FCategoryResult& Result = State->Results.AddDefaulted_GetRef();
+			Result.Category = Category;
+		}
+
+		TArray<UE::Tasks::FTask> Chains;
+		for (int32 CategoryIndex = 0; CategoryIndex < State->Results.Num(); ++CategoryIndex)
+		{
+			TArray<UE::Tasks::FTask> Previous;
+			for (int32 PhaseIndex = 0; PhaseIndex <= (int32)Desc.LastPhase; ++PhaseIndex)
+			{
+				const EPhase Phase = (EPhase)PhaseIndex;
+				auto Body = [State, CategoryIndex, Phase]()
+				{
+					ExecuteNode(*State, CategoryIndex, Phase);
+				};
+
+				UE::Tasks::FTask Node = Phase == EPhase::Apply
+					? State->ApplyPipe.Launch(TEXT("MagicOptimizer.Apply"), MoveTemp(Body), Previous)
+					: UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(Body), Previous);
+				Previous = { Node };
+			}
+			Chains.Append(Previous);
+		}
+
+		return UE::Tasks::Launch(UE_SOURCE_LOCATION, [State]()
+		{
+			FPassResult Pass;
+			Pass.Categories = State->Results;
+			Pass.WallSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - State->StartCycles);
+			return Pass;
+		}, Chains);
+	}
+}
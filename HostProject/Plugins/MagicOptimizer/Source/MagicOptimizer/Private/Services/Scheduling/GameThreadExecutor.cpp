@@ -0,0 +1,209 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  GameThreadExecutor.cpp
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#include "Services/Scheduling/GameThreadExecutor.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformTime.h"
+#include "MagicOptimizerCVars.h"
+#include "MagicOptimizerLogging.h"
+#include "MagicOptimizerMemory.h"
+#include "MagicOptimizerTrace.h"
+#include "Services/Scheduling/MemoryGovernor.h"
+
+namespace MagicOptimizerGameThread
+{
+	struct FJob
+	{
+		uint32 Id = 0;
+		FString Name;
+		TArray<FWorkItem> Items;
+		int32 NextItem = 0;
+		FOnJobDone OnDone;
+		FOptimizerCancellationTokenPtr CancelToken;
+
+		bool IsCancelled() const
+		{
+			return CancelToken.IsValid() && CancelToken->IsCancelled();
+		}
+	};
+
+	// Front job runs first
+	static TArray<FJob> Jobs;
+	static uint32 NextJobId = 1;
+	static FTSTicker::FDelegateHandle TickHandle;
+	static FInteractionProbe InteractionProbe;
+
+	static int32 FindJob(uint32 JobId)
+	{
+		return Jobs.IndexOfByPredicate([JobId](const FJob& Job) { return Job.Id == JobId; });
+	}
+
+	// Removes the job before its callback, which may queue or cancel other jobs
+	static void FinishJob(int32 JobIndex, bool bCompleted)
+	{
+		FJob Job = MoveTemp(Jobs[JobIndex]);
+		Jobs.RemoveAt(JobIndex);
+		if (!bCompleted)
+		{
+			UE_LOG(LogMagicOptimizer, Log, TEXT("%s cancelled after %d of %d items"), *Job.Name, Job.NextItem, Job.Items.Num());
+		}
+		if (Job.OnDone)
+		{
+			Job.OnDone(bCompleted);
+		}
+	}
+
+	// Runs the front job's next item; false once nothing is queued
+	static bool RunNextItem()
+	{
+		while (Jobs.Num() > 0 && (Jobs[0].NextItem >= Jobs[0].Items.Num() || Jobs[0].IsCancelled()))
+		{
+			FinishJob(0, !Jobs[0].IsCancelled());
+		}
+		if (Jobs.Num() == 0)
+		{
+			return false;
+		}
+
+		const uint32 JobId = Jobs[0].Id;
+		// Moved out, as the item may queue jobs and grow the array under it
+		FWorkItem Item = MoveTemp(Jobs[0].Items[Jobs[0].NextItem]);
+		++Jobs[0].NextItem;
+		Item();
+		// Items load assets; the ones no longer needed are unloaded once memory gets tight
+		MagicOptimizerMemoryGovernor::Update();
+
+		const int32 JobIndex = FindJob(JobId);
+		if (JobIndex != INDEX_NONE && Jobs[JobIndex].NextItem >= Jobs[JobIndex].Items.Num())
+		{
+			FinishJob(JobIndex, true);
+		}
+		return true;
+	}
+
+	static bool Tick(float DeltaTime)
+	{
+		MAGICOPT_LLM_SCOPE_ROOT();
+		MAGICOPT_TRACE_SCOPE(MagicOptimizer_GameThreadSlice);
+		const double EndTime = FPlatformTime::Seconds() + GetBudgetSeconds();
+		do
+		{
+			if (!RunNextItem())
+			{
+				break;
+			}
+		}
+		while (FPlatformTime::Seconds() < EndTime);
+
+		if (Jobs.Num() == 0)
+		{
+			TickHandle.Reset();
+			return false;
+		}
+		return true;
+	}
+
+	static void EnsureTicking()
+	{
+		if (!TickHandle.IsValid())
+		{
+			TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&Tick));
+		}
+	}
+
+	uint32 Enqueue(const FString& Name, TArray<FWorkItem> Items, FOnJobDone OnDone, const FOptimizerCancellationTokenPtr& CancelToken)
+	{
+		check(IsInGameThread());
+		FJob& Job = Jobs.AddDefaulted_GetRef();
+		Job.Id = NextJobId++;
+		if (NextJobId == 0)
+		{
+			NextJobId = 1;
+		}
+		Job.Name = Name;
+		Job.Items = MoveTemp(Items);
+		Job.OnDone = MoveTemp(OnDone);
+		Job.CancelToken = CancelToken;
+		EnsureTicking();
+		return Job.Id;
+	}
+
+	void Cancel(uint32 JobId)
+	{
+		check(IsInGameThread());
+		const int32 JobIndex = FindJob(JobId);
+		if (JobIndex != INDEX_NONE)
+		{
+			FinishJob(JobIndex, false);
+		}
+	}
+
+	void Flush(uint32 JobId)
+	{
+		check(IsInGameThread());
+		MAGICOPT_LLM_SCOPE_ROOT();
+		while ((JobId == 0 || FindJob(JobId) != INDEX_NONE) && RunNextItem())
+		{
+		}
+	}
+
+	bool IsQueued(uint32 JobId)
+	{
+		return FindJob(JobId) != INDEX_NONE;
+	}
+
+	bool GetProgress(uint32 JobId, int32& OutDone, int32& OutTotal)
+	{
+		const int32 JobIndex = FindJob(JobId);
+		if (JobIndex == INDEX_NONE)
+		{
+			return false;
+		}
+		OutDone = Jobs[JobIndex].NextItem;
+		OutTotal = Jobs[JobIndex].Items.Num();
+		return true;
+	}
+
+	int32 GetNumQueuedItems()
+	{
+		int32 Count = 0;
+		for (const FJob& Job : Jobs)
+		{
+			Count += Job.Items.Num() - Job.NextItem;
+		}
+		return Count;
+	}
+
+	void SetInteractionProbe(FInteractionProbe Probe)
+	{
+		InteractionProbe = MoveTemp(Probe);
+	}
+
+	bool IsUserInteracting()
+	{
+		return InteractionProbe && InteractionProbe() < InteractionWindowSeconds;
+	}
+
+	double GetBudgetSeconds()
+	{
+		return MagicOptimizerCVars::GetGameThreadBudgetSeconds(IsUserInteracting());
+	}
+
+	void Shutdown()
+	{
+		while (Jobs.Num() > 0)
+		{
+			FinishJob(Jobs.Num() - 1, false);
+		}
+		if (TickHandle.IsValid())
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+			TickHandle.Reset();
+		}
+		InteractionProbe.Reset();
+	}
+}
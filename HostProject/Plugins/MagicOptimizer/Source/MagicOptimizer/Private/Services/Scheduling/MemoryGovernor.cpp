@@ -0,0 +1,153 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  MemoryGovernor.cpp
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#include "Services/Scheduling/MemoryGovernor.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "MagicOptimizerCVars.h"
+#include "MagicOptimizerLogging.h"
+#include "MagicOptimizerMemory.h"
+#include "MagicOptimizerTrace.h"
+#include "UObject/Package.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+
+namespace MagicOptimizerMemoryGovernor
+{
+	// Memory stats cost a system call; items are often much shorter than this
+	static constexpr double SampleIntervalSeconds = 0.05;
+	// Over the ceiling with fewer packages than this to unload, a collection would free too little to repeat
+	static constexpr int32 MinPackagesPerReclaim = 64;
+
+	static TSet<TWeakObjectPtr<UPackage>> TrackedPackages;
+	static double LastSampleTime = 0.0;
+	static int64 LastUsedPhysical = 0;
+	static int32 NumReclaims = 0;
+	static int32 NumUnloadedPackages = 0;
+
+	static int64 GetCeilingBytes()
+	{
+		const int64 Configured = MagicOptimizerCVars::GetMemoryCeilingBytes();
+		return Configured > 0 ? Configured : (int64)(FPlatformMemory::GetConstants().TotalPhysical / 2);
+	}
+
+	static void Sample()
+	{
+		LastUsedPhysical = (int64)FPlatformMemory::GetStats().UsedPhysical;
+		LastSampleTime = FPlatformTime::Seconds();
+	}
+
+	UObject* LoadAsset(const FSoftObjectPath& Path)
+	{
+		check(IsInGameThread());
+		if (UObject* Resident = Path.ResolveObject())
+		{
+			return Resident;
+		}
+		UObject* Loaded = Path.TryLoad();
+		if (Loaded)
+		{
+			TrackedPackages.Add(Loaded->GetPackage());
+		}
+		return Loaded;
+	}
+
+	void Update()
+	{
+		check(IsInGameThread());
+		if (FPlatformTime::Seconds() - LastSampleTime >= SampleIntervalSeconds)
+		{
+			Sample();
+		}
+		const int32 MaxPackages = MagicOptimizerCVars::GetMaxLoadedPackages();
+		const bool bOverPackages = MaxPackages > 0 && TrackedPackages.Num() >= MaxPackages;
+		const bool bOverCeiling = GetPressure() >= 1.0 && TrackedPackages.Num() >= MinPackagesPerReclaim;
+		if ((bOverPackages || bOverCeiling) && !IsGarbageCollecting())
+		{
+			Reclaim();
+		}
+	}
+
+	int32 Reclaim()
+	{
+		check(IsInGameThread());
+		MAGICOPT_LLM_SCOPE_ROOT();
+		MAGICOPT_TRACE_SCOPE(MagicOptimizer_MemoryReclaim);
+		const double StartTime = FPlatformTime::Seconds();
+		Sample();
+		const int64 UsedBefore = LastUsedPhysical;
+
+		// Dirty packages hold edits not saved yet; they stay tracked for a later pass
+		int32 NumUnloaded = 0;
+		TSet<TWeakObjectPtr<UPackage>> Kept;
+		for (const TWeakObjectPtr<UPackage>& WeakPackage : TrackedPackages)
+		{
+			UPackage* Package = WeakPackage.Get();
+			if (!Package)
+			{
+				continue;
+			}
+			if (Package->IsDirty())
+			{
+				Kept.Add(WeakPackage);
+				continue;
+			}
+			// The collection destroys the package with its objects, and its linker with it; resetting loaders
+			// here would also detach packages that turn out to be referenced and stay loaded
+			ForEachObjectWithPackage(Package, [](UObject* Object)
+			{
+				Object->ClearFlags(RF_Standalone);
+				return true;
+			}, false);
+			++NumUnloaded;
+		}
+		TrackedPackages = MoveTemp(Kept);
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		Sample();
+		++NumReclaims;
+		NumUnloadedPackages += NumUnloaded;
+		UE_LOG(LogMagicOptimizer, Log, TEXT("Memory governor unloaded %d packages: working set %lld -> %lld MB (ceiling %lld MB) in %.0f ms"),
+			NumUnloaded, UsedBefore / (1024 * 1024), LastUsedPhysical / (1024 * 1024), GetCeilingBytes() / (1024 * 1024),
+			(FPlatformTime::Seconds() - StartTime) * 1000.0);
+		return NumUnloaded;
+	}
+
+	double GetPressure()
+	{
+		const int64 Ceiling = GetCeilingBytes();
+		return Ceiling > 0 ? (double)LastUsedPhysical / (double)Ceiling : 0.0;
+	}
+
+	int32 ThrottleWindow(int32 MaxWindow)
+	{
+		const double Pressure = GetPressure();
+		if (Pressure <= SoftLimitFraction || MaxWindow <= 1)
+		{
+			return MaxWindow;
+		}
+		const double Scale = 1.0 - FMath::Min(1.0, (Pressure - SoftLimitFraction) / (1.0 - SoftLimitFraction));
+		return FMath::Max(1, FMath::FloorToInt32(MaxWindow * Scale));
+	}
+
+	FStatus GetStatus()
+	{
+		FStatus Status;
+		Status.UsedPhysicalBytes = LastUsedPhysical > 0 ? LastUsedPhysical : (int64)FPlatformMemory::GetStats().UsedPhysical;
+		Status.CeilingBytes = GetCeilingBytes();
+		Status.NumTrackedPackages = TrackedPackages.Num();
+		Status.NumReclaims = NumReclaims;
+		Status.NumUnloadedPackages = NumUnloadedPackages;
+		return Status;
+	}
+
+	void Shutdown()
+	{
+		TrackedPackages.Reset();
+	}
+}
@@ -0,0 +1,138 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  AssetQuery.cpp
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#include "Services/Search/AssetQuery.h"
+#include "MagicOptimizerMemory.h"
+
+namespace
+{
+	// Splits on whitespace outside double quotes; quotes are kept for the term parser to strip
+	static void Tokenize(const FString& Query, TArray<FString>& OutTokens)
+	{
+		FString Current;
+		bool bInQuotes = false;
+		for (const TCHAR Char : Query)
+		{
+			if (Char == TEXT('"'))
+			{
+				bInQuotes = !bInQuotes;
+				Current.AppendChar(Char);
+			}
+			else if (!bInQuotes && FChar::IsWhitespace(Char))
+			{
+				if (!Current.IsEmpty())
+				{
+					OutTokens.Add(MoveTemp(Current));
+					Current.Reset();
+				}
+			}
+			else
+			{
+				Current.AppendChar(Char);
+			}
+		}
+		if (!Current.IsEmpty())
+		{
+			OutTokens.Add(MoveTemp(Current));
+		}
+	}
+
+	static FString Unquote(const FString& In)
+	{
+		return In.Replace(TEXT("\""), TEXT(""));
+	}
+}
+
+namespace AssetQuery
+{
+	bool Parse(const FString& Query, TArray<FAssetQueryTerm>& OutTerms, FString& OutError)
+	{
+		MAGICOPT_LLM_SCOPE(AuditStore);
+		OutTerms.Reset();
+		OutError.Reset();
+
+		TArray<FString> Tokens;
+		Tokenize(Query, Tokens);
+
+		for (const FString& Token : Tokens)
+		{
+			FAssetQueryTerm Term;
+			FString Body = Token;
+			if (Body.Len() > 1 && Body[0] == TEXT('-'))
+			{
+				Term.bNegated = true;
+				Body.RightChopInline(1);
+			}
+
+			// Operator is the first of : = < > outside quotes
+			int32 OpIndex = INDEX_NONE;
+			bool bInQuotes = false;
+			for (int32 CharIndex = 0; CharIndex < Body.Len(); ++CharIndex)
+			{
+				const TCHAR Char = Body[CharIndex];
+				if (Char == TEXT('"'))
+				{
+					bInQuotes = !bInQuotes;
+				}
+				else if (!bInQuotes && (Char == TEXT(':') || Char == TEXT('=') || Char == TEXT('<') || Char == TEXT('>')))
+				{
+					OpIndex = CharIndex;
+					break;
+				}
+			}
+
+			if (OpIndex == INDEX_NONE)
+			{
+				Term.Value = Unquote(Body).ToLower();
+				if (!Term.Value.IsEmpty())
+				{
+					OutTerms.Add(MoveTemp(Term));
+				}
+				continue;
+			}
+
+			int32 OpLen = 1;
+			switch (Body[OpIndex])
+			{
+			case TEXT(':'):
+				Term.Op = EAssetQueryOp::Contains;
+				break;
+			case TEXT('='):
+				Term.Op = EAssetQueryOp::Equal;
+				break;
+			case TEXT('<'):
+			case TEXT('>'):
+			{
+				const bool bOrEqual = OpIndex + 1 < Body.Len() && Body[OpIndex + 1] == TEXT('=');
+				OpLen = bOrEqual ? 2 : 1;
+				if (Body[OpIndex] == TEXT('<'))
+				{
+					Term.Op = bOrEqual ? EAssetQueryOp::LessEqual : EAssetQueryOp::Less;
+				}
+				else
+				{
+					Term.Op = bOrEqual ? EAssetQueryOp::GreaterEqual : EAssetQueryOp::Greater;
+				}
+				break;
+			}
+			default:
+				break;
+			}
+
+			Term.Key = Body.Left(OpIndex).TrimStartAndEnd();
+			Term.Value = Unquote(Body.Mid(OpIndex + OpLen)).TrimStartAndEnd().ToLower();
+			if (Term.Key.IsEmpty() || Term.Value.IsEmpty())
+			{
+				// Typically a term still being typed ("width>"); report it and keep the rest
+				OutError = FString::Printf(TEXT("Incomplete term '%s'"), *Token);
+				continue;
+			}
+			OutTerms.Add(MoveTemp(Term));
+		}
+		return OutError.IsEmpty();
+	}
+}
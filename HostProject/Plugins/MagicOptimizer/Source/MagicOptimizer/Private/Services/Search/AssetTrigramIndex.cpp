@@ -0,0 +1,156 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  AssetTrigramIndex.cpp
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#include "Services/Search/AssetTrigramIndex.h"
+#include "MagicOptimizerMemory.h"
+
+namespace
+{
+	// Once the candidate set is this small, verifying is cheaper than intersecting more lists
+	static constexpr int32 VerifyThreshold = 64;
+
+	static void IntersectSorted(const TArray<int32>& A, const TArray<int32>& B, TArray<int32>& Out)
+	{
+		Out.Reset(FMath::Min(A.Num(), B.Num()));
+		int32 IndexA = 0;
+		int32 IndexB = 0;
+		while (IndexA < A.Num() && IndexB < B.Num())
+		{
+			if (A[IndexA] < B[IndexB])
+			{
+				++IndexA;
+			}
+			else if (B[IndexB] < A[IndexA])
+			{
+				++IndexB;
+			}
+			else
+			{
+				Out.Add(A[IndexA]);
+				++IndexA;
+				++IndexB;
+			}
+		}
+	}
+}
+
+uint64 FAssetTrigramIndex::MakeKey(const TCHAR* Chars)
+{
+	// 21 bits per code unit covers the full Unicode range
+	return ((uint64)(uint32)Chars[0] << 42) | ((uint64)(uint32)Chars[1] << 21) | (uint64)(uint32)Chars[2];
+}
+
+void FAssetTrigramIndex::Build(const TArray<FString>& Documents)
+{
+	MAGICOPT_LLM_SCOPE(AuditStore);
+	Strings.Reset();
+	DocToString.Reset(Documents.Num());
+	StringDocOffsets.Reset();
+	StringDocs.Reset();
+	Postings.Reset();
+
+	// Intern documents
+	TMap<FString, int32> StringIds;
+	for (const FString& Document : Documents)
+	{
+		int32& StringId = StringIds.FindOrAdd(Document, INDEX_NONE);
+		if (StringId == INDEX_NONE)
+		{
+			StringId = Strings.Add(Document);
+		}
+		DocToString.Add(StringId);
+	}
+
+	// Posting lists; strings are visited in id order so each list comes out ascending
+	TArray<uint64> Keys;
+	for (int32 StringId = 0; StringId < Strings.Num(); ++StringId)
+	{
+		const FString& String = Strings[StringId];
+		Keys.Reset();
+		for (int32 CharIndex = 0; CharIndex + TrigramLength <= String.Len(); ++CharIndex)
+		{
+			Keys.Add(MakeKey(*String + CharIndex));
+		}
+		Keys.Sort();
+		uint64 PreviousKey = 0;
+		for (int32 KeyIndex = 0; KeyIndex < Keys.Num(); ++KeyIndex)
+		{
+			if (KeyIndex > 0 && Keys[KeyIndex] == PreviousKey)
+			{
+				continue;
+			}
+			PreviousKey = Keys[KeyIndex];
+			Postings.FindOrAdd(PreviousKey).Add(StringId);
+		}
+	}
+	for (TPair<uint64, TArray<int32>>& Pair : Postings)
+	{
+		Pair.Value.Shrink();
+	}
+
+	// String -> documents, as offsets into a flat array
+	StringDocOffsets.SetNumZeroed(Strings.Num() + 1);
+	for (const int32 StringId : DocToString)
+	{
+		++StringDocOffsets[StringId + 1];
+	}
+	for (int32 StringId = 0; StringId < Strings.Num(); ++StringId)
+	{
+		StringDocOffsets[StringId + 1] += StringDocOffsets[StringId];
+	}
+	StringDocs.SetNumUninitialized(DocToString.Num());
+	TArray<int32> WriteCursor(StringDocOffsets.GetData(), Strings.Num());
+	for (int32 DocId = 0; DocId < DocToString.Num(); ++DocId)
+	{
+		StringDocs[WriteCursor[DocToString[DocId]]++] = DocId;
+	}
+}
+
+bool FAssetTrigramIndex::FindDocuments(const FString& FoldedNeedle, TArray<int32>& OutDocIds) const
+{
+	MAGICOPT_LLM_SCOPE(AuditStore);
+	OutDocIds.Reset();
+	if (FoldedNeedle.Len() < TrigramLength)
+	{
+		return false;
+	}
+
+	// Posting list of every distinct trigram in the needle; a missing trigram means no match
+	TArray<const TArray<int32>*> Lists;
+	for (int32 CharIndex = 0; CharIndex + TrigramLength <= FoldedNeedle.Len(); ++CharIndex)
+	{
+		const TArray<int32>* List = Postings.Find(MakeKey(*FoldedNeedle + CharIndex));
+		if (!List)
+		{
+			return true;
+		}
+		Lists.AddUnique(List);
+	}
+
+	// Intersect from the shortest list up
+	Lists.Sort([](const TArray<int32>& A, const TArray<int32>& B) { return A.Num() < B.Num(); });
+	TArray<int32> Candidates = *Lists[0];
+	TArray<int32> Scratch;
+	for (int32 ListIndex = 1; ListIndex < Lists.Num() && Candidates.Num() > VerifyThreshold; ++ListIndex)
+	{
+		IntersectSorted(Candidates, *Lists[ListIndex], Scratch);
+		Swap(Candidates, Scratch);
+	}
+
+	// Trigram containment is necessary but not sufficient; verify and expand to documents
+	for (const int32 StringId : Candidates)
+	{
+		if (Strings[StringId].Contains(FoldedNeedle, ESearchCase::CaseSensitive))
+		{
+			for (int32 Offset = StringDocOffsets[StringId]; Offset < StringDocOffsets[StringId + 1]; ++Offset)
+			{
+				OutDocIds.Add(StringDocs[Offset]);
+			}
+		}
+	}
+	return true;
+}
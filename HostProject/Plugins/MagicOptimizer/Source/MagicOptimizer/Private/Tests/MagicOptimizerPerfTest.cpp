@@ -0,0 +1,360 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#include "Misc/AutomationTest.h"
+#include "MagicOptimizerStats.h"
+#include "Services/Analysis/TextureInspection.h"
+#include "Services/Apply/TextureApply.h"
+#include "Services/Csv/TextureCsvReader.h"
+#include "Services/Paging/CsvLineIndex.h"
+#include "ViewModels/TextureTableViewModel.h"
+#include "Algo/Find.h"
+#include "Algo/NoneOf.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * MagicOptimizer.Perf.Pipeline.<1k|10k|100k>
+ *
+ * Times each pipeline stage over a synthetic texture audit of the given size and writes the timings
+ * to Saved/MagicOptimizer/Perf/<Dataset>.json. Each stage is checked against a stored baseline and
+ * the test fails when a stage is slower than Baseline * (1 + Tolerance) + SlackMs.
+ *
+ * Command line:
+ *   -MagicOptPerfBaseline=<path>      Baseline file (default Saved/MagicOptimizer/Perf/baseline.json);
+ *                                      point CI at a checked-in file for its build machines
+ *   -MagicOptPerfUpdateBaseline       Record this run as the baseline instead of comparing
+ *   -MagicOptPerfTolerance=<ratio>    Allowed slowdown per stage (default 0.25)
+ *   -MagicOptPerfAssetPath=<path>     Content path for the registry query (default /Game), e.g. the
+ *                                      output of the synthetic content commandlet
+ * A dataset missing from the baseline is recorded rather than compared.
+ */
+namespace
+{
+	struct FPerfDataset
+	{
+		const TCHAR* Name;
+		int32 Rows;
+	};
+
+	static const FPerfDataset PerfDatasets[] = {
+		{ TEXT("1k"), 1000 },
+		{ TEXT("10k"), 10000 },
+		{ TEXT("100k"), 100000 },
+	};
+
+	// Applying creates transient textures; more than this adds memory without changing the per-asset cost
+	static constexpr int32 MaxApplyRows = 2000;
+	// Registry textures loaded and inspected natively; like the registry query, independent of the dataset
+	static constexpr int32 MaxInspectAssets = 500;
+	static constexpr double DefaultTolerance = 0.25;
+	static constexpr double SlackMs = 2.0;
+
+	static FString GetPerfDir()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("MagicOptimizer/Perf");
+	}
+
+	static FString GetBaselinePath()
+	{
+		FString Path;
+		if (FParse::Value(FCommandLine::Get(), TEXT("MagicOptPerfBaseline="), Path))
+		{
+			return Path;
+		}
+		return GetPerfDir() / TEXT("baseline.json");
+	}
+
+	// Audit CSV with the column mix and naming conventions of a real project; the seed keeps it stable
+	static FString BuildSyntheticAuditCsv(int32 NumRows)
+	{
+		static const TCHAR* Suffixes[] = { TEXT("_D"), TEXT("_N"), TEXT("_ORM"), TEXT("_M"), TEXT("_E"), TEXT("_UI") };
+		static const TCHAR* Formats[] = { TEXT("TC_Default"), TEXT("TC_Normalmap"), TEXT("TC_Masks"), TEXT("TC_Grayscale"), TEXT("TC_HDR"), TEXT("TC_EditorIcon") };
+		static const TCHAR* Groups[] = { TEXT("TEXTUREGROUP_World"), TEXT("TEXTUREGROUP_WorldNormalMap"), TEXT("TEXTUREGROUP_Character"), TEXT("TEXTUREGROUP_UI") };
+		static const int32 Sizes[] = { 64, 128, 256, 512, 1024, 2048, 4096, 8192, 1000, 1536 };
+
+		FRandomStream Random(1337);
+		FString Csv;
+		Csv.Reserve(NumRows * 96);
+		Csv += TEXT("path,width,height,format,lod_group,srgb\n");
+		for (int32 Index = 0; Index < NumRows; ++Index)
+		{
+			const int32 Width = Sizes[Random.RandHelper(UE_ARRAY_COUNT(Sizes))];
+			const int32 Height = Random.FRand() < 0.8f ? Width : Sizes[Random.RandHelper(UE_ARRAY_COUNT(Sizes))];
+			Csv += FString::Printf(TEXT("/Game/Perf/Set%02d/Folder%03d/T_Asset%06d%s,%d,%d,%s,%s,%d\n"),
+				Index % 16, Index % 509, Index, Suffixes[Random.RandHelper(UE_ARRAY_COUNT(Suffixes))],
+				Width, Height,
+				Formats[Random.RandHelper(UE_ARRAY_COUNT(Formats))],
+				Groups[Random.RandHelper(UE_ARRAY_COUNT(Groups))],
+				Random.FRand() < 0.6f ? 1 : 0);
+		}
+		return Csv;
+	}
+
+	// Stage timings in run order
+	class FStageTimings
+	{
+	public:
+		template <typename FuncType>
+		void Time(const TCHAR* Stage, FuncType&& Func)
+		{
+			const double Start = FPlatformTime::Seconds();
+			Func();
+			Add(Stage, (FPlatformTime::Seconds() - Start) * 1000.0);
+		}
+
+		void Add(const TCHAR* Stage, double Milliseconds)
+		{
+			Stages.Emplace(Stage, Milliseconds);
+		}
+
+		const TArray<TPair<FString, double>>& Get() const { return Stages; }
+
+	private:
+		TArray<TPair<FString, double>> Stages;
+	};
+
+	static TSharedPtr<FJsonObject> LoadJsonFile(const FString& Path)
+	{
+		FString Json;
+		TSharedPtr<FJsonObject> Root;
+		if (FFileHelper::LoadFileToString(Json, *Path))
+		{
+			FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root);
+		}
+		return Root;
+	}
+
+	static bool SaveJsonFile(const TSharedRef<FJsonObject>& Root, const FString& Path)
+	{
+		FString Json;
+		FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Json));
+		return FFileHelper::SaveStringToFile(Json, *Path);
+	}
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FMagicOptimizerPerfPipelineTest, "MagicOptimizer.Perf.Pipeline", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::PerfFilter)
+
+void FMagicOptimizerPerfPipelineTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const FPerfDataset& Dataset : PerfDatasets)
+	{
+		OutBeautifiedNames.Add(Dataset.Name);
+		OutTestCommands.Add(Dataset.Name);
+	}
+}
+
+bool FMagicOptimizerPerfPipelineTest::RunTest(const FString& Parameters)
+{
+	const FPerfDataset* Dataset = Algo::FindByPredicate(PerfDatasets, [&Parameters](const FPerfDataset& Candidate) { return Parameters == Candidate.Name; });
+	if (!Dataset)
+	{
+		AddError(FString::Printf(TEXT("Unknown dataset '%s'"), *Parameters));
+		return false;
+	}
+
+	const FString CsvPath = GetPerfDir() / FString::Printf(TEXT("textures_%s.csv"), Dataset->Name);
+	FStageTimings Timings;
+
+	// Registry query: class scan under the content path; independent of the synthetic row count
+	FString AssetPath = TEXT("/Game");
+	FParse::Value(FCommandLine::Get(), TEXT("MagicOptPerfAssetPath="), AssetPath);
+	int32 RegistryAssets = 0;
+	TArray<FAssetData> RegistryTextures;
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		Timings.Time(TEXT("registry_query"), [&]()
+		{
+			FARFilter Filter;
+			Filter.PackagePaths.Add(FName(*AssetPath));
+			Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+			Filter.bRecursivePaths = true;
+			AssetRegistry->GetAssets(Filter, RegistryTextures);
+			RegistryAssets = RegistryTextures.Num();
+		});
+	}
+
+	FString Csv;
+	Timings.Time(TEXT("generate"), [&]() { Csv = BuildSyntheticAuditCsv(Dataset->Rows); });
+	Timings.Time(TEXT("csv_write"), [&]() { FFileHelper::SaveStringToFile(Csv, *CsvPath); });
+	Csv.Empty();
+
+	// CSV parse and rule classification run in one call; the stage accumulators split them
+	TArray<FTextureAuditRowPtr> Rows;
+	{
+		const MagicOptimizerStats::FRunStats Before = MagicOptimizerStats::GetRunStats();
+		const double Start = FPlatformTime::Seconds();
+		TextureCsvReader::ReadAuditCsvFile(CsvPath, Rows);
+		const double TotalMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+		const MagicOptimizerStats::FRunStats After = MagicOptimizerStats::GetRunStats();
+		const int32 RuleStage = (int32)MagicOptimizerTrace::EStage::RuleEvaluation;
+		const double RulesMs = (After.Stages[RuleStage].Seconds - Before.Stages[RuleStage].Seconds) * 1000.0;
+		Timings.Add(TEXT("csv_read"), FMath::Max(0.0, TotalMs - RulesMs));
+		Timings.Add(TEXT("rule_evaluation"), RulesMs);
+	}
+	TestEqual(TEXT("All synthetic rows parsed"), Rows.Num(), Dataset->Rows);
+
+	// Paged I/O: line index plus every page the list would fetch
+	Timings.Time(TEXT("csv_index_paging"), [&]()
+	{
+		FCsvLineIndex Index;
+		Index.Build(CsvPath, TEXT("path"));
+		TArray<FString> Page;
+		for (int32 Start = 0; Start < Index.Num(); Start += 256)
+		{
+			Page.Reset();
+			Index.ReadLines(Start, 256, Page);
+		}
+	});
+
+	// Analysis: table build with facet aggregation and the search indices
+	TSharedRef<FTextureTableViewModel> ViewModel = MakeShared<FTextureTableViewModel>();
+	ViewModel->SetAsyncRefresh(false);
+	Timings.Time(TEXT("analysis"), [&]()
+	{
+		ViewModel->SetSourceData(Rows);
+		ViewModel->WaitForSearchIndex();
+	});
+
+	Timings.Time(TEXT("filter"), [&]()
+	{
+		ViewModel->SetQuery(TEXT("type:normal width>=1024 -path:/Set03/"));
+		ViewModel->SetQuery(TEXT("asset00"));
+		ViewModel->SetQuery(FString());
+	});
+	TestEqual(TEXT("Cleared query shows every row"), ViewModel->GetFilteredCount(), Dataset->Rows);
+
+	Timings.Time(TEXT("sort"), [&]()
+	{
+		ViewModel->SetSortColumn(FTextureTableViewModel::ColumnMemory, /*bInAscending*/ false);
+		ViewModel->SetSortColumn(FTextureTableViewModel::ColumnPath, /*bInAscending*/ true);
+	});
+
+	// Native inspection: game-thread extraction, worker analysis
+	if (RegistryTextures.Num() > 0)
+	{
+		TArray<FSoftObjectPath> InspectPaths;
+		for (int32 Index = 0; Index < FMath::Min(RegistryTextures.Num(), MaxInspectAssets); ++Index)
+		{
+			InspectPaths.Add(RegistryTextures[Index].GetSoftObjectPath());
+		}
+		int32 Inspected = 0;
+		Timings.Time(TEXT("inspection"), [&]() { Inspected = TextureInspection::InspectTextures(InspectPaths).Num(); });
+		TestEqual(TEXT("Every registry texture inspected"), Inspected, InspectPaths.Num());
+	}
+
+#if WITH_EDITOR
+	// Apply: the dock's sRGB batch, run through the game-thread executor on transient textures;
+	// transient packages are not saved
+	const int32 ApplyRows = FMath::Min(Rows.Num(), MaxApplyRows);
+	TArray<UTexture2D*> Textures;
+	Textures.Reserve(ApplyRows);
+	for (int32 Index = 0; Index < ApplyRows; ++Index)
+	{
+		UTexture2D* Texture = NewObject<UTexture2D>(GetTransientPackage(), NAME_None, RF_Transient);
+		Texture->SRGB = true;
+		Textures.Add(Texture);
+	}
+	TArray<MagicOptimizerGameThread::FWorkItem> ApplyItems;
+	ApplyItems.Reserve(Textures.Num() * 2);
+	const TSharedRef<int32> NumApplied = MakeShared<int32>(0);
+	for (UTexture2D* Texture : Textures)
+	{
+		TextureApply::AddSetSrgbItems(ApplyItems, Texture->GetPathName(), false, nullptr, [NumApplied](bool bLoaded)
+		{
+			*NumApplied += bLoaded ? 1 : 0;
+		}, nullptr);
+	}
+	Timings.Time(TEXT("apply"), [&]()
+	{
+		const uint32 JobId = MagicOptimizerGameThread::Enqueue(TEXT("Perf apply"), MoveTemp(ApplyItems));
+		MagicOptimizerGameThread::Flush(JobId);
+	});
+	TestEqual(TEXT("Every transient texture applied"), *NumApplied, Textures.Num());
+	TestTrue(TEXT("sRGB cleared"), Algo::NoneOf(Textures, [](const UTexture2D* Texture) { return Texture->SRGB; }));
+	for (UTexture2D* Texture : Textures)
+	{
+		Texture->MarkAsGarbage();
+	}
+#endif
+
+	// Compare against the baseline, then write results
+	const FString BaselinePath = GetBaselinePath();
+	TSharedPtr<FJsonObject> Baseline = LoadJsonFile(BaselinePath);
+	if (!Baseline.IsValid())
+	{
+		Baseline = MakeShared<FJsonObject>();
+	}
+	const TSharedPtr<FJsonObject>* DatasetBaseline = nullptr;
+	const bool bUpdateBaseline = FParse::Param(FCommandLine::Get(), TEXT("MagicOptPerfUpdateBaseline"));
+	const bool bCompare = !bUpdateBaseline && Baseline->TryGetObjectField(Dataset->Name, DatasetBaseline) && DatasetBaseline;
+	double Tolerance = DefaultTolerance;
+	FParse::Value(FCommandLine::Get(), TEXT("MagicOptPerfTolerance="), Tolerance);
+
+	TSharedRef<FJsonObject> Results = MakeShared<FJsonObject>();
+	Results->SetStringField(TEXT("dataset"), Dataset->Name);
+	Results->SetNumberField(TEXT("rows"), Dataset->Rows);
+	Results->SetNumberField(TEXT("registry_assets"), RegistryAssets);
+	Results->SetStringField(TEXT("time"), FDateTime::Now().ToIso8601());
+	Results->SetStringField(TEXT("baseline"), BaselinePath);
+	Results->SetNumberField(TEXT("tolerance"), Tolerance);
+
+	TSharedRef<FJsonObject> StageResults = MakeShared<FJsonObject>();
+	TSharedRef<FJsonObject> NewBaseline = MakeShared<FJsonObject>();
+	int32 Regressions = 0;
+	for (const TPair<FString, double>& Stage : Timings.Get())
+	{
+		TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetNumberField(TEXT("ms"), Stage.Value);
+		NewBaseline->SetNumberField(Stage.Key, Stage.Value);
+
+		double BaselineMs = 0.0;
+		if (bCompare && (*DatasetBaseline)->TryGetNumberField(Stage.Key, BaselineMs))
+		{
+			const double LimitMs = BaselineMs * (1.0 + Tolerance) + SlackMs;
+			const bool bRegressed = Stage.Value > LimitMs;
+			Entry->SetNumberField(TEXT("baseline_ms"), BaselineMs);
+			Entry->SetNumberField(TEXT("limit_ms"), LimitMs);
+			Entry->SetBoolField(TEXT("regressed"), bRegressed);
+			if (bRegressed)
+			{
+				++Regressions;
+				AddError(FString::Printf(TEXT("%s: %s took %.2f ms, limit %.2f ms (baseline %.2f ms)"), Dataset->Name, *Stage.Key, Stage.Value, LimitMs, BaselineMs));
+			}
+		}
+		AddInfo(FString::Printf(TEXT("%s: %s %.2f ms"), Dataset->Name, *Stage.Key, Stage.Value));
+		StageResults->SetObjectField(Stage.Key, Entry);
+	}
+	Results->SetObjectField(TEXT("stages"), StageResults);
+	Results->SetNumberField(TEXT("regressions"), Regressions);
+	Results->SetBoolField(TEXT("compared"), bCompare);
+
+	const FString ResultsPath = GetPerfDir() / FString::Printf(TEXT("%s.json"), Dataset->Name);
+	TestTrue(TEXT("Results written"), SaveJsonFile(Results, ResultsPath));
+
+	if (!bCompare)
+	{
+		Baseline->SetObjectField(Dataset->Name, NewBaseline);
+		if (SaveJsonFile(Baseline.ToSharedRef(), BaselinePath))
+		{
+			AddWarning(FString::Printf(TEXT("%s: recorded as the baseline in %s"), Dataset->Name, *BaselinePath));
+		}
+	}
+
+	IFileManager::Get().Delete(*CsvPath, /*RequireExists*/ false, /*EvenReadOnly*/ true, /*Quiet*/ true);
+	return Regressions == 0;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
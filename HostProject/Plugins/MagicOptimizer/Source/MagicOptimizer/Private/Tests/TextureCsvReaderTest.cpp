@@ -0,0 +1,48 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Services/Csv/TextureCsvReader.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	static FString ClassifyPath(const FString& Path, const FString& Format = TEXT("TC_Default"))
+	{
+		FTextureAuditRow Row;
+		Row.Path = Path;
+		Row.Width = 1024;
+		Row.Height = 1024;
+		Row.Format = Format;
+		TextureCsvReader::ClassifyTexture(Row);
+		return Row.Type;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMagicOptimizerClassifyTextureTest, "MagicOptimizer.TextureCsvReader.ClassifyTexture", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter)
+bool FMagicOptimizerClassifyTextureTest::RunTest(const FString& Parameters)
+{
+	// Substrings of folders and other name tokens must not classify
+	TestEqual(TEXT("T_Nature_D is color"), ClassifyPath(TEXT("/Game/Nature/T_Nature_D")), FString(TEXT("color")));
+	TestEqual(TEXT("T_Plat_D under /Platform/ is color"), ClassifyPath(TEXT("/Game/Platform/T_Plat_D")), FString(TEXT("color")));
+	TestEqual(TEXT("/Storm/ folder is color"), ClassifyPath(TEXT("/Game/Storm/T_Cloud_D.T_Cloud_D")), FString(TEXT("color")));
+	TestEqual(TEXT("/Uniform/ folder is color"), ClassifyPath(TEXT("/Game/Uniform/T_Cloth_BC")), FString(TEXT("color")));
+
+	TestEqual(TEXT("_N suffix is normal"), ClassifyPath(TEXT("/Game/Rock/T_Rock_N.T_Rock_N")), FString(TEXT("normal")));
+	TestEqual(TEXT("_Normal suffix is normal"), ClassifyPath(TEXT("/Game/Rock/T_Rock_Normal")), FString(TEXT("normal")));
+	TestEqual(TEXT("_ORM suffix is mask"), ClassifyPath(TEXT("/Game/Rock/T_Rock_ORM")), FString(TEXT("mask")));
+	TestEqual(TEXT("_Mask suffix is mask"), ClassifyPath(TEXT("/Game/Rock/T_Rock_Mask")), FString(TEXT("mask")));
+	TestEqual(TEXT("Normalmap format is normal"), ClassifyPath(TEXT("/Game/Rock/T_Rock"), TEXT("TC_Normalmap")), FString(TEXT("normal")));
+
+	FTextureAuditRow Row;
+	Row.Path = TEXT("/Game/Nature/T_Nature_D");
+	Row.Width = 1024;
+	Row.Height = 1024;
+	Row.Format = TEXT("TC_Default");
+	Row.SRGB = 1;
+	TextureCsvReader::ClassifyTexture(Row);
+	TestEqual(TEXT("No false issues for a color texture"), Row.Issues, FString());
+	return true;
+}
+
+#endif
@@ -0,0 +1,38 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#include "ViewModels/MaterialTableViewModel.h"
+
+const FName FMaterialTableViewModel::ColumnPath(TEXT("Path"));
+const FName FMaterialTableViewModel::ColumnTextureCount(TEXT("TextureCount"));
+const FName FMaterialTableViewModel::ColumnShaderComplexity(TEXT("ShaderComplexity"));
+const FName FMaterialTableViewModel::ColumnIssues(TEXT("Issues"));
+
+TArray<FMaterialTableViewModel::FColumn> FMaterialTableViewModel::MakeColumns()
+{
+	TArray<FColumn> Columns;
+	Columns.Add(FColumn::MakeText(ColumnPath, [](const FMaterialAuditRow& Row) -> const FString& { return Row.Path; }, true, EAssetColumnFilterKind::None));
+	Columns.Add(FColumn::MakeNumber(ColumnTextureCount, [](const FMaterialAuditRow& Row) { return (int64)Row.TextureCount; }).WithAliases({ TEXT("textures") }));
+	Columns.Add(FColumn::MakeNumber(ColumnShaderComplexity, [](const FMaterialAuditRow& Row) { return (int64)Row.ShaderComplexity; }).WithAliases({ TEXT("complexity") }));
+	Columns.Add(FColumn::MakeText(ColumnIssues, [](const FMaterialAuditRow& Row) -> const FString& { return Row.Issues; }, true).WithAliases({ TEXT("issue") }));
+	return Columns;
+}
+
+FMaterialTableViewModel::FMaterialTableViewModel()
+	: TAssetTableViewModel<FMaterialAuditRow>(MakeColumns())
+{
+}
+
+FName FMaterialTableViewModel::GetColumnId(EMaterialSortColumn InColumn)
+{
+	switch (InColumn)
+	{
+	case EMaterialSortColumn::TextureCount:
+		return ColumnTextureCount;
+	case EMaterialSortColumn::ShaderComplexity:
+		return ColumnShaderComplexity;
+	case EMaterialSortColumn::Issues:
+		return ColumnIssues;
+	default:
+		return ColumnPath;
+	}
+}
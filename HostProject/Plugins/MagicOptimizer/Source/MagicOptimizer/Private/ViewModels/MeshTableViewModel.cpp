@@ -0,0 +1,40 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#include "ViewModels/MeshTableViewModel.h"
+
+const FName FMeshTableViewModel::ColumnPath(TEXT("Path"));
+const FName FMeshTableViewModel::ColumnVertexCount(TEXT("VertexCount"));
+const FName FMeshTableViewModel::ColumnTriangleCount(TEXT("TriangleCount"));
+const FName FMeshTableViewModel::ColumnLODCount(TEXT("LODCount"));
+const FName FMeshTableViewModel::ColumnIssues(TEXT("Issues"));
+
+TArray<FMeshTableViewModel::FColumn> FMeshTableViewModel::MakeColumns()
+{
+	TArray<FColumn> Columns;
+	Columns.Add(FColumn::MakeText(ColumnPath, [](const FMeshAuditRow& Row) -> const FString& { return Row.Path; }, true, EAssetColumnFilterKind::None));
+	Columns.Add(FColumn::MakeNumber(ColumnVertexCount, [](const FMeshAuditRow& Row) { return (int64)Row.VertexCount; }).WithAliases({ TEXT("verts") }));
+	Columns.Add(FColumn::MakeNumber(ColumnTriangleCount, [](const FMeshAuditRow& Row) { return (int64)Row.TriangleCount; }).WithAliases({ TEXT("tris") }));
+	Columns.Add(FColumn::MakeNumber(ColumnLODCount, [](const FMeshAuditRow& Row) { return (int64)Row.LODCount; }).WithAliases({ TEXT("lods") }));
+	Columns.Add(FColumn::MakeText(ColumnIssues, [](const FMeshAuditRow& Row) -> const FString& { return Row.Issues; }, true).WithAliases({ TEXT("issue") }));
+	return Columns;
+}
+
+FMeshTableViewModel::FMeshTableViewModel()
+	: TAssetTableViewModel<FMeshAuditRow>(MakeColumns())
+{
+}
+
+FName FMeshTableViewModel::GetColumnId(EMeshSortColumn InColumn)
+{
+	switch (InColumn)
+	{
+	case EMeshSortColumn::VertexCount:
+		return ColumnVertexCount;
+	case EMeshSortColumn::TriangleCount:
+		return ColumnTriangleCount;
+	case EMeshSortColumn::LODCount:
+		return ColumnLODCount;
+	default:
+		return ColumnPath;
+	}
+}
@@ -1,105 +1,135 @@
 // Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
 
 #include "ViewModels/TextureTableViewModel.h"
+#include "Services/Facets/TextureFacets.h"
 #include "OptimizerSettings.h"
-
-FTextureTableViewModel::FTextureTableViewModel()
-	: MinWidthFilter(0)
-	, MinHeightFilter(0)
-	, CurrentSortColumn(ESortColumn::Path)
-	, bSortAscending(true)
-{
+#include "MagicOptimizerMemory.h"
+
+const FName FTextureTableViewModel::ColumnPath(TEXT("Path"));
+const FName FTextureTableViewModel::ColumnWidth(TEXT("Width"));
+const FName FTextureTableViewModel::ColumnHeight(TEXT("Height"));
+const FName FTextureTableViewModel::ColumnFormat(TEXT("Format"));
+const FName FTextureTableViewModel::ColumnType(TEXT("Type"));
+const FName FTextureTableViewModel::ColumnLODGroup(TEXT("LODGroup"));
+const FName FTextureTableViewModel::ColumnSRGB(TEXT("SRGB"));
+const FName FTextureTableViewModel::ColumnIssues(TEXT("Issues"));
+const FName FTextureTableViewModel::ColumnSize(TEXT("Size"));
+const FName FTextureTableViewModel::ColumnMemory(TEXT("Memory"));
+
+TArray<FTextureTableViewModel::FColumn> FTextureTableViewModel::MakeColumns()
+{
+	TArray<FColumn> Columns;
+	Columns.Add(FColumn::MakeText(ColumnPath, [](const FTextureAuditRow& Row) -> const FString& { return Row.Path; }, true, EAssetColumnFilterKind::None));
+	Columns.Add(FColumn::MakeNumber(ColumnWidth, [](const FTextureAuditRow& Row) { return (int64)Row.Width; }));
+	Columns.Add(FColumn::MakeNumber(ColumnHeight, [](const FTextureAuditRow& Row) { return (int64)Row.Height; }));
+	Columns.Add(FColumn::MakeText(ColumnFormat, [](const FTextureAuditRow& Row) -> const FString& { return Row.Format; }, true));
+
+	// Query-only columns (type:normal group:ui srgb=1 issue:npot size=4k mem>16000000)
+	Columns.Add(FColumn::MakeText(ColumnType, [](const FTextureAuditRow& Row) -> const FString& { return Row.Type; }, false, EAssetColumnFilterKind::None));
+	Columns.Add(FColumn::MakeText(ColumnLODGroup, [](const FTextureAuditRow& Row) -> const FString& { return Row.LODGroup; }, false, EAssetColumnFilterKind::None).WithAliases({ TEXT("group") }));
+	Columns.Add(FColumn::MakeNumber(ColumnSRGB, [](const FTextureAuditRow& Row) { return (int64)Row.SRGB; }, EAssetColumnFilterKind::None));
+	Columns.Add(FColumn::MakeText(ColumnIssues, [](const FTextureAuditRow& Row) -> const FString& { return Row.Issues; }, false, EAssetColumnFilterKind::None).WithAliases({ TEXT("issue") }));
+	Columns.Add(FColumn::MakeText(ColumnSize, [](const FTextureAuditRow& Row) -> const FString& { return Row.SizeBucket; }, false, EAssetColumnFilterKind::None));
+	Columns.Add(FColumn::MakeNumber(ColumnMemory, [](const FTextureAuditRow& Row) { return Row.EstimatedBytes; }, EAssetColumnFilterKind::None).WithAliases({ TEXT("mem"), TEXT("bytes") }));
+	return Columns;
 }
 
-void FTextureTableViewModel::SetSourceData(const TArray<FTextureAuditRowPtr>& InSourceData)
+FTextureTableViewModel::FTextureTableViewModel()
+	: TAssetTableViewModel<FTextureAuditRow>(MakeColumns())
 {
-	SourceData = InSourceData;
-	RefreshData();
 }
 
-void FTextureTableViewModel::RefreshData()
+void FTextureTableViewModel::SetMinWidthFilter(int32 InMinWidth)
 {
-	ApplyFilters();
-	ApplySorting();
+	SetColumnMinFilter(ColumnWidth, InMinWidth);
 }
 
-void FTextureTableViewModel::SetTextFilter(const FString& InFilter)
+void FTextureTableViewModel::SetMinHeightFilter(int32 InMinHeight)
 {
-	TextFilter = InFilter;
-	RefreshData();
+	SetColumnMinFilter(ColumnHeight, InMinHeight);
 }
 
-void FTextureTableViewModel::SetMinWidthFilter(int32 InMinWidth)
+void FTextureTableViewModel::SetFormatFilter(const FString& InFilter)
 {
-	MinWidthFilter = InMinWidth;
-	RefreshData();
+	SetColumnFilter(ColumnFormat, InFilter);
 }
 
-void FTextureTableViewModel::SetMinHeightFilter(int32 InMinHeight)
+void FTextureTableViewModel::SetSortColumn(ESortColumn InColumn, bool bInAscending)
 {
-	MinHeightFilter = InMinHeight;
-	RefreshData();
+	SetSortColumn(GetColumnId(InColumn), bInAscending);
 }
 
-void FTextureTableViewModel::SetFormatFilter(const FString& InFilter)
+void FTextureTableViewModel::SetSortColumn(ETextureSortColumn InColumn, bool bInAscending)
 {
-	FormatFilter = InFilter;
-	RefreshData();
+	SetSortColumn(GetColumnId(InColumn), bInAscending);
 }
 
-void FTextureTableViewModel::ClearAllFilters()
+FTextureTableViewModel::ESortColumn FTextureTableViewModel::GetCurrentSortColumn() const
 {
-	TextFilter.Empty();
-	MinWidthFilter = 0;
-	MinHeightFilter = 0;
-	FormatFilter.Empty();
-	RefreshData();
+	const FName SortId = GetSortColumnId();
+	if (SortId == ColumnWidth)
+	{
+		return ESortColumn::Width;
+	}
+	if (SortId == ColumnHeight)
+	{
+		return ESortColumn::Height;
+	}
+	if (SortId == ColumnFormat)
+	{
+		return ESortColumn::Format;
+	}
+	return ESortColumn::Path;
 }
 
-void FTextureTableViewModel::SetSortColumn(ESortColumn InColumn, bool bInAscending)
+FName FTextureTableViewModel::GetColumnId(ESortColumn InColumn)
 {
-	CurrentSortColumn = InColumn;
-	bSortAscending = bInAscending;
-	ApplySorting();
+	switch (InColumn)
+	{
+	case ESortColumn::Width:
+		return ColumnWidth;
+	case ESortColumn::Height:
+		return ColumnHeight;
+	case ESortColumn::Format:
+		return ColumnFormat;
+	default:
+		return ColumnPath;
+	}
 }
 
-bool FTextureTableViewModel::HasActiveFilters() const
+FName FTextureTableViewModel::GetColumnId(ETextureSortColumn InColumn)
 {
-	return !TextFilter.IsEmpty() || MinWidthFilter > 0 || MinHeightFilter > 0 || !FormatFilter.IsEmpty();
+	switch (InColumn)
+	{
+	case ETextureSortColumn::Width:
+		return ColumnWidth;
+	case ETextureSortColumn::Height:
+		return ColumnHeight;
+	case ETextureSortColumn::Format:
+		return ColumnFormat;
+	default:
+		return ColumnPath;
+	}
 }
 
 void FTextureTableViewModel::LoadSettingsFromConfig(UOptimizerSettings* Settings)
 {
 	if (Settings)
 	{
+		BeginBatch();
+
 		// Load filter settings
-		TextFilter = Settings->TextureFilterText;
-		MinWidthFilter = Settings->TextureFilterMinWidth;
-		MinHeightFilter = Settings->TextureFilterMinHeight;
-		FormatFilter = Settings->TextureFormatFilter;
-		
-		// Load sort settings
-		if (Settings->TextureSortColumn == TEXT("Width"))
-		{
-			CurrentSortColumn = ESortColumn::Width;
-		}
-		else if (Settings->TextureSortColumn == TEXT("Height"))
-		{
-			CurrentSortColumn = ESortColumn::Height;
-		}
-		else if (Settings->TextureSortColumn == TEXT("Format"))
-		{
-			CurrentSortColumn = ESortColumn::Format;
-		}
-		else
-		{
-			CurrentSortColumn = ESortColumn::Path; // Default
-		}
-		
-		bSortAscending = Settings->bTextureSortAscending;
-		
+		SetTextFilter(Settings->TextureFilterText);
+		SetMinWidthFilter(Settings->TextureFilterMinWidth);
+		SetMinHeightFilter(Settings->TextureFilterMinHeight);
+		SetFormatFilter(Settings->TextureFormatFilter);
+
+		// Load sort settings (unknown names fall back to Path)
+		const FName SortId(*Settings->TextureSortColumn);
+		SetSortColumn(FindColumnIndex(SortId) != INDEX_NONE ? SortId : ColumnPath, Settings->bTextureSortAscending);
+
 		// Apply loaded settings to data
-		RefreshData();
+		EndBatch();
 	}
 }
 
@@ -108,126 +138,103 @@ void FTextureTableViewModel::SaveSettingsToConfig(UOptimizerSettings* Settings)
 	if (Settings)
 	{
 		// Save filter settings
-		Settings->TextureFilterText = TextFilter;
-		Settings->TextureFilterMinWidth = MinWidthFilter;
-		Settings->TextureFilterMinHeight = MinHeightFilter;
-		Settings->TextureFormatFilter = FormatFilter;
-		
+		Settings->TextureFilterText = GetTextFilter();
+		Settings->TextureFilterMinWidth = GetMinWidthFilter();
+		Settings->TextureFilterMinHeight = GetMinHeightFilter();
+		Settings->TextureFormatFilter = GetFormatFilter();
+
 		// Save sort settings
-		switch (CurrentSortColumn)
-		{
-		case ESortColumn::Width:
-			Settings->TextureSortColumn = TEXT("Width");
-			break;
-		case ESortColumn::Height:
-			Settings->TextureSortColumn = TEXT("Height");
-			break;
-		case ESortColumn::Format:
-			Settings->TextureSortColumn = TEXT("Format");
-			break;
-		default:
-			Settings->TextureSortColumn = TEXT("Path");
-			break;
-		}
-		
-		Settings->bTextureSortAscending = bSortAscending;
-		
+		Settings->TextureSortColumn = GetSortColumnId().ToString();
+		Settings->bTextureSortAscending = IsSortAscending();
+
 		// Persist to disk
 		Settings->SaveSettings();
 	}
 }
 
-void FTextureTableViewModel::ApplyFilters()
+void FTextureTableViewModel::HandleSourceDataChanged(const TArray<FTextureAuditRowPtr>& Rows)
 {
-	FilteredData.Empty();
-	
-	for (const auto& Row : SourceData)
+	MAGICOPT_LLM_SCOPE(Views);
+	// Rows for repeated paths are not keyed; they are re-added below if still present
+	for (const int32 FacetRowId : DuplicateFacetRows)
 	{
-		if (RowPassesFilters(Row))
-		{
-			FilteredData.Add(Row);
-		}
+		Facets.RemoveRow(FacetRowId);
+		FreeFacetRows.Add(FacetRowId);
 	}
-}
+	DuplicateFacetRows.Reset();
 
-void FTextureTableViewModel::ApplySorting()
-{
-	FilteredData.Sort([this](const FTextureAuditRowPtr& A, const FTextureAuditRowPtr& B)
+	TBitArray<> Seen(false, FacetRowHashes.Num());
+	SourceFacetRows.Reset(Rows.Num());
+	for (const FTextureAuditRowPtr& Row : Rows)
 	{
-		int32 CompareResult = CompareRows(A, B);
-		return bSortAscending ? (CompareResult < 0) : (CompareResult > 0);
-	});
-}
+		if (!Row.IsValid())
+		{
+			SourceFacetRows.Add(INDEX_NONE);
+			continue;
+		}
 
-bool FTextureTableViewModel::RowPassesFilters(const FTextureAuditRowPtr& Row) const
-{
-	if (!Row.IsValid())
-	{
-		return false;
-	}
-	
-	// Text filter
-	if (!TextFilter.IsEmpty())
-	{
-		FString SearchText = TextFilter.ToLower();
-		FString PathLower = Row->Path.ToLower();
-		FString FormatLower = Row->Format.ToLower();
-		
-		if (!PathLower.Contains(SearchText) && !FormatLower.Contains(SearchText))
+		const FAssetFacetRow FacetRow = TextureFacets::MakeRow(*Row);
+		uint32 Hash = GetTypeHash(FacetRow.Bytes);
+		for (const TPair<EAssetFacet, FString>& Value : FacetRow.Values)
 		{
-			return false;
+			Hash = HashCombineFast(Hash, HashCombineFast((uint32)Value.Key, GetTypeHash(Value.Value)));
 		}
+
+		const int32* Existing = FacetRowByPath.Find(Row->Path);
+		const bool bDuplicate = Existing && Seen[*Existing];
+		int32 FacetRowId = Existing && !bDuplicate ? *Existing : INDEX_NONE;
+		if (FacetRowId == INDEX_NONE)
+		{
+			if (FreeFacetRows.Num() > 0)
+			{
+				FacetRowId = FreeFacetRows.Pop(EAllowShrinking::No);
+			}
+			else
+			{
+				FacetRowId = FacetRowHashes.Add(0);
+				Seen.Add(false);
+			}
+			if (bDuplicate)
+			{
+				DuplicateFacetRows.Add(FacetRowId);
+			}
+			else
+			{
+				FacetRowByPath.Add(Row->Path, FacetRowId);
+			}
+			Facets.SetRow(FacetRowId, FacetRow);
+		}
+		else if (FacetRowHashes[FacetRowId] != Hash)
+		{
+			Facets.SetRow(FacetRowId, FacetRow);
+		}
+		FacetRowHashes[FacetRowId] = Hash;
+		Seen[FacetRowId] = true;
+		SourceFacetRows.Add(FacetRowId);
 	}
-	
-	// Width filter
-	if (MinWidthFilter > 0 && Row->Width < MinWidthFilter)
-	{
-		return false;
-	}
-	
-	// Height filter
-	if (MinHeightFilter > 0 && Row->Height < MinHeightFilter)
-	{
-		return false;
-	}
-	
-	// Format filter
-	if (!FormatFilter.IsEmpty())
+
+	// Rows that are no longer audited
+	for (auto It = FacetRowByPath.CreateIterator(); It; ++It)
 	{
-		FString SearchFormat = FormatFilter.ToLower();
-		FString RowFormat = Row->Format.ToLower();
-		
-		if (!RowFormat.Contains(SearchFormat))
+		if (!Seen[It.Value()])
 		{
-			return false;
+			Facets.RemoveRow(It.Value());
+			FreeFacetRows.Add(It.Value());
+			It.RemoveCurrent();
 		}
 	}
-	
-	return true;
 }
 
-int32 FTextureTableViewModel::CompareRows(const FTextureAuditRowPtr& A, const FTextureAuditRowPtr& B) const
+void FTextureTableViewModel::HandleResultsPublished(const TArray<int32>& FilteredIndices)
 {
-	if (!A.IsValid() || !B.IsValid())
+	MAGICOPT_LLM_SCOPE(Views);
+	FilteredFacetRows.Reset(FilteredIndices.Num());
+	for (const int32 RowIndex : FilteredIndices)
 	{
-		return 0;
-	}
-	
-	switch (CurrentSortColumn)
-	{
-	case ESortColumn::Path:
-		return A->Path.Compare(B->Path);
-		
-	case ESortColumn::Width:
-		return A->Width - B->Width;
-		
-	case ESortColumn::Height:
-		return A->Height - B->Height;
-		
-	case ESortColumn::Format:
-		return A->Format.Compare(B->Format);
-		
-	default:
-		return 0;
+		if (SourceFacetRows.IsValidIndex(RowIndex) && SourceFacetRows[RowIndex] != INDEX_NONE)
+		{
+			FilteredFacetRows.Add(SourceFacetRows[RowIndex]);
+		}
 	}
+	Facets.SetFilteredRows(FilteredFacetRows);
 }
@@ -0,0 +1,59 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  MagicOptimizerCommandlet.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MagicOptimizerCommandlet.generated.h"
+
+/**
+ * Headless MagicOptimizer pipeline for CI and nightly runs: runs a phase, reads its audit back,
+ * checks budgets and writes a report, without Slate or the editor module UI.
+ *
+ * UnrealEditor-Cmd <Project> -run=MagicOptimizer [options] -unattended -nullrhi -nosplash -nosound -nopause
+ *   -phase=audit|recommend|apply|verify    Default audit
+ *   -profile=Console_Optimized             Default: project setting
+ *   -include=/Game/Env[,/Game/Props]       Default: project setting
+ *   -exclude=/Game/Dev
+ *   -categories=Textures[,Meshes,Materials] Default Textures
+ *   -out=<dir>                             Report folder (default Saved/MagicOptimizer/Reports/CI_<time>)
+ *   -native                                Also inspect the textures natively (pixel issue codes such as
+ *                                          unused_alpha); its rows replace the CSV rows of the same asset
+ *                                          and are written to inspection.csv
+ *   -threads=N                             Sets magicopt.MaxWorkerThreads, which caps rule evaluation of the
+ *                                          audit rows and the -native inspection; add
+ *                                          -NumberOfWorkerThreadsToUse=N to also size the engine worker pool,
+ *                                          which is fixed at launch. The Python phase runs on the game thread
+ *                                          and ignores it
+ *   -DryRun=false -MaxChanges=N            Apply phase safety (default: project settings)
+ *
+ * Budgets; any budget exceeded returns ExitOverBudget:
+ *   -MaxIssues=N                           Textures with at least one issue code
+ *   -MaxTextureMemoryMB=N                  Estimated resident memory of the audited textures
+ *   -Budget=srgb:0,npot:25                 Textures per issue code
+ */
+UCLASS()
+class UMagicOptimizerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	enum EExitCode : int32
+	{
+		// Pipeline ran and every budget held
+		ExitSuccess = 0,
+		// Bad arguments, or the phase or audit read failed
+		ExitFailed = 1,
+		// Pipeline ran but at least one budget was exceeded
+		ExitOverBudget = 2,
+	};
+
+	UMagicOptimizerCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
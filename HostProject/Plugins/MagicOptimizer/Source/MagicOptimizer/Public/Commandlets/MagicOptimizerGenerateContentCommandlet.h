@@ -0,0 +1,42 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  MagicOptimizerGenerateContentCommandlet.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MagicOptimizerGenerateContentCommandlet.generated.h"
+
+/**
+ * Generates procedural textures, static meshes and material instances into a scratch content folder,
+ * so the audits can be profiled at scale without project content. Output is deterministic for a seed:
+ * every asset derives its parameters from (Seed, Kind, Index) alone.
+ *
+ * UnrealEditor-Cmd <Project> -run=MagicOptimizerGenerateContent [options]
+ *   -Path=/Game/MagicOptimizerSynthetic   Content folder; assets go to Textures/, Materials/, Meshes/
+ *   -Textures=1000 -Meshes=200 -Materials=200
+ *   -Seed=1337
+ *   -MaxTextureSize=1024                   Largest generated dimension
+ *   -MinTriangles=200 -MaxTriangles=20000  Triangle range of LOD0
+ *   -MaxLODs=3                             Each mesh gets 1..MaxLODs LODs, halving triangles per LOD
+ *   -BatchSize=256                         Assets per generate/save/GC batch
+ *   -Build                                 Build texture platform data and mesh render data before saving
+ *   -Clean                                 Delete the folder on disk first
+ *
+ * Pixel and mesh data are generated in parallel; objects are created and saved on the game thread,
+ * with package writes done asynchronously.
+ */
+UCLASS()
+class UMagicOptimizerGenerateContentCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMagicOptimizerGenerateContentCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -17,4 +17,19 @@ namespace MagicOptimizerCVars
     bool IsVerbose();
     bool IsDryRun();
     bool IsPerformanceTrackingEnabled();
+    int64 GetLogMaxFileBytes();
+    // Threads plugin batch work may use, including the calling thread (magicopt.MaxWorkerThreads, capped to the task graph)
+    MAGICOPTIMIZER_API int32 GetWorkerThreadCount();
+    // Knowledge raw files are compacted once one grows past this (magicopt.KnowledgeCompactMB; 0 = never)
+    int64 GetKnowledgeCompactBytes();
+    // Per-frame game-thread budget for time-sliced work (magicopt.GameThreadBudgetMs, or the smaller
+    // magicopt.GameThreadInteractiveBudgetMs while the user is interacting)
+    double GetGameThreadBudgetSeconds(bool bUserInteracting);
+    // An interactive (selection-scoped) request cancels a running background pass, which is requeued for
+    // the categories it did not finish (magicopt.PreemptBackground); otherwise it only jumps the queue
+    bool ShouldPreemptBackground();
+    // Working-set ceiling for load-based batches (magicopt.MemoryCeilingMB); 0 = let the governor pick
+    int64 GetMemoryCeilingBytes();
+    // Packages a batch may keep loaded before they are unloaded (magicopt.MaxLoadedPackages; 0 = no limit)
+    int32 GetMaxLoadedPackages();
 }
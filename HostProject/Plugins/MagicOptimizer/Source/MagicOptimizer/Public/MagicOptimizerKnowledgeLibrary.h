@@ -0,0 +1,45 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "MagicOptimizerKnowledgeLibrary.generated.h"
+
+/**
+ * Knowledge base entry points for the Python backend (unreal.MagicOptimizerKnowledgeLibrary).
+ * Records go through the native write-behind sink (see MagicOptimizerKnowledge::AppendLines).
+ */
+UCLASS()
+class MAGICOPTIMIZER_API UMagicOptimizerKnowledgeLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Queues a batch of records, one line each, for a knowledge file such as events.jsonl or
+	 * kb_textures.csv. Header is written first if the file is new. Returns false if the sink does
+	 * not own FileName; the caller then writes the lines itself.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MagicOptimizer|Knowledge")
+	static bool AppendKnowledgeLines(const FString& FileName, const TArray<FString>& Lines, const FString& Header);
+
+	// Blocks until every queued record is on disk
+	UFUNCTION(BlueprintCallable, Category = "MagicOptimizer|Knowledge")
+	static void FlushKnowledge();
+
+	UFUNCTION(BlueprintPure, Category = "MagicOptimizer|Knowledge")
+	static FString GetKnowledgeDir();
+
+	// Folds events recorded since the last update into the rolling aggregates; returns how many, or -1 on failure
+	UFUNCTION(BlueprintCallable, Category = "MagicOptimizer|Knowledge")
+	static int64 UpdateKnowledgeAggregates();
+
+	// The saved aggregates as JSON (per event type, profile, format, token, issue and recommendation counts)
+	UFUNCTION(BlueprintCallable, Category = "MagicOptimizer|Knowledge")
+	static FString GetKnowledgeAggregatesJson();
+
+	// Moves folded raw events into the columnar summary and trims the raw files
+	UFUNCTION(BlueprintCallable, Category = "MagicOptimizer|Knowledge")
+	static bool CompactKnowledge();
+};
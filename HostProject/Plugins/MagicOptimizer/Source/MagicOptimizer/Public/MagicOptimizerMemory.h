@@ -0,0 +1,45 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+/**
+ * Low-level memory tracker tags for the plugin's own allocations. Run the editor with -llm and use
+ * `stat LLMFULL` (or the Memory Insights LLM view) to see them as MagicOptimizer/<Area>; run reports
+ * record each tag's peak while the run was recording.
+ *
+ * MAGICOPT_LLM_SCOPE(Area) attributes the allocations of the enclosing scope on the calling thread;
+ * work started on other threads opens its own scope.
+ */
+LLM_DECLARE_TAG_API(MagicOptimizer, MAGICOPTIMIZER_API);
+// Python bridge: script arguments, captured output, result JSON
+LLM_DECLARE_TAG_API(MagicOptimizer_Bridge, MAGICOPTIMIZER_API);
+// Audit rows, CSV readers, facet and search indexes, row paging
+LLM_DECLARE_TAG_API(MagicOptimizer_AuditStore, MAGICOPTIMIZER_API);
+// Table view models and the editor widgets
+LLM_DECLARE_TAG_API(MagicOptimizer_Views, MAGICOPTIMIZER_API);
+// Audit thumbnails
+LLM_DECLARE_TAG_API(MagicOptimizer_Thumbnails, MAGICOPTIMIZER_API);
+// Apply, revert and snapshots
+LLM_DECLARE_TAG_API(MagicOptimizer_Apply, MAGICOPTIMIZER_API);
+
+// Area is Bridge, AuditStore, Views, Thumbnails or Apply; plugin code outside those uses MAGICOPT_LLM_SCOPE_ROOT
+#define MAGICOPT_LLM_SCOPE(Area) LLM_SCOPE_BYTAG(MagicOptimizer_##Area)
+#define MAGICOPT_LLM_SCOPE_ROOT() LLM_SCOPE_BYTAG(MagicOptimizer)
+
+namespace MagicOptimizerMemory
+{
+	// The root tag followed by the sub-tags, in that order
+	static constexpr int32 NumTags = 6;
+
+	// LLM names of the tags ("MagicOptimizer", "MagicOptimizer/Bridge", ...), for queries and reports
+	MAGICOPTIMIZER_API const TCHAR* GetTagName(int32 Index);
+
+	// True when the editor was started with -llm
+	MAGICOPTIMIZER_API bool IsTracking();
+
+	// Bytes currently tracked under each tag; false when LLM is not running
+	MAGICOPTIMIZER_API bool GetTagAmounts(int64 (&OutBytes)[NumTags]);
+}
@@ -3,25 +3,235 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "MagicOptimizerMemory.h"
 #include "Stats/Stats.h"
+#include "MagicOptimizerTrace.h"
 
 // Performance statistics group for MagicOptimizer
 DECLARE_STATS_GROUP(TEXT("MagicOptimizer"), STATGROUP_MagicOptimizer, STATCAT_Advanced);
 
-// Cycle counters for optimization operations
-DECLARE_CYCLE_STAT(TEXT("Optimization Pass Time"), STAT_MagicOpt_PassTime, STATGROUP_MagicOptimizer);
-DECLARE_CYCLE_STAT(TEXT("Texture Optimization Time"), STAT_MagicOpt_TextureTime, STATGROUP_MagicOptimizer);
-DECLARE_CYCLE_STAT(TEXT("Mesh Optimization Time"), STAT_MagicOpt_MeshTime, STATGROUP_MagicOptimizer);
-DECLARE_CYCLE_STAT(TEXT("Material Optimization Time"), STAT_MagicOpt_MaterialTime, STATGROUP_MagicOptimizer);
+// Cycle counters for optimization passes; each spans the pass's work on the thread that does it
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Optimization Pass Time"), STAT_MagicOpt_PassTime, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Texture Optimization Time"), STAT_MagicOpt_TextureTime, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Mesh Optimization Time"), STAT_MagicOpt_MeshTime, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Material Optimization Time"), STAT_MagicOpt_MaterialTime, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
 
-// Memory statistics
-DECLARE_DWORD_COUNTER_STAT(TEXT("Assets Processed"), STAT_MagicOpt_AssetsProcessed, STATGROUP_MagicOptimizer);
-DECLARE_DWORD_COUNTER_STAT(TEXT("Assets Optimized"), STAT_MagicOpt_AssetsOptimized, STATGROUP_MagicOptimizer);
-DECLARE_DWORD_COUNTER_STAT(TEXT("Memory Saved (MB)"), STAT_MagicOpt_MemorySaved, STATGROUP_MagicOptimizer);
+// Cycle counters per pipeline stage (see MAGICOPT_STAGE_SCOPE)
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Stage: Registry Query"), STAT_MagicOpt_Stage_RegistryQuery, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Stage: Asset Load"), STAT_MagicOpt_Stage_AssetLoad, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Stage: Analyze"), STAT_MagicOpt_Stage_Analyze, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Stage: Rule Evaluation"), STAT_MagicOpt_Stage_RuleEvaluation, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Stage: CSV Read"), STAT_MagicOpt_Stage_CsvRead, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Stage: CSV Write"), STAT_MagicOpt_Stage_CsvWrite, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Stage: Report Read"), STAT_MagicOpt_Stage_ReportRead, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Stage: Report Write"), STAT_MagicOpt_Stage_ReportWrite, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Stage: Apply"), STAT_MagicOpt_Stage_Apply, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Stage: Save"), STAT_MagicOpt_Stage_Save, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Stage: Log Write"), STAT_MagicOpt_Stage_LogWrite, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Stage: Python Bridge"), STAT_MagicOpt_Stage_Bridge, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+
+// Per-stage time accumulated over the current run, summed across threads (reset by BeginRun)
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Run: Registry Query (ms)"), STAT_MagicOpt_Run_RegistryQueryMs, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Run: Asset Load (ms)"), STAT_MagicOpt_Run_AssetLoadMs, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Run: Analyze (ms)"), STAT_MagicOpt_Run_AnalyzeMs, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Run: Rule Evaluation (ms)"), STAT_MagicOpt_Run_RuleEvaluationMs, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Run: CSV Read (ms)"), STAT_MagicOpt_Run_CsvReadMs, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Run: CSV Write (ms)"), STAT_MagicOpt_Run_CsvWriteMs, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Run: Report Read (ms)"), STAT_MagicOpt_Run_ReportReadMs, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Run: Report Write (ms)"), STAT_MagicOpt_Run_ReportWriteMs, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Run: Apply (ms)"), STAT_MagicOpt_Run_ApplyMs, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Run: Save (ms)"), STAT_MagicOpt_Run_SaveMs, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Run: Log Write (ms)"), STAT_MagicOpt_Run_LogWriteMs, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Run: Python Bridge (ms)"), STAT_MagicOpt_Run_BridgeMs, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+
+// Throughput over the current run's wall time
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Run Time (s)"), STAT_MagicOpt_RunSeconds, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Assets/s"), STAT_MagicOpt_AssetsPerSecond, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Read MB/s"), STAT_MagicOpt_ReadMBPerSecond, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("MB Read"), STAT_MagicOpt_MBRead, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("MB Written"), STAT_MagicOpt_MBWritten, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+
+// Asset counts for the current run
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Assets Processed"), STAT_MagicOpt_AssetsProcessed, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Assets Optimized"), STAT_MagicOpt_AssetsOptimized, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+
+// Memory from the texture estimator (TextureFacets::EstimateMemoryBytes)
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Estimated Texture Memory"), STAT_MagicOpt_EstimatedMemory, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Estimated Memory Saved"), STAT_MagicOpt_MemorySaved, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
 
 // Error and warning counters
-DECLARE_DWORD_COUNTER_STAT(TEXT("Optimization Errors"), STAT_MagicOpt_Errors, STATGROUP_MagicOptimizer);
-DECLARE_DWORD_COUNTER_STAT(TEXT("Optimization Warnings"), STAT_MagicOpt_Warnings, STATGROUP_MagicOptimizer);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Optimization Errors"), STAT_MagicOpt_Errors, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Optimization Warnings"), STAT_MagicOpt_Warnings, STATGROUP_MagicOptimizer, MAGICOPTIMIZER_API);
+
+namespace MagicOptimizerStats
+{
+	using MagicOptimizerTrace::EStage;
+
+	static constexpr int32 NumStages = (int32)EStage::Count;
+
+	// Slowest individually timed assets kept per run
+	static constexpr int32 MaxSlowestAssets = 50;
+
+	struct FStageStats
+	{
+		double Seconds = 0.0;
+		int64 Count = 0;
+		int64 Bytes = 0;
+	};
+
+	// A named section of a run (see FPhaseScope); times are wall clock from the run start
+	struct FPhaseStats
+	{
+		FString Name;
+		double StartSeconds = 0.0;
+		double Seconds = 0.0;
+	};
+
+	struct FAssetTiming
+	{
+		FString Path;
+		EStage Stage = EStage::Count;
+		double Seconds = 0.0;
+	};
+
+	// Snapshot of one run's numbers; the same values feed `stat MagicOptimizer` and the run report
+	struct MAGICOPTIMIZER_API FRunStats
+	{
+		FString Label;
+		FDateTime StartTime;
+		double WallSeconds = 0.0;
+		// Stopped by a cancellation; the numbers cover the work done until then
+		bool bCancelled = false;
+		FStageStats Stages[NumStages];
+
+		int64 AssetsProcessed = 0;
+		int64 AssetsOptimized = 0;
+		int64 Errors = 0;
+		int64 Warnings = 0;
+		int64 BytesRead = 0;
+		int64 BytesWritten = 0;
+		int64 EstimatedMemoryBytes = 0;
+		int64 MemorySavedBytes = 0;
+
+		// Process resources sampled while the run recorded, and garbage collections during it
+		int64 PeakWorkingSetBytes = 0;
+		int64 PeakUObjectCount = 0;
+		int64 GCPasses = 0;
+		// Peak bytes per LLM tag (MagicOptimizerMemory order); zero unless the editor runs with -llm
+		int64 PeakTagBytes[MagicOptimizerMemory::NumTags] = {};
+
+		TArray<FPhaseStats> Phases;
+		// Slowest first, at most MaxSlowestAssets
+		TArray<FAssetTiming> SlowestAssets;
+
+		double GetAssetsPerSecond() const;
+		double GetReadMBPerSecond() const;
+
+		FString ToJsonString() const;
+	};
+
+	// Starts a new run: clears the accumulators and the run stats; Label names the run's report folder.
+	// A run begun while another is recording (a dock apply spanning frames, a subsystem pass) does not
+	// reset anything: it joins the recording run, whose report then covers both.
+	MAGICOPTIMIZER_API void BeginRun(const FString& Label);
+
+	// Ends a run. The last of the joined runs to end publishes the final numbers and writes them to
+	// Saved/MagicOptimizer/Reports/<Label>_<time>/stats.json, marked cancelled if any of them was;
+	// the others only get the numbers so far.
+	MAGICOPTIMIZER_API FRunStats EndRun(bool bCancelled = false);
+
+	// Numbers of the run so far
+	MAGICOPTIMIZER_API FRunStats GetRunStats();
+
+	// Report file a finished run is written to
+	MAGICOPTIMIZER_API FString GetReportPath(const FRunStats& Stats);
+
+	// Thread-safe accumulators
+	MAGICOPTIMIZER_API void RecordAsset(EStage Stage, int64 Bytes);
+	MAGICOPTIMIZER_API void AddAssetsProcessed(int64 Count);
+	MAGICOPTIMIZER_API void AddAssetsOptimized(int64 Count);
+	MAGICOPTIMIZER_API void AddErrors(int64 Count);
+	MAGICOPTIMIZER_API void AddWarnings(int64 Count);
+	MAGICOPTIMIZER_API void AddMemorySaved(int64 Bytes);
+
+	// Estimated resident memory of the audited set; replaces the previous value
+	MAGICOPTIMIZER_API void SetEstimatedMemory(int64 Bytes);
+
+	// Time one asset took in a stage; the run keeps the slowest MaxSlowestAssets. Thread-safe.
+	MAGICOPTIMIZER_API void RecordAssetTime(EStage Stage, FStringView Path, double Seconds);
+
+	// Size of a file on disk, for the byte counts of files read or written as strings (whose Len() is
+	// characters, not bytes); 0 if it does not exist
+	MAGICOPTIMIZER_API int64 GetFileBytes(const FString& Filename);
+
+	// Wall time of a named run section, e.g. "Python" or "Evaluate"; phases may overlap
+	class MAGICOPTIMIZER_API FPhaseScope
+	{
+	public:
+		explicit FPhaseScope(FStringView InName);
+		~FPhaseScope();
+
+		FPhaseScope(const FPhaseScope&) = delete;
+		FPhaseScope& operator=(const FPhaseScope&) = delete;
+
+	private:
+		FString Name;
+		uint64 StartCycles;
+	};
+
+	// Times one asset through a stage for the slowest-assets list; does not add to the stage time
+	class MAGICOPTIMIZER_API FAssetTimer
+	{
+	public:
+		FAssetTimer(EStage InStage, FStringView InPath);
+		~FAssetTimer();
+
+		FAssetTimer(const FAssetTimer&) = delete;
+		FAssetTimer& operator=(const FAssetTimer&) = delete;
+
+	private:
+		EStage Stage;
+		FString Path;
+		uint64 StartCycles;
+	};
+
+	/**
+	 * Times a pipeline stage on the calling thread into the run's per-stage accumulator and the stage's
+	 * cycle stat. Scopes nest: a stage opened inside another pauses the outer one, so per-stage times
+	 * are exclusive and add up to the time spent in the pipeline. Work split across threads adds up
+	 * in the same accumulator.
+	 */
+	class MAGICOPTIMIZER_API FStageScope
+	{
+	public:
+		explicit FStageScope(EStage InStage);
+		~FStageScope();
+
+		FStageScope(const FStageScope&) = delete;
+		FStageScope& operator=(const FStageScope&) = delete;
+
+	private:
+		EStage Stage;
+		uint64 SliceStartCycles = 0;
+		FStageScope* Parent = nullptr;
+		FScopeCycleCounter CycleCounter;
+
+		void EndSlice(uint64 NowCycles);
+	};
+}
+
+// Stage timer plus a CPU scope of the same name on the MagicOptimizer trace channel
+#define MAGICOPT_STAGE_SCOPE(Stage, Name) \
+    MAGICOPT_TRACE_SCOPE(Name); \
+    MagicOptimizerStats::FStageScope PREPROCESSOR_JOIN(MagicOptStageScope_, __LINE__)(MagicOptimizerTrace::EStage::Stage)
+
+// Counts an asset or file and its bytes toward the run stats, and emits the matching trace event
+#define MAGICOPT_STAT_ASSET(Stage, Path, Bytes) \
+    do \
+    { \
+        MagicOptimizerStats::RecordAsset(MagicOptimizerTrace::EStage::Stage, Bytes); \
+        MAGICOPT_TRACE_ASSET(Stage, Path, Bytes); \
+    } while (0)
 
 // Performance tracking macros for easy use
 #define MAGICOPT_SCOPE_CYCLE_COUNTER(StatName) \
@@ -30,21 +240,18 @@ DECLARE_DWORD_COUNTER_STAT(TEXT("Optimization Warnings"), STAT_MagicOpt_Warnings
 #define MAGICOPT_QUICK_SCOPE_CYCLE_COUNTER(StatName) \
     QUICK_SCOPE_CYCLE_COUNTER(StatName)
 
-// Memory tracking macros
-#define MAGICOPT_TRACK_MEMORY(StatName, Value) \
-    INC_DWORD_STAT_BY(StatName, Value)
-
+// Run counters; these go through the run accumulators so the report sees the same numbers
 #define MAGICOPT_TRACK_ASSETS_PROCESSED(Count) \
-    INC_DWORD_STAT_BY(STAT_MagicOpt_AssetsProcessed, Count)
+    MagicOptimizerStats::AddAssetsProcessed(Count)
 
 #define MAGICOPT_TRACK_ASSETS_OPTIMIZED(Count) \
-    INC_DWORD_STAT_BY(STAT_MagicOpt_AssetsOptimized, Count)
+    MagicOptimizerStats::AddAssetsOptimized(Count)
 
-#define MAGICOPT_TRACK_MEMORY_SAVED(MegaBytes) \
-    INC_DWORD_STAT_BY(STAT_MagicOpt_MemorySaved, MegaBytes)
+#define MAGICOPT_TRACK_MEMORY_SAVED(Bytes) \
+    MagicOptimizerStats::AddMemorySaved(Bytes)
 
 #define MAGICOPT_TRACK_ERRORS(Count) \
-    INC_DWORD_STAT_BY(STAT_MagicOpt_Errors, Count)
+    MagicOptimizerStats::AddErrors(Count)
 
 #define MAGICOPT_TRACK_WARNINGS(Count) \
-    INC_DWORD_STAT_BY(STAT_MagicOpt_Warnings, Count)
+    MagicOptimizerStats::AddWarnings(Count)
@@ -5,9 +5,13 @@
 #include "CoreMinimal.h"
 #include "Subsystems/EngineSubsystem.h"
 #include "Engine/Engine.h"
+#include "Tasks/Task.h"
+#include "Services/Scheduling/CancellationToken.h"
+#include "PythonBridge.h"
 #include "MagicOptimizerSubsystem.generated.h"
 
 class UOptimizerSettings;
+class UPythonBridge;
 
 /**
  * Engine-level subsystem for MagicOptimizer that provides optimization services
@@ -26,7 +30,8 @@ public:
     virtual void Initialize(FSubsystemCollectionBase& Collection) override;
     virtual void Deinitialize() override;
 
-    // Optimization API
+    // Optimization API; a request made while a pass runs is queued, merged into a queued request with
+    // the same scope, and selection-scoped (interactive) requests go ahead of background ones
     UFUNCTION(BlueprintCallable, Category="Optimization", meta=(DisplayName="Run Optimization Pass"))
     void RunOptimizationPass();
 
@@ -39,10 +44,25 @@ public:
     UFUNCTION(BlueprintCallable, Category="Optimization", meta=(DisplayName="Run Material Optimization"))
     void RunMaterialOptimization();
 
+    // Stops the running pass: the Python process is terminated and nodes not started yet are skipped;
+    // the pass then completes as cancelled with the phases that did finish
+    UFUNCTION(BlueprintCallable, Category="Optimization", meta=(DisplayName="Cancel Optimization"))
+    void CancelOptimization();
+
+    // Drops the queued passes; the running one carries on
+    UFUNCTION(BlueprintCallable, Category="Optimization", meta=(DisplayName="Clear Optimization Queue"))
+    void ClearOptimizationQueue();
+
     // Status and control
     UFUNCTION(BlueprintPure, Category="Optimization")
     bool IsOptimizationRunning() const { return bOptimizationRunning; }
 
+    UFUNCTION(BlueprintPure, Category="Optimization")
+    int32 GetQueuedPassCount() const { return PassQueue.Num(); }
+
+    // The running pass, then one line per queued pass in run order (magicopt.Status)
+    void DescribeQueue(TArray<FString>& OutLines) const;
+
     UFUNCTION(BlueprintPure, Category="Optimization")
     float GetLastOptimizationTime() const { return LastOptimizationTime; }
 
@@ -54,13 +74,34 @@ public:
     UOptimizerSettings* GetOptimizerSettings() const;
 
 protected:
-    // Internal optimization methods
-    void ExecuteOptimizationPass();
-    void OnOptimizationComplete(bool bSuccess, const FString& ResultMessage);
+    struct FPassRequest
+    {
+        // "Full", "Texture", ...; merged requests join theirs, e.g. "Texture+Mesh"
+        FString Type;
+        TArray<FString> Categories;
+        // Settings as they were when the pass was requested
+        FOptimizerRunParams BaseParams;
+        // Selection-scoped; runs ahead of, and may preempt, background passes
+        bool bInteractive = false;
+        double RequestTime = 0.0;
+        // Requests merged into this one, itself included
+        int32 NumRequests = 1;
+        int32 NumPreemptions = 0;
+    };
+
+    // Builds the request from the current settings, then starts, queues or merges it
+    void RequestOptimization(const FString& OptimizationType);
+    void StartNextQueuedPass();
+
+    // Internal optimization methods; a pass runs the selected categories through the task-graph
+    // pipeline (see MagicOptimizerPipeline), categories concurrently
+    void ExecuteOptimizationPass(FPassRequest Request);
+    // UnfinishedCategories are those the cancellation token stopped, requeued if the pass was preempted
+    void OnOptimizationComplete(bool bSuccess, bool bCancelled, const FString& ResultMessage, const TArray<FString>& UnfinishedCategories);
 
     // Performance tracking
     void StartPerformanceTracking();
-    void EndPerformanceTracking();
+    void EndPerformanceTracking(bool bCancelled);
 
 private:
     // State tracking
@@ -73,6 +114,22 @@ private:
     UPROPERTY()
     int32 OptimizedAssetCount;
 
+    // Runs the pipeline's phases; created with the first pass
+    UPROPERTY()
+    UPythonBridge* PythonBridge;
+
+    // Completes once the running pass has reported back
+    UE::Tasks::FTask PassTask;
+
+    // Shared by every node of the running pass
+    FOptimizerCancellationTokenPtr PassCancelToken;
+
+    FPassRequest RunningPass;
+    // Interactive passes first, each group in request order
+    TArray<FPassRequest> PassQueue;
+    // The running pass is being cancelled to make way for an interactive one, and is requeued
+    bool bPreemptingPass = false;
+
     // Performance tracking
     double OptimizationStartTime;
     FString CurrentOptimizationType;
@@ -0,0 +1,68 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * Unreal Insights instrumentation for the optimizer pipeline.
+ *
+ * Everything is emitted on the "MagicOptimizer" trace channel, so a capture only pays for it when the
+ * channel is on (-trace=cpu,counters,MagicOptimizer or "Trace.Enable MagicOptimizer"):
+ *  - MAGICOPT_TRACE_SCOPE puts a named CPU timing scope on the Timing view.
+ *  - MAGICOPT_TRACE_ASSET(Stage, Path, Bytes), Stage being an EStage name, logs a MagicOptimizer.AssetEvent
+ *    (stage, asset or file path, byte count) and feeds the MagicOptimizer/BytesRead and
+ *    MagicOptimizer/BytesWritten counters.
+ * Per-asset scopes use fixed names; the asset itself travels in the event, so a million assets do not
+ * create a million timers.
+ */
+UE_TRACE_CHANNEL_EXTERN(MagicOptimizerChannel, MAGICOPTIMIZER_API)
+
+namespace MagicOptimizerTrace
+{
+	// Pipeline stage an asset event belongs to
+	enum class EStage : uint8
+	{
+		RegistryQuery,
+		AssetLoad,
+		Analyze,
+		RuleEvaluation,
+		CsvRead,
+		CsvWrite,
+		ReportRead,
+		ReportWrite,
+		Apply,
+		Save,
+		LogWrite,
+		Bridge,
+
+		Count
+	};
+
+	MAGICOPTIMIZER_API const TCHAR* GetStageName(EStage Stage);
+
+	// Whether a stage's byte counts are reads or writes (stages such as Apply are neither)
+	MAGICOPTIMIZER_API bool IsReadStage(EStage Stage);
+	MAGICOPTIMIZER_API bool IsWriteStage(EStage Stage);
+
+	// Emits the asset event; call through MAGICOPT_TRACE_ASSET so disabled captures skip building arguments
+	MAGICOPTIMIZER_API void OutputAssetEvent(EStage Stage, FStringView Path, int64 Bytes);
+}
+
+#define MAGICOPT_TRACE_SCOPE(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, MagicOptimizerChannel)
+
+#if UE_TRACE_ENABLED
+#define MAGICOPT_TRACE_ASSET(Stage, Path, Bytes) \
+	do \
+	{ \
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(MagicOptimizerChannel)) \
+		{ \
+			MagicOptimizerTrace::OutputAssetEvent(MagicOptimizerTrace::EStage::Stage, Path, Bytes); \
+		} \
+	} while (0)
+#else
+#define MAGICOPT_TRACE_ASSET(Stage, Path, Bytes) do {} while (0)
+#endif
@@ -16,9 +16,15 @@ namespace MagicOptimizerLog
 	// Returns the absolute path to the assistant-only backlog file
 	MAGICOPTIMIZER_API FString GetBacklogFilePath();
 
-	// Appends a single line with timestamp to the runtime log (creates directories on demand)
+	// Queues a single line with timestamp for the runtime log; written on a background thread
 	MAGICOPTIMIZER_API void AppendLine(const FString& Line);
 
-	// Appends a single line with timestamp to the assistant-only backlog
+	// Queues a single line with timestamp for the assistant-only backlog
 	MAGICOPTIMIZER_API void AppendBacklog(const FString& Line);
+
+	// Blocks until every line queued so far is on disk
+	MAGICOPTIMIZER_API void Flush();
+
+	// Flushes and stops the writer thread; later lines are written synchronously
+	MAGICOPTIMIZER_API void Shutdown();
 }
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "Services/Scheduling/CancellationToken.h"
 #include "OptimizerRun.generated.h"
 
 class UOptimizerSettings;
@@ -66,7 +67,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Optimizer Run")
 	void Run(const FString& Phase, const TArray<FString>& Categories);
 
-	// Cancel current run
+	// Cancel current run; the Python process is terminated and the run ends as Cancelled shortly after
 	UFUNCTION(BlueprintCallable, Category = "Optimizer Run")
 	void Cancel();
 
@@ -149,6 +150,9 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "Optimizer Run")
 	bool bCancelled;
 
+	// Fired by Cancel; polled by the bridge while its process runs
+	FOptimizerCancellationTokenPtr CancelToken;
+
 	// Generate run ID
 	FString GenerateRunID() const;
 
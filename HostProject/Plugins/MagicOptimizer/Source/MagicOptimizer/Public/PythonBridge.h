@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "Services/Scheduling/CancellationToken.h"
 #include "PythonBridge.generated.h"
 
 class UOptimizerSettings;
@@ -42,11 +43,16 @@ struct FOptimizerResult
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Result")
 	int32 AssetsModified;
 
+	// The run's cancellation token fired and the Python process was terminated
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Result")
+	bool bCancelled;
+
 	FOptimizerResult()
 	{
 		bSuccess = false;
 		AssetsProcessed = 0;
 		AssetsModified = 0;
+		bCancelled = false;
 	}
 };
 
@@ -79,6 +85,9 @@ struct FOptimizerRunParams
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Run")
 	bool bUseSelection;
 
+	// Optional; the Python process is terminated once it fires
+	FOptimizerCancellationTokenPtr CancelToken;
+
 	FOptimizerRunParams()
 	{
 		Phase = TEXT("audit");
@@ -112,6 +121,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Python Bridge")
 	FOptimizerResult RunPhase(const FString& Phase, const TArray<FString>& Categories);
 
+	// Parameters RunPhase uses, taken from the optimizer settings
+	FOptimizerRunParams MakePhaseParams(const FString& Phase, const TArray<FString>& Categories) const;
+
 	// Get Python script path
 	UFUNCTION(BlueprintCallable, Category = "Python Bridge")
 	FString GetPythonScriptPath() const;
@@ -136,6 +148,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Python Bridge")
 	UOptimizerSettings* GetOptimizerSettings() const;
 
+	// Python processes started by any bridge that have not exited yet; they may still be appending to the knowledge files
+	static int32 GetNumRunningProcesses();
+
+	/**
+	 * Runs Fn if no bridge process is running, holding off launches until it returns; returns false,
+	 * without running Fn, otherwise. For rewriting files the processes append to.
+	 */
+	static bool RunWithoutProcesses(TFunctionRef<void()> Fn);
+
 protected:
 	// Python script path
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Python Bridge")
@@ -156,8 +177,11 @@ protected:
 	// Initialize Python environment
 	bool InitializePythonEnvironment();
 
-	// Execute Python command
-	bool ExecutePythonCommand(const FString& Command, FString& Output, FString& Error);
+	// Runs entry.py or another script; returns early, terminating the process, if CancelToken fires
+	bool RunScript(const FString& ScriptPath, const TArray<FString>& Arguments, const FOptimizerCancellationTokenPtr& CancelToken, FString& Output, FString& Error);
+
+	// Execute Python command; the process is polled every 10 ms for output and cancellation
+	bool ExecutePythonCommand(const FString& Executable, const FString& Params, const FOptimizerCancellationTokenPtr& CancelToken, FString& Output, FString& Error);
 
 	// Validate Python script
 	bool ValidatePythonScript(const FString& ScriptPath) const;
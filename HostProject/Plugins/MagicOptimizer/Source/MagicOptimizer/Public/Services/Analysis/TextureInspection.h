@@ -0,0 +1,64 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  TextureInspection.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+#include "ViewModels/TextureModels.h"
+#include "Services/Scheduling/ExtractAnalyzeScheduler.h"
+
+/**
+ * Native texture audit on the extract/analyze scheduler: the game thread loads each texture and
+ * copies its settings (and, in the editor, its source pixels up to MaxPixelDim) into an
+ * FTextureExtract; workers classify it with the audit CSV rules and add pixel-based issue codes:
+ *   unused_alpha     the source has an alpha channel that is fully opaque
+ *   constant_color   every source pixel is the same colour
+ *   unmarked_normal  the pixels look like a tangent-space normal map but the texture is not set up as one
+ */
+namespace TextureInspection
+{
+	// Sources larger than this on either side are audited without pixel statistics
+	static constexpr int32 DefaultMaxPixelDim = 2048;
+
+	// Plain copy of what the analysis needs; no UObject references
+	struct FTextureExtract
+	{
+		FString Path;
+		int32 Width = 0;
+		int32 Height = 0;
+		FString Format;
+		FString LODGroup;
+		bool bSRGB = false;
+
+		// Source mip 0, as 8-bit BGRA or G8; empty when not available or over MaxPixelDim
+		TArray64<uint8> Pixels;
+		int32 PixelWidth = 0;
+		int32 PixelHeight = 0;
+		int32 BytesPerPixel = 0;
+		bool bSourceHasAlpha = false;
+	};
+
+	typedef TExtractAnalyzeScheduler<FSoftObjectPath, FTextureExtract, FTextureAuditRowPtr> FScheduler;
+
+	// Game thread: loads the texture and fills OutExtract; false if it is not a texture
+	MAGICOPTIMIZER_API bool ExtractTexture(const FSoftObjectPath& Path, FTextureExtract& OutExtract, int32 MaxPixelDim = DefaultMaxPixelDim);
+
+	// Any thread: audit row with type, issue codes, size bucket and estimated memory
+	MAGICOPTIMIZER_API FTextureAuditRowPtr AnalyzeTexture(FTextureExtract&& Extract);
+
+	// Scheduler wired to ExtractTexture / AnalyzeTexture
+	MAGICOPTIMIZER_API TUniquePtr<FScheduler> MakeScheduler(int32 MaxPixelDim = DefaultMaxPixelDim);
+
+	/**
+	 * Blocking audit of Paths from the game thread; the game thread extracts and helps analyse.
+	 * In-flight extracts are capped at MaxInFlightMB of pixel data. Rows keep the order of Paths;
+	 * paths that are not textures are left out. Once CancelToken fires, the rows analysed so far are returned.
+	 */
+	MAGICOPTIMIZER_API TArray<FTextureAuditRowPtr> InspectTextures(const TArray<FSoftObjectPath>& Paths, int64 MaxInFlightMB = 256,
+		const FOptimizerCancellationTokenPtr& CancelToken = nullptr);
+}
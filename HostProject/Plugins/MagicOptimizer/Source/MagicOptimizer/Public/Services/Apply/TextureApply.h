@@ -0,0 +1,39 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  TextureApply.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Services/Scheduling/GameThreadExecutor.h"
+
+class UPackage;
+
+#if WITH_EDITOR
+
+/**
+ * Work items for texture fixes, run on the game-thread executor. The dock's apply, cancel and
+ * revert batches are built from these, and the perf test times the same items.
+ *
+ * Saving needs UnrealEd, which this module does not depend on, so the caller passes the save.
+ */
+namespace TextureApply
+{
+	// Saves the package; the editor passes a checkout-and-save
+	typedef TFunction<void(UPackage* Package)> FSavePackage;
+
+	/**
+	 * Queues load-and-edit and save as separate work items, so a frame's slice can end between them.
+	 * The texture is held until its save; it has no other reference and GC may run in between.
+	 * OnEdited runs once the texture is modified, with the value it had before; OnSaved runs after the
+	 * save item, with false if the texture did not load. Transient packages, and any package when
+	 * SavePackage is unset, are left unsaved.
+	 */
+	MAGICOPTIMIZER_API void AddSetSrgbItems(TArray<MagicOptimizerGameThread::FWorkItem>& OutItems, const FString& ObjPath, bool bSRGB,
+		TFunction<void(bool bPreviousSRGB)> OnEdited, TFunction<void(bool bSaved)> OnSaved, FSavePackage SavePackage);
+}
+
+#endif
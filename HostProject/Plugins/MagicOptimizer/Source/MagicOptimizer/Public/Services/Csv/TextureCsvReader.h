@@ -9,6 +9,7 @@
 
 #include "CoreMinimal.h"
 #include "ViewModels/TextureModels.h"
+#include "Services/Paging/AssetRowSource.h"
 
 class UOptimizerSettings;
 
@@ -17,8 +18,22 @@ namespace TextureCsvReader
 	// Reads audit CSV (textures.csv) into OutRows. Returns true if file existed and was parsed.
 	MAGICOPTIMIZER_API bool ReadAuditCsv(const UOptimizerSettings* OptimizerSettings, TArray<FTextureAuditRowPtr>& OutRows);
 
+	// Reads an audit CSV at an explicit path (benchmarks, commandlets). Returns true if the file was parsed.
+	MAGICOPTIMIZER_API bool ReadAuditCsvFile(const FString& CsvPath, TArray<FTextureAuditRowPtr>& OutRows);
+
 	// Reads recommendations CSV (textures_recommend.csv) into OutRows. Returns true if file existed and was parsed.
 	MAGICOPTIMIZER_API bool ReadRecommendationsCsv(const UOptimizerSettings* OptimizerSettings, TArray<FTextureRecRowPtr>& OutRows);
+
+	// Opens the recommendations CSV as a paged row source without loading it. Returns null if there is no CSV.
+	MAGICOPTIMIZER_API TSharedPtr<const TAssetRowSource<FTextureRecRow>, ESPMode::ThreadSafe> OpenRecommendationsSource(const UOptimizerSettings* OptimizerSettings);
+
+	// Lowercased "_"-separated tokens of the short asset name: "/Game/Rock/T_Rock_N" -> t, rock, n
+	MAGICOPTIMIZER_API TArray<FString> GetAssetNameTokens(const FString& Path);
+
+	// Fills the derived columns (type, issue codes, size bucket, estimated bytes) from the read ones.
+	// Normal and mask maps are recognised by whole name tokens (_N, _Normal, _ORM, _Mask), the same
+	// heuristics as the Python recommend pass. Thread-safe.
+	MAGICOPTIMIZER_API void ClassifyTexture(FTextureAuditRow& Row);
 }
 
 
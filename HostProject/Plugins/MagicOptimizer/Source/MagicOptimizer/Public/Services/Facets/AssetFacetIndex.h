@@ -0,0 +1,90 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  AssetFacetIndex.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Dimensions the audit tables are aggregated by
+enum class EAssetFacet : uint8
+{
+	Format,
+	SizeBucket,
+	LODGroup,
+	Folder,
+	Issue,
+	Num
+};
+
+// Rows and estimated bytes carrying one facet value, over all rows and over the filtered rows
+struct FAssetFacetBucket
+{
+	FString Value;
+	int32 Count = 0;
+	int64 Bytes = 0;
+	int32 FilteredCount = 0;
+	int64 FilteredBytes = 0;
+};
+
+// Facet values of one row (a row may carry several values of a facet, e.g. issue codes)
+struct FAssetFacetRow
+{
+	TArray<TPair<EAssetFacet, FString>, TInlineAllocator<8>> Values;
+	int64 Bytes = 0;
+};
+
+/**
+ * Counts and byte sums per facet value, kept current incrementally: adding, changing or removing
+ * a row touches only that row's buckets, and a new filter result touches only the rows whose
+ * membership changed.
+ */
+class MAGICOPTIMIZER_API FAssetFacetIndex
+{
+public:
+	// Drops all rows and buckets
+	void Reset();
+
+	// Adds a row or replaces its previous contribution; a changed row keeps its filter membership
+	void SetRow(int32 RowId, const FAssetFacetRow& Row);
+	void RemoveRow(int32 RowId);
+
+	// Makes RowIds the filtered set
+	void SetFilteredRows(TConstArrayView<int32> RowIds);
+
+	// Buckets of a facet that have rows, largest filtered byte sum first
+	TArray<FAssetFacetBucket> GetBuckets(EAssetFacet Facet) const;
+	const FAssetFacetBucket* FindBucket(EAssetFacet Facet, const FString& Value) const;
+
+	int32 GetNumRows() const { return NumRows; }
+	int32 GetNumFilteredRows() const { return NumFilteredRows; }
+	int64 GetTotalBytes() const { return TotalBytes; }
+	int64 GetFilteredBytes() const { return FilteredBytes; }
+
+	static const TCHAR* GetFacetName(EAssetFacet Facet);
+
+private:
+	struct FFacetBuckets
+	{
+		TMap<FString, int32> Ids;
+		TArray<FAssetFacetBucket> Buckets;
+	};
+	FFacetBuckets Facets[(int32)EAssetFacet::Num];
+
+	// Per row: buckets as (facet << 24 | bucket index), byte contribution, presence and filter membership
+	TArray<TArray<uint32, TInlineAllocator<6>>> RowBuckets;
+	TArray<int64> RowBytes;
+	TBitArray<> RowPresent;
+	TBitArray<> RowFiltered;
+
+	int32 NumRows = 0;
+	int32 NumFilteredRows = 0;
+	int64 TotalBytes = 0;
+	int64 FilteredBytes = 0;
+
+	void AddToTotals(int32 RowId, int32 Sign);
+	void AddToFiltered(int32 RowId, int32 Sign);
+};
@@ -0,0 +1,28 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  TextureFacets.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Services/Facets/AssetFacetIndex.h"
+
+struct FTextureAuditRow;
+
+namespace TextureFacets
+{
+	// Estimated resident size from the compression setting's bits per pixel, including the full mip chain
+	MAGICOPTIMIZER_API int64 EstimateMemoryBytes(int32 Width, int32 Height, const FString& Format);
+
+	// Largest dimension rounded up to a power of two, e.g. "2K"; empty when dimensions are unknown
+	MAGICOPTIMIZER_API FString GetSizeBucket(int32 Width, int32 Height);
+
+	// First two segments of a package path, e.g. "/Game/Characters"
+	MAGICOPTIMIZER_API FString GetFolder(const FString& Path);
+
+	// Facet values of an audit row (uses the derived SizeBucket, EstimatedBytes and Issues)
+	MAGICOPTIMIZER_API FAssetFacetRow MakeRow(const FTextureAuditRow& Row);
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  KnowledgeAggregator.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Rolling aggregates over the knowledge event log, kept in Knowledge/kb_aggregates.json.
+ *
+ * Each update streams only the bytes appended to events.jsonl since the previous one and folds
+ * them into the saved counts, so insight queries cost O(new events) rather than O(history). Once
+ * the raw files pass magicopt.KnowledgeCompactMB, folded events are reduced to per-run counts in
+ * the columnar Knowledge/kb_compacted.json and dropped from the raw log. Compaction waits while a
+ * bridge Python process is running, since it appends to the raw files outside the event sink, and
+ * holds off new bridge launches until it is done.
+ */
+namespace MagicOptimizerKnowledge
+{
+	using FCountMap = TMap<FString, int64>;
+
+	struct MAGICOPTIMIZER_API FKnowledgeAggregates
+	{
+		int64 Events = 0;
+		int64 Runs = 0;
+		FString LastRunId;
+
+		FCountMap ByEventType;
+		FCountMap ByProfile;
+		FCountMap ByFormat;
+		FCountMap ByToken;
+		FCountMap ByIssue;
+		FCountMap ByRecommendation;
+
+		// Bytes of events.jsonl folded in so far
+		int64 EventsOffset = 0;
+		// Events in kb_compacted.json
+		int64 CompactedEvents = 0;
+		// Folded events not compacted yet, counted per run_id / event type / profile (keys joined by '|')
+		FCountMap PendingGroups;
+
+		FString ToJsonString() const;
+		bool FromJsonString(const FString& Json);
+	};
+
+	MAGICOPTIMIZER_API FString GetAggregatesPath();
+	MAGICOPTIMIZER_API FString GetCompactedPath();
+
+	// Saved aggregates; empty if there are none yet
+	MAGICOPTIMIZER_API FKnowledgeAggregates LoadAggregates();
+
+	/**
+	 * Folds the events appended since the last update into the saved aggregates, then compacts when
+	 * the raw files are over the limit. Returns the number of events folded in, or INDEX_NONE if the
+	 * aggregates could not be saved.
+	 */
+	MAGICOPTIMIZER_API int64 UpdateAggregates();
+
+	/**
+	 * Moves folded events into kb_compacted.json and drops them from events.jsonl; the knowledge CSVs
+	 * keep their header and their newest rows. Runs with the event sink's files closed. Returns false,
+	 * changing nothing, while a bridge Python process is running.
+	 */
+	MAGICOPTIMIZER_API bool Compact();
+}
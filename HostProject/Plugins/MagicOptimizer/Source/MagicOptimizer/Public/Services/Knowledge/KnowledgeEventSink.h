@@ -0,0 +1,45 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  KnowledgeEventSink.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Write-behind sink for the self-learning knowledge base under Saved/MagicOptimizer/Knowledge.
+ *
+ * The Python backend hands over whole batches of pre-serialized records (one JSON object or CSV
+ * row per line); they are queued on an untimestamped FAsyncLogWriter and written in blocks on its
+ * thread through handles that stay open, instead of an open/append/close per record.
+ *
+ * Only entry.py running in the editor's embedded interpreter (the commandlet) can reach the sink.
+ * Editor runs start entry.py in an external interpreter without the unreal module; there the script
+ * batches its own appends.
+ */
+namespace MagicOptimizerKnowledge
+{
+	// Absolute path of Saved/MagicOptimizer/Knowledge
+	MAGICOPTIMIZER_API FString GetKnowledgeDir();
+
+	// Whether FileName (e.g. events.jsonl) is one of the files the sink writes
+	MAGICOPTIMIZER_API bool IsKnownFile(const FString& FileName);
+
+	/**
+	 * Queues Lines for FileName; callable from any thread. Header is written first when the file
+	 * is new or empty (CSV files). Returns false, queuing nothing, for files the sink does not own.
+	 */
+	MAGICOPTIMIZER_API bool AppendLines(const FString& FileName, const TArray<FString>& Lines, const FString& Header = FString());
+
+	// Blocks until every queued record is on disk
+	MAGICOPTIMIZER_API void Flush();
+
+	// Runs Fn with every queued record on disk and the sink's files closed, e.g. to compact them
+	MAGICOPTIMIZER_API void WithFilesClosed(TFunctionRef<void()> Fn);
+
+	// Flushes and stops the writer thread; later records are written synchronously
+	MAGICOPTIMIZER_API void Shutdown();
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  AsyncLogWriter.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Templates/UniquePtr.h"
+#include <atomic>
+
+class FArchive;
+class FEvent;
+class FRunnableThread;
+
+/**
+ * Appends timestamped lines to a fixed set of log files without touching the disk on the calling thread.
+ *
+ * Producers push into a bounded lock-free ring (any number of threads, one CAS per line). A writer
+ * thread drains it every FlushIntervalMs, or sooner once the ring is half full, and writes each file's
+ * lines as one block through a handle that stays open. A file is rotated to Name.1.ext .. Name.N.ext
+ * before a write would take it past the size limit. A producer that finds the ring full waits for the
+ * writer rather than dropping the line.
+ *
+ * Flush blocks until every line queued before it is on disk; it is also run on a system error (crash)
+ * and by Shutdown, after which lines are written synchronously.
+ *
+ * Untimestamped writers store each line as is, for record files such as JSONL or CSV.
+ */
+class MAGICOPTIMIZER_API FAsyncLogWriter : public FRunnable
+{
+public:
+	static constexpr uint32 DefaultCapacity = 4096;
+	static constexpr int32 MaxRotatedFiles = 3;
+	static constexpr uint32 FlushIntervalMs = 100;
+
+	// One target per file path; Capacity is rounded up to a power of two
+	explicit FAsyncLogWriter(TArray<FString> InFilePaths, uint32 InCapacity = DefaultCapacity, bool bInTimestampLines = true);
+	virtual ~FAsyncLogWriter();
+
+	// Queues a line for the target file; callable from any thread
+	void Enqueue(int32 Target, FString Line);
+
+	void Flush();
+	void Shutdown();
+
+	// Writes out everything queued, closes the files and runs Fn before any further line is written,
+	// so Fn may rewrite or replace them; files reopen on the next write
+	void WithFilesClosed(TFunctionRef<void()> Fn);
+
+	// Files are rotated before they grow past this many bytes (<= 0 disables rotation)
+	void SetMaxFileBytes(int64 InMaxFileBytes) { MaxFileBytes.store(InMaxFileBytes, std::memory_order_relaxed); }
+
+	//~ FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	struct FSlot
+	{
+		std::atomic<uint64> Sequence{ 0 };
+		int32 Target = 0;
+		int64 Ticks = 0;
+		FString Text;
+	};
+
+	struct FTargetFile
+	{
+		FString Path;
+		TUniquePtr<FArchive> Writer;
+		TArray<ANSICHAR> Pending;
+	};
+
+	TUniquePtr<FSlot[]> Slots;
+	uint64 Mask = 0;
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePos{ 0 };
+
+	// Serializes consumers: the writer thread, Flush and the crash handler
+	FCriticalSection DrainLock;
+	uint64 DequeuePos = 0;
+	TArray<FTargetFile> Targets;
+	std::atomic<int64> MaxFileBytes{ 16 * 1024 * 1024 };
+	bool bTimestampLines = true;
+
+	FEvent* WakeEvent = nullptr;
+	FRunnableThread* Thread = nullptr;
+	std::atomic<bool> bStopping{ false };
+	FDelegateHandle SystemErrorHandle;
+
+	bool TryEnqueue(int32 Target, int64 Ticks, FString& Line);
+
+	// Moves everything published so far into the files; caller holds DrainLock
+	void DrainLocked();
+	void WriteTarget(FTargetFile& File);
+	void RotateTarget(FTargetFile& File);
+	void HandleSystemError();
+};
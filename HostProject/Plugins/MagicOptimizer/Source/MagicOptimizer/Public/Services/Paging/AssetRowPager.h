@@ -0,0 +1,173 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  AssetRowPager.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeLock.h"
+#include "Tasks/Task.h"
+#include "Services/Paging/AssetRowSource.h"
+#include "MagicOptimizerMemory.h"
+
+/**
+ * Page cache in front of a TAssetRowSource, so a list only ever materializes the rows around its
+ * visible window. Rows are fetched in fixed-size pages: pages under the window are fetched on the
+ * calling thread if missing, and for sources that can fetch asynchronously the pages within the
+ * prefetch distance either side are read on worker tasks, so scrolling usually finds them ready. The least recently used pages are dropped
+ * beyond MaxPages.
+ */
+template<typename RowType>
+class TAssetRowPager
+{
+public:
+	typedef TSharedPtr<RowType> FRowPtr;
+	typedef TSharedPtr<const TAssetRowSource<RowType>, ESPMode::ThreadSafe> FSourcePtr;
+
+	static constexpr int32 DefaultPageSize = 256;
+	static constexpr int32 DefaultMaxPages = 64;
+
+	explicit TAssetRowPager(int32 InPageSize = DefaultPageSize, int32 InMaxPages = DefaultMaxPages)
+		: PageSize(FMath::Max(1, InPageSize))
+		, MaxPages(FMath::Max(1, InMaxPages))
+		, State(MakeShared<FState, ESPMode::ThreadSafe>())
+	{
+	}
+
+	// Replaces the dataset; pages of the previous source are dropped and its prefetches ignored
+	void SetSource(FSourcePtr InSource)
+	{
+		FScopeLock Lock(&State->Lock);
+		Source = MoveTemp(InSource);
+		State->Pages.Reset();
+		State->Loading.Reset();
+		++State->Generation;
+	}
+
+	const FSourcePtr& GetSource() const { return Source; }
+	int32 Num() const { return Source.IsValid() ? Source->Num() : 0; }
+
+	int32 GetNumCachedPages() const
+	{
+		FScopeLock Lock(&State->Lock);
+		return State->Pages.Num();
+	}
+
+	// Fills OutWindow with rows [First, First + Count) and prefetches PrefetchRows either side
+	void GetWindow(int32 First, int32 Count, int32 PrefetchRows, TArray<FRowPtr>& OutWindow)
+	{
+		OutWindow.Reset();
+		const int32 Total = Num();
+		First = FMath::Clamp(First, 0, Total);
+		const int32 End = FMath::Min(Total, First + FMath::Max(0, Count));
+		if (First >= End)
+		{
+			return;
+		}
+
+		FScopeLock Lock(&State->Lock);
+		const uint64 Use = ++State->UseClock;
+		for (int32 PageIndex = First / PageSize; PageIndex <= (End - 1) / PageSize; ++PageIndex)
+		{
+			FPage* Page = State->Pages.Find(PageIndex);
+			if (!Page)
+			{
+				FPage NewPage;
+				Source->FetchRows(PageIndex * PageSize, PageSize, NewPage.Rows);
+				Page = &State->Pages.Add(PageIndex, MoveTemp(NewPage));
+			}
+			Page->LastUse = Use;
+
+			const int32 PageStart = PageIndex * PageSize;
+			const int32 RowEnd = FMath::Min(End, PageStart + Page->Rows.Num());
+			for (int32 RowIndex = FMath::Max(First, PageStart); RowIndex < RowEnd; ++RowIndex)
+			{
+				OutWindow.Add(Page->Rows[RowIndex - PageStart]);
+			}
+		}
+
+		// In-memory sources are cheap to fetch when scrolled to; only slow sources are read ahead
+		if (!Source->CanFetchAsync())
+		{
+			EvictPages();
+			return;
+		}
+		const int32 PrefetchFirst = FMath::Max(0, First - PrefetchRows) / PageSize;
+		const int32 PrefetchLast = (FMath::Min(Total, End + PrefetchRows) - 1) / PageSize;
+		for (int32 PageIndex = PrefetchFirst; PageIndex <= PrefetchLast; ++PageIndex)
+		{
+			if (!State->Pages.Contains(PageIndex) && !State->Loading.Contains(PageIndex))
+			{
+				LaunchPrefetch(PageIndex);
+			}
+		}
+		EvictPages();
+	}
+
+private:
+	struct FPage
+	{
+		TArray<FRowPtr> Rows;
+		uint64 LastUse = 0;
+	};
+
+	struct FState
+	{
+		FCriticalSection Lock;
+		TMap<int32, FPage> Pages;
+		TSet<int32> Loading;
+		uint64 Generation = 0;
+		uint64 UseClock = 0;
+	};
+
+	FSourcePtr Source;
+	int32 PageSize;
+	int32 MaxPages;
+	TSharedRef<FState, ESPMode::ThreadSafe> State;
+
+	// Called with the state lock held
+	void LaunchPrefetch(int32 PageIndex)
+	{
+		State->Loading.Add(PageIndex);
+		UE::Tasks::Launch(UE_SOURCE_LOCATION, [State = State, Source = Source, PageIndex, PageSize = PageSize, Generation = State->Generation]()
+		{
+			MAGICOPT_LLM_SCOPE(AuditStore);
+			FPage NewPage;
+			Source->FetchRows(PageIndex * PageSize, PageSize, NewPage.Rows);
+
+			FScopeLock Lock(&State->Lock);
+			if (State->Generation != Generation)
+			{
+				return;
+			}
+			State->Loading.Remove(PageIndex);
+			if (!State->Pages.Contains(PageIndex))
+			{
+				NewPage.LastUse = State->UseClock;
+				State->Pages.Add(PageIndex, MoveTemp(NewPage));
+			}
+		}, UE::Tasks::ETaskPriority::BackgroundNormal);
+	}
+
+	// Called with the state lock held; the window's pages are the most recently used, so they stay
+	void EvictPages()
+	{
+		while (State->Pages.Num() > MaxPages)
+		{
+			int32 OldestPage = INDEX_NONE;
+			uint64 OldestUse = MAX_uint64;
+			for (const TPair<int32, FPage>& Entry : State->Pages)
+			{
+				if (Entry.Value.LastUse < OldestUse)
+				{
+					OldestUse = Entry.Value.LastUse;
+					OldestPage = Entry.Key;
+				}
+			}
+			State->Pages.Remove(OldestPage);
+		}
+	}
+};
@@ -0,0 +1,60 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  AssetRowSource.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Random-access rows of a table that is not held as one materialized array, e.g. the filtered
+ * result of a view model or a CSV on disk. Rows are fetched in ranges by TAssetRowPager.
+ * A source describes a fixed snapshot: Num never changes, and a new dataset means a new source.
+ */
+template<typename RowType>
+class TAssetRowSource
+{
+public:
+	typedef TSharedPtr<RowType> FRowPtr;
+
+	virtual ~TAssetRowSource() = default;
+
+	virtual int32 Num() const = 0;
+
+	// Appends rows [Start, Start + Count) to OutRows; Count is clamped to the rows available
+	virtual void FetchRows(int32 Start, int32 Count, TArray<FRowPtr>& OutRows) const = 0;
+
+	// True if FetchRows builds new rows (e.g. parses them from disk) and may run on a worker thread.
+	// Sources that hand out rows shared with other owners must not: row pointers are not thread-safe.
+	virtual bool CanFetchAsync() const { return false; }
+};
+
+// Source over rows that are already in memory
+template<typename RowType>
+class TArrayRowSource : public TAssetRowSource<RowType>
+{
+public:
+	typedef TSharedPtr<RowType> FRowPtr;
+
+	explicit TArrayRowSource(TArray<FRowPtr> InRows)
+		: Rows(MoveTemp(InRows))
+	{
+	}
+
+	virtual int32 Num() const override { return Rows.Num(); }
+
+	virtual void FetchRows(int32 Start, int32 Count, TArray<FRowPtr>& OutRows) const override
+	{
+		const int32 End = FMath::Min(Rows.Num(), Start + Count);
+		for (int32 Index = FMath::Max(0, Start); Index < End; ++Index)
+		{
+			OutRows.Add(Rows[Index]);
+		}
+	}
+
+private:
+	TArray<FRowPtr> Rows;
+};
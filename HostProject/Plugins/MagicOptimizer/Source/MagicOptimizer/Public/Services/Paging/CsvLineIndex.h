@@ -0,0 +1,38 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  CsvLineIndex.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Byte offsets of the non-empty lines of a UTF-8 CSV, so any range of lines can be read back
+ * without holding the file in memory (8 bytes per line). Reads open their own file handle and
+ * are safe from any thread.
+ */
+class MAGICOPTIMIZER_API FCsvLineIndex
+{
+public:
+	/**
+	 * Scans the file. If the first non-empty line starts with HeaderPrefix (case-insensitive) it is
+	 * kept as the header and not counted as a line. Returns false if the file could not be read.
+	 */
+	bool Build(const FString& InPath, const TCHAR* HeaderPrefix = nullptr);
+
+	int32 Num() const { return LineStarts.Num(); }
+	const FString& GetPath() const { return Path; }
+	const FString& GetHeader() const { return Header; }
+
+	// Appends lines [Start, Start + Count) to OutLines, without their line endings
+	void ReadLines(int32 Start, int32 Count, TArray<FString>& OutLines) const;
+
+private:
+	FString Path;
+	FString Header;
+	TArray<int64> LineStarts;
+	int64 FileSize = 0;
+};
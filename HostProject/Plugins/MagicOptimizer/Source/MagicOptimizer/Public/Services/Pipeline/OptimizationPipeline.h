@@ -0,0 +1,89 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  OptimizationPipeline.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "Services/Scheduling/CancellationToken.h"
+
+/**
+ * Audit -> Recommend -> Apply -> Verify for several asset categories as a graph of UE::Tasks.
+ *
+ * Each category is its own chain, each phase having the previous one as prerequisite, so categories
+ * run concurrently and a category moves on as soon as its own previous phase is done (texture
+ * recommendations do not wait for the mesh audit). Apply nodes go through one pipe, because
+ * modifying and saving assets must not overlap between categories. A failed phase ends its
+ * category's chain; the other categories carry on. Once the pass's cancellation token fires, nodes
+ * not started yet are skipped and the running ones are expected to return early.
+ */
+namespace MagicOptimizerPipeline
+{
+	enum class EPhase : uint8
+	{
+		Audit,
+		Recommend,
+		Apply,
+		Verify,
+	};
+
+	static constexpr int32 NumPhases = (int32)EPhase::Verify + 1;
+
+	// Phase name as passed to entry.py ("audit", "recommend", ...)
+	MAGICOPTIMIZER_API const TCHAR* GetPhaseName(EPhase Phase);
+
+	// Pipeline categories in the mask (EOptimizerCategory bits), in a fixed order: Textures, Meshes, Materials, Audio
+	MAGICOPTIMIZER_API TArray<FString> GetCategories(uint8 CategoryMask);
+
+	struct FNodeResult
+	{
+		bool bSuccess = false;
+		// Stopped by the pass's cancellation token rather than failed
+		bool bCancelled = false;
+		FString Message;
+	};
+
+	struct FCategoryResult
+	{
+		FString Category;
+		bool bSuccess = true;
+		// bSuccess is false too; the chain stopped at LastPhase
+		bool bCancelled = false;
+		// Last phase that ran; the failed one when bSuccess is false
+		EPhase LastPhase = EPhase::Audit;
+		FString Message;
+		// Summed over the category's phases
+		double Seconds = 0.0;
+	};
+
+	struct MAGICOPTIMIZER_API FPassResult
+	{
+		TArray<FCategoryResult> Categories;
+		double WallSeconds = 0.0;
+
+		bool IsSuccess() const;
+		bool WasCancelled() const;
+		// One line, e.g. "Textures ok, Meshes failed in recommend (...)"
+		FString GetSummary() const;
+	};
+
+	// Runs one phase for one category on a worker thread; called concurrently for different categories
+	using FRunNode = TFunction<FNodeResult(EPhase Phase, const FString& Category)>;
+
+	struct FPassDesc
+	{
+		TArray<FString> Categories;
+		// Phases from Audit up to and including this one
+		EPhase LastPhase = EPhase::Verify;
+		FRunNode RunNode;
+		// Optional; checked before each node
+		FOptimizerCancellationTokenPtr CancelToken;
+	};
+
+	// Launches the graph; the returned task completes once every category's chain has finished
+	MAGICOPTIMIZER_API UE::Tasks::TTask<FPassResult> LaunchPass(FPassDesc Desc);
+}
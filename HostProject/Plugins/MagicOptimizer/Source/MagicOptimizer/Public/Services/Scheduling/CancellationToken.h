@@ -0,0 +1,52 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  CancellationToken.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include <atomic>
+
+/**
+ * Cooperative cancellation, shared by every stage of one run.
+ *
+ * Whoever starts the run creates the token and hands it to each stage. Cancel may then be called from
+ * any thread. Stages poll IsCancelled between small units of work, such as an asset, a pipeline node or
+ * one 10 ms poll of the Python process. On cancellation a stage stops and returns what it has finished,
+ * so a cancelled run ends within about 100 ms with a consistent partial result.
+ */
+class FOptimizerCancellationToken
+{
+public:
+	// Idempotent; the first call's time is kept
+	void Cancel()
+	{
+		bool bExpected = false;
+		if (bCancelled.compare_exchange_strong(bExpected, true))
+		{
+			CancelTime.store(FPlatformTime::Seconds(), std::memory_order_relaxed);
+		}
+	}
+
+	bool IsCancelled() const
+	{
+		return bCancelled.load(std::memory_order_relaxed);
+	}
+
+	// Time from Cancel to now, for logging how long a stage took to stop; 0 if not cancelled
+	double GetSecondsSinceCancel() const
+	{
+		const double Time = CancelTime.load(std::memory_order_relaxed);
+		return Time > 0.0 ? FPlatformTime::Seconds() - Time : 0.0;
+	}
+
+private:
+	std::atomic<bool> bCancelled{ false };
+	std::atomic<double> CancelTime{ 0.0 };
+};
+
+typedef TSharedPtr<FOptimizerCancellationToken, ESPMode::ThreadSafe> FOptimizerCancellationTokenPtr;
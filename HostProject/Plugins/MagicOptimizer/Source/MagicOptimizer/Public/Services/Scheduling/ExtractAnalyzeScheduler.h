@@ -0,0 +1,313 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  ExtractAnalyzeScheduler.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include "Tasks/Task.h"
+#include "MagicOptimizerCVars.h"
+#include "MagicOptimizerMemory.h"
+#include "MagicOptimizerTrace.h"
+#include "Services/Scheduling/CancellationToken.h"
+#include "Services/Scheduling/MemoryGovernor.h"
+#include <atomic>
+
+/**
+ * Splits asset analysis into a game-thread extraction step and worker-thread analysis.
+ *
+ * Pump runs on the game thread. It extracts items one at a time. Extract reads the UObject and copies
+ * the fields the analysis needs into a plain struct. Pump stops once its time budget is used, or when
+ * the extracted items not yet analysed reach MaxInFlight or MaxInFlightBytes. Extraction only resumes as
+ * analysis catches up, so extracted data never piles up beyond that window. Under memory pressure the
+ * memory governor shrinks MaxInFlight, and it may unload the assets already extracted between items.
+ *
+ * Extracted items are analysed on the UE::Tasks worker pool, which is work-stealing. At most
+ * magicopt.MaxWorkerThreads drain tasks run at once, each taking items until the queue is empty.
+ * Results keep the order of the input items; items whose extraction failed have no result.
+ *
+ * RunToCompletion pumps until everything is analysed, helping with analysis while the window is full.
+ * Use it from commandlets, tests or a blocking editor action.
+ */
+template<typename ItemType, typename ExtractedType, typename ResultType>
+class TExtractAnalyzeScheduler
+{
+public:
+	// Game thread; false skips the item
+	typedef TFunction<bool(const ItemType& Item, ExtractedType& OutExtracted)> FExtractFn;
+	// Any worker thread, concurrently; must not touch UObjects
+	typedef TFunction<ResultType(ExtractedType&& Extracted)> FAnalyzeFn;
+	// Memory held by an extracted item, for MaxInFlightBytes
+	typedef TFunction<int64(const ExtractedType& Extracted)> FSizeFn;
+
+	struct FSettings
+	{
+		// Extracted items waiting for or in analysis; 0 = twice the worker count
+		int32 MaxInFlight = 0;
+		// Bytes held by those items (needs a size function); 0 = no limit
+		int64 MaxInFlightBytes = 0;
+		// Optional; once it fires the batch stops as if Cancel had been called
+		FOptimizerCancellationTokenPtr CancelToken;
+	};
+
+	TExtractAnalyzeScheduler(FExtractFn InExtract, FAnalyzeFn InAnalyze, FSizeFn InGetSize = FSizeFn())
+		: Extract(MoveTemp(InExtract))
+		, State(MakeShared<FState, ESPMode::ThreadSafe>())
+	{
+		State->Analyze = MoveTemp(InAnalyze);
+		State->GetSize = MoveTemp(InGetSize);
+	}
+
+	~TExtractAnalyzeScheduler()
+	{
+		Cancel();
+		WaitForWorkers();
+	}
+
+	// Starts over with a new batch; the previous one must be done or cancelled
+	void Start(TArray<ItemType> InItems, const FSettings& InSettings = FSettings())
+	{
+		check(IsInGameThread());
+		WaitForWorkers();
+		Items = MoveTemp(InItems);
+		NextItem = 0;
+		MaxWorkers = FMath::Max(1, MagicOptimizerCVars::GetWorkerThreadCount());
+		MaxInFlight = InSettings.MaxInFlight > 0 ? InSettings.MaxInFlight : MaxWorkers * 2;
+		MaxInFlightBytes = State->GetSize ? InSettings.MaxInFlightBytes : 0;
+
+		FScopeLock Lock(&State->Lock);
+		State->Pending.Reset();
+		State->Results.Reset();
+		State->Results.SetNum(Items.Num());
+		State->InFlight = 0;
+		State->InFlightBytes = 0;
+		State->Analyzed = 0;
+		State->bCancelled = false;
+		State->CancelToken = InSettings.CancelToken;
+	}
+
+	/**
+	 * Extracts items until BudgetSeconds have passed or the in-flight window is full; at least one
+	 * item when there is room, so a small budget still makes progress. Returns true while work remains.
+	 */
+	bool Pump(double BudgetSeconds)
+	{
+		check(IsInGameThread());
+		MAGICOPT_LLM_SCOPE_ROOT();
+		if (IsTokenCancelled(*State) && !State->bCancelled)
+		{
+			Cancel();
+		}
+		const double EndTime = FPlatformTime::Seconds() + BudgetSeconds;
+		bool bExtractedAny = false;
+		while (NextItem < Items.Num() && !State->bCancelled && !IsTokenCancelled(*State) && HasRoom())
+		{
+			if (bExtractedAny && FPlatformTime::Seconds() >= EndTime)
+			{
+				break;
+			}
+			MagicOptimizerMemoryGovernor::Update();
+			if (!HasRoom())
+			{
+				break;
+			}
+			const int32 Index = NextItem++;
+			ExtractedType Extracted;
+			bool bExtracted = false;
+			{
+				MAGICOPT_TRACE_SCOPE(MagicOptimizer_SchedulerExtract);
+				bExtracted = Extract(Items[Index], Extracted);
+			}
+			if (bExtracted)
+			{
+				Enqueue(Index, MoveTemp(Extracted));
+				bExtractedAny = true;
+			}
+		}
+		return !IsDone();
+	}
+
+	// Pumps until every item is analysed; the calling (game) thread analyses items itself while waiting
+	void RunToCompletion(double BudgetSeconds = 0.005)
+	{
+		while (Pump(BudgetSeconds))
+		{
+			if (!HasRoom() || NextItem >= Items.Num() || State->bCancelled)
+			{
+				if (!AnalyzeOne(*State))
+				{
+					FPlatformProcess::SleepNoStats(0.0005f);
+				}
+			}
+		}
+		WaitForWorkers();
+	}
+
+	// Stops extracting; queued items are dropped and analyses already running finish
+	void Cancel()
+	{
+		FScopeLock Lock(&State->Lock);
+		State->bCancelled = true;
+		for (const FPending& Pending : State->Pending)
+		{
+			State->InFlightBytes -= Pending.Bytes;
+		}
+		State->InFlight -= State->Pending.Num();
+		State->Pending.Reset();
+	}
+
+	bool IsDone() const
+	{
+		return (NextItem >= Items.Num() || State->bCancelled) && State->InFlight.load() == 0;
+	}
+
+	int32 Num() const { return Items.Num(); }
+	int32 GetNumExtracted() const { return NextItem; }
+	int32 GetNumAnalyzed() const { return State->Analyzed.load(); }
+	int32 GetNumInFlight() const { return State->InFlight.load(); }
+
+	// Results in input order, once IsDone; unset for skipped or cancelled items
+	TArray<TOptional<ResultType>> TakeResults()
+	{
+		check(IsDone());
+		WaitForWorkers();
+		FScopeLock Lock(&State->Lock);
+		return MoveTemp(State->Results);
+	}
+
+private:
+	struct FPending
+	{
+		int32 Index = INDEX_NONE;
+		int64 Bytes = 0;
+		ExtractedType Extracted;
+	};
+
+	// Shared with the drain tasks, which may outlive a Cancel
+	struct FState
+	{
+		FAnalyzeFn Analyze;
+		FSizeFn GetSize;
+		FOptimizerCancellationTokenPtr CancelToken;
+
+		FCriticalSection Lock;
+		// FIFO; bounded by MaxInFlight, so removing from the front stays cheap
+		TArray<FPending> Pending;
+		TArray<UE::Tasks::FTask> Workers;
+		int32 ActiveWorkers = 0;
+
+		// Each written only by the task that analyses that item
+		TArray<TOptional<ResultType>> Results;
+
+		std::atomic<int32> InFlight{ 0 };
+		std::atomic<int64> InFlightBytes{ 0 };
+		std::atomic<int32> Analyzed{ 0 };
+		std::atomic<bool> bCancelled{ false };
+	};
+
+	typedef TSharedRef<FState, ESPMode::ThreadSafe> FStateRef;
+
+	bool HasRoom() const
+	{
+		if (State->InFlight.load() >= MagicOptimizerMemoryGovernor::ThrottleWindow(MaxInFlight))
+		{
+			return false;
+		}
+		// One item may go over the byte limit on its own, or a large item would never be extracted
+		return MaxInFlightBytes <= 0 || State->InFlight.load() == 0 || State->InFlightBytes.load() < MaxInFlightBytes;
+	}
+
+	void Enqueue(int32 Index, ExtractedType&& Extracted)
+	{
+		const int64 Bytes = State->GetSize ? State->GetSize(Extracted) : 0;
+
+		FScopeLock Lock(&State->Lock);
+		State->Pending.Add(FPending{ Index, Bytes, MoveTemp(Extracted) });
+		++State->InFlight;
+		State->InFlightBytes += Bytes;
+		if (State->ActiveWorkers < MaxWorkers)
+		{
+			++State->ActiveWorkers;
+			State->Workers.RemoveAll([](const UE::Tasks::FTask& Worker) { return Worker.IsCompleted(); });
+			State->Workers.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [WorkerState = State]()
+			{
+				Drain(*WorkerState);
+			}));
+		}
+	}
+
+	static bool IsTokenCancelled(const FState& InState)
+	{
+		return InState.CancelToken.IsValid() && InState.CancelToken->IsCancelled();
+	}
+
+	// Analyses one queued item, or drops it once cancelled; returns false if there was none
+	static bool AnalyzeOne(FState& InState)
+	{
+		FPending Item;
+		{
+			FScopeLock Lock(&InState.Lock);
+			if (InState.Pending.Num() == 0)
+			{
+				return false;
+			}
+			Item = MoveTemp(InState.Pending[0]);
+			InState.Pending.RemoveAt(0, EAllowShrinking::No);
+		}
+
+		if (!InState.bCancelled && !IsTokenCancelled(InState))
+		{
+			MAGICOPT_TRACE_SCOPE(MagicOptimizer_SchedulerAnalyze);
+			InState.Results[Item.Index] = InState.Analyze(MoveTemp(Item.Extracted));
+			++InState.Analyzed;
+		}
+		InState.InFlightBytes -= Item.Bytes;
+		--InState.InFlight;
+		return true;
+	}
+
+	static void Drain(FState& InState)
+	{
+		MAGICOPT_LLM_SCOPE_ROOT();
+		for (;;)
+		{
+			if (!AnalyzeOne(InState))
+			{
+				// Re-checked under the lock, so an item queued after the miss either sees this worker
+				// still active or launches a new one
+				FScopeLock Lock(&InState.Lock);
+				if (InState.Pending.Num() == 0)
+				{
+					--InState.ActiveWorkers;
+					return;
+				}
+			}
+		}
+	}
+
+	void WaitForWorkers()
+	{
+		TArray<UE::Tasks::FTask> Workers;
+		{
+			FScopeLock Lock(&State->Lock);
+			Workers = State->Workers;
+		}
+		UE::Tasks::Wait(Workers);
+	}
+
+	FExtractFn Extract;
+	FStateRef State;
+
+	// Game thread only
+	TArray<ItemType> Items;
+	int32 NextItem = 0;
+	int32 MaxWorkers = 1;
+	int32 MaxInFlight = 2;
+	int64 MaxInFlightBytes = 0;
+};
@@ -0,0 +1,64 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  GameThreadExecutor.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Services/Scheduling/CancellationToken.h"
+
+/**
+ * Time-sliced execution of work that has to stay on the game thread: loads, Modify/PostEditChange,
+ * package saves.
+ *
+ * Work is queued as jobs, each a list of items run in order; jobs run one after another. A core
+ * ticker runs items each frame until magicopt.GameThreadBudgetMs is used, and always at least one,
+ * so a batch of thousands of assets leaves the editor usable instead of freezing it. While the user
+ * is interacting (input within InteractionWindowSeconds, as reported by the probe the editor module
+ * installs) the smaller magicopt.GameThreadInteractiveBudgetMs applies.
+ *
+ * Everything here is game thread only.
+ */
+namespace MagicOptimizerGameThread
+{
+	typedef TFunction<void()> FWorkItem;
+	// bCompleted is false when the job was cancelled before its last item ran
+	typedef TFunction<void(bool bCompleted)> FOnJobDone;
+	// Seconds since the user last gave input
+	typedef TFunction<double()> FInteractionProbe;
+
+	static constexpr double InteractionWindowSeconds = 0.5;
+
+	/**
+	 * Queues a job and returns its id (never 0); OnDone runs on the game thread once it finishes or is
+	 * cancelled. A job whose CancelToken fires is cancelled before its next item.
+	 */
+	MAGICOPTIMIZER_API uint32 Enqueue(const FString& Name, TArray<FWorkItem> Items, FOnJobDone OnDone = FOnJobDone(),
+		const FOptimizerCancellationTokenPtr& CancelToken = nullptr);
+
+	// Drops the job's remaining items and calls its OnDone with false
+	MAGICOPTIMIZER_API void Cancel(uint32 JobId);
+
+	// Runs the job, and the jobs queued before it, to the end now; 0 runs everything queued (commandlets, tests)
+	MAGICOPTIMIZER_API void Flush(uint32 JobId = 0);
+
+	MAGICOPTIMIZER_API bool IsQueued(uint32 JobId);
+
+	// Items run and total for a queued job; false once it is done
+	MAGICOPTIMIZER_API bool GetProgress(uint32 JobId, int32& OutDone, int32& OutTotal);
+
+	// Items left over all queued jobs
+	MAGICOPTIMIZER_API int32 GetNumQueuedItems();
+
+	MAGICOPTIMIZER_API void SetInteractionProbe(FInteractionProbe Probe);
+	MAGICOPTIMIZER_API bool IsUserInteracting();
+
+	// Budget the next tick will use
+	MAGICOPTIMIZER_API double GetBudgetSeconds();
+
+	// Cancels what is queued and stops ticking; called when the module shuts down
+	void Shutdown();
+}
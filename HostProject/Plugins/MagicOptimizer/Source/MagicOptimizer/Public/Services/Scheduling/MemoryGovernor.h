@@ -0,0 +1,65 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  MemoryGovernor.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UObject;
+struct FSoftObjectPath;
+
+/**
+ * Keeps load-based batches (inspection, apply, snapshot, revert) within a memory ceiling.
+ *
+ * In the editor, loaded assets are RF_Standalone and garbage collection keeps them. A batch that loads
+ * every texture in the project would keep them all resident. Batches load through LoadAsset, which
+ * remembers the packages it had to load. Update runs between items. Once the working set reaches
+ * magicopt.MemoryCeilingMB, or the remembered packages reach magicopt.MaxLoadedPackages, Reclaim unloads
+ * those packages: clean ones lose RF_Standalone, and a garbage collection frees the ones nothing else
+ * references, linkers included. Packages that were resident before the batch, or that are dirty, are
+ * left alone. The commandlet's -native inspection and the dock's apply batches load through it.
+ *
+ * Between the soft limit and the ceiling, ThrottleWindow shrinks the number of assets a batch keeps
+ * loaded ahead of its analysis, down to one at the ceiling.
+ *
+ * Everything here is game thread only.
+ */
+namespace MagicOptimizerMemoryGovernor
+{
+	// Fraction of the ceiling above which load windows start to shrink
+	static constexpr double SoftLimitFraction = 0.75;
+
+	struct FStatus
+	{
+		int64 UsedPhysicalBytes = 0;
+		int64 CeilingBytes = 0;
+		// Packages loaded through LoadAsset and not unloaded yet
+		int32 NumTrackedPackages = 0;
+		int32 NumReclaims = 0;
+		int32 NumUnloadedPackages = 0;
+	};
+
+	// Resolves the asset, loading it if needed; a package it had to load becomes a candidate for unloading
+	MAGICOPTIMIZER_API UObject* LoadAsset(const FSoftObjectPath& Path);
+
+	// Samples memory (at most every few ms) and reclaims once a limit is reached; call between items
+	MAGICOPTIMIZER_API void Update();
+
+	// Unloads the tracked packages that are clean and collects garbage now; returns the packages unloaded
+	MAGICOPTIMIZER_API int32 Reclaim();
+
+	// Working set over the ceiling as of the last sample: below 1 is under it
+	MAGICOPTIMIZER_API double GetPressure();
+
+	// MaxWindow while under the soft limit, then scaled down to 1 at the ceiling
+	MAGICOPTIMIZER_API int32 ThrottleWindow(int32 MaxWindow);
+
+	MAGICOPTIMIZER_API FStatus GetStatus();
+
+	// Forgets the tracked packages; called when the module shuts down
+	void Shutdown();
+}
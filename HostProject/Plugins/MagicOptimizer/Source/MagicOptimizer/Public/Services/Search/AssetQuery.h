@@ -0,0 +1,53 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  AssetQuery.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Comparison of a query term
+enum class EAssetQueryOp : uint8
+{
+	Contains,		// key:value (substring on text columns, equality on numeric columns)
+	Equal,			// key=value
+	Greater,		// key>value
+	GreaterEqual,	// key>=value
+	Less,			// key<value
+	LessEqual		// key<=value
+};
+
+// One term of a search query; terms are combined with AND
+struct FAssetQueryTerm
+{
+	// Field name as typed (empty for a bare word, which matches any searchable column)
+	FString Key;
+	EAssetQueryOp Op = EAssetQueryOp::Contains;
+
+	// Case-folded value
+	FString Value;
+
+	// Leading '-' excludes matching rows
+	bool bNegated = false;
+
+	bool operator==(const FAssetQueryTerm& Other) const
+	{
+		return Op == Other.Op && bNegated == Other.bNegated && Key.Equals(Other.Key, ESearchCase::IgnoreCase) && Value == Other.Value;
+	}
+	bool operator!=(const FAssetQueryTerm& Other) const { return !(*this == Other); }
+};
+
+/**
+ * Parser for the dock search box query language, e.g.
+ *   type:normal width>2048 format:TC_Default -path:/Game/UI issue:srgb "two words"
+ * Terms are separated by whitespace; values containing spaces can be quoted.
+ */
+namespace AssetQuery
+{
+	// Parses Query into terms. Returns false and sets OutError on a malformed term; the
+	// well-formed terms are still returned so the table keeps filtering while the user types.
+	MAGICOPTIMIZER_API bool Parse(const FString& Query, TArray<FAssetQueryTerm>& OutTerms, FString& OutError);
+}
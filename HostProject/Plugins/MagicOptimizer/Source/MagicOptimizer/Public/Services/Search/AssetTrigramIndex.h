@@ -0,0 +1,47 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+/*
+  AssetTrigramIndex.h
+  Part of the MagicOptimizer Unreal Engine plugin.
+  Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Trigram posting-list index for substring search over a column of case-folded strings
+ * (asset paths, formats). Documents are interned, so repeated values such as formats cost one
+ * entry. Build once per data load (safe on a worker thread), then query from any thread.
+ */
+class MAGICOPTIMIZER_API FAssetTrigramIndex
+{
+public:
+	// Needles shorter than this cannot be answered by the index
+	static constexpr int32 TrigramLength = 3;
+
+	// Builds the index; document ids are indices into Documents, which must already be case-folded
+	void Build(const TArray<FString>& Documents);
+
+	// Finds every document containing FoldedNeedle. Returns false if the needle is too short to be
+	// answered by the index, in which case the caller must scan. OutDocIds is unordered.
+	bool FindDocuments(const FString& FoldedNeedle, TArray<int32>& OutDocIds) const;
+
+	int32 GetNumDocuments() const { return DocToString.Num(); }
+	int32 GetNumUniqueStrings() const { return Strings.Num(); }
+	int32 GetNumTrigrams() const { return Postings.Num(); }
+
+private:
+	// Interned unique strings and the string id of each document
+	TArray<FString> Strings;
+	TArray<int32> DocToString;
+
+	// Documents of each unique string: StringDocs[StringDocOffsets[Id] .. StringDocOffsets[Id + 1])
+	TArray<int32> StringDocOffsets;
+	TArray<int32> StringDocs;
+
+	// Trigram key -> ascending unique string ids containing it
+	TMap<uint64, TArray<int32>> Postings;
+
+	static uint64 MakeKey(const TCHAR* Chars);
+};
@@ -0,0 +1,105 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Sort.h"
+#include "MagicOptimizerMemory.h"
+
+// One level of a multi-column sort
+struct FAssetTableSortKey
+{
+	FName ColumnId;
+	bool bAscending = true;
+};
+
+/**
+ * Sorting helpers for the asset table view models.
+ * Table sorts run over precomputed integer keys (dense per-column ranks packed into uint64 where they
+ * fit), so the comparator never touches row objects and large tables can be sorted across workers.
+ */
+namespace AssetTableSort
+{
+	// Below this many items a single-threaded sort is faster than splitting the work
+	static constexpr int32 MinItemsForParallelSort = 16384;
+
+	// Bits needed to hold values in [0, MaxValue]
+	inline int32 BitsFor(uint32 MaxValue)
+	{
+		return MaxValue == 0 ? 0 : (int32)FMath::FloorLog2(MaxValue) + 1;
+	}
+
+	/**
+	 * Sorts Items by Less: each worker sorts one chunk, then sorted runs are merged pairwise in
+	 * parallel passes. Not stable for equal items; callers make keys unique (e.g. by row index).
+	 */
+	template<typename ItemType, typename LessType>
+	void ParallelSort(TArray<ItemType>& Items, const LessType& Less)
+	{
+		const int32 NumItems = Items.Num();
+		int32 NumChunks = 1;
+		const int32 MaxChunks = FMath::Max(1, FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+		while (NumChunks * 2 <= MaxChunks && NumItems / (NumChunks * 2) >= MinItemsForParallelSort / 2)
+		{
+			NumChunks *= 2;
+		}
+		if (NumChunks == 1)
+		{
+			Algo::Sort(Items, Less);
+			return;
+		}
+
+		const int32 ChunkSize = FMath::DivideAndRoundUp(NumItems, NumChunks);
+		ItemType* Data = Items.GetData();
+		ParallelFor(NumChunks, [Data, NumItems, ChunkSize, &Less](const int32 Chunk)
+		{
+			MAGICOPT_LLM_SCOPE(Views);
+			const int32 Start = Chunk * ChunkSize;
+			const int32 End = FMath::Min(NumItems, Start + ChunkSize);
+			if (Start < End)
+			{
+				Algo::Sort(TArrayView<ItemType>(Data + Start, End - Start), Less);
+			}
+		});
+
+		TArray<ItemType> Scratch;
+		Scratch.SetNumUninitialized(NumItems);
+		ItemType* Source = Data;
+		ItemType* Dest = Scratch.GetData();
+		for (int64 RunLength = ChunkSize; RunLength < NumItems; RunLength *= 2)
+		{
+			const int32 NumPairs = (int32)((NumItems + 2 * RunLength - 1) / (2 * RunLength));
+			ParallelFor(NumPairs, [Source, Dest, NumItems, RunLength, &Less](const int32 Pair)
+			{
+				MAGICOPT_LLM_SCOPE(Views);
+				const int32 Start = (int32)(Pair * 2 * RunLength);
+				const int32 Mid = (int32)FMath::Min<int64>(NumItems, Start + RunLength);
+				const int32 End = (int32)FMath::Min<int64>(NumItems, Start + 2 * RunLength);
+				int32 Left = Start;
+				int32 Right = Mid;
+				int32 Out = Start;
+				while (Left < Mid && Right < End)
+				{
+					Dest[Out++] = Less(Source[Right], Source[Left]) ? Source[Right++] : Source[Left++];
+				}
+				while (Left < Mid)
+				{
+					Dest[Out++] = Source[Left++];
+				}
+				while (Right < End)
+				{
+					Dest[Out++] = Source[Right++];
+				}
+			});
+			Swap(Source, Dest);
+		}
+		if (Source != Data)
+		{
+			for (int32 Index = 0; Index < NumItems; ++Index)
+			{
+				Data[Index] = MoveTemp(Source[Index]);
+			}
+		}
+	}
+}
@@ -0,0 +1,1387 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+#include "Services/Search/AssetTrigramIndex.h"
+#include "Services/Search/AssetQuery.h"
+#include "ViewModels/AssetTableSort.h"
+#include "Services/Paging/AssetRowSource.h"
+#include "MagicOptimizerTrace.h"
+#include "MagicOptimizerMemory.h"
+
+// Fired on the game thread whenever a table view model publishes new filtered/sorted results
+DECLARE_MULTICAST_DELEGATE(FOnAssetTableResultsReady);
+
+// How a column takes part in per-column filtering
+enum class EAssetColumnFilterKind : uint8
+{
+	None,		// Column is not filterable
+	Contains,	// Case-insensitive substring match on a text column
+	MinValue	// Lower bound on a numeric column (0 disables the filter)
+};
+
+/**
+ * Column descriptor for a table of RowType.
+ * A column is either a text column (GetText bound) or a numeric column (GetNumber bound);
+ * the descriptor provides the comparator used for sorting and the filter kind used for filtering.
+ */
+template<typename RowType>
+struct TAssetTableColumn
+{
+	FName Id;
+	EAssetColumnFilterKind FilterKind = EAssetColumnFilterKind::None;
+
+	// Whether the free-text search box matches against this column
+	bool bTextSearchable = false;
+
+	// Extra field names accepted by the query language (the Id always matches)
+	TArray<FString> QueryAliases;
+
+	TFunction<const FString&(const RowType&)> GetText;
+	TFunction<int64(const RowType&)> GetNumber;
+
+	bool IsNumeric() const { return (bool)GetNumber; }
+
+	int32 Compare(const RowType& A, const RowType& B) const
+	{
+		if (IsNumeric())
+		{
+			const int64 ValueA = GetNumber(A);
+			const int64 ValueB = GetNumber(B);
+			return ValueA < ValueB ? -1 : (ValueA > ValueB ? 1 : 0);
+		}
+		return GetText(A).Compare(GetText(B));
+	}
+
+	bool MatchesQueryKey(const FString& Key) const
+	{
+		return Id.ToString().Equals(Key, ESearchCase::IgnoreCase)
+			|| QueryAliases.ContainsByPredicate([&Key](const FString& Alias) { return Alias.Equals(Key, ESearchCase::IgnoreCase); });
+	}
+
+	TAssetTableColumn& WithAliases(std::initializer_list<const TCHAR*> InAliases)
+	{
+		for (const TCHAR* Alias : InAliases)
+		{
+			QueryAliases.Add(Alias);
+		}
+		return *this;
+	}
+
+	static TAssetTableColumn MakeText(FName InId, TFunction<const FString&(const RowType&)> InGetter, bool bInTextSearchable = false, EAssetColumnFilterKind InFilterKind = EAssetColumnFilterKind::Contains)
+	{
+		TAssetTableColumn Column;
+		Column.Id = InId;
+		Column.FilterKind = InFilterKind;
+		Column.bTextSearchable = bInTextSearchable;
+		Column.GetText = MoveTemp(InGetter);
+		return Column;
+	}
+
+	static TAssetTableColumn MakeNumber(FName InId, TFunction<int64(const RowType&)> InGetter, EAssetColumnFilterKind InFilterKind = EAssetColumnFilterKind::MinValue)
+	{
+		TAssetTableColumn Column;
+		Column.Id = InId;
+		Column.FilterKind = InFilterKind;
+		Column.GetNumber = MoveTemp(InGetter);
+		return Column;
+	}
+};
+
+/**
+ * Filter/sort view model shared by the texture, mesh and material audit tables.
+ * The row schema is supplied as a list of column descriptors; every table gets the same
+ * free-text search, typed per-column filters and column sorting.
+ *
+ * Source rows are indexed once per SetSourceData into an immutable table snapshot: text columns
+ * are case-folded and numeric columns copied into row-aligned key arrays. A refresh turns the
+ * snapshot plus the current filter/sort state into an immutable result (sort permutation and
+ * filtered row indices). Filtering walks the permutation so results come out already sorted, and
+ * a filter change that can only narrow the result (e.g. typing another character) re-scans just
+ * the previous result.
+ * For large tables, substring-filterable columns also get a trigram index built on a worker
+ * thread; once ready, Contains predicates of 3+ characters are answered from posting lists.
+ * A search query (AssetQuery.h) is compiled once into a predicate program that narrows a
+ * selection vector one column at a time, cheapest predicates first.
+ * Sorting may use several columns. Each sorted column gets dense ranks (computed once per data
+ * load); ranks and row index are packed into uint64 keys and sorted in parallel, and flipping the
+ * direction of every sort column reuses the previous permutation instead of sorting again.
+ * With SetAsyncRefresh(true), refreshes of large tables run on a worker task: a newer request
+ * cancels the one in flight, the previous result stays visible meanwhile (IsRefreshing), and the
+ * new result is swapped in on the game thread before OnResultsReady fires. The view model must be
+ * owned by a TSharedPtr for that; otherwise refreshes stay synchronous.
+ */
+template<typename RowType>
+class TAssetTableViewModel : public TSharedFromThis<TAssetTableViewModel<RowType>, ESPMode::ThreadSafe>
+{
+public:
+	typedef TSharedPtr<RowType> FRowPtr;
+	typedef TAssetTableColumn<RowType> FColumn;
+
+	explicit TAssetTableViewModel(TArray<FColumn> InColumns)
+		: Columns(MoveTemp(InColumns))
+		, BatchDepth(0)
+		, bRefreshPending(false)
+		, bAsyncRefresh(false)
+		, RefreshGeneration(0)
+	{
+		ColumnTextFilters.SetNum(Columns.Num());
+		ColumnMinFilters.SetNumZeroed(Columns.Num());
+		if (Columns.Num() > 0)
+		{
+			SortColumns.Add({ 0, true });
+		}
+		for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+		{
+			if (Columns[ColumnIndex].bTextSearchable && !Columns[ColumnIndex].IsNumeric())
+			{
+				SearchableColumns.Add(ColumnIndex);
+			}
+		}
+		Data = BuildTableData(TArray<FRowPtr>());
+		CurrentResult = MakeShared<FRefreshResult, ESPMode::ThreadSafe>();
+	}
+
+	virtual ~TAssetTableViewModel()
+	{
+		CancelPendingRefresh();
+	}
+
+	// Data management
+	void SetSourceData(const TArray<FRowPtr>& InSourceData)
+	{
+		MAGICOPT_LLM_SCOPE(Views);
+		Data = BuildTableData(InSourceData);
+		HandleSourceDataChanged(Data->Rows);
+		RefreshData();
+	}
+
+	void RefreshData()
+	{
+		MAGICOPT_LLM_SCOPE(Views);
+		if (BatchDepth > 0)
+		{
+			bRefreshPending = true;
+			return;
+		}
+
+		FRefreshRequest Request(Data.ToSharedRef());
+		Request.Sort = SortColumns;
+		Request.Filter = MakeFilterState();
+		Request.Program = QueryProgram;
+		Request.Previous = CurrentResult;
+
+		CancelPendingRefresh();
+		if (bAsyncRefresh && Data->Rows.Num() >= MinRowsForAsyncRefresh && this->DoesSharedInstanceExist())
+		{
+			LaunchRefresh(MoveTemp(Request));
+			return;
+		}
+
+		const std::atomic<bool> bNeverCancelled(false);
+		PublishResult(ComputeRefresh(Request, bNeverCancelled));
+	}
+
+	// Defers refreshes until the matching EndBatch, so several filters can be set with a single pass
+	void BeginBatch()
+	{
+		++BatchDepth;
+	}
+
+	void EndBatch()
+	{
+		check(BatchDepth > 0);
+		if (--BatchDepth == 0 && bRefreshPending)
+		{
+			bRefreshPending = false;
+			RefreshData();
+		}
+	}
+
+	// Background refresh (see class comment); tables below MinRowsForAsyncRefresh always refresh inline
+	void SetAsyncRefresh(bool bEnable)
+	{
+		bAsyncRefresh = bEnable;
+		if (!bEnable)
+		{
+			WaitForRefresh();
+		}
+	}
+
+	// True while a background refresh is running; the published results are the previous ones
+	bool IsRefreshing() const { return PendingRefresh.IsValid(); }
+
+	// Blocks until a pending background refresh has finished and publishes its result
+	void WaitForRefresh()
+	{
+		if (!PendingRefresh.IsValid())
+		{
+			return;
+		}
+		FRefreshResultPtr Result = PendingRefresh.GetResult();
+		PendingRefresh = UE::Tasks::TTask<FRefreshResultPtr>();
+		PendingCancel.Reset();
+		PublishResult(Result);
+	}
+
+	FOnAssetTableResultsReady& OnResultsReady() { return ResultsReadyEvent; }
+
+	static constexpr int32 MinRowsForAsyncRefresh = 16384;
+
+	// Filtering
+	void SetTextFilter(const FString& InFilter)
+	{
+		TextFilter = InFilter;
+		RefreshData();
+	}
+
+	void SetColumnFilter(FName ColumnId, const FString& InFilter)
+	{
+		const int32 ColumnIndex = FindColumnIndex(ColumnId);
+		if (ColumnIndex != INDEX_NONE && Columns[ColumnIndex].FilterKind == EAssetColumnFilterKind::Contains)
+		{
+			ColumnTextFilters[ColumnIndex] = InFilter;
+			RefreshData();
+		}
+	}
+
+	void SetColumnMinFilter(FName ColumnId, int64 InMinValue)
+	{
+		const int32 ColumnIndex = FindColumnIndex(ColumnId);
+		if (ColumnIndex != INDEX_NONE && Columns[ColumnIndex].FilterKind == EAssetColumnFilterKind::MinValue)
+		{
+			ColumnMinFilters[ColumnIndex] = InMinValue;
+			RefreshData();
+		}
+	}
+
+	// Clears the filter row state; the query is owned by the search box and set through SetQuery
+	void ClearAllFilters()
+	{
+		TextFilter.Empty();
+		for (FString& Filter : ColumnTextFilters)
+		{
+			Filter.Empty();
+		}
+		for (int64& MinValue : ColumnMinFilters)
+		{
+			MinValue = 0;
+		}
+		RefreshData();
+	}
+
+	FString GetTextFilter() const { return TextFilter; }
+
+	FString GetColumnFilter(FName ColumnId) const
+	{
+		const int32 ColumnIndex = FindColumnIndex(ColumnId);
+		return ColumnIndex != INDEX_NONE ? ColumnTextFilters[ColumnIndex] : FString();
+	}
+
+	int64 GetColumnMinFilter(FName ColumnId) const
+	{
+		const int32 ColumnIndex = FindColumnIndex(ColumnId);
+		return ColumnIndex != INDEX_NONE ? ColumnMinFilters[ColumnIndex] : 0;
+	}
+
+	// Query language (see AssetQuery.h), applied on top of the other filters
+	void SetQuery(const FString& InQuery)
+	{
+		if (InQuery.Equals(QueryText, ESearchCase::CaseSensitive))
+		{
+			return;
+		}
+		QueryText = InQuery;
+		CompileQuery();
+		RefreshData();
+	}
+
+	FString GetQuery() const { return QueryText; }
+
+	// Empty when the whole query compiled; otherwise describes the first term that was skipped
+	const FString& GetQueryError() const { return QueryError; }
+
+	bool HasActiveFilters() const
+	{
+		if (!TextFilter.IsEmpty() || QueryProgram.Num() > 0)
+		{
+			return true;
+		}
+		for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+		{
+			if (!ColumnTextFilters[ColumnIndex].IsEmpty() || ColumnMinFilters[ColumnIndex] > 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Sorting; SetSortColumn replaces the sort, AddSortColumn appends (or re-directs) a tie-breaker
+	void SetSortColumn(FName ColumnId, bool bInAscending)
+	{
+		SetSortColumns({ { ColumnId, bInAscending } });
+	}
+
+	void AddSortColumn(FName ColumnId, bool bInAscending)
+	{
+		TArray<FAssetTableSortKey> Keys = GetSortColumns();
+		FAssetTableSortKey* Existing = Keys.FindByPredicate([ColumnId](const FAssetTableSortKey& Key) { return Key.ColumnId == ColumnId; });
+		if (Existing)
+		{
+			Existing->bAscending = bInAscending;
+		}
+		else
+		{
+			Keys.Add({ ColumnId, bInAscending });
+		}
+		SetSortColumns(Keys);
+	}
+
+	// Unknown and repeated columns are ignored; an empty list keeps source order
+	void SetSortColumns(const TArray<FAssetTableSortKey>& InKeys)
+	{
+		TArray<FSortColumn> NewSortColumns;
+		for (const FAssetTableSortKey& Key : InKeys)
+		{
+			const int32 ColumnIndex = FindColumnIndex(Key.ColumnId);
+			if (ColumnIndex != INDEX_NONE && !NewSortColumns.ContainsByPredicate([ColumnIndex](const FSortColumn& Sort) { return Sort.ColumnIndex == ColumnIndex; }))
+			{
+				NewSortColumns.Add({ ColumnIndex, Key.bAscending });
+			}
+		}
+		if ((InKeys.Num() > 0 && NewSortColumns.Num() == 0) || NewSortColumns == SortColumns)
+		{
+			return;
+		}
+		SortColumns = MoveTemp(NewSortColumns);
+		RefreshData();
+	}
+
+	TArray<FAssetTableSortKey> GetSortColumns() const
+	{
+		TArray<FAssetTableSortKey> Keys;
+		for (const FSortColumn& Sort : SortColumns)
+		{
+			Keys.Add({ Columns[Sort.ColumnIndex].Id, Sort.bAscending });
+		}
+		return Keys;
+	}
+
+	// Primary sort column
+	FName GetSortColumnId() const { return SortColumns.Num() > 0 ? Columns[SortColumns[0].ColumnIndex].Id : NAME_None; }
+	bool IsSortAscending() const { return SortColumns.Num() == 0 || SortColumns[0].bAscending; }
+
+	// Data access (filtered data reflects the last published result). The filtered row array is only
+	// built when asked for; lists page through MakeFilteredRowSource instead.
+	const TArray<FRowPtr>& GetFilteredData() const
+	{
+		if (bFilteredDataStale)
+		{
+			FilteredData.Reset(CurrentResult->FilteredIndices.Num());
+			for (const int32 RowIndex : CurrentResult->FilteredIndices)
+			{
+				FilteredData.Add(CurrentResult->Data->Rows[RowIndex]);
+			}
+			bFilteredDataStale = false;
+		}
+		return FilteredData;
+	}
+	const TArray<FRowPtr>& GetSourceData() const { return Data->Rows; }
+	int32 GetTotalCount() const { return Data->Rows.Num(); }
+	int32 GetFilteredCount() const { return CurrentResult->FilteredIndices.Num(); }
+
+	// The published result as a paged row source, in display order; it keeps that result alive and
+	// does not change when a newer one is published
+	TSharedRef<const TAssetRowSource<RowType>, ESPMode::ThreadSafe> MakeFilteredRowSource() const
+	{
+		return MakeShared<const FFilteredRowSource, ESPMode::ThreadSafe>(CurrentResult.ToSharedRef());
+	}
+
+	// Source row indices of the filtered rows, in display order
+	const TArray<int32>& GetFilteredIndices() const { return CurrentResult->FilteredIndices; }
+
+	// Blocks until the background search indices for the current source data are built
+	void WaitForSearchIndex()
+	{
+		for (const FColumnKeys& Keys : Data->ColumnKeys)
+		{
+			if (Keys.IndexTask.IsValid())
+			{
+				Keys.IndexTask.Wait();
+			}
+		}
+	}
+
+	// Tables smaller than this are always scanned; the index does not pay for itself
+	static constexpr int32 MinRowsForSearchIndex = 4096;
+
+	// Schema access
+	const TArray<FColumn>& GetColumns() const { return Columns; }
+
+	int32 FindColumnIndex(FName ColumnId) const
+	{
+		return Columns.IndexOfByPredicate([ColumnId](const FColumn& Column) { return Column.Id == ColumnId; });
+	}
+
+protected:
+	// Derived view model hooks, called on the game thread: new source rows, and a newly published
+	// result (source row indices in display order) just before OnResultsReady fires
+	virtual void HandleSourceDataChanged(const TArray<FRowPtr>& Rows) {}
+	virtual void HandleResultsPublished(const TArray<int32>& FilteredIndices) {}
+
+	// Case-folded filter values, as applied to produce a result's filtered indices
+	struct FFilterState
+	{
+		FString Text;
+		TArray<FString> ColumnText;
+		TArray<int64> ColumnMin;
+		TArray<FAssetQueryTerm> QueryTerms;
+
+		bool operator==(const FFilterState& Other) const
+		{
+			return Text.Equals(Other.Text, ESearchCase::CaseSensitive) && ColumnText == Other.ColumnText
+				&& ColumnMin == Other.ColumnMin && QueryTerms == Other.QueryTerms;
+		}
+	};
+
+	// One compiled query term; ColumnIndex INDEX_NONE means any searchable column
+	struct FCompiledPredicate
+	{
+		int32 ColumnIndex = INDEX_NONE;
+		EAssetQueryOp Op = EAssetQueryOp::Contains;
+		FString Text;
+		int64 Number = 0;
+		bool bNegated = false;
+		int32 Cost = 0;
+	};
+
+	struct FSortColumn
+	{
+		int32 ColumnIndex = INDEX_NONE;
+		bool bAscending = true;
+
+		bool operator==(const FSortColumn& Other) const { return ColumnIndex == Other.ColumnIndex && bAscending == Other.bAscending; }
+	};
+
+	typedef TSharedPtr<const FAssetTrigramIndex, ESPMode::ThreadSafe> FSearchIndexPtr;
+
+	// Row-aligned keys for one column (Folded for text columns, Numbers for numeric columns).
+	// Folded is shared with the worker building the column's search index.
+	struct FColumnKeys
+	{
+		TSharedRef<TArray<FString>, ESPMode::ThreadSafe> Folded = MakeShared<TArray<FString>, ESPMode::ThreadSafe>();
+		TArray<int64> Numbers;
+		mutable UE::Tasks::TTask<FSearchIndexPtr> IndexTask;
+	};
+
+	// Dense ranks of a column's values in comparator order (equal values share a rank)
+	struct FColumnRanks
+	{
+		TArray<uint32> Ranks;
+		uint32 MaxRank = 0;
+	};
+	typedef TSharedPtr<const FColumnRanks, ESPMode::ThreadSafe> FColumnRanksPtr;
+
+	// Keeps the selected rows for which Test returns true, preserving order
+	template<typename TestType>
+	static void FilterSelection(TArray<int32>& Selection, TestType Test)
+	{
+		int32 WriteIndex = 0;
+		for (int32 ReadIndex = 0; ReadIndex < Selection.Num(); ++ReadIndex)
+		{
+			const int32 RowIndex = Selection[ReadIndex];
+			if (Test(RowIndex))
+			{
+				Selection[WriteIndex++] = RowIndex;
+			}
+		}
+		Selection.SetNum(WriteIndex, EAllowShrinking::No);
+	}
+
+	/**
+	 * Everything derived from one SetSourceData call. Immutable once built, apart from the sort ranks,
+	 * which are built on first use under a lock, so refresh jobs on any thread can share it.
+	 */
+	struct FTableData
+	{
+		TArray<FColumn> Columns;
+		TArray<int32> SearchableColumns;
+		TArray<FRowPtr> Rows;
+		TArray<FColumnKeys> ColumnKeys;
+
+		mutable FCriticalSection RanksLock;
+		mutable TArray<FColumnRanksPtr> Ranks;
+
+		FColumnRanksPtr GetRanks(int32 ColumnIndex) const
+		{
+			FScopeLock Lock(&RanksLock);
+			if (!Ranks[ColumnIndex].IsValid())
+			{
+				Ranks[ColumnIndex] = BuildRanks(ColumnIndex);
+			}
+			return Ranks[ColumnIndex];
+		}
+
+		// The column's search index if its build has finished, otherwise null
+		const FAssetTrigramIndex* GetReadySearchIndex(int32 ColumnIndex) const
+		{
+			const FColumnKeys& Keys = ColumnKeys[ColumnIndex];
+			if (Keys.IndexTask.IsValid() && Keys.IndexTask.IsCompleted())
+			{
+				return Keys.IndexTask.GetResult().Get();
+			}
+			return nullptr;
+		}
+
+		// Rows containing Needle in the column (or, for INDEX_NONE, in any searchable column), from the
+		// search indices. Returns false if the needle is too short or an index is not ready yet.
+		bool QuerySearchIndex(int32 ColumnIndex, const FString& Needle, TBitArray<>& OutMatch) const
+		{
+			if (Needle.Len() < FAssetTrigramIndex::TrigramLength)
+			{
+				return false;
+			}
+
+			TArray<const FAssetTrigramIndex*, TInlineAllocator<4>> Indices;
+			if (ColumnIndex == INDEX_NONE)
+			{
+				for (const int32 SearchableIndex : SearchableColumns)
+				{
+					Indices.Add(GetReadySearchIndex(SearchableIndex));
+				}
+			}
+			else
+			{
+				Indices.Add(GetReadySearchIndex(ColumnIndex));
+			}
+			if (Indices.Num() == 0 || Indices.Contains(nullptr))
+			{
+				return false;
+			}
+
+			OutMatch.Init(false, Rows.Num());
+			TArray<int32> DocIds;
+			for (const FAssetTrigramIndex* Index : Indices)
+			{
+				Index->FindDocuments(Needle, DocIds);
+				for (const int32 DocId : DocIds)
+				{
+					OutMatch[DocId] = true;
+				}
+			}
+			return true;
+		}
+
+		// Resolves the Contains predicates that have a ready index into a row bitmap; false if none could be
+		bool ResolveIndexedPredicates(const FFilterState& State, TBitArray<>& OutMatch, TBitArray<>& OutResolved) const
+		{
+			bool bAnyResolved = false;
+
+			// Free-text search is a union over the searchable columns
+			if (QuerySearchIndex(INDEX_NONE, State.Text, OutMatch))
+			{
+				OutResolved[Columns.Num()] = true;
+				bAnyResolved = true;
+			}
+
+			for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+			{
+				TBitArray<> ColumnMatch;
+				if (Columns[ColumnIndex].FilterKind != EAssetColumnFilterKind::Contains || !QuerySearchIndex(ColumnIndex, State.ColumnText[ColumnIndex], ColumnMatch))
+				{
+					continue;
+				}
+				if (bAnyResolved)
+				{
+					OutMatch.CombineWithBitwiseAND(ColumnMatch, EBitwiseOperatorFlags::MinSize);
+				}
+				else
+				{
+					OutMatch = MoveTemp(ColumnMatch);
+				}
+				OutResolved[ColumnIndex] = true;
+				bAnyResolved = true;
+			}
+			return bAnyResolved;
+		}
+
+		// Evaluates the filters not already resolved by the search indices
+		bool RowPassesFilters(int32 RowIndex, const FFilterState& State, const TBitArray<>& Resolved) const
+		{
+			// Free-text search over the searchable columns
+			if (!State.Text.IsEmpty() && !Resolved[Columns.Num()] && !AnySearchableContains(RowIndex, State.Text))
+			{
+				return false;
+			}
+
+			// Typed per-column filters
+			for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+			{
+				switch (Columns[ColumnIndex].FilterKind)
+				{
+				case EAssetColumnFilterKind::Contains:
+					if (!State.ColumnText[ColumnIndex].IsEmpty() && !Resolved[ColumnIndex] && !(*ColumnKeys[ColumnIndex].Folded)[RowIndex].Contains(State.ColumnText[ColumnIndex], ESearchCase::CaseSensitive))
+					{
+						return false;
+					}
+					break;
+
+				case EAssetColumnFilterKind::MinValue:
+					if (State.ColumnMin[ColumnIndex] > 0 && ColumnKeys[ColumnIndex].Numbers[RowIndex] < State.ColumnMin[ColumnIndex])
+					{
+						return false;
+					}
+					break;
+
+				default:
+					break;
+				}
+			}
+			return true;
+		}
+
+		bool AnySearchableContains(int32 RowIndex, const FString& Needle) const
+		{
+			for (const int32 ColumnIndex : SearchableColumns)
+			{
+				if ((*ColumnKeys[ColumnIndex].Folded)[RowIndex].Contains(Needle, ESearchCase::CaseSensitive))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// Runs a compiled query over the selection, one predicate (column) at a time
+		bool ApplyQuery(TArray<int32>& Selection, const TArray<FCompiledPredicate>& Program, const std::atomic<bool>& bCancelled) const
+		{
+			for (const FCompiledPredicate& Predicate : Program)
+			{
+				if (Selection.Num() == 0)
+				{
+					return true;
+				}
+				if (bCancelled.load(std::memory_order_relaxed))
+				{
+					return false;
+				}
+				const bool bNegated = Predicate.bNegated;
+
+				// Posting lists beat a scan while the selection is still large
+				TBitArray<> IndexMatch;
+				if (Predicate.Op == EAssetQueryOp::Contains && Selection.Num() >= MinRowsForSearchIndex
+					&& (Predicate.ColumnIndex == INDEX_NONE || !Columns[Predicate.ColumnIndex].IsNumeric())
+					&& QuerySearchIndex(Predicate.ColumnIndex, Predicate.Text, IndexMatch))
+				{
+					FilterSelection(Selection, [&IndexMatch, bNegated](const int32 RowIndex) { return IndexMatch[RowIndex] != bNegated; });
+					continue;
+				}
+
+				if (Predicate.ColumnIndex == INDEX_NONE)
+				{
+					const FString& Needle = Predicate.Text;
+					FilterSelection(Selection, [this, &Needle, bNegated](const int32 RowIndex) { return AnySearchableContains(RowIndex, Needle) != bNegated; });
+				}
+				else if (Columns[Predicate.ColumnIndex].IsNumeric())
+				{
+					const int64* Values = ColumnKeys[Predicate.ColumnIndex].Numbers.GetData();
+					const int64 Number = Predicate.Number;
+					switch (Predicate.Op)
+					{
+					case EAssetQueryOp::Greater:
+						FilterSelection(Selection, [Values, Number, bNegated](const int32 RowIndex) { return (Values[RowIndex] > Number) != bNegated; });
+						break;
+					case EAssetQueryOp::GreaterEqual:
+						FilterSelection(Selection, [Values, Number, bNegated](const int32 RowIndex) { return (Values[RowIndex] >= Number) != bNegated; });
+						break;
+					case EAssetQueryOp::Less:
+						FilterSelection(Selection, [Values, Number, bNegated](const int32 RowIndex) { return (Values[RowIndex] < Number) != bNegated; });
+						break;
+					case EAssetQueryOp::LessEqual:
+						FilterSelection(Selection, [Values, Number, bNegated](const int32 RowIndex) { return (Values[RowIndex] <= Number) != bNegated; });
+						break;
+					default:
+						FilterSelection(Selection, [Values, Number, bNegated](const int32 RowIndex) { return (Values[RowIndex] == Number) != bNegated; });
+						break;
+					}
+				}
+				else
+				{
+					const TArray<FString>& Keys = *ColumnKeys[Predicate.ColumnIndex].Folded;
+					const FString& Needle = Predicate.Text;
+					if (Predicate.Op == EAssetQueryOp::Equal)
+					{
+						FilterSelection(Selection, [&Keys, &Needle, bNegated](const int32 RowIndex) { return Keys[RowIndex].Equals(Needle, ESearchCase::CaseSensitive) != bNegated; });
+					}
+					else
+					{
+						FilterSelection(Selection, [&Keys, &Needle, bNegated](const int32 RowIndex) { return Keys[RowIndex].Contains(Needle, ESearchCase::CaseSensitive) != bNegated; });
+					}
+				}
+			}
+			return true;
+		}
+
+	private:
+		FColumnRanksPtr BuildRanks(int32 ColumnIndex) const
+		{
+			const int32 NumRows = Rows.Num();
+			TArray<int32> Order;
+			Order.SetNumUninitialized(NumRows);
+			for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex)
+			{
+				Order[RowIndex] = RowIndex;
+			}
+
+			TSharedRef<FColumnRanks, ESPMode::ThreadSafe> Result = MakeShared<FColumnRanks, ESPMode::ThreadSafe>();
+			Result->Ranks.SetNumUninitialized(NumRows);
+			if (Columns[ColumnIndex].IsNumeric())
+			{
+				const TArray<int64>& Numbers = ColumnKeys[ColumnIndex].Numbers;
+				AssetTableSort::ParallelSort(Order, [&Numbers](const int32 A, const int32 B) { return Numbers[A] < Numbers[B]; });
+				AssignDenseRanks(*Result, Order, [&Numbers](const int32 A, const int32 B) { return Numbers[A] == Numbers[B]; });
+			}
+			else
+			{
+				// Ranked on the original text, matching TAssetTableColumn::Compare
+				const FColumn& Column = Columns[ColumnIndex];
+				TArray<const FString*> Texts;
+				Texts.Reserve(NumRows);
+				for (const FRowPtr& Row : Rows)
+				{
+					Texts.Add(&Column.GetText(*Row));
+				}
+				AssetTableSort::ParallelSort(Order, [&Texts](const int32 A, const int32 B) { return Texts[A]->Compare(*Texts[B]) < 0; });
+				AssignDenseRanks(*Result, Order, [&Texts](const int32 A, const int32 B) { return Texts[A]->Equals(*Texts[B], ESearchCase::CaseSensitive); });
+			}
+			return Result;
+		}
+
+		template<typename EqualType>
+		static void AssignDenseRanks(FColumnRanks& OutRanks, const TArray<int32>& Order, EqualType Equal)
+		{
+			uint32 Rank = 0;
+			for (int32 Position = 0; Position < Order.Num(); ++Position)
+			{
+				if (Position > 0 && !Equal(Order[Position - 1], Order[Position]))
+				{
+					++Rank;
+				}
+				OutRanks.Ranks[Order[Position]] = Rank;
+			}
+			OutRanks.MaxRank = Rank;
+		}
+	};
+	typedef TSharedPtr<const FTableData, ESPMode::ThreadSafe> FTableDataPtr;
+
+	// A sort permutation of the rows, each row's position in it, and where each run of rows with
+	// equal sort keys starts
+	struct FSortedOrder
+	{
+		TArray<FSortColumn> SortedBy;
+		TArray<int32> Order;
+		TArray<int32> Rank;
+		TArray<int32> RunStarts;
+	};
+	typedef TSharedPtr<const FSortedOrder, ESPMode::ThreadSafe> FSortedOrderPtr;
+
+	// Output of one refresh; immutable once published
+	struct FRefreshResult
+	{
+		FTableDataPtr Data;
+		FSortedOrderPtr Sorted;
+		TArray<int32> FilteredIndices;
+		FFilterState Filter;
+	};
+	typedef TSharedPtr<FRefreshResult, ESPMode::ThreadSafe> FRefreshResultPtr;
+	typedef TSharedPtr<const FRefreshResult, ESPMode::ThreadSafe> FConstRefreshResultPtr;
+
+	// Filtered rows of one published result; shares row pointers with the view model, so game thread only
+	class FFilteredRowSource : public TAssetRowSource<RowType>
+	{
+	public:
+		explicit FFilteredRowSource(TSharedRef<const FRefreshResult, ESPMode::ThreadSafe> InResult)
+			: Result(MoveTemp(InResult))
+		{
+		}
+
+		virtual int32 Num() const override { return Result->FilteredIndices.Num(); }
+
+		virtual void FetchRows(int32 Start, int32 Count, TArray<FRowPtr>& OutRows) const override
+		{
+			const int32 End = FMath::Min(Result->FilteredIndices.Num(), Start + Count);
+			for (int32 Index = FMath::Max(0, Start); Index < End; ++Index)
+			{
+				OutRows.Add(Result->Data->Rows[Result->FilteredIndices[Index]]);
+			}
+		}
+
+	private:
+		TSharedRef<const FRefreshResult, ESPMode::ThreadSafe> Result;
+	};
+
+	// Input of one refresh, captured on the game thread
+	struct FRefreshRequest
+	{
+		explicit FRefreshRequest(TSharedRef<const FTableData, ESPMode::ThreadSafe> InData) : Data(MoveTemp(InData)) {}
+
+		TSharedRef<const FTableData, ESPMode::ThreadSafe> Data;
+		TArray<FSortColumn> Sort;
+		FFilterState Filter;
+		TArray<FCompiledPredicate> Program;
+
+		// Result currently on screen, reused where the new state allows
+		FConstRefreshResultPtr Previous;
+	};
+
+	// Row schema
+	TArray<FColumn> Columns;
+	TArray<int32> SearchableColumns;
+
+	// Current source snapshot, the published result, and its rows in display order (built on demand)
+	FTableDataPtr Data;
+	FConstRefreshResultPtr CurrentResult;
+	mutable TArray<FRowPtr> FilteredData;
+	mutable bool bFilteredDataStale = false;
+
+	// Filter state (per-column arrays are indexed like Columns)
+	FString TextFilter;
+	TArray<FString> ColumnTextFilters;
+	TArray<int64> ColumnMinFilters;
+
+	// Query state: source text, accepted terms in query order, and the program (cheapest first)
+	FString QueryText;
+	FString QueryError;
+	TArray<FAssetQueryTerm> QueryTerms;
+	TArray<FCompiledPredicate> QueryProgram;
+
+	// Sort state, primary column first
+	TArray<FSortColumn> SortColumns;
+
+	// Batched refresh state
+	int32 BatchDepth;
+	bool bRefreshPending;
+
+	// Background refresh state; RefreshGeneration identifies the newest request
+	bool bAsyncRefresh;
+	uint64 RefreshGeneration;
+	UE::Tasks::TTask<FRefreshResultPtr> PendingRefresh;
+	TSharedPtr<std::atomic<bool>, ESPMode::ThreadSafe> PendingCancel;
+	FOnAssetTableResultsReady ResultsReadyEvent;
+
+	TSharedRef<const FTableData, ESPMode::ThreadSafe> BuildTableData(const TArray<FRowPtr>& InSourceData) const
+	{
+		MAGICOPT_TRACE_SCOPE(MagicOptimizer_BuildTableData);
+		TSharedRef<FTableData, ESPMode::ThreadSafe> NewData = MakeShared<FTableData, ESPMode::ThreadSafe>();
+		NewData->Columns = Columns;
+		NewData->SearchableColumns = SearchableColumns;
+		NewData->Ranks.SetNum(Columns.Num());
+		NewData->Rows.Reserve(InSourceData.Num());
+		for (const FRowPtr& Row : InSourceData)
+		{
+			if (Row.IsValid())
+			{
+				NewData->Rows.Add(Row);
+			}
+		}
+
+		const TArray<FRowPtr>& Rows = NewData->Rows;
+		NewData->ColumnKeys.SetNum(Columns.Num());
+		for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+		{
+			const FColumn& Column = Columns[ColumnIndex];
+			FColumnKeys& Keys = NewData->ColumnKeys[ColumnIndex];
+			if (Column.IsNumeric())
+			{
+				Keys.Numbers.Reserve(Rows.Num());
+				for (const FRowPtr& Row : Rows)
+				{
+					Keys.Numbers.Add(Column.GetNumber(*Row));
+				}
+			}
+			else
+			{
+				Keys.Folded->Reserve(Rows.Num());
+				for (const FRowPtr& Row : Rows)
+				{
+					Keys.Folded->Add(Column.GetText(*Row).ToLower());
+				}
+
+				const bool bSubstringColumn = Column.bTextSearchable || Column.FilterKind == EAssetColumnFilterKind::Contains;
+				if (bSubstringColumn && Rows.Num() >= MinRowsForSearchIndex)
+				{
+					TSharedRef<const TArray<FString>, ESPMode::ThreadSafe> Documents = Keys.Folded;
+					Keys.IndexTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Documents]()
+					{
+						MAGICOPT_LLM_SCOPE(Views);
+						TSharedRef<FAssetTrigramIndex, ESPMode::ThreadSafe> Index = MakeShared<FAssetTrigramIndex, ESPMode::ThreadSafe>();
+						Index->Build(*Documents);
+						return FSearchIndexPtr(Index);
+					});
+				}
+			}
+		}
+		return NewData;
+	}
+
+	FFilterState MakeFilterState() const
+	{
+		FFilterState State;
+		State.Text = TextFilter.TrimStartAndEnd().ToLower();
+		State.ColumnText.Reserve(ColumnTextFilters.Num());
+		for (const FString& Filter : ColumnTextFilters)
+		{
+			State.ColumnText.Add(Filter.ToLower());
+		}
+		State.ColumnMin = ColumnMinFilters;
+		State.QueryTerms = QueryTerms;
+		return State;
+	}
+
+	void LaunchRefresh(FRefreshRequest&& Request)
+	{
+		const uint64 Generation = ++RefreshGeneration;
+		TSharedRef<std::atomic<bool>, ESPMode::ThreadSafe> bCancelled = MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false);
+		PendingCancel = bCancelled;
+
+		TWeakPtr<TAssetTableViewModel, ESPMode::ThreadSafe> WeakThis = this->AsShared();
+		PendingRefresh = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Request = MoveTemp(Request), bCancelled, WeakThis, Generation]()
+		{
+			MAGICOPT_LLM_SCOPE(Views);
+			FRefreshResultPtr Result = ComputeRefresh(Request, *bCancelled);
+			if (Result.IsValid())
+			{
+				AsyncTask(ENamedThreads::GameThread, [WeakThis, Generation, Result]()
+				{
+					if (TSharedPtr<TAssetTableViewModel, ESPMode::ThreadSafe> ViewModel = WeakThis.Pin())
+					{
+						ViewModel->CompleteRefresh(Generation, Result);
+					}
+				});
+			}
+			return Result;
+		});
+	}
+
+	void CompleteRefresh(uint64 Generation, const FRefreshResultPtr& Result)
+	{
+		// Superseded, or already published by WaitForRefresh
+		if (Generation != RefreshGeneration || !PendingRefresh.IsValid())
+		{
+			return;
+		}
+		PendingRefresh = UE::Tasks::TTask<FRefreshResultPtr>();
+		PendingCancel.Reset();
+		PublishResult(Result);
+	}
+
+	void CancelPendingRefresh()
+	{
+		if (PendingCancel.IsValid())
+		{
+			PendingCancel->store(true, std::memory_order_relaxed);
+		}
+		PendingCancel.Reset();
+		PendingRefresh = UE::Tasks::TTask<FRefreshResultPtr>();
+		++RefreshGeneration;
+	}
+
+	// Swaps the result in; the filtered row array is rebuilt lazily. Game thread only
+	void PublishResult(const FRefreshResultPtr& Result)
+	{
+		MAGICOPT_LLM_SCOPE(Views);
+		if (!Result.IsValid())
+		{
+			return;
+		}
+		CurrentResult = Result;
+		FilteredData.Reset();
+		bFilteredDataStale = true;
+		HandleResultsPublished(Result->FilteredIndices);
+		ResultsReadyEvent.Broadcast();
+	}
+
+	/**
+	 * Sorts and filters a snapshot. Runs on any thread; returns null if cancelled.
+	 * The previous result is reused when it was computed on the same snapshot: an identical sort is
+	 * shared, a flipped sort is derived from it, and a narrowing filter only re-scans its rows.
+	 */
+	static FRefreshResultPtr ComputeRefresh(const FRefreshRequest& Request, const std::atomic<bool>& bCancelled)
+	{
+		MAGICOPT_TRACE_SCOPE(MagicOptimizer_RefreshTable);
+		const FTableData& TableData = *Request.Data;
+		const FRefreshResult* Previous = Request.Previous.IsValid() && Request.Previous->Data.Get() == &TableData ? Request.Previous.Get() : nullptr;
+
+		FRefreshResultPtr Result = MakeShared<FRefreshResult, ESPMode::ThreadSafe>();
+		Result->Data = Request.Data;
+		Result->Filter = Request.Filter;
+
+		if (Previous && Previous->Sorted->SortedBy == Request.Sort)
+		{
+			Result->Sorted = Previous->Sorted;
+		}
+		else if (Previous && IsDirectionFlip(Previous->Sorted->SortedBy, Request.Sort))
+		{
+			Result->Sorted = ReverseSortedOrder(*Previous->Sorted, Request.Sort);
+		}
+		else
+		{
+			Result->Sorted = BuildSortedOrder(TableData, Request.Sort);
+		}
+		if (bCancelled.load(std::memory_order_relaxed))
+		{
+			return nullptr;
+		}
+		const FSortedOrder& Sorted = *Result->Sorted;
+
+		// Candidates are in display order: the previous result, the index matches, or the sorted source
+		const FFilterState& State = Request.Filter;
+		TArray<int32> Candidates;
+		const bool bNarrowing = Previous && IsNarrowing(Previous->Filter, State);
+		if (bNarrowing)
+		{
+			Candidates = Previous->Sorted == Result->Sorted ? Previous->FilteredIndices : ReorderRows(Previous->FilteredIndices, Sorted);
+			if (Previous->Filter == State)
+			{
+				Result->FilteredIndices = MoveTemp(Candidates);
+				return Result;
+			}
+		}
+
+		// Substring predicates answered by the search indices; the last bit stands for the free-text search
+		TBitArray<> IndexedMatch;
+		TBitArray<> ResolvedPredicates(false, TableData.Columns.Num() + 1);
+		const bool bUseIndex = TableData.ResolveIndexedPredicates(State, IndexedMatch, ResolvedPredicates);
+		if (!bNarrowing)
+		{
+			if (bUseIndex)
+			{
+				CollectIndexedCandidates(IndexedMatch, Sorted, Candidates);
+			}
+			else
+			{
+				Candidates = Sorted.Order;
+			}
+		}
+
+		TArray<int32>& Filtered = Result->FilteredIndices;
+		Filtered.Reset(Candidates.Num());
+		for (int32 Position = 0; Position < Candidates.Num(); ++Position)
+		{
+			if ((Position & 16383) == 0 && bCancelled.load(std::memory_order_relaxed))
+			{
+				return nullptr;
+			}
+			const int32 RowIndex = Candidates[Position];
+			if ((!bUseIndex || IndexedMatch[RowIndex]) && TableData.RowPassesFilters(RowIndex, State, ResolvedPredicates))
+			{
+				Filtered.Add(RowIndex);
+			}
+		}
+		if (!TableData.ApplyQuery(Filtered, Request.Program, bCancelled))
+		{
+			return nullptr;
+		}
+		return Result;
+	}
+
+	// True when every row passing NewState also passed OldState, so only the previous result needs scanning
+	static bool IsNarrowing(const FFilterState& OldState, const FFilterState& NewState)
+	{
+		if (!NewState.Text.Contains(OldState.Text, ESearchCase::CaseSensitive))
+		{
+			return false;
+		}
+		for (int32 ColumnIndex = 0; ColumnIndex < NewState.ColumnText.Num(); ++ColumnIndex)
+		{
+			if (!NewState.ColumnText[ColumnIndex].Contains(OldState.ColumnText[ColumnIndex], ESearchCase::CaseSensitive)
+				|| NewState.ColumnMin[ColumnIndex] < OldState.ColumnMin[ColumnIndex])
+			{
+				return false;
+			}
+		}
+
+		// Query terms are ANDed, so appending terms or extending a substring term narrows
+		if (NewState.QueryTerms.Num() < OldState.QueryTerms.Num())
+		{
+			return false;
+		}
+		for (int32 TermIndex = 0; TermIndex < OldState.QueryTerms.Num(); ++TermIndex)
+		{
+			if (!IsTermNarrowing(OldState.QueryTerms[TermIndex], NewState.QueryTerms[TermIndex]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static bool IsTermNarrowing(const FAssetQueryTerm& OldTerm, const FAssetQueryTerm& NewTerm)
+	{
+		if (OldTerm == NewTerm)
+		{
+			return true;
+		}
+		return OldTerm.Op == EAssetQueryOp::Contains && NewTerm.Op == EAssetQueryOp::Contains
+			&& !OldTerm.bNegated && !NewTerm.bNegated
+			&& OldTerm.Key.Equals(NewTerm.Key, ESearchCase::IgnoreCase)
+			&& NewTerm.Value.Contains(OldTerm.Value, ESearchCase::CaseSensitive);
+	}
+
+	// Matched rows in display order: rank-sorted when few, otherwise by walking the sorted order
+	static void CollectIndexedCandidates(const TBitArray<>& Match, const FSortedOrder& Sorted, TArray<int32>& OutCandidates)
+	{
+		const int32 NumMatches = Match.CountSetBits();
+		OutCandidates.Reset(NumMatches);
+		if (NumMatches * 16 < Sorted.Order.Num())
+		{
+			for (TConstSetBitIterator<> It(Match); It; ++It)
+			{
+				OutCandidates.Add(It.GetIndex());
+			}
+			const TArray<int32>& Rank = Sorted.Rank;
+			OutCandidates.Sort([&Rank](const int32 A, const int32 B) { return Rank[A] < Rank[B]; });
+		}
+		else
+		{
+			for (const int32 RowIndex : Sorted.Order)
+			{
+				if (Match[RowIndex])
+				{
+					OutCandidates.Add(RowIndex);
+				}
+			}
+		}
+	}
+
+	// The given rows, re-listed in the new sort order
+	static TArray<int32> ReorderRows(const TArray<int32>& RowIndices, const FSortedOrder& Sorted)
+	{
+		TBitArray<> Selected(false, Sorted.Order.Num());
+		for (const int32 RowIndex : RowIndices)
+		{
+			Selected[RowIndex] = true;
+		}
+		TArray<int32> Reordered;
+		Reordered.Reserve(RowIndices.Num());
+		for (const int32 RowIndex : Sorted.Order)
+		{
+			if (Selected[RowIndex])
+			{
+				Reordered.Add(RowIndex);
+			}
+		}
+		return Reordered;
+	}
+
+	static bool IsDirectionFlip(const TArray<FSortColumn>& OldSort, const TArray<FSortColumn>& NewSort)
+	{
+		if (NewSort.Num() == 0 || OldSort.Num() != NewSort.Num())
+		{
+			return false;
+		}
+		for (int32 SortIndex = 0; SortIndex < NewSort.Num(); ++SortIndex)
+		{
+			if (OldSort[SortIndex].ColumnIndex != NewSort[SortIndex].ColumnIndex || OldSort[SortIndex].bAscending == NewSort[SortIndex].bAscending)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static void FillRanks(FSortedOrder& Sorted)
+	{
+		Sorted.Rank.SetNumUninitialized(Sorted.Order.Num());
+		for (int32 Position = 0; Position < Sorted.Order.Num(); ++Position)
+		{
+			Sorted.Rank[Sorted.Order[Position]] = Position;
+		}
+	}
+
+	// With every direction flipped, the new order is the old one with its runs of equal keys reversed
+	// (rows inside a run keep source order, as a stable sort would)
+	static FSortedOrderPtr ReverseSortedOrder(const FSortedOrder& Previous, const TArray<FSortColumn>& Sort)
+	{
+		TSharedRef<FSortedOrder, ESPMode::ThreadSafe> Sorted = MakeShared<FSortedOrder, ESPMode::ThreadSafe>();
+		Sorted->SortedBy = Sort;
+		Sorted->Order.Reserve(Previous.Order.Num());
+		Sorted->RunStarts.Reserve(Previous.RunStarts.Num());
+		for (int32 Run = Previous.RunStarts.Num() - 1; Run >= 0; --Run)
+		{
+			const int32 Start = Previous.RunStarts[Run];
+			const int32 End = Run + 1 < Previous.RunStarts.Num() ? Previous.RunStarts[Run + 1] : Previous.Order.Num();
+			Sorted->RunStarts.Add(Sorted->Order.Num());
+			Sorted->Order.Append(Previous.Order.GetData() + Start, End - Start);
+		}
+		FillRanks(*Sorted);
+		return Sorted;
+	}
+
+	static FSortedOrderPtr BuildSortedOrder(const FTableData& TableData, const TArray<FSortColumn>& Sort)
+	{
+		TSharedRef<FSortedOrder, ESPMode::ThreadSafe> Sorted = MakeShared<FSortedOrder, ESPMode::ThreadSafe>();
+		Sorted->SortedBy = Sort;
+		TArray<int32>& Order = Sorted->Order;
+		TArray<int32>& RunStarts = Sorted->RunStarts;
+
+		const int32 NumRows = TableData.Rows.Num();
+		Order.SetNumUninitialized(NumRows);
+		if (Sort.Num() == 0)
+		{
+			for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex)
+			{
+				Order[RowIndex] = RowIndex;
+				RunStarts.Add(RowIndex);
+			}
+			FillRanks(*Sorted);
+			return Sorted;
+		}
+
+		TArray<FColumnRanksPtr, TInlineAllocator<4>> Ranks;
+		const int32 RowBits = AssetTableSort::BitsFor(NumRows > 0 ? (uint32)(NumRows - 1) : 0);
+		int32 TotalBits = RowBits;
+		for (const FSortColumn& SortColumn : Sort)
+		{
+			Ranks.Add(TableData.GetRanks(SortColumn.ColumnIndex));
+			TotalBits += AssetTableSort::BitsFor(Ranks.Last()->MaxRank);
+		}
+
+		if (TotalBits <= 64)
+		{
+			// Ranks (inverted for descending columns) followed by the row index: unique keys whose
+			// plain integer order is the stable multi-column order
+			TArray<uint64> Packed;
+			Packed.SetNumUninitialized(NumRows);
+			for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex)
+			{
+				uint64 Key = 0;
+				for (int32 SortIndex = 0; SortIndex < Sort.Num(); ++SortIndex)
+				{
+					const FColumnRanks& ColumnRanks = *Ranks[SortIndex];
+					const uint32 Rank = Sort[SortIndex].bAscending ? ColumnRanks.Ranks[RowIndex] : ColumnRanks.MaxRank - ColumnRanks.Ranks[RowIndex];
+					Key = (Key << AssetTableSort::BitsFor(ColumnRanks.MaxRank)) | Rank;
+				}
+				Packed[RowIndex] = (Key << RowBits) | (uint64)RowIndex;
+			}
+			AssetTableSort::ParallelSort(Packed, TLess<uint64>());
+
+			const uint64 RowMask = RowBits == 64 ? ~0ull : ((1ull << RowBits) - 1);
+			for (int32 Position = 0; Position < NumRows; ++Position)
+			{
+				Order[Position] = (int32)(Packed[Position] & RowMask);
+				if (Position == 0 || (Packed[Position] >> RowBits) != (Packed[Position - 1] >> RowBits))
+				{
+					RunStarts.Add(Position);
+				}
+			}
+			FillRanks(*Sorted);
+			return Sorted;
+		}
+
+		// Too many distinct values to pack; compare rank tuples with the row index as tie-breaker
+		for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex)
+		{
+			Order[RowIndex] = RowIndex;
+		}
+		auto CompareRanks = [&Sort, &Ranks](const int32 A, const int32 B) -> int32
+		{
+			for (int32 SortIndex = 0; SortIndex < Sort.Num(); ++SortIndex)
+			{
+				const TArray<uint32>& ColumnRanks = Ranks[SortIndex]->Ranks;
+				if (ColumnRanks[A] != ColumnRanks[B])
+				{
+					return (ColumnRanks[A] < ColumnRanks[B]) == Sort[SortIndex].bAscending ? -1 : 1;
+				}
+			}
+			return 0;
+		};
+		AssetTableSort::ParallelSort(Order, [&CompareRanks](const int32 A, const int32 B)
+		{
+			const int32 Result = CompareRanks(A, B);
+			return Result != 0 ? Result < 0 : A < B;
+		});
+		for (int32 Position = 0; Position < NumRows; ++Position)
+		{
+			if (Position == 0 || CompareRanks(Order[Position - 1], Order[Position]) != 0)
+			{
+				RunStarts.Add(Position);
+			}
+		}
+		FillRanks(*Sorted);
+		return Sorted;
+	}
+
+	int32 FindColumnByQueryKey(const FString& Key) const
+	{
+		return Columns.IndexOfByPredicate([&Key](const FColumn& Column) { return Column.MatchesQueryKey(Key); });
+	}
+
+	void CompileQuery()
+	{
+		QueryTerms.Reset();
+		QueryProgram.Reset();
+
+		TArray<FAssetQueryTerm> Terms;
+		AssetQuery::Parse(QueryText, Terms, QueryError);
+		for (const FAssetQueryTerm& Term : Terms)
+		{
+			FCompiledPredicate Predicate;
+			Predicate.Op = Term.Op;
+			Predicate.bNegated = Term.bNegated;
+
+			if (Term.Key.IsEmpty())
+			{
+				Predicate.Text = Term.Value;
+				Predicate.Cost = 3;
+			}
+			else
+			{
+				Predicate.ColumnIndex = FindColumnByQueryKey(Term.Key);
+				if (Predicate.ColumnIndex == INDEX_NONE)
+				{
+					QueryError = FString::Printf(TEXT("Unknown field '%s'"), *Term.Key);
+					continue;
+				}
+
+				if (Columns[Predicate.ColumnIndex].IsNumeric())
+				{
+					if (!Term.Value.IsNumeric())
+					{
+						QueryError = FString::Printf(TEXT("'%s' expects a number"), *Term.Key);
+						continue;
+					}
+					Predicate.Number = FCString::Atoi64(*Term.Value);
+					if (Predicate.Op == EAssetQueryOp::Contains)
+					{
+						Predicate.Op = EAssetQueryOp::Equal;
+					}
+					Predicate.Cost = 0;
+				}
+				else
+				{
+					if (Predicate.Op != EAssetQueryOp::Contains && Predicate.Op != EAssetQueryOp::Equal)
+					{
+						QueryError = FString::Printf(TEXT("'%s' only supports ':' and '='"), *Term.Key);
+						continue;
+					}
+					Predicate.Text = Term.Value;
+					Predicate.Cost = Predicate.Op == EAssetQueryOp::Equal ? 1 : 2;
+				}
+			}
+
+			// Recorded with the resolved op, so a Contains term is always a substring match
+			FAssetQueryTerm& Accepted = QueryTerms.Add_GetRef(Term);
+			Accepted.Op = Predicate.Op;
+			QueryProgram.Add(MoveTemp(Predicate));
+		}
+
+		QueryProgram.StableSort([](const FCompiledPredicate& A, const FCompiledPredicate& B) { return A.Cost < B.Cost; });
+	}
+};
@@ -0,0 +1,26 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ViewModels/AssetTableViewModel.h"
+#include "ViewModels/MaterialModels.h"
+
+class MAGICOPTIMIZER_API FMaterialTableViewModel : public TAssetTableViewModel<FMaterialAuditRow>
+{
+public:
+	// Column ids
+	static const FName ColumnPath;
+	static const FName ColumnTextureCount;
+	static const FName ColumnShaderComplexity;
+	static const FName ColumnIssues;
+
+	// Constructor
+	FMaterialTableViewModel();
+
+	// Column id for a sort column
+	static FName GetColumnId(EMaterialSortColumn InColumn);
+
+private:
+	static TArray<FColumn> MakeColumns();
+};
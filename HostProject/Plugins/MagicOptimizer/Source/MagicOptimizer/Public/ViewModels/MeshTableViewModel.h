@@ -0,0 +1,27 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ViewModels/AssetTableViewModel.h"
+#include "ViewModels/MeshModels.h"
+
+class MAGICOPTIMIZER_API FMeshTableViewModel : public TAssetTableViewModel<FMeshAuditRow>
+{
+public:
+	// Column ids
+	static const FName ColumnPath;
+	static const FName ColumnVertexCount;
+	static const FName ColumnTriangleCount;
+	static const FName ColumnLODCount;
+	static const FName ColumnIssues;
+
+	// Constructor
+	FMeshTableViewModel();
+
+	// Column id for a sort column
+	static FName GetColumnId(EMeshSortColumn InColumn);
+
+private:
+	static TArray<FColumn> MakeColumns();
+};
@@ -23,6 +23,18 @@ struct FTextureAuditRow
 	int32 Width = 0;
 	int32 Height = 0;
 	FString Format;
+
+	// Optional audit columns (empty / -1 when the CSV does not provide them)
+	FString LODGroup;
+	int32 SRGB = -1;
+
+	// Derived on load: texture role (normal, mask, ui, color) and space-separated issue codes
+	FString Type;
+	FString Issues;
+
+	// Derived on load: size bucket ("2K") and estimated resident bytes with mips
+	FString SizeBucket;
+	int64 EstimatedBytes = 0;
 };
 
 // Texture recommendation row
@@ -3,11 +3,13 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ViewModels/AssetTableViewModel.h"
 #include "ViewModels/TextureModels.h"
+#include "Services/Facets/AssetFacetIndex.h"
 
 class UOptimizerSettings;
 
-class FTextureTableViewModel
+class MAGICOPTIMIZER_API FTextureTableViewModel : public TAssetTableViewModel<FTextureAuditRow>
 {
 public:
 	// Sort column enumeration
@@ -19,60 +21,64 @@ public:
 		Format
 	};
 
+	// Column ids
+	static const FName ColumnPath;
+	static const FName ColumnWidth;
+	static const FName ColumnHeight;
+	static const FName ColumnFormat;
+	static const FName ColumnType;
+	static const FName ColumnLODGroup;
+	static const FName ColumnSRGB;
+	static const FName ColumnIssues;
+	static const FName ColumnSize;
+	static const FName ColumnMemory;
+
 	// Constructor
 	FTextureTableViewModel();
 
-	// Data management
-	void SetSourceData(const TArray<FTextureAuditRowPtr>& InSourceData);
-	void RefreshData();
-	
 	// Filtering
-	void SetTextFilter(const FString& InFilter);
 	void SetMinWidthFilter(int32 InMinWidth);
 	void SetMinHeightFilter(int32 InMinHeight);
 	void SetFormatFilter(const FString& InFilter);
-	void ClearAllFilters();
-	
+
 	// Sorting
+	using TAssetTableViewModel<FTextureAuditRow>::SetSortColumn;
 	void SetSortColumn(ESortColumn InColumn, bool bInAscending);
-	ESortColumn GetCurrentSortColumn() const { return CurrentSortColumn; }
-	bool IsSortAscending() const { return bSortAscending; }
-	
-	// Data access
-	const TArray<FTextureAuditRowPtr>& GetFilteredData() const { return FilteredData; }
-	const TArray<FTextureAuditRowPtr>& GetSourceData() const { return SourceData; }
-	int32 GetTotalCount() const { return SourceData.Num(); }
-	int32 GetFilteredCount() const { return FilteredData.Num(); }
-	
+	void SetSortColumn(ETextureSortColumn InColumn, bool bInAscending);
+	ESortColumn GetCurrentSortColumn() const;
+
 	// Filter state
-	FString GetTextFilter() const { return TextFilter; }
-	int32 GetMinWidthFilter() const { return MinWidthFilter; }
-	int32 GetMinHeightFilter() const { return MinHeightFilter; }
-	FString GetFormatFilter() const { return FormatFilter; }
-	bool HasActiveFilters() const;
+	int32 GetMinWidthFilter() const { return (int32)GetColumnMinFilter(ColumnWidth); }
+	int32 GetMinHeightFilter() const { return (int32)GetColumnMinFilter(ColumnHeight); }
+	FString GetFormatFilter() const { return GetColumnFilter(ColumnFormat); }
 
 	// Settings integration
 	void LoadSettingsFromConfig(UOptimizerSettings* Settings);
 	void SaveSettingsToConfig(UOptimizerSettings* Settings);
 
+	// Column id for a sort column
+	static FName GetColumnId(ESortColumn InColumn);
+	static FName GetColumnId(ETextureSortColumn InColumn);
+
+	// Counts and estimated bytes per format, size bucket, LOD group, folder and issue; the filtered
+	// sums follow the published results
+	const FAssetFacetIndex& GetFacets() const { return Facets; }
+
+protected:
+	virtual void HandleSourceDataChanged(const TArray<FTextureAuditRowPtr>& Rows) override;
+	virtual void HandleResultsPublished(const TArray<int32>& FilteredIndices) override;
+
 private:
-	// Source and filtered data
-	TArray<FTextureAuditRowPtr> SourceData;
-	TArray<FTextureAuditRowPtr> FilteredData;
-	
-	// Filter state
-	FString TextFilter;
-	int32 MinWidthFilter;
-	int32 MinHeightFilter;
-	FString FormatFilter;
-	
-	// Sort state
-	ESortColumn CurrentSortColumn;
-	bool bSortAscending;
-	
-	// Internal methods
-	void ApplyFilters();
-	void ApplySorting();
-	bool RowPassesFilters(const FTextureAuditRowPtr& Row) const;
-	int32 CompareRows(const FTextureAuditRowPtr& A, const FTextureAuditRowPtr& B) const;
+	static TArray<FColumn> MakeColumns();
+
+	FAssetFacetIndex Facets;
+
+	// Facet rows are keyed by asset path, so loading a fresh audit only re-aggregates the rows whose
+	// facet values changed. SourceFacetRows maps source row index to facet row.
+	TMap<FString, int32> FacetRowByPath;
+	TArray<uint32> FacetRowHashes;
+	TArray<int32> FreeFacetRows;
+	TArray<int32> DuplicateFacetRows;
+	TArray<int32> SourceFacetRows;
+	TArray<int32> FilteredFacetRows;
 };
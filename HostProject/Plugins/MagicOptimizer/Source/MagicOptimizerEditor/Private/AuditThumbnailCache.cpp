@@ -0,0 +1,266 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#include "AuditThumbnailCache.h"
+#include "MagicOptimizerTrace.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Brushes/SlateDynamicImageBrush.h"
+#include "ImageUtils.h"
+#include "Misc/ObjectThumbnail.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopeLock.h"
+#include "ObjectTools.h"
+#include "Styling/AppStyle.h"
+#include "Tasks/Task.h"
+#include "Widgets/Images/SImage.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Views/ITableRow.h"
+#include "MagicOptimizerMemory.h"
+
+namespace
+{
+	// Frames a request survives without its row being painted
+	static constexpr uint64 StaleRequestFrames = 2;
+
+	// Audit CSVs list package paths ("/Game/T_Foo"); the registry wants object paths ("/Game/T_Foo.T_Foo")
+	static FString ToObjectPath(const FString& AssetPath)
+	{
+		return AssetPath.Contains(TEXT(".")) ? AssetPath : AssetPath + TEXT(".") + FPackageName::GetShortName(AssetPath);
+	}
+}
+
+FAuditThumbnailCache::FAuditThumbnailCache(int32 InCapacity)
+	: Brushes(FMath::Max(1, InCapacity))
+	, Completed(MakeShared<FCompletionQueue, ESPMode::ThreadSafe>())
+{
+}
+
+FAuditThumbnailCache::~FAuditThumbnailCache()
+{
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	}
+}
+
+const FSlateBrush* FAuditThumbnailCache::GetBrush(const FString& AssetPath, int32 Priority)
+{
+	MAGICOPT_LLM_SCOPE(Thumbnails);
+	if (const TSharedPtr<FSlateDynamicImageBrush>* Brush = Brushes.FindAndTouch(AssetPath))
+	{
+		return Brush->Get();
+	}
+	if (AssetPath.IsEmpty() || InFlight.Contains(AssetPath))
+	{
+		return nullptr;
+	}
+
+	FRequest* Request = Pending.Find(AssetPath);
+	if (!Request)
+	{
+		FRequest NewRequest;
+		if (!StartRequest(AssetPath, NewRequest))
+		{
+			return nullptr;
+		}
+		Request = &Pending.Add(AssetPath, MoveTemp(NewRequest));
+		EnsureTicking();
+	}
+	Request->Priority = Priority;
+	Request->LastRequestedFrame = GFrameCounter;
+	return nullptr;
+}
+
+TSharedRef<SWidget> FAuditThumbnailCache::MakeRowThumbnail(const FString& AssetPath, const TSharedRef<ITableRow>& Row, float Size)
+{
+	const TWeakPtr<FAuditThumbnailCache> WeakCache = AsShared();
+	const TWeakPtr<ITableRow> WeakRow = Row;
+	return SNew(SBox)
+		.WidthOverride(Size)
+		.HeightOverride(Size)
+		[
+			SNew(SImage)
+			.Image_Lambda([WeakCache, WeakRow, AssetPath]() -> const FSlateBrush*
+			{
+				// Evaluated only while the row is on screen; the row's list index is its priority
+				const TSharedPtr<FAuditThumbnailCache> Cache = WeakCache.Pin();
+				const TSharedPtr<ITableRow> PinnedRow = WeakRow.Pin();
+				const FSlateBrush* Brush = Cache.IsValid() && PinnedRow.IsValid() ? Cache->GetBrush(AssetPath, PinnedRow->GetIndexInList()) : nullptr;
+				return Brush ? Brush : FAppStyle::GetNoBrush();
+			})
+		];
+}
+
+bool FAuditThumbnailCache::StartRequest(const FString& AssetPath, FRequest& OutRequest)
+{
+	MAGICOPT_TRACE_SCOPE(MagicOptimizer_RegistryQuery);
+	// Registry lookups are in-memory; nothing here loads the asset
+	const FAssetData AssetData = IAssetRegistry::GetChecked().GetAssetByObjectPath(FSoftObjectPath(ToObjectPath(AssetPath)));
+	if (!AssetData.IsValid())
+	{
+		Brushes.Add(AssetPath, nullptr);
+		return false;
+	}
+	OutRequest.ObjectFullName = AssetData.GetFullName();
+	OutRequest.PackageName = AssetData.PackageName.ToString();
+
+	// A package that is already loaded keeps its thumbnails in memory; copy the pixels for the worker
+	if (const FObjectThumbnail* Thumbnail = ThumbnailTools::FindCachedThumbnail(OutRequest.ObjectFullName))
+	{
+		if (!Thumbnail->IsEmpty())
+		{
+			OutRequest.Width = Thumbnail->GetImageWidth();
+			OutRequest.Height = Thumbnail->GetImageHeight();
+			OutRequest.Bgra = Thumbnail->GetUncompressedImageData();
+		}
+	}
+	return true;
+}
+
+void FAuditThumbnailCache::EnsureTicking()
+{
+	if (!TickHandle.IsValid())
+	{
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FAuditThumbnailCache::Tick));
+	}
+}
+
+bool FAuditThumbnailCache::Tick(float DeltaTime)
+{
+	MAGICOPT_LLM_SCOPE(Thumbnails);
+	// Finished reads go into the LRU
+	TArray<FDecoded> Done;
+	{
+		FScopeLock Lock(&Completed->Lock);
+		Done = MoveTemp(Completed->Items);
+	}
+	for (const FDecoded& Decoded : Done)
+	{
+		InFlight.Remove(Decoded.AssetPath);
+		AddBrush(Decoded.AssetPath, Decoded.Width, Decoded.Height, Decoded.Bgra);
+	}
+
+	// Rows that stopped painting no longer want their thumbnail
+	for (auto It = Pending.CreateIterator(); It; ++It)
+	{
+		if (GFrameCounter - It.Value().LastRequestedFrame > StaleRequestFrames)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Fill the free read slots, most important (top-most) row first
+	while (InFlight.Num() < MaxReadsInFlight && Pending.Num() > 0)
+	{
+		const FString* BestPath = nullptr;
+		int32 BestPriority = MAX_int32;
+		for (const TPair<FString, FRequest>& Entry : Pending)
+		{
+			if (!BestPath || Entry.Value.Priority < BestPriority)
+			{
+				BestPath = &Entry.Key;
+				BestPriority = Entry.Value.Priority;
+			}
+		}
+		const FString AssetPath = *BestPath;
+		LaunchRead(AssetPath, Pending.FindAndRemoveChecked(AssetPath));
+		InFlight.Add(AssetPath);
+	}
+
+	if (Pending.Num() == 0 && InFlight.Num() == 0)
+	{
+		TickHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FAuditThumbnailCache::LaunchRead(const FString& AssetPath, FRequest Request)
+{
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [AssetPath, Request = MoveTemp(Request), Queue = Completed]() mutable
+	{
+		MAGICOPT_LLM_SCOPE(Thumbnails);
+		MAGICOPT_TRACE_SCOPE(MagicOptimizer_LoadThumbnail);
+		FDecoded Decoded;
+		Decoded.AssetPath = AssetPath;
+		if (Request.Bgra.Num() > 0)
+		{
+			Decoded.Width = Request.Width;
+			Decoded.Height = Request.Height;
+			Decoded.Bgra = MoveTemp(Request.Bgra);
+		}
+		else
+		{
+			// Reads only the package summary and thumbnail table, not the exports
+			FString Filename;
+			if (FPackageName::DoesPackageExist(Request.PackageName, &Filename))
+			{
+				const FName FullName(*Request.ObjectFullName);
+				TSet<FName> Names;
+				Names.Add(FullName);
+				FThumbnailMap Thumbnails;
+				if (ThumbnailTools::LoadThumbnailsFromPackage(Filename, Names, Thumbnails))
+				{
+					if (const FObjectThumbnail* Thumbnail = Thumbnails.Find(FullName))
+					{
+						if (!Thumbnail->IsEmpty())
+						{
+							Decoded.Width = Thumbnail->GetImageWidth();
+							Decoded.Height = Thumbnail->GetImageHeight();
+							Decoded.Bgra = Thumbnail->GetUncompressedImageData();
+						}
+					}
+				}
+				MAGICOPT_TRACE_ASSET(AssetLoad, AssetPath, Decoded.Bgra.Num());
+			}
+		}
+		Downscale(Decoded);
+
+		FScopeLock Lock(&Queue->Lock);
+		Queue->Items.Add(MoveTemp(Decoded));
+	}, UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void FAuditThumbnailCache::AddBrush(const FString& AssetPath, int32 Width, int32 Height, const TArray<uint8>& Bgra)
+{
+	MAGICOPT_LLM_SCOPE(Thumbnails);
+	if (Bgra.Num() == 0)
+	{
+		Brushes.Add(AssetPath, nullptr);
+		return;
+	}
+	// The least recently used brush is evicted once the cache is full, releasing its texture
+	const FName ResourceName(*FString::Printf(TEXT("MagicOptimizerThumbnail_%u"), NextBrushId++));
+	Brushes.Add(AssetPath, FSlateDynamicImageBrush::CreateWithImageData(ResourceName, FVector2D(Width, Height), Bgra));
+}
+
+void FAuditThumbnailCache::Downscale(FDecoded& Decoded)
+{
+	const int32 Width = Decoded.Width;
+	const int32 Height = Decoded.Height;
+	if (Width <= 0 || Height <= 0 || Decoded.Bgra.Num() != Width * Height * 4)
+	{
+		Decoded.Width = Decoded.Height = 0;
+		Decoded.Bgra.Reset();
+		return;
+	}
+	if (Width <= ThumbnailSize && Height <= ThumbnailSize)
+	{
+		return;
+	}
+
+	const float Scale = (float)ThumbnailSize / (float)FMath::Max(Width, Height);
+	const int32 NewWidth = FMath::Max(1, FMath::RoundToInt(Width * Scale));
+	const int32 NewHeight = FMath::Max(1, FMath::RoundToInt(Height * Scale));
+
+	// Thumbnail pixels are BGRA8, the same layout as FColor
+	TArray<FColor> Source;
+	Source.SetNumUninitialized(Width * Height);
+	FMemory::Memcpy(Source.GetData(), Decoded.Bgra.GetData(), Decoded.Bgra.Num());
+	TArray<FColor> Resized;
+	FImageUtils::ImageResize(Width, Height, Source, NewWidth, NewHeight, Resized, /*bLinearSpace*/ false);
+
+	Decoded.Width = NewWidth;
+	Decoded.Height = NewHeight;
+	Decoded.Bgra.SetNumUninitialized(Resized.Num() * 4);
+	FMemory::Memcpy(Decoded.Bgra.GetData(), Resized.GetData(), Decoded.Bgra.Num());
+}
@@ -9,6 +9,7 @@
 #include "ContentBrowserModule.h"
 #include "IContentBrowserSingleton.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "MagicOptimizerTrace.h"
 
 namespace
 {
@@ -37,6 +38,7 @@ namespace ContentBrowserActions
 
 	bool SyncToAssetPath(const FString& InPath)
 	{
+		MAGICOPT_TRACE_SCOPE(MagicOptimizer_RegistryQuery);
 		const FString ObjectPath = EnsureObjectPath(InPath);
 		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
 		const FAssetData AssetData = AssetRegistryModule.Get().GetAssetByObjectPath(FSoftObjectPath(*ObjectPath));
@@ -13,6 +13,9 @@
 #include "Framework/Commands/Commands.h"
 #include "Framework/Commands/UICommandList.h"
 #include "Engine/Engine.h"
+#include "MagicOptimizerMemory.h"
+#include "Services/Scheduling/GameThreadExecutor.h"
+#include "Framework/Application/SlateApplication.h"
 
 #define LOCTEXT_NAMESPACE "FMagicOptimizerEditorModule"
 
@@ -48,11 +51,19 @@ public:
 
 void FMagicOptimizerEditorModule::StartupModule()
 {
-    if (!GIsEditor)
+    MAGICOPT_LLM_SCOPE_ROOT();
+    // Commandlets (CI runs) have no UI to extend
+    if (!GIsEditor || IsRunningCommandlet())
     {
         return;
     }
 
+    // Time-sliced work shrinks its frame budget while the user is using the editor
+    MagicOptimizerGameThread::SetInteractionProbe([]()
+    {
+        return FSlateApplication::IsInitialized() ? FPlatformTime::Seconds() - FSlateApplication::Get().GetLastUserInteractionTime() : DBL_MAX;
+    });
+
     // Register commands
     FMagicOptimizerCommands::Register();
     CommandList = MakeShared<FUICommandList>();
@@ -123,6 +134,8 @@ void FMagicOptimizerEditorModule::StartupModule()
 
 void FMagicOptimizerEditorModule::ShutdownModule()
 {
+    MagicOptimizerGameThread::SetInteractionProbe(MagicOptimizerGameThread::FInteractionProbe());
+
     // Unregister ToolMenus
     UToolMenus::UnRegisterStartupCallback(this);
     UToolMenus::UnregisterOwner(this);
@@ -164,6 +177,7 @@ void FMagicOptimizerEditorModule::RegisterMenus()
 
 TSharedRef<SDockTab> FMagicOptimizerEditorModule::OnSpawnPluginTab(const FSpawnTabArgs& SpawnTabArgs)
 {
+    MAGICOPT_LLM_SCOPE(Views);
     return SNew(SDockTab)
         .TabRole(ETabRole::NomadTab)
         [
@@ -189,6 +203,7 @@ void FMagicOptimizerEditorModule::OpenOptimizerPanel()
 // Command execution methods
 void FMagicOptimizerEditorModule::ExecuteRunOptimization()
 {
+    MAGICOPT_LLM_SCOPE(Bridge);
     if (GEngine)
     {
         if (UMagicOptimizerSubsystem* Subsystem = GEngine->GetEngineSubsystem<UMagicOptimizerSubsystem>())
@@ -205,6 +220,7 @@ void FMagicOptimizerEditorModule::ExecuteRunOptimization()
 
 void FMagicOptimizerEditorModule::ExecuteRunTextureOptimization()
 {
+    MAGICOPT_LLM_SCOPE(Bridge);
     if (GEngine)
     {
         if (UMagicOptimizerSubsystem* Subsystem = GEngine->GetEngineSubsystem<UMagicOptimizerSubsystem>())
@@ -221,6 +237,7 @@ void FMagicOptimizerEditorModule::ExecuteRunTextureOptimization()
 
 void FMagicOptimizerEditorModule::ExecuteRunMeshOptimization()
 {
+    MAGICOPT_LLM_SCOPE(Bridge);
     if (GEngine)
     {
         if (UMagicOptimizerSubsystem* Subsystem = GEngine->GetEngineSubsystem<UMagicOptimizerSubsystem>())
@@ -237,6 +254,7 @@ void FMagicOptimizerEditorModule::ExecuteRunMeshOptimization()
 
 void FMagicOptimizerEditorModule::ExecuteRunMaterialOptimization()
 {
+    MAGICOPT_LLM_SCOPE(Bridge);
     if (GEngine)
     {
         if (UMagicOptimizerSubsystem* Subsystem = GEngine->GetEngineSubsystem<UMagicOptimizerSubsystem>())
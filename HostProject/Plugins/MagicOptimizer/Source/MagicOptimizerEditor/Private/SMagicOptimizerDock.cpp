@@ -8,13 +8,17 @@
 
 #include "OptimizerSettings.h"
 #include "PythonBridge.h"
+#include "MagicOptimizerStats.h"
+#include "MagicOptimizerLogging.h"
 #include "ViewModels/TextureTableViewModel.h"
+#include "Services/Facets/AssetFacetIndex.h"
 
 // SDashboard might not be available in UE5.6, using standard widgets instead
 #include "STextureAuditSection.h"
 #include "STextureRecommendSection.h"
 #include "SMeshesTab.h"
 #include "SMaterialsTab.h"
+#include "AuditThumbnailCache.h"
 
 #include "Services/Csv/TextureCsvReader.h"
 #include "Services/Csv/MeshCsvReader.h"
@@ -35,6 +39,7 @@
 #include "Widgets/Images/SImage.h"
 #include "Widgets/Layout/SWidgetSwitcher.h"
 #include "Widgets/Layout/SSpacer.h"
+#include "Widgets/Layout/SWrapBox.h"
 #include "Styling/AppStyle.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Widgets/SWindow.h"
@@ -48,6 +53,7 @@
 #include "Input/Events.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "Misc/PackageName.h"
 #include "HAL/FileManager.h"
 #include "HAL/PlatformApplicationMisc.h"
 #include "Editor.h"
@@ -61,9 +67,69 @@
 #include "Serialization/JsonWriter.h"
 #include "Serialization/JsonSerializer.h"
 #include "Policies/CondensedJsonPrintPolicy.h"
+#include "MagicOptimizerMemory.h"
+#include "Services/Apply/TextureApply.h"
+#include "Services/Scheduling/GameThreadExecutor.h"
+#include "Services/Scheduling/MemoryGovernor.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+
+namespace
+{
+	// On-disk size of a package, for the run stats and trace byte counters
+	static int64 GetPackageFileSize(const UPackage* Package)
+	{
+		FString Filename;
+		if (!Package || !FPackageName::TryConvertLongPackageNameToFilename(Package->GetName(), Filename, FPackageName::GetAssetPackageExtension()))
+		{
+			return 0;
+		}
+		return FMath::Max<int64>(0, IFileManager::Get().FileSize(*Filename));
+	}
+
+	// Checkout-and-save without prompting, for the texture apply items
+	static void SaveTexturePackage(UPackage* Package)
+	{
+		TArray<UPackage*> PackagesToSave; PackagesToSave.Add(Package);
+		FEditorFileUtils::PromptForCheckoutAndSave(PackagesToSave, /*bCheckDirty=*/false, /*bPromptToSave=*/false);
+	}
+
+	static void AddSetTextureSrgbItems(TArray<MagicOptimizerGameThread::FWorkItem>& OutItems, const FString& ObjPath, bool bSRGB,
+		TFunction<void(bool bPreviousSRGB)> OnEdited, TFunction<void(bool bSaved)> OnSaved)
+	{
+		TextureApply::AddSetSrgbItems(OutItems, ObjPath, bSRGB, MoveTemp(OnEdited), MoveTemp(OnSaved), &SaveTexturePackage);
+	}
+
+	/**
+	 * Queues setting each texture back to its SRGB value. Not cancellable: it is what a cancelled apply
+	 * runs to roll back, and it outlives the dock if the tab is closed.
+	 */
+	static void QueueSrgbRevert(const TArray<TPair<FString, bool>>& Targets, TFunction<void(int32 NumReverted, bool bCompleted)> OnDone)
+	{
+		const TSharedRef<int32> NumReverted = MakeShared<int32>(0);
+		TArray<MagicOptimizerGameThread::FWorkItem> WorkItems;
+		WorkItems.Reserve(Targets.Num() * 2);
+		for (const TPair<FString, bool>& Target : Targets)
+		{
+			AddSetTextureSrgbItems(WorkItems, Target.Key, Target.Value, nullptr, [NumReverted](bool bSaved)
+			{
+				*NumReverted += bSaved ? 1 : 0;
+			});
+		}
+		MagicOptimizerGameThread::Enqueue(TEXT("Revert textures"), MoveTemp(WorkItems), [NumReverted, OnDone = MoveTemp(OnDone)](bool bCompleted)
+		{
+			if (OnDone)
+			{
+				OnDone(*NumReverted, bCompleted);
+			}
+		});
+	}
+}
 
 void SMagicOptimizerDock::Construct(const FArguments& InArgs)
 {
+	MAGICOPT_LLM_SCOPE(Views);
 	InitializeServices();
 	InitializePresets();
 
@@ -110,9 +176,13 @@ void SMagicOptimizerDock::Construct(const FArguments& InArgs)
 
 SMagicOptimizerDock::~SMagicOptimizerDock()
 {
-	if (TextureTableViewModel.IsValid() && OptimizerSettings)
+	if (TextureTableViewModel.IsValid())
 	{
-		TextureTableViewModel->SaveSettingsToConfig(OptimizerSettings);
+		TextureTableViewModel->OnResultsReady().RemoveAll(this);
+		if (OptimizerSettings)
+		{
+			TextureTableViewModel->SaveSettingsToConfig(OptimizerSettings);
+		}
 	}
 }
 
@@ -133,10 +203,14 @@ void SMagicOptimizerDock::InitializeServices()
 	{
 		TextureTableViewModel->LoadSettingsFromConfig(OptimizerSettings);
 	}
+	// Facet chips and quick fixes follow the filtered results
+	TextureTableViewModel->OnResultsReady().AddSP(this, &SMagicOptimizerDock::HandleTextureResultsReady);
 	// Preload source control hint
 	UpdateSourceControlHint();
-	// Create thumbnail pool (size 32, not shared)
+	// Thumbnail pool for the slide-over preview (size 32, not shared)
 	ThumbnailPool = MakeShareable(new FAssetThumbnailPool(32));
+	// The audit lists read saved package thumbnails instead, so scrolling never loads assets
+	ThumbnailCache = MakeShared<FAuditThumbnailCache>();
 }
 
 void SMagicOptimizerDock::InitializePresets()
@@ -285,10 +359,22 @@ TSharedRef<SWidget> SMagicOptimizerDock::BuildLeftRail()
 		[
 			SAssignNew(SearchBox, SEditableTextBox)
 			.MinDesiredWidth(200)
-			.HintText(FText::FromString(TEXT("Search (e.g. type normal, group UI)")))
+			.HintText(FText::FromString(TEXT("Search (e.g. type:normal width>2048 group:ui issue:srgb)")))
 			.OnTextChanged(this, &SMagicOptimizerDock::OnSearchTextChanged)
 		]
 		+ SVerticalBox::Slot().AutoHeight().Padding(0,8,0,0)
+		[
+			SNew(STextBlock).Text(FText::FromString(TEXT("Facets")))
+		]
+		+ SVerticalBox::Slot().FillHeight(0.6f).Padding(0,4,0,0)
+		[
+			SNew(SScrollBox)
+			+ SScrollBox::Slot()
+			[
+				SAssignNew(FacetChipsBox, SVerticalBox)
+			]
+		]
+		+ SVerticalBox::Slot().AutoHeight().Padding(0,8,0,0)
 		[
 			SNew(SHorizontalBox)
 			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)[ SNew(STextBlock).Text(FText::FromString(TEXT("Saved Views"))) ]
@@ -357,6 +443,7 @@ TSharedRef<SWidget> SMagicOptimizerDock::BuildMainViews()
 					.Visibility_Lambda([this](){ return CurrentAuditType==EAuditAssetType::Textures?EVisibility::Visible:EVisibility::Collapsed; })
 					[
 						SAssignNew(AuditTexturesWidget, STextureAuditSection)
+						.ThumbnailCache(ThumbnailCache)
 					]
 				]
 				+ SOverlay::Slot()
@@ -365,6 +452,7 @@ TSharedRef<SWidget> SMagicOptimizerDock::BuildMainViews()
 					.Visibility_Lambda([this](){ return CurrentAuditType==EAuditAssetType::Meshes?EVisibility::Visible:EVisibility::Collapsed; })
 					[
 						SAssignNew(MeshesTabWidget, SMeshesTab)
+						.ThumbnailCache(ThumbnailCache)
 					]
 				]
 				+ SOverlay::Slot()
@@ -373,6 +461,7 @@ TSharedRef<SWidget> SMagicOptimizerDock::BuildMainViews()
 					.Visibility_Lambda([this](){ return CurrentAuditType==EAuditAssetType::Materials?EVisibility::Visible:EVisibility::Collapsed; })
 					[
 						SAssignNew(MaterialsTabWidget, SMaterialsTab)
+						.ThumbnailCache(ThumbnailCache)
 					]
 				]
 			]
@@ -443,7 +532,14 @@ TSharedRef<SWidget> SMagicOptimizerDock::BuildMainViews()
 				SNew(SHorizontalBox)
 				+ SHorizontalBox::Slot().AutoWidth().Padding(0,0,4,0)[ SNew(SButton).Text(FText::FromString(TEXT("Pause"))) ]
 				+ SHorizontalBox::Slot().AutoWidth().Padding(0,0,4,0)[ SNew(SButton).Text(FText::FromString(TEXT("Resume"))) ]
-				+ SHorizontalBox::Slot().AutoWidth().Padding(0,0,4,0)[ SNew(SButton).Text(FText::FromString(TEXT("Cancel"))) ]
+				+ SHorizontalBox::Slot().AutoWidth().Padding(0,0,4,0)
+				[
+					SNew(SButton)
+					.Text(FText::FromString(TEXT("Cancel")))
+					.ToolTipText(FText::FromString(TEXT("Stop after the current texture and roll back the ones already changed")))
+					.IsEnabled_Lambda([this]() { return bApplyRunning; })
+					.OnClicked(this, &SMagicOptimizerDock::OnCancelApply)
+				]
 				+ SHorizontalBox::Slot().FillWidth(1.f)
 				[
 					SNew(SSpacer)
@@ -487,10 +583,7 @@ TSharedRef<SWidget> SMagicOptimizerDock::BuildMainViews()
 					.Text(FText::FromString(TEXT("Revert All")))
 					.OnClicked_Lambda([this]()
 					{
-						for (const FTextureSnapshotItem& Item : LoadedSnapshot)
-						{
-							OnRevertOne(Item.ObjectPath);
-						}
+						RevertTextures(LoadedSnapshot);
 						return FReply::Handled();
 					})
 				]
@@ -520,6 +613,8 @@ TSharedRef<SWidget> SMagicOptimizerDock::BuildMainViews()
 					[
 						SNew(SHorizontalBox)
 						+ SHorizontalBox::Slot().FillWidth(1.f).Padding(2,0)[ SNew(STextBlock).Text(FText::FromString(Item.IsValid() ? Item->Name : TEXT(""))) ]
+						+ SHorizontalBox::Slot().AutoWidth().Padding(8,0)[ SNew(STextBlock).Text(FText::FromString(Item.IsValid() ? Item->PerfSummary : TEXT(""))) ]
+						+ SHorizontalBox::Slot().AutoWidth().Padding(2,0)[ SNew(SButton).Text(FText::FromString(TEXT("Perf"))).IsEnabled(Item.IsValid() && !Item->PerfSummary.IsEmpty()).OnClicked_Lambda([this, Item]() { return OnOpenArtifact(Item->StatsPath); }) ]
 						+ SHorizontalBox::Slot().AutoWidth().Padding(2,0)[ SNew(SButton).Text(FText::FromString(TEXT("CSV"))).OnClicked_Lambda([this, Item]() { return OnOpenArtifact(Item->CsvPath); }) ]
 						+ SHorizontalBox::Slot().AutoWidth().Padding(2,0)[ SNew(SButton).Text(FText::FromString(TEXT("JSON"))).OnClicked_Lambda([this, Item]() { return OnOpenArtifact(Item->JsonPath); }) ]
 						+ SHorizontalBox::Slot().AutoWidth().Padding(2,0)[ SNew(SButton).Text(FText::FromString(TEXT("HTML"))).OnClicked_Lambda([this, Item]() { return OnOpenArtifact(Item->HtmlPath); }) ]
@@ -598,6 +693,7 @@ FText SMagicOptimizerDock::GetScopeSummaryText() const
 
 FReply SMagicOptimizerDock::OnRunScan()
 {
+	MAGICOPT_LLM_SCOPE(Bridge);
 	if (!PythonBridge || !PythonBridge->IsPythonAvailable())
 	{
 		Notify(TEXT("Python bridge unavailable"), false);
@@ -615,12 +711,23 @@ FReply SMagicOptimizerDock::OnRunScan()
 
 	AppendTaskLine(TEXT("Run Scan started"));
 	StartProgressNotification(TEXT("MagicOptimizer: Running Scan"));
-	auto Result = PythonBridge->RunOptimization(Params);
+	MagicOptimizerStats::BeginRun(TEXT("Scan"));
+	FOptimizerResult Result;
+	{
+		MagicOptimizerStats::FPhaseScope Phase(TEXT("Python Audit"));
+		Result = PythonBridge->RunOptimization(Params);
+	}
 	if (Result.AssetsProcessed > 0)
 	{
 		AppendTaskLine(FString::Printf(TEXT("Scan processed %d assets (%d modified)"), Result.AssetsProcessed, Result.AssetsModified));
 	}
-	LoadAuditData();
+	{
+		MagicOptimizerStats::FPhaseScope Phase(TEXT("Load Audit"));
+		LoadAuditData();
+	}
+	const MagicOptimizerStats::FRunStats RunStats = MagicOptimizerStats::EndRun();
+	AppendTaskLine(FString::Printf(TEXT("Scan took %.1fs (%.0f assets/s)"), RunStats.WallSeconds, RunStats.GetAssetsPerSecond()));
+	RefreshRunsList();
 	UpdateQuickFixShelf();
 	SwitchView(EMainView::Audit);
 	CompleteProgressNotification(Result.bSuccess, Result.bSuccess ? TEXT("Scan complete") : TEXT("Scan failed"));
@@ -637,6 +744,12 @@ FReply SMagicOptimizerDock::OnPreviewPlan()
 
 FReply SMagicOptimizerDock::OnAutoFix()
 {
+	MAGICOPT_LLM_SCOPE(Apply);
+	if (bApplyRunning)
+	{
+		Notify(TEXT("Apply already running"), false);
+		return FReply::Handled();
+	}
 	// Confirm before applying
 	const FText Title = FText::FromString(TEXT("Apply fixes?"));
 	const FText Msg = FText::FromString(TEXT("This will write changes. A snapshot is saved for reverts."));
@@ -645,6 +758,11 @@ FReply SMagicOptimizerDock::OnAutoFix()
 	{
 		return FReply::Handled();
 	}
+	if (TextureTableViewModel.IsValid())
+	{
+		// Act on the rows for the latest filters, not a result still being computed
+		TextureTableViewModel->WaitForRefresh();
+	}
 	if (OptimizerSettings && TextureTableViewModel.IsValid())
 	{
 		const int32 Planned = TextureTableViewModel->GetFilteredCount();
@@ -655,24 +773,11 @@ FReply SMagicOptimizerDock::OnAutoFix()
 			if (OverResp != EAppReturnType::Yes) { return FReply::Handled(); }
 		}
 	}
-	// Guarded action: still keep dry run by default
-	FOptimizerRunParams Params;
-	Params.Phase = TEXT("Apply");
-	Params.Profile = CurrentPreset.IsValid() ? *CurrentPreset : TEXT("Console Balanced");
-	Params.bDryRun = false;
-	Params.MaxChanges = OptimizerSettings ? OptimizerSettings->MaxChanges : 500;
-	Params.Categories = { TEXT("Textures") };
-	if (PythonBridge)
-	{
-		AppendTaskLine(TEXT("Apply started"));
-		StartProgressNotification(TEXT("MagicOptimizer: Applying"));
-		auto Result = PythonBridge->RunOptimization(Params);
-		if (Result.AssetsProcessed > 0)
-		{
-			AppendTaskLine(FString::Printf(TEXT("Apply processed %d assets (%d modified)"), Result.AssetsProcessed, Result.AssetsModified));
-		}
-		CompleteProgressNotification(Result.bSuccess, Result.bSuccess ? TEXT("Apply complete") : TEXT("Apply failed"));
-	}
+	MagicOptimizerStats::BeginRun(TEXT("Apply"));
+	// Snapshot, Python apply and native batch run one after another under one token; Cancel stops the
+	// current step and skips the rest, and once the Python apply has started it rolls back to the snapshot
+	ApplyCancelToken = MakeShared<FOptimizerCancellationToken, ESPMode::ThreadSafe>();
+	bApplyRunning = true;
 	// Prepare snapshot/report for Verify & Reports
 	LastReportDir = FPaths::ProjectSavedDir() / TEXT("MagicOptimizer/Reports");
 	IFileManager::Get().MakeDirectory(*LastReportDir, true);
@@ -684,24 +789,114 @@ FReply SMagicOptimizerDock::OnAutoFix()
 	}
 	if (ObjectPaths.Num() == 0 && TextureTableViewModel.IsValid())
 	{
-		for (const FTextureAuditRowPtr& Row : TextureTableViewModel->GetFilteredData())
+		const TArray<FTextureAuditRowPtr>& SourceRows = TextureTableViewModel->GetSourceData();
+		for (const int32 RowIndex : TextureTableViewModel->GetFilteredIndices())
 		{
+			const FTextureAuditRowPtr& Row = SourceRows[RowIndex];
 			if (Row.IsValid()) { ObjectPaths.Add(ToObjectPath(Row->Path)); }
 		}
 	}
-	// Save snapshot and apply batch
-	FString SnapshotPath;
-	if (SaveTextureSnapshot(ObjectPaths, SnapshotPath))
+	// Snapshot first, so a cancel can roll back whatever the Python apply changes
+	AppendTaskLine(TEXT("Apply started"));
+	const TWeakPtr<SMagicOptimizerDock> WeakDock = SharedThis(this);
+	SaveTextureSnapshot(ObjectPaths, [WeakDock, ObjectPaths](const TArray<TPair<FString, bool>>& Snapshot, bool bCompleted)
 	{
-		LastSnapshotPath = SnapshotPath;
+		const TSharedPtr<SMagicOptimizerDock> Dock = WeakDock.Pin();
+		if (!Dock.IsValid())
+		{
+			MagicOptimizerStats::EndRun(/*bCancelled*/ true);
+			return;
+		}
+		if (!bCompleted)
+		{
+			Dock->FinishApply(false, TEXT("Apply cancelled"));
+			return;
+		}
+		Dock->RunPythonApply(ObjectPaths, Snapshot);
+	});
+	return FReply::Handled();
+}
+
+void SMagicOptimizerDock::RunPythonApply(const TArray<FString>& ObjectPaths, const TArray<TPair<FString, bool>>& Snapshot)
+{
+	MAGICOPT_LLM_SCOPE(Apply);
+	if (!PythonBridge)
+	{
+		ApplySrgbOffBatch(ObjectPaths);
+		return;
 	}
-	ApplySrgbOffBatch(ObjectPaths);
+	// Guarded action: still keep dry run by default
+	FOptimizerRunParams Params;
+	Params.Phase = TEXT("Apply");
+	Params.Profile = CurrentPreset.IsValid() ? *CurrentPreset : TEXT("Console Balanced");
+	Params.bDryRun = false;
+	Params.MaxChanges = OptimizerSettings ? OptimizerSettings->MaxChanges : 500;
+	Params.Categories = { TEXT("Textures") };
+	Params.CancelToken = ApplyCancelToken;
+	StartProgressNotification(TEXT("MagicOptimizer: Applying"));
+
+	// The process runs on a worker so the dock, and its Cancel button, stay responsive
+	TStrongObjectPtr<UPythonBridge> Bridge(PythonBridge);
+	const TWeakPtr<SMagicOptimizerDock> WeakDock = SharedThis(this);
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Bridge = MoveTemp(Bridge), Params, WeakDock, ObjectPaths, Snapshot]() mutable
+	{
+		MAGICOPT_LLM_SCOPE_ROOT();
+		const FOptimizerResult Result = Bridge->RunOptimization(Params);
+
+		// The bridge reference is released on the game thread
+		AsyncTask(ENamedThreads::GameThread, [Bridge = MoveTemp(Bridge), Result, CancelToken = Params.CancelToken, WeakDock, ObjectPaths, Snapshot]()
+		{
+			if (Result.bCancelled || (CancelToken.IsValid() && CancelToken->IsCancelled()))
+			{
+				UE_LOG(LogMagicOptimizer, Log, TEXT("Python apply stopped %.0f ms after cancel; rolling back %d textures"),
+					CancelToken.IsValid() ? CancelToken->GetSecondsSinceCancel() * 1000.0 : 0.0, Snapshot.Num());
+				QueueSrgbRevert(Snapshot, [WeakDock](int32 NumReverted, bool bRevertCompleted)
+				{
+					if (const TSharedPtr<SMagicOptimizerDock> Dock = WeakDock.Pin())
+					{
+						Dock->Notify(FString::Printf(TEXT("Rolled back %d textures"), NumReverted), bRevertCompleted);
+					}
+				});
+				if (const TSharedPtr<SMagicOptimizerDock> Dock = WeakDock.Pin())
+				{
+					Dock->FinishApply(false, TEXT("Apply cancelled"));
+				}
+				else
+				{
+					MagicOptimizerStats::EndRun(/*bCancelled*/ true);
+				}
+				return;
+			}
+			const TSharedPtr<SMagicOptimizerDock> Dock = WeakDock.Pin();
+			if (!Dock.IsValid())
+			{
+				MagicOptimizerStats::EndRun(/*bCancelled*/ false);
+				return;
+			}
+			if (Result.AssetsProcessed > 0)
+			{
+				Dock->AppendTaskLine(FString::Printf(TEXT("Apply processed %d assets (%d modified)"), Result.AssetsProcessed, Result.AssetsModified));
+			}
+			Dock->CompleteProgressNotification(Result.bSuccess, Result.bSuccess ? TEXT("Apply complete") : TEXT("Apply failed"));
+			// The native batch ends the run
+			Dock->ApplySrgbOffBatch(ObjectPaths);
+		});
+	});
+}
+
+void SMagicOptimizerDock::FinishApply(bool bSuccess, const FString& Message)
+{
+	MagicOptimizerStats::EndRun(/*bCancelled*/ !bSuccess);
+	bApplyRunning = false;
+	ApplyCancelToken.Reset();
+	CompleteProgressNotification(bSuccess, Message);
 	RefreshRunsList();
-	return FReply::Handled();
 }
 
 void SMagicOptimizerDock::LoadAuditData()
 {
+	MAGICOPT_LLM_SCOPE(AuditStore);
+	MAGICOPT_TRACE_SCOPE(MagicOptimizer_LoadAuditData);
 	TArray<TSharedPtr<struct FTextureAuditRow>> TextureRows;
 	TextureCsvReader::ReadAuditCsv(OptimizerSettings, TextureRows);
 	if (TextureTableViewModel.IsValid())
@@ -758,10 +953,10 @@ void SMagicOptimizerDock::LoadAuditData()
 
 void SMagicOptimizerDock::LoadRecommendations()
 {
+	MAGICOPT_LLM_SCOPE(AuditStore);
 	if (!RecommendWidget.IsValid()) { return; }
-	TArray<FTextureRecRowPtr> RecRows;
-	TextureCsvReader::ReadRecommendationsCsv(OptimizerSettings, RecRows);
-	RecommendWidget->SetRecommendationRows(RecRows);
+	// Paged straight from the CSV; whole-project recommendation sets are never loaded at once
+	RecommendWidget->SetRecommendationSource(TextureCsvReader::OpenRecommendationsSource(OptimizerSettings));
 }
 
 void SMagicOptimizerDock::UpdateSourceControlHint()
@@ -787,9 +982,31 @@ void SMagicOptimizerDock::UpdateQuickFixShelf()
 {
 	if (!QuickFixChipsBox.IsValid()) { return; }
 	QuickFixChipsBox->ClearChildren();
-	// Show only when there is a selection
+	// Without a selection, offer the fixes for issues present in the filtered rows, largest first
 	if (SelectedTextureRows.Num() == 0)
 	{
+		struct FIssueFix { const TCHAR* Issue; const TCHAR* Label; const FAssetFacetBucket* Bucket; };
+		TArray<FIssueFix> Fixes;
+		if (TextureTableViewModel.IsValid())
+		{
+			const FAssetFacetIndex& Facets = TextureTableViewModel->GetFacets();
+			Fixes.Add({ TEXT("srgb"), TEXT("Clear sRGB on masks"), Facets.FindBucket(EAssetFacet::Issue, TEXT("srgb")) });
+			Fixes.Add({ TEXT("normal_format"), TEXT("Convert normals to BC5"), Facets.FindBucket(EAssetFacet::Issue, TEXT("normal_format")) });
+			Fixes.Add({ TEXT("mask_format"), TEXT("Use Masks compression"), Facets.FindBucket(EAssetFacet::Issue, TEXT("mask_format")) });
+			Fixes.RemoveAll([](const FIssueFix& Fix) { return !Fix.Bucket || Fix.Bucket->FilteredCount == 0; });
+			Fixes.Sort([](const FIssueFix& A, const FIssueFix& B) { return A.Bucket->FilteredBytes > B.Bucket->FilteredBytes; });
+		}
+		for (const FIssueFix& Fix : Fixes)
+		{
+			const FString Term = FString::Printf(TEXT("issue:%s"), Fix.Issue);
+			QuickFixChipsBox->AddSlot().AutoHeight()
+			[
+				SNew(SButton)
+				.Text(FText::Format(FText::FromString(TEXT("{0} ({1}, {2})")), FText::FromString(Fix.Label), FText::AsNumber(Fix.Bucket->FilteredCount), FText::AsMemory(Fix.Bucket->FilteredBytes)))
+				.ToolTipText(FText::FromString(FString::Printf(TEXT("Show the affected textures (%s), then select rows to preview the plan"), *Term)))
+				.OnClicked_Lambda([this, Term]() { AppendQueryTerm(Term); return FReply::Handled(); })
+			];
+		}
 		QuickFixChipsBox->AddSlot().AutoHeight()[ SNew(STextBlock).Text(FText::FromString(TEXT("Select rows to see Quick Fixes"))) ];
 		return;
 	}
@@ -809,11 +1026,159 @@ void SMagicOptimizerDock::UpdateQuickFixShelf()
 	];
 }
 
+void SMagicOptimizerDock::RebuildFacetChips()
+{
+	MAGICOPT_LLM_SCOPE(Views);
+	if (!FacetChipsBox.IsValid() || !TextureTableViewModel.IsValid())
+	{
+		return;
+	}
+	FacetChipsBox->ClearChildren();
+
+	const FAssetFacetIndex& Facets = TextureTableViewModel->GetFacets();
+	if (Facets.GetNumRows() == 0)
+	{
+		FacetChipsBox->AddSlot().AutoHeight()[ SNew(STextBlock).Text(FText::FromString(TEXT("Run a scan to see facets"))) ];
+		return;
+	}
+	FacetChipsBox->AddSlot().AutoHeight()
+	[
+		SNew(STextBlock).Text(FText::Format(FText::FromString(TEXT("{0} textures, {1}")), FText::AsNumber(Facets.GetNumFilteredRows()), FText::AsMemory(Facets.GetFilteredBytes())))
+	];
+
+	// Clicking a chip adds the matching query term; folders and issues match by substring
+	struct FFacetQuery { EAssetFacet Facet; const TCHAR* Key; const TCHAR* Op; };
+	static const FFacetQuery FacetQueries[] =
+	{
+		{ EAssetFacet::Format, TEXT("format"), TEXT("=") },
+		{ EAssetFacet::SizeBucket, TEXT("size"), TEXT("=") },
+		{ EAssetFacet::LODGroup, TEXT("group"), TEXT("=") },
+		{ EAssetFacet::Folder, TEXT("path"), TEXT(":") },
+		{ EAssetFacet::Issue, TEXT("issue"), TEXT(":") },
+	};
+	static constexpr int32 MaxChipsPerFacet = 8;
+
+	for (const FFacetQuery& Query : FacetQueries)
+	{
+		TSharedPtr<SWrapBox> Chips;
+		int32 NumChips = 0;
+		for (const FAssetFacetBucket& Bucket : Facets.GetBuckets(Query.Facet))
+		{
+			if (Bucket.FilteredCount == 0 || NumChips == MaxChipsPerFacet)
+			{
+				break;
+			}
+			if (!Chips.IsValid())
+			{
+				FacetChipsBox->AddSlot().AutoHeight().Padding(0,6,0,2)[ SNew(STextBlock).Text(FText::FromString(FAssetFacetIndex::GetFacetName(Query.Facet))) ];
+				FacetChipsBox->AddSlot().AutoHeight()[ SAssignNew(Chips, SWrapBox).UseAllottedSize(true) ];
+			}
+			const FString Value = Bucket.Value.Contains(TEXT(" ")) ? FString::Printf(TEXT("\"%s\""), *Bucket.Value) : Bucket.Value;
+			const FString Term = FString::Printf(TEXT("%s%s%s"), Query.Key, Query.Op, *Value);
+			Chips->AddSlot().Padding(2)
+			[
+				SNew(SButton)
+				.Text(FText::Format(FText::FromString(TEXT("{0}: {1}")), FText::FromString(Bucket.Value), FText::AsMemory(Bucket.FilteredBytes)))
+				.ToolTipText(FText::Format(FText::FromString(TEXT("{0} of {1} textures, {2} of {3} estimated\nClick to add '{4}' to the search")),
+					FText::AsNumber(Bucket.FilteredCount), FText::AsNumber(Bucket.Count), FText::AsMemory(Bucket.FilteredBytes), FText::AsMemory(Bucket.Bytes), FText::FromString(Term)))
+				.OnClicked_Lambda([this, Term]() { AppendQueryTerm(Term); return FReply::Handled(); })
+			];
+			++NumChips;
+		}
+	}
+}
+
+void SMagicOptimizerDock::HandleTextureResultsReady()
+{
+	MAGICOPT_LLM_SCOPE(Views);
+	RebuildFacetChips();
+	if (SelectedTextureRows.Num() == 0)
+	{
+		UpdateQuickFixShelf();
+	}
+}
+
+void SMagicOptimizerDock::AppendQueryTerm(const FString& Term)
+{
+	if (!SearchBox.IsValid())
+	{
+		return;
+	}
+	FString Query = SearchBox->GetText().ToString().TrimStartAndEnd();
+	TArray<FString> Existing;
+	Query.ParseIntoArrayWS(Existing);
+	if (Existing.Contains(Term))
+	{
+		return;
+	}
+	Query = Query.IsEmpty() ? Term : Query + TEXT(" ") + Term;
+	SearchBox->SetText(FText::FromString(Query));
+	OnSearchTextChanged(SearchBox->GetText());
+}
+
 void SMagicOptimizerDock::OnSearchTextChanged(const FText& NewText)
 {
 	if (TextureTableViewModel.IsValid())
 	{
-		TextureTableViewModel->SetTextFilter(NewText.ToString());
+		// Bare words behave like the old substring search; key:value terms narrow further
+		TextureTableViewModel->SetQuery(NewText.ToString());
+		if (SearchBox.IsValid())
+		{
+			SearchBox->SetError(TextureTableViewModel->GetQueryError());
+		}
+	}
+	if (AuditTexturesWidget.IsValid())
+	{
+		AuditTexturesWidget->RefreshDisplay();
+	}
+}
+
+void SMagicOptimizerDock::SaveCurrentView()
+{
+	if (!TextureTableViewModel.IsValid())
+	{
+		return;
+	}
+
+	FSavedView View;
+	View.Text = TextureTableViewModel->GetTextFilter();
+	View.MinW = TextureTableViewModel->GetMinWidthFilter();
+	View.MinH = TextureTableViewModel->GetMinHeightFilter();
+	View.Format = TextureTableViewModel->GetFormatFilter();
+	View.SortCol = (int32)TextureTableViewModel->GetCurrentSortColumn();
+	View.bAsc = TextureTableViewModel->IsSortAscending();
+	View.Query = TextureTableViewModel->GetQuery().TrimStartAndEnd();
+
+	const FString Name = View.Query.IsEmpty() ? FString::Printf(TEXT("View %d"), SavedViews.Num() + 1) : View.Query;
+	if (!SavedViews.Contains(Name))
+	{
+		SavedViewNames.Add(MakeShared<FString>(Name));
+	}
+	SavedViews.Add(Name, MoveTemp(View));
+}
+
+void SMagicOptimizerDock::LoadSavedView(const FString& Name)
+{
+	const FSavedView* View = SavedViews.Find(Name);
+	if (!View || !TextureTableViewModel.IsValid())
+	{
+		return;
+	}
+
+	TextureTableViewModel->BeginBatch();
+	TextureTableViewModel->SetTextFilter(View->Text);
+	TextureTableViewModel->SetMinWidthFilter(View->MinW);
+	TextureTableViewModel->SetMinHeightFilter(View->MinH);
+	TextureTableViewModel->SetFormatFilter(View->Format);
+	TextureTableViewModel->SetSortColumn((FTextureTableViewModel::ESortColumn)View->SortCol, View->bAsc);
+	TextureTableViewModel->SetQuery(View->Query);
+	TextureTableViewModel->EndBatch();
+
+	if (SearchBox.IsValid())
+	{
+		// Setting the text re-enters OnSearchTextChanged with the same query, which is a no-op
+		SearchBox->SetText(FText::FromString(View->Query));
+		SearchBox->SetError(TextureTableViewModel->GetQueryError());
 	}
 	if (AuditTexturesWidget.IsValid())
 	{
@@ -865,7 +1230,9 @@ FReply SMagicOptimizerDock::OnExportProposedCsv()
 	{
 		Csv += TEXT("\"") + Line.ReplaceCharWithEscapedChar() + TEXT("\"\n");
 	}
+	MAGICOPT_STAGE_SCOPE(CsvWrite, MagicOptimizer_WriteProposedCsv);
 	FFileHelper::SaveStringToFile(Csv, *OutPath);
+	MAGICOPT_STAT_ASSET(CsvWrite, OutPath, MagicOptimizerStats::GetFileBytes(OutPath));
 	return FReply::Handled();
 }
 
@@ -880,8 +1247,47 @@ FReply SMagicOptimizerDock::OnCopyProposedForJira()
 	return FReply::Handled();
 }
 
+namespace
+{
+	static bool LoadStatsJson(const FString& StatsPath, TSharedPtr<FJsonObject>& Out)
+	{
+		FString Json;
+		if (!FPaths::FileExists(StatsPath) || !FFileHelper::LoadFileToString(Json, *StatsPath))
+		{
+			return false;
+		}
+		MAGICOPT_STAT_ASSET(ReportRead, StatsPath, MagicOptimizerStats::GetFileBytes(StatsPath));
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+		return FJsonSerializer::Deserialize(Reader, Out) && Out.IsValid();
+	}
+
+	static double GetStatsNumber(const TSharedPtr<FJsonObject>& Stats, const TCHAR* Key)
+	{
+		double Value = 0.0;
+		return Stats.IsValid() && Stats->TryGetNumberField(Key, Value) ? Value : 0.0;
+	}
+
+	// One line for the Reports list from a run's stats.json (see MagicOptimizerStats::EndRun)
+	static FString LoadRunPerfSummary(const FString& StatsPath)
+	{
+		TSharedPtr<FJsonObject> Stats;
+		if (!LoadStatsJson(StatsPath, Stats))
+		{
+			return FString();
+		}
+		return FString::Printf(TEXT("%.1fs | %.0f assets/s | %.1f MB read | peak %.0f MB, %.0f UObjects | %.0f GC"),
+			GetStatsNumber(Stats, TEXT("wall_seconds")),
+			GetStatsNumber(Stats, TEXT("assets_per_second")),
+			GetStatsNumber(Stats, TEXT("bytes_read")) / (1024.0 * 1024.0),
+			GetStatsNumber(Stats, TEXT("peak_working_set_bytes")) / (1024.0 * 1024.0),
+			GetStatsNumber(Stats, TEXT("peak_uobject_count")),
+			GetStatsNumber(Stats, TEXT("gc_passes")));
+	}
+}
+
 void SMagicOptimizerDock::RefreshRunsList()
 {
+	MAGICOPT_LLM_SCOPE(Views);
 	RunEntries.Empty();
 	const FString BaseDir = FPaths::ProjectSavedDir() / TEXT("MagicOptimizer/Reports");
 	TArray<FString> Dirs;
@@ -895,6 +1301,8 @@ void SMagicOptimizerDock::RefreshRunsList()
 		Entry->CsvPath = Dir / TEXT("audit.csv");
 		Entry->JsonPath = Dir / TEXT("audit.json");
 		Entry->HtmlPath = Dir / TEXT("audit.html");
+		Entry->StatsPath = Dir / TEXT("stats.json");
+		Entry->PerfSummary = LoadRunPerfSummary(Entry->StatsPath);
 		RunEntries.Add(Entry);
 	}
 	if (RunsListView.IsValid()) { RunsListView->RequestListRefresh(); }
@@ -1002,56 +1410,139 @@ FString SMagicOptimizerDock::ToObjectPath(const FString& CsvPath)
 	return CsvPath;
 }
 
-bool SMagicOptimizerDock::SaveTextureSnapshot(const TArray<FString>& ObjectPaths, FString& OutSnapshotPath)
+void SMagicOptimizerDock::SaveTextureSnapshot(const TArray<FString>& ObjectPaths, TFunction<void(const TArray<TPair<FString, bool>>& Snapshot, bool bCompleted)> OnDone)
 {
-	TArray<TSharedPtr<FJsonValue>> Items;
+	MAGICOPT_LLM_SCOPE(Apply);
+	const TSharedRef<TArray<TSharedPtr<FJsonValue>>> Entries = MakeShared<TArray<TSharedPtr<FJsonValue>>>();
+	const TSharedRef<TArray<TPair<FString, bool>>> Snapshot = MakeShared<TArray<TPair<FString, bool>>>();
+	const TWeakPtr<SMagicOptimizerDock> WeakDock = SharedThis(this);
+
+	// One load per item, then one item writing the file
+	TArray<MagicOptimizerGameThread::FWorkItem> Items;
+	Items.Reserve(ObjectPaths.Num() + 1);
 	for (const FString& ObjPath : ObjectPaths)
 	{
-		UTexture* Texture = Cast<UTexture>(StaticLoadObject(UTexture::StaticClass(), nullptr, *ObjPath));
-		if (!Texture) { continue; }
-		TSharedPtr<FJsonObject> Item = MakeShared<FJsonObject>();
-		Item->SetStringField(TEXT("ObjectPath"), ObjPath);
-		Item->SetBoolField(TEXT("SRGB"), Texture->SRGB);
-		Items.Add(MakeShared<FJsonValueObject>(Item));
+		Items.Add([Entries, Snapshot, ObjPath]()
+		{
+			MAGICOPT_LLM_SCOPE(Apply);
+			UTexture* Texture = nullptr;
+			{
+				MAGICOPT_STAGE_SCOPE(AssetLoad, MagicOptimizer_LoadAsset);
+				Texture = Cast<UTexture>(MagicOptimizerMemoryGovernor::LoadAsset(FSoftObjectPath(ObjPath)));
+			}
+			if (!Texture) { return; }
+			MAGICOPT_STAT_ASSET(AssetLoad, ObjPath, GetPackageFileSize(Texture->GetOutermost()));
+			TSharedPtr<FJsonObject> Item = MakeShared<FJsonObject>();
+			Item->SetStringField(TEXT("ObjectPath"), ObjPath);
+			Item->SetBoolField(TEXT("SRGB"), Texture->SRGB);
+			Entries->Add(MakeShared<FJsonValueObject>(Item));
+			Snapshot->Emplace(ObjPath, (bool)Texture->SRGB);
+		});
 	}
-	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	Root->SetArrayField(TEXT("textures"), Items);
-	const FString OutDir = FPaths::ProjectSavedDir() / TEXT("MagicOptimizer/Reports");
-	IFileManager::Get().MakeDirectory(*OutDir, true);
-	OutSnapshotPath = OutDir / TEXT("last_snapshot.json");
-	FString JsonString;
-	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
-	FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
-	return FFileHelper::SaveStringToFile(JsonString, *OutSnapshotPath);
+	Items.Add([Entries, WeakDock]()
+	{
+		MAGICOPT_LLM_SCOPE(Apply);
+		MAGICOPT_STAGE_SCOPE(ReportWrite, MagicOptimizer_SaveSnapshot);
+		TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetArrayField(TEXT("textures"), *Entries);
+		const FString OutDir = FPaths::ProjectSavedDir() / TEXT("MagicOptimizer/Reports");
+		IFileManager::Get().MakeDirectory(*OutDir, true);
+		const FString SnapshotPath = OutDir / TEXT("last_snapshot.json");
+		FString JsonString;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+		FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+		const bool bSaved = FFileHelper::SaveStringToFile(JsonString, *SnapshotPath);
+		MAGICOPT_STAT_ASSET(ReportWrite, SnapshotPath, MagicOptimizerStats::GetFileBytes(SnapshotPath));
+		const TSharedPtr<SMagicOptimizerDock> Dock = WeakDock.Pin();
+		if (bSaved && Dock.IsValid())
+		{
+			Dock->LastSnapshotPath = SnapshotPath;
+		}
+	});
+	MagicOptimizerGameThread::Enqueue(TEXT("Texture snapshot"), MoveTemp(Items), [Snapshot, OnDone = MoveTemp(OnDone)](bool bCompleted)
+	{
+		if (OnDone)
+		{
+			OnDone(*Snapshot, bCompleted);
+		}
+	}, ApplyCancelToken);
 }
 
 void SMagicOptimizerDock::ApplySrgbOffBatch(const TArray<FString>& ObjectPaths)
 {
+	MAGICOPT_LLM_SCOPE(Apply);
 	bApplyRunning = true;
 	ApplyProgressCurrent = 0;
 	ApplyProgressTotal = ObjectPaths.Num();
+	StartProgressNotification(TEXT("MagicOptimizer: Applying sRGB Off"));
+
+	// The phase spans the whole batch; the run ends when the last item has run
+	const TSharedRef<TUniquePtr<MagicOptimizerStats::FPhaseScope>> Phase = MakeShared<TUniquePtr<MagicOptimizerStats::FPhaseScope>>();
+	const TWeakPtr<SMagicOptimizerDock> WeakDock = SharedThis(this);
+	// Every texture modified so far, saved or not, with its previous value; a cancel rolls these back
+	const TSharedRef<TArray<TPair<FString, bool>>> Touched = MakeShared<TArray<TPair<FString, bool>>>();
+
+	TArray<MagicOptimizerGameThread::FWorkItem> Items;
+	Items.Reserve(ObjectPaths.Num() * 2 + 1);
+	Items.Add([Phase]() { *Phase = MakeUnique<MagicOptimizerStats::FPhaseScope>(TEXT("Apply sRGB Off")); });
 	for (const FString& ObjPath : ObjectPaths)
 	{
-		ApplyCurrentPath = ObjPath;
-		UTexture* Texture = Cast<UTexture>(StaticLoadObject(UTexture::StaticClass(), nullptr, *ObjPath));
-		if (!Texture) { ++ApplyProgressCurrent; continue; }
-		UPackage* Package = Texture->GetOutermost();
-		Texture->Modify();
-		Texture->SRGB = false;
-		Texture->MarkPackageDirty();
-		TArray<UPackage*> PackagesToSave; PackagesToSave.Add(Package);
-		FEditorFileUtils::PromptForCheckoutAndSave(PackagesToSave, /*bCheckDirty=*/false, /*bPromptToSave=*/false);
-		++ApplyProgressCurrent;
-		UpdateProgressNotification(TEXT("Applying"), ApplyProgressCurrent, ApplyProgressTotal);
+		AddSetTextureSrgbItems(Items, ObjPath, false, [Touched, ObjPath](bool bPreviousSRGB)
+		{
+			Touched->Emplace(ObjPath, bPreviousSRGB);
+		},
+		[WeakDock, ObjPath](bool bSaved)
+		{
+			if (bSaved)
+			{
+				MAGICOPT_TRACK_ASSETS_OPTIMIZED(1);
+			}
+			if (const TSharedPtr<SMagicOptimizerDock> Dock = WeakDock.Pin())
+			{
+				Dock->ApplyCurrentPath = ObjPath;
+				++Dock->ApplyProgressCurrent;
+				Dock->UpdateProgressNotification(TEXT("Applying"), Dock->ApplyProgressCurrent, Dock->ApplyProgressTotal);
+			}
+		});
 	}
-	bApplyRunning = false;
+	const FOptimizerCancellationTokenPtr CancelToken = ApplyCancelToken;
+	MagicOptimizerGameThread::Enqueue(TEXT("Apply sRGB Off"), MoveTemp(Items), [Phase, WeakDock, Touched, CancelToken](bool bCompleted)
+	{
+		Phase->Reset();
+		MagicOptimizerStats::EndRun(!bCompleted);
+		if (!bCompleted)
+		{
+			UE_LOG(LogMagicOptimizer, Log, TEXT("Apply stopped %.0f ms after cancel; rolling back %d textures"),
+				CancelToken.IsValid() ? CancelToken->GetSecondsSinceCancel() * 1000.0 : 0.0, Touched->Num());
+		}
+		if (const TSharedPtr<SMagicOptimizerDock> Dock = WeakDock.Pin())
+		{
+			Dock->bApplyRunning = false;
+			Dock->ApplyCancelToken.Reset();
+			Dock->CompleteProgressNotification(bCompleted, bCompleted ? TEXT("sRGB Off applied") : TEXT("Apply cancelled"));
+			Dock->RefreshRunsList();
+		}
+		if (!bCompleted && Touched->Num() > 0)
+		{
+			QueueSrgbRevert(*Touched, [WeakDock](int32 NumReverted, bool bRevertCompleted)
+			{
+				if (const TSharedPtr<SMagicOptimizerDock> Dock = WeakDock.Pin())
+				{
+					Dock->Notify(FString::Printf(TEXT("Rolled back %d textures"), NumReverted), bRevertCompleted);
+				}
+			});
+		}
+	}, ApplyCancelToken);
 }
 
 void SMagicOptimizerDock::LoadSnapshotFromPath(const FString& SnapshotPath)
 {
+	MAGICOPT_LLM_SCOPE(Apply);
+	MAGICOPT_STAGE_SCOPE(ReportRead, MagicOptimizer_LoadSnapshot);
 	LoadedSnapshot.Empty();
 	FString Json;
 	if (!FFileHelper::LoadFileToString(Json, *SnapshotPath)) { Notify(TEXT("Snapshot not found"), false); return; }
+	MAGICOPT_STAT_ASSET(ReportRead, SnapshotPath, MagicOptimizerStats::GetFileBytes(SnapshotPath));
 	TSharedPtr<FJsonObject> Root;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
 	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid()) { Notify(TEXT("Invalid snapshot"), false); return; }
@@ -1069,19 +1560,42 @@ void SMagicOptimizerDock::LoadSnapshotFromPath(const FString& SnapshotPath)
 	Notify(TEXT("Snapshot loaded"), true);
 }
 
+void SMagicOptimizerDock::RevertTextures(const TArray<FTextureSnapshotItem>& Items)
+{
+	MAGICOPT_LLM_SCOPE(Apply);
+	TArray<TPair<FString, bool>> Targets;
+	Targets.Reserve(Items.Num());
+	for (const FTextureSnapshotItem& Item : Items)
+	{
+		Targets.Emplace(Item.ObjectPath, Item.bSRGB);
+	}
+	const TWeakPtr<SMagicOptimizerDock> WeakDock = SharedThis(this);
+	const int32 NumItems = Items.Num();
+	QueueSrgbRevert(Targets, [WeakDock, NumItems](int32 NumReverted, bool bCompleted)
+	{
+		if (const TSharedPtr<SMagicOptimizerDock> Dock = WeakDock.Pin())
+		{
+			Dock->Notify(NumItems == 1 ? (NumReverted == 1 ? TEXT("Reverted") : TEXT("Texture not found"))
+				: FString::Printf(TEXT("Reverted %d of %d textures"), NumReverted, NumItems), bCompleted && NumReverted == NumItems);
+		}
+	});
+}
+
+FReply SMagicOptimizerDock::OnCancelApply()
+{
+	if (ApplyCancelToken.IsValid())
+	{
+		ApplyCancelToken->Cancel();
+		AppendTaskLine(TEXT("Apply cancel requested"));
+	}
+	return FReply::Handled();
+}
+
 FReply SMagicOptimizerDock::OnRevertOne(const FString ObjectPath)
 {
 	const FTextureSnapshotItem* Found = LoadedSnapshot.FindByPredicate([&](const FTextureSnapshotItem& I){ return I.ObjectPath == ObjectPath; });
 	if (!Found) { Notify(TEXT("Not in snapshot"), false); return FReply::Handled(); }
-	UTexture* Texture = Cast<UTexture>(StaticLoadObject(UTexture::StaticClass(), nullptr, *ObjectPath));
-	if (!Texture) { Notify(TEXT("Texture not found"), false); return FReply::Handled(); }
-	UPackage* Package = Texture->GetOutermost();
-	Texture->Modify();
-	Texture->SRGB = Found->bSRGB;
-	Texture->MarkPackageDirty();
-	TArray<UPackage*> PackagesToSave; PackagesToSave.Add(Package);
-	FEditorFileUtils::PromptForCheckoutAndSave(PackagesToSave, false, false);
-	Notify(TEXT("Reverted"), true);
+	RevertTextures({ *Found });
 	return FReply::Handled();
 }
 
@@ -1166,9 +1680,11 @@ void SMagicOptimizerDock::OpenSlideOverForTexture(FTextureAuditRowPtr Item)
 	// Build a thumbnail widget for the selected asset (best-effort)
 	TSharedPtr<SWidget> ThumbWidget;
 	{
+		MAGICOPT_STAGE_SCOPE(RegistryQuery, MagicOptimizer_RegistryQuery);
 		FAssetRegistryModule& ARM = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 		const FString ObjPath = ToObjectPath(Item->Path);
 		FAssetData AD = ARM.Get().GetAssetByObjectPath(*ObjPath);
+		MAGICOPT_STAT_ASSET(RegistryQuery, ObjPath, 0);
 		if (AD.IsValid() && ThumbnailPool.IsValid())
 		{
 			FAssetThumbnail Thumb(AD, 256, 256, ThumbnailPool);
@@ -1216,14 +1732,43 @@ FReply SMagicOptimizerDock::OnOpenArtifact(const FString& Path)
 
 void SMagicOptimizerDock::ComputeRunDeltas()
 {
+	MAGICOPT_LLM_SCOPE(Views);
+	MAGICOPT_STAGE_SCOPE(ReportRead, MagicOptimizer_ComputeRunDeltas);
 	CompareDeltaLines.Empty();
 	if (!CompareRunA.IsValid() || !CompareRunB.IsValid()) { if (CompareDeltaListView.IsValid()) CompareDeltaListView->RequestListRefresh(); return; }
 	auto LoadJson = [](const FString& Path, TSharedPtr<FJsonObject>& Out)->bool
 	{
 		FString Json; if (!FFileHelper::LoadFileToString(Json, *Path)) return false;
+		MAGICOPT_STAT_ASSET(ReportRead, Path, MagicOptimizerStats::GetFileBytes(Path));
 		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
 		return FJsonSerializer::Deserialize(Reader, Out) && Out.IsValid();
 	};
+	// Run performance from stats.json, when both runs recorded one
+	TSharedPtr<FJsonObject> AStats, BStats;
+	if (LoadStatsJson(CompareRunA->StatsPath, AStats) && LoadStatsJson(CompareRunB->StatsPath, BStats))
+	{
+		auto AddPerfDelta = [&](const TCHAR* Label, const TCHAR* Key, double Scale)
+		{
+			const double AValue = GetStatsNumber(AStats, Key) * Scale;
+			const double BValue = GetStatsNumber(BStats, Key) * Scale;
+			CompareDeltaLines.Add(MakeShared<FString>(FString::Printf(TEXT("%s: %.1f -> %.1f (%+.1f)"), Label, AValue, BValue, BValue - AValue)));
+		};
+		AddPerfDelta(TEXT("Run time (s)"), TEXT("wall_seconds"), 1.0);
+		AddPerfDelta(TEXT("Assets/s"), TEXT("assets_per_second"), 1.0);
+		AddPerfDelta(TEXT("Peak working set MB"), TEXT("peak_working_set_bytes"), 1.0 / (1024.0 * 1024.0));
+		AddPerfDelta(TEXT("Peak UObjects"), TEXT("peak_uobject_count"), 1.0);
+		AddPerfDelta(TEXT("GC passes"), TEXT("gc_passes"), 1.0);
+		const TArray<TSharedPtr<FJsonValue>>* Slowest = nullptr;
+		if (BStats->TryGetArrayField(TEXT("slowest_assets"), Slowest) && Slowest->Num() > 0)
+		{
+			const TSharedPtr<FJsonObject> Top = (*Slowest)[0]->AsObject();
+			if (Top.IsValid())
+			{
+				CompareDeltaLines.Add(MakeShared<FString>(FString::Printf(TEXT("Slowest asset in B: %s (%s, %.2fs)"),
+					*Top->GetStringField(TEXT("path")), *Top->GetStringField(TEXT("stage")), Top->GetNumberField(TEXT("seconds")))));
+			}
+		}
+	}
 	TSharedPtr<FJsonObject> A, B;
 	if (!LoadJson(CompareRunA->JsonPath, A) || !LoadJson(CompareRunB->JsonPath, B)) { if (CompareDeltaListView.IsValid()) CompareDeltaListView->RequestListRefresh(); return; }
 	// Example: compare totals + disk/memory if available
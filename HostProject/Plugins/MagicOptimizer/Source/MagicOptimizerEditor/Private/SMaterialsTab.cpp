@@ -1,26 +1,84 @@
 // Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
 
 #include "SMaterialsTab.h"
-#include "Widgets/Layout/SBox.h"
+#include "Widgets/Layout/SExpandableArea.h"
 #include "Widgets/Text/STextBlock.h"
-#include "EditorStyleSet.h"
+#include "Widgets/SBoxPanel.h"
+#include "SAssetPagedList.h"
+#include "AssetTableWidgets.h"
+#include "ViewModels/MaterialTableViewModel.h"
+#include "MagicOptimizerMemory.h"
 
 void SMaterialsTab::Construct(const FArguments& InArgs)
 {
+	MAGICOPT_LLM_SCOPE(Views);
+	ViewModel = MakeShared<FMaterialTableViewModel>();
+	ThumbnailCache = InArgs._ThumbnailCache;
+	const TSharedRef<FMaterialTableViewModel> ViewModelRef = ViewModel.ToSharedRef();
+
+	// Large tables filter and sort on a worker; the list refreshes when results are swapped in
+	ViewModel->SetAsyncRefresh(true);
+	ViewModel->OnResultsReady().AddSP(this, &SMaterialsTab::RefreshList);
+
 	ChildSlot
 	[
-		SNew(SBox)
-		.Padding(16.0f)
+		SNew(SExpandableArea)
+		.AreaTitle(FText::FromString(TEXT("Audit Results (Materials)")))
+		.InitiallyCollapsed(false)
+		.BodyContent()
 		[
-			SNew(STextBlock)
-			.Text(FText::FromString(TEXT("Material Optimization - Coming Soon!")))
-			.Font(FCoreStyle::GetDefaultFontStyle("Bold", 20))
-			.ColorAndOpacity(FLinearColor(0.2f, 0.6f, 1.0f))
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0,0,0,4)
+			[
+				AssetTableWidgets::MakeFilterBar<FMaterialAuditRow>(ViewModelRef, [this]() { RefreshList(); })
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0,0,0,2)
+			[
+				AssetTableWidgets::MakeStatusLine<FMaterialAuditRow>(ViewModelRef)
+			]
+			+ SVerticalBox::Slot()
+			.FillHeight(1.f)
+			[
+				SAssignNew(MaterialListView, SAssetPagedList<FMaterialAuditRow>)
+				.ItemHeight(20)
+				.OnGenerateRow(this, &SMaterialsTab::OnGenerateRow)
+				.HeaderRow(AssetTableWidgets::MakeHeaderRow<FMaterialAuditRow>(ViewModelRef, [this]() { RefreshList(); }))
+			]
 		]
 	];
+	RefreshList();
 }
 
 SMaterialsTab::~SMaterialsTab()
 {
-	// TODO: Implement cleanup
+	if (ViewModel.IsValid())
+	{
+		ViewModel->OnResultsReady().RemoveAll(this);
+	}
+}
+
+void SMaterialsTab::SetMaterialRows(const TArray<FMaterialAuditRowPtr>& InRows)
+{
+	MAGICOPT_LLM_SCOPE(Views);
+	ViewModel->SetSourceData(InRows);
+	RefreshList();
+}
+
+void SMaterialsTab::RefreshList()
+{
+	// The list pages through the published result; only the visible rows are materialized
+	if (MaterialListView.IsValid())
+	{
+		MaterialListView->SetSource(ViewModel->MakeFilteredRowSource());
+	}
+}
+
+TSharedRef<ITableRow> SMaterialsTab::OnGenerateRow(FMaterialAuditRowPtr Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	MAGICOPT_LLM_SCOPE(Views);
+	return AssetTableWidgets::MakeRow<FMaterialAuditRow>(*ViewModel, Item, OwnerTable, ThumbnailCache);
 }
@@ -1,26 +1,84 @@
 // Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
 
 #include "SMeshesTab.h"
-#include "Widgets/Layout/SBox.h"
+#include "Widgets/Layout/SExpandableArea.h"
 #include "Widgets/Text/STextBlock.h"
-#include "EditorStyleSet.h"
+#include "Widgets/SBoxPanel.h"
+#include "SAssetPagedList.h"
+#include "AssetTableWidgets.h"
+#include "ViewModels/MeshTableViewModel.h"
+#include "MagicOptimizerMemory.h"
 
 void SMeshesTab::Construct(const FArguments& InArgs)
 {
+	MAGICOPT_LLM_SCOPE(Views);
+	ViewModel = MakeShared<FMeshTableViewModel>();
+	ThumbnailCache = InArgs._ThumbnailCache;
+	const TSharedRef<FMeshTableViewModel> ViewModelRef = ViewModel.ToSharedRef();
+
+	// Large tables filter and sort on a worker; the list refreshes when results are swapped in
+	ViewModel->SetAsyncRefresh(true);
+	ViewModel->OnResultsReady().AddSP(this, &SMeshesTab::RefreshList);
+
 	ChildSlot
 	[
-		SNew(SBox)
-		.Padding(16.0f)
+		SNew(SExpandableArea)
+		.AreaTitle(FText::FromString(TEXT("Audit Results (Meshes)")))
+		.InitiallyCollapsed(false)
+		.BodyContent()
 		[
-			SNew(STextBlock)
-			.Text(FText::FromString(TEXT("Mesh Optimization - Coming Soon!")))
-			.Font(FCoreStyle::GetDefaultFontStyle("Bold", 20))
-			.ColorAndOpacity(FLinearColor(0.2f, 0.6f, 1.0f))
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0,0,0,4)
+			[
+				AssetTableWidgets::MakeFilterBar<FMeshAuditRow>(ViewModelRef, [this]() { RefreshList(); })
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0,0,0,2)
+			[
+				AssetTableWidgets::MakeStatusLine<FMeshAuditRow>(ViewModelRef)
+			]
+			+ SVerticalBox::Slot()
+			.FillHeight(1.f)
+			[
+				SAssignNew(MeshListView, SAssetPagedList<FMeshAuditRow>)
+				.ItemHeight(20)
+				.OnGenerateRow(this, &SMeshesTab::OnGenerateRow)
+				.HeaderRow(AssetTableWidgets::MakeHeaderRow<FMeshAuditRow>(ViewModelRef, [this]() { RefreshList(); }))
+			]
 		]
 	];
+	RefreshList();
 }
 
 SMeshesTab::~SMeshesTab()
 {
-	// TODO: Implement cleanup
+	if (ViewModel.IsValid())
+	{
+		ViewModel->OnResultsReady().RemoveAll(this);
+	}
+}
+
+void SMeshesTab::SetMeshRows(const TArray<FMeshAuditRowPtr>& InRows)
+{
+	MAGICOPT_LLM_SCOPE(Views);
+	ViewModel->SetSourceData(InRows);
+	RefreshList();
+}
+
+void SMeshesTab::RefreshList()
+{
+	// The list pages through the published result; only the visible rows are materialized
+	if (MeshListView.IsValid())
+	{
+		MeshListView->SetSource(ViewModel->MakeFilteredRowSource());
+	}
+}
+
+TSharedRef<ITableRow> SMeshesTab::OnGenerateRow(FMeshAuditRowPtr Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	MAGICOPT_LLM_SCOPE(Views);
+	return AssetTableWidgets::MakeRow<FMeshAuditRow>(*ViewModel, Item, OwnerTable, ThumbnailCache);
 }
@@ -4,9 +4,11 @@
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Text/STextBlock.h"
 #include "EditorStyleSet.h"
+#include "MagicOptimizerMemory.h"
 
 void SOptimizationTab::Construct(const FArguments& InArgs)
 {
+	MAGICOPT_LLM_SCOPE(Views);
 	ChildSlot
 	[
 		SNew(SBox)
@@ -39,9 +39,11 @@
 #include "SMeshesTab.h"
 #include "SMaterialsTab.h"
 #include "SOptimizationTab.h"
+#include "MagicOptimizerMemory.h"
 
 void SOptimizerPanel::Construct(const FArguments& InArgs)
 {
+	MAGICOPT_LLM_SCOPE(Views);
 	// Initialize settings and Python bridge
 	OptimizerSettings = UOptimizerSettings::Get();
 	PythonBridge = NewObject<UPythonBridge>();
@@ -497,6 +499,8 @@ void SOptimizerPanel::InitializeUI()
 
 	// Initialize ViewModel
 	TextureTableViewModel = MakeShareable(new FTextureTableViewModel());
+	// Refreshes synchronously, so the legacy list reads its rows right after each change
+	LegacyTextureViewModel = MakeShareable(new FTextureTableViewModel());
 	
 	// Load settings into ViewModel
 	if (OptimizerSettings)
@@ -577,6 +581,7 @@ FText SOptimizerPanel::GetCurrentProfileText() const
 // Run optimization phase
 void SOptimizerPanel::RunOptimizationPhase(const FString& Phase)
 {
+	MAGICOPT_LLM_SCOPE(Bridge);
 	if (!PythonBridge || !PythonBridge->IsPythonAvailable())
 	{
 		ShowNotification(TEXT("Python bridge not available"), false);
@@ -657,6 +662,7 @@ FOptimizerRunParams SOptimizerPanel::BuildRunParams(const FString& Phase) const
 
 void SOptimizerPanel::LoadTextureAuditCsv()
 {
+	MAGICOPT_LLM_SCOPE(AuditStore);
 	AllTextureRows.Empty();
 	TArray<FTextureAuditRowPtr> Parsed;
 	const bool bOk = TextureCsvReader::ReadAuditCsv(OptimizerSettings, Parsed);
@@ -674,6 +680,10 @@ void SOptimizerPanel::LoadTextureAuditCsv()
 	{
 		TextureTableViewModel->SetSourceData(AllTextureRows);
 	}
+	if (LegacyTextureViewModel.IsValid())
+	{
+		LegacyTextureViewModel->SetSourceData(AllTextureRows);
+	}
 	
 	if (TextureAuditSection.IsValid())
 	{
@@ -686,6 +696,7 @@ void SOptimizerPanel::LoadTextureAuditCsv()
 
 TSharedRef<ITableRow> SOptimizerPanel::OnGenerateTextureRow(FTextureAuditRowPtr Item, const TSharedRef<STableViewBase>& OwnerTable)
 {
+	MAGICOPT_LLM_SCOPE(Views);
 	return SNew(STableRow<FTextureAuditRowPtr>, OwnerTable)
 	[
 		SNew(SHorizontalBox)
@@ -743,6 +754,7 @@ TSharedRef<ITableRow> SOptimizerPanel::OnGenerateTextureRow(FTextureAuditRowPtr
 
 void SOptimizerPanel::LoadTextureRecommendationsCsv()
 {
+	MAGICOPT_LLM_SCOPE(AuditStore);
 	AllTextureRecRows.Empty();
 	TArray<FTextureRecRowPtr> Parsed;
 	const bool bOk = TextureCsvReader::ReadRecommendationsCsv(OptimizerSettings, Parsed);
@@ -766,6 +778,7 @@ void SOptimizerPanel::LoadTextureRecommendationsCsv()
 
 TSharedRef<ITableRow> SOptimizerPanel::OnGenerateTextureRecRow(FTextureRecRowPtr Item, const TSharedRef<STableViewBase>& OwnerTable)
 {
+    MAGICOPT_LLM_SCOPE(Views);
     return SNew(STableRow<FTextureRecRowPtr>, OwnerTable)
     [
         SNew(SHorizontalBox)
@@ -854,21 +867,10 @@ TSharedRef<ITableRow> SOptimizerPanel::OnGenerateTextureRecRow(FTextureRecRowPtr
 }
 void SOptimizerPanel::SortTextureRows()
 {
-	auto CmpPathAsc = [](const FTextureAuditRowPtr& A, const FTextureAuditRowPtr& B){ return A->Path < B->Path; };
-	auto CmpPathDesc = [](const FTextureAuditRowPtr& A, const FTextureAuditRowPtr& B){ return A->Path > B->Path; };
-	auto CmpWidthAsc = [](const FTextureAuditRowPtr& A, const FTextureAuditRowPtr& B){ return A->Width < B->Width; };
-	auto CmpWidthDesc = [](const FTextureAuditRowPtr& A, const FTextureAuditRowPtr& B){ return A->Width > B->Width; };
-	auto CmpHeightAsc = [](const FTextureAuditRowPtr& A, const FTextureAuditRowPtr& B){ return A->Height < B->Height; };
-	auto CmpHeightDesc = [](const FTextureAuditRowPtr& A, const FTextureAuditRowPtr& B){ return A->Height > B->Height; };
-	auto CmpFormatAsc = [](const FTextureAuditRowPtr& A, const FTextureAuditRowPtr& B){ return A->Format < B->Format; };
-	auto CmpFormatDesc = [](const FTextureAuditRowPtr& A, const FTextureAuditRowPtr& B){ return A->Format > B->Format; };
-
-	switch (CurrentSortColumn)
+	if (LegacyTextureViewModel.IsValid())
 	{
-		case ETextureSortColumn::Path: TextureRows.StableSort(bSortAscending ? CmpPathAsc : CmpPathDesc); break;
-		case ETextureSortColumn::Width: TextureRows.StableSort(bSortAscending ? CmpWidthAsc : CmpWidthDesc); break;
-		case ETextureSortColumn::Height: TextureRows.StableSort(bSortAscending ? CmpHeightAsc : CmpHeightDesc); break;
-		case ETextureSortColumn::Format: TextureRows.StableSort(bSortAscending ? CmpFormatAsc : CmpFormatDesc); break;
+		LegacyTextureViewModel->SetSortColumn(CurrentSortColumn, bSortAscending);
+		TextureRows = LegacyTextureViewModel->GetFilteredData();
 	}
 }
 
@@ -925,25 +927,17 @@ FReply SOptimizerPanel::OnSortByFormat()
 
 void SOptimizerPanel::ApplyTextureFilterAndSort()
 {
-	TextureRows.Reset();
-	const FString Needle = TextureFilterText.TrimStartAndEnd().ToLower();
-	for (const FTextureAuditRowPtr& Row : AllTextureRows)
+	MAGICOPT_LLM_SCOPE(Views);
+	if (LegacyTextureViewModel.IsValid())
 	{
-		if (!Row.IsValid()) { continue; }
-		if (Row->Width < FilterMinWidth || Row->Height < FilterMinHeight) { continue; }
-		bool bMatches = true;
-		if (!Needle.IsEmpty())
-		{
-			const FString PathLower = Row->Path.ToLower();
-			const FString FormatLower = Row->Format.ToLower();
-			bMatches = PathLower.Contains(Needle) || FormatLower.Contains(Needle);
-		}
-		if (bMatches)
-		{
-			TextureRows.Add(Row);
-		}
+		LegacyTextureViewModel->BeginBatch();
+		LegacyTextureViewModel->SetTextFilter(TextureFilterText.TrimStartAndEnd());
+		LegacyTextureViewModel->SetMinWidthFilter(FilterMinWidth);
+		LegacyTextureViewModel->SetMinHeightFilter(FilterMinHeight);
+		LegacyTextureViewModel->SetSortColumn(CurrentSortColumn, bSortAscending);
+		LegacyTextureViewModel->EndBatch();
+		TextureRows = LegacyTextureViewModel->GetFilteredData();
 	}
-	SortTextureRows();
 	if (TextureListView.IsValid()) { TextureListView->RequestListRefresh(); }
 }
 
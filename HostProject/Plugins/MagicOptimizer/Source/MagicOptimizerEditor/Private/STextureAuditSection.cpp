@@ -6,19 +6,30 @@
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SEditableTextBox.h"
 #include "Widgets/SBoxPanel.h"
+#include "Widgets/SNullWidget.h"
 #include "Widgets/Views/SListView.h"
+#include "SAssetPagedList.h"
 #include "Widgets/Views/STableRow.h"
 #include "Widgets/Layout/SExpandableArea.h"
+#include "Widgets/Images/SThrobber.h"
 #include "HAL/PlatformApplicationMisc.h"
 #include "ContentBrowserModule.h"
 #include "IContentBrowserSingleton.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Services/Editor/ContentBrowserActions.h"
 #include "ViewModels/TextureTableViewModel.h"
+#include "AuditThumbnailCache.h"
 #include "MagicOptimizerLogging.h"
+#include "MagicOptimizerMemory.h"
 
 void STextureAuditSection::Construct(const FArguments& InArgs)
 {
+	MAGICOPT_LLM_SCOPE(Views);
+	// Owned ViewModel until a shared one is attached via SetViewModel
+	ViewModel = MakeShared<FTextureTableViewModel>();
+	BindViewModel();
+	ThumbnailCache = InArgs._ThumbnailCache;
+
 	ChildSlot
 	[
 		SNew(SExpandableArea)
@@ -75,24 +86,28 @@ void STextureAuditSection::Construct(const FArguments& InArgs)
 			.AutoHeight()
 			.Padding(0,0,0,2)
 			[
-				SNew(STextBlock)
-				.Text_Lambda([this]() { 
-					if (ViewModel.IsValid())
-					{
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
+				[
+					SNew(STextBlock)
+					.Text_Lambda([this]() { 
 						return FText::FromString(FString::Printf(TEXT("Filtered %d / %d"), 
 							ViewModel->GetFilteredCount(), ViewModel->GetTotalCount())); 
-					}
-					return FText::FromString(FString::Printf(TEXT("Filtered %d / %d"), 0, AllTextureRows.Num())); 
-				})
+					})
+				]
+				// Busy while a background refresh runs; the previous results stay listed
+				+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(6,0,0,0)
+				[
+					SNew(SCircularThrobber)
+					.Radius(6.f)
+					.Visibility_Lambda([this]() { return ViewModel->IsRefreshing() ? EVisibility::Visible : EVisibility::Collapsed; })
+				]
 			]
 			+ SVerticalBox::Slot()
 			.FillHeight(1.f)
 			[
-				SAssignNew(TextureListView, SListView<FTextureAuditRowPtr>)
+				SAssignNew(TextureListView, SAssetPagedList<FTextureAuditRow>)
 				.ItemHeight(20)
-				.ListItemsSource_Lambda([this]() -> const TArray<FTextureAuditRowPtr>& { 
-					return ViewModel.IsValid() ? ViewModel->GetFilteredData() : AllTextureRows; 
-				})
 				.OnGenerateRow(this, &STextureAuditSection::OnGenerateRow)
 				.HeaderRow(
 					SAssignNew(TextureHeaderRow, SHeaderRow)
@@ -105,212 +120,128 @@ void STextureAuditSection::Construct(const FArguments& InArgs)
 			]
 		]
 	];
+	TextureListView->SetSource(ViewModel->MakeFilteredRowSource());
 }
 
 void STextureAuditSection::SetTextureRows(const TArray<FTextureAuditRowPtr>& InRows)
 {
+	MAGICOPT_LLM_SCOPE(Views);
 	AllTextureRows = InRows;
-	
-	// Update ViewModel if available
-	if (ViewModel.IsValid())
-	{
-		ViewModel->SetSourceData(InRows);
-		UpdateUIFromViewModel();
-	}
-	else
-	{
-		// Fallback to local filtering if no ViewModel
-		ApplyFiltersAndSort();
-	}
+	ViewModel->SetSourceData(InRows);
+	UpdateUIFromViewModel();
 }
 
 void STextureAuditSection::SetViewModel(TSharedPtr<FTextureTableViewModel> InViewModel)
 {
+	if (!InViewModel.IsValid())
+	{
+		return;
+	}
+	ViewModel->OnResultsReady().RemoveAll(this);
 	ViewModel = InViewModel;
+	BindViewModel();
+	if (TextureListView.IsValid())
+	{
+		TextureListView->SetSource(ViewModel->MakeFilteredRowSource(), /*bResetScroll*/ true);
+	}
 	
-	// Update UI with ViewModel data if available
-	if (ViewModel.IsValid() && AllTextureRows.Num() > 0)
+	// Seed a shared ViewModel with rows we received before it was attached
+	if (AllTextureRows.Num() > 0 && ViewModel->GetTotalCount() == 0)
 	{
 		ViewModel->SetSourceData(AllTextureRows);
-		UpdateUIFromViewModel();
 	}
+	UpdateUIFromViewModel();
 }
 
-void STextureAuditSection::UpdateUIFromViewModel()
+STextureAuditSection::~STextureAuditSection()
 {
-	if (!ViewModel.IsValid())
+	if (ViewModel.IsValid())
 	{
-		return;
+		ViewModel->OnResultsReady().RemoveAll(this);
 	}
-	
+}
+
+void STextureAuditSection::BindViewModel()
+{
+	// Large tables filter and sort on a worker; the list refreshes when results are swapped in
+	ViewModel->SetAsyncRefresh(true);
+	ViewModel->OnResultsReady().AddSP(this, &STextureAuditSection::HandleResultsReady);
+}
+
+void STextureAuditSection::HandleResultsReady()
+{
+	if (TextureListView.IsValid())
+	{
+		TextureListView->SetSource(ViewModel->MakeFilteredRowSource());
+	}
+}
+
+void STextureAuditSection::UpdateUIFromViewModel()
+{
 	// Update UI state from ViewModel
 	FilterText = ViewModel->GetTextFilter();
 	FilterMinWidth = ViewModel->GetMinWidthFilter();
 	FilterMinHeight = ViewModel->GetMinHeightFilter();
 	FormatFilter = ViewModel->GetFormatFilter();
+	CurrentSortColumn = (ETextureSortColumn)ViewModel->GetCurrentSortColumn();
+	bSortAscending = ViewModel->IsSortAscending();
 	
 	// Update list view with filtered data
 	if (TextureListView.IsValid())
 	{
-		TextureListView->RequestListRefresh();
+		TextureListView->RequestRefresh();
 	}
 }
 
 void STextureAuditSection::RefreshDisplay()
 {
-	ApplyFiltersAndSort();
-	if (TextureListView.IsValid())
+	// The ViewModel is kept current by its setters; only the widgets need refreshing
+	UpdateUIFromViewModel();
+}
+
+void STextureAuditSection::NotifySettingsChanged()
+{
+	UpdateUIFromViewModel();
+	if (OnSettingsChanged.IsBound())
 	{
-		TextureListView->RequestListRefresh();
+		OnSettingsChanged.Execute();
 	}
 }
 
 void STextureAuditSection::SetFilterText(const FString& InFilterText)
 {
-	FilterText = InFilterText;
-	
-	if (ViewModel.IsValid())
-	{
-		ViewModel->SetTextFilter(InFilterText);
-		UpdateUIFromViewModel();
-		
-		// Trigger settings save
-		if (OnSettingsChanged.IsBound())
-		{
-			OnSettingsChanged.Execute();
-		}
-	}
-	else
-	{
-		ApplyFiltersAndSort();
-	}
+	ViewModel->SetTextFilter(InFilterText);
+	NotifySettingsChanged();
 }
 
 void STextureAuditSection::SetMinWidth(int32 InMinWidth)
 {
-	FilterMinWidth = InMinWidth;
-	
-	if (ViewModel.IsValid())
-	{
-		ViewModel->SetMinWidthFilter(InMinWidth);
-		UpdateUIFromViewModel();
-		
-		// Trigger settings save
-		if (OnSettingsChanged.IsBound())
-		{
-			OnSettingsChanged.Execute();
-		}
-	}
-	else
-	{
-		ApplyFiltersAndSort();
-	}
+	ViewModel->SetMinWidthFilter(InMinWidth);
+	NotifySettingsChanged();
 }
 
 void STextureAuditSection::SetMinHeight(int32 InMinHeight)
 {
-	FilterMinHeight = InMinHeight;
-	
-	if (ViewModel.IsValid())
-	{
-		ViewModel->SetMinHeightFilter(InMinHeight);
-		UpdateUIFromViewModel();
-		
-		// Trigger settings save
-		if (OnSettingsChanged.IsBound())
-		{
-			OnSettingsChanged.Execute();
-		}
-	}
-	else
-	{
-		ApplyFiltersAndSort();
-	}
+	ViewModel->SetMinHeightFilter(InMinHeight);
+	NotifySettingsChanged();
 }
 
 void STextureAuditSection::SetFormatFilter(const FString& InFormatFilter)
 {
-	FormatFilter = InFormatFilter;
-	
-	if (ViewModel.IsValid())
-	{
-		ViewModel->SetFormatFilter(InFormatFilter);
-		UpdateUIFromViewModel();
-		
-		// Trigger settings save
-		if (OnSettingsChanged.IsBound())
-		{
-			OnSettingsChanged.Execute();
-		}
-	}
-	else
-	{
-		ApplyFiltersAndSort();
-	}
+	ViewModel->SetFormatFilter(InFormatFilter);
+	NotifySettingsChanged();
 }
 
 void STextureAuditSection::ClearFilters()
 {
-	FilterText.Empty();
-	FilterMinWidth = 0;
-	FilterMinHeight = 0;
-	FormatFilter.Empty();
-	
-	if (ViewModel.IsValid())
-	{
-		ViewModel->ClearAllFilters();
-		UpdateUIFromViewModel();
-		
-		// Trigger settings save
-		if (OnSettingsChanged.IsBound())
-		{
-			OnSettingsChanged.Execute();
-		}
-	}
-	else
-	{
-		ApplyFiltersAndSort();
-	}
+	ViewModel->ClearAllFilters();
+	NotifySettingsChanged();
 }
 
 void STextureAuditSection::SetSortColumn(ETextureSortColumn InColumn, bool bInAscending)
 {
-	CurrentSortColumn = InColumn;
-	bSortAscending = bInAscending;
-	
-	if (ViewModel.IsValid())
-	{
-		// Convert to ViewModel sort column
-		FTextureTableViewModel::ESortColumn ViewModelColumn;
-		switch (InColumn)
-		{
-		case ETextureSortColumn::Width:
-			ViewModelColumn = FTextureTableViewModel::ESortColumn::Width;
-			break;
-		case ETextureSortColumn::Height:
-			ViewModelColumn = FTextureTableViewModel::ESortColumn::Height;
-			break;
-		case ETextureSortColumn::Format:
-			ViewModelColumn = FTextureTableViewModel::ESortColumn::Format;
-			break;
-		default:
-			ViewModelColumn = FTextureTableViewModel::ESortColumn::Path;
-			break;
-		}
-		
-		ViewModel->SetSortColumn(ViewModelColumn, bInAscending);
-		UpdateUIFromViewModel();
-		
-		// Trigger settings save
-		if (OnSettingsChanged.IsBound())
-		{
-			OnSettingsChanged.Execute();
-		}
-	}
-	else
-	{
-		ApplyFiltersAndSort();
-	}
+	ViewModel->SetSortColumn(InColumn, bInAscending);
+	NotifySettingsChanged();
 }
 
 EColumnSortMode::Type STextureAuditSection::GetSortModeForColumn(ETextureSortColumn Column) const
@@ -322,109 +253,33 @@ EColumnSortMode::Type STextureAuditSection::GetSortModeForColumn(ETextureSortCol
 	return EColumnSortMode::None;
 }
 
-void STextureAuditSection::ApplyFiltersAndSort()
+TSharedRef<class ITableRow> STextureAuditSection::OnGenerateRow(FTextureAuditRowPtr Item, const TSharedRef<class STableViewBase>& OwnerTable)
 {
-	// Apply filters
-	FilteredTextureRows.Empty();
-	
-	for (const auto& Row : AllTextureRows)
-	{
-		bool bPassesFilter = true;
-		
-		// Text filter
-		if (!FilterText.IsEmpty())
-		{
-			FString SearchText = FilterText.ToLower();
-			FString PathLower = Row->Path.ToLower();
-			FString FormatLower = Row->Format.ToLower();
-			
-			if (!PathLower.Contains(SearchText) && !FormatLower.Contains(SearchText))
-			{
-				bPassesFilter = false;
-			}
-		}
-		
-		// Width filter
-		if (FilterMinWidth > 0 && Row->Width < FilterMinWidth)
-		{
-			bPassesFilter = false;
-		}
-		
-		// Height filter
-		if (FilterMinHeight > 0 && Row->Height < FilterMinHeight)
-		{
-			bPassesFilter = false;
-		}
-		
-		// Format filter
-		if (!FormatFilter.IsEmpty())
-		{
-			FString SearchFormat = FormatFilter.ToLower();
-			FString RowFormat = Row->Format.ToLower();
-			
-			if (!RowFormat.Contains(SearchFormat))
-			{
-				bPassesFilter = false;
-			}
-		}
-		
-		if (bPassesFilter)
-		{
-			FilteredTextureRows.Add(Row);
-		}
-	}
-	
-	// Apply sorting
-	SortRows();
-	
-	// Update list view
-	if (TextureListView.IsValid())
-	{
-		TextureListView->RequestListRefresh();
-	}
-}
+	MAGICOPT_LLM_SCOPE(Views);
+	TSharedRef<STableRow<FTextureAuditRowPtr>> Row = SNew(STableRow<FTextureAuditRowPtr>, OwnerTable);
 
-void STextureAuditSection::SortRows()
-{
-	FilteredTextureRows.Sort([this](const FTextureAuditRowPtr& A, const FTextureAuditRowPtr& B)
+	// Inline thumbnail from the package's saved thumbnail; never loads the texture
+	TSharedRef<SWidget> Thumbnail = SNullWidget::NullWidget;
+	if (ThumbnailCache.IsValid())
 	{
-		if (!A.IsValid() || !B.IsValid())
-		{
-			return false;
-		}
-		
-		int32 CompareResult = 0;
-		
-		switch (CurrentSortColumn)
-		{
-		case ETextureSortColumn::Path:
-			CompareResult = A->Path.Compare(B->Path);
-			break;
-		case ETextureSortColumn::Width:
-			CompareResult = A->Width - B->Width;
-			break;
-		case ETextureSortColumn::Height:
-			CompareResult = A->Height - B->Height;
-			break;
-		case ETextureSortColumn::Format:
-			CompareResult = A->Format.Compare(B->Format);
-			break;
-		}
-		
-		return bSortAscending ? (CompareResult < 0) : (CompareResult > 0);
-	});
-}
+		Thumbnail = ThumbnailCache->MakeRowThumbnail(Item->Path, Row);
+	}
 
-TSharedRef<class ITableRow> STextureAuditSection::OnGenerateRow(FTextureAuditRowPtr Item, const TSharedRef<class STableViewBase>& OwnerTable)
-{
-	return SNew(STableRow<FTextureAuditRowPtr>, OwnerTable)
-	[
+	Row->SetContent(
 		SNew(SHorizontalBox)
 		+ SHorizontalBox::Slot().FillWidth(0.4f).Padding(2,0)
 		[
-			SNew(STextBlock)
-			.Text(FText::FromString(Item->Path))
-			.ToolTipText(FText::FromString(Item->Path))
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(0,1,4,1)
+			[
+				Thumbnail
+			]
+			+ SHorizontalBox::Slot().FillWidth(1.f).VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(Item->Path))
+				.ToolTipText(FText::FromString(Item->Path))
+			]
 		]
 		+ SHorizontalBox::Slot().FillWidth(0.15f).Padding(2,0).HAlign(HAlign_Right)
 		[
@@ -471,26 +326,24 @@ TSharedRef<class ITableRow> STextureAuditSection::OnGenerateRow(FTextureAuditRow
 				})
 			]
 		]
-	];
+	);
+	return Row;
 }
 
 FReply STextureAuditSection::OnHeaderColumnSort(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type NewSortMode)
 {
-	if (ColumnId == TEXT("Path"))
-	{
-		SetSortColumn(ETextureSortColumn::Path, NewSortMode == EColumnSortMode::Ascending);
-	}
-	else if (ColumnId == TEXT("Width"))
+	if (ViewModel->FindColumnIndex(ColumnId) != INDEX_NONE)
 	{
-		SetSortColumn(ETextureSortColumn::Width, NewSortMode == EColumnSortMode::Ascending);
-	}
-	else if (ColumnId == TEXT("Height"))
-	{
-		SetSortColumn(ETextureSortColumn::Height, NewSortMode == EColumnSortMode::Ascending);
-	}
-	else if (ColumnId == TEXT("Format"))
-	{
-		SetSortColumn(ETextureSortColumn::Format, NewSortMode == EColumnSortMode::Ascending);
+		// Shift-click adds the column as a tie-breaker
+		if (SortPriority == EColumnSortPriority::Secondary)
+		{
+			ViewModel->AddSortColumn(ColumnId, NewSortMode == EColumnSortMode::Ascending);
+		}
+		else
+		{
+			ViewModel->SetSortColumn(ColumnId, NewSortMode == EColumnSortMode::Ascending);
+		}
+		NotifySettingsChanged();
 	}
 	
 	return FReply::Handled();
@@ -503,7 +356,7 @@ void STextureAuditSection::OnFilterTextChanged(const FText& NewText)
 	{
 		OnFilterChanged.Execute(FilterText);
 	}
-	ApplyFiltersAndSort();
+	SetFilterText(FilterText);
 }
 
 void STextureAuditSection::OnMinWidthChanged(const FText& NewText)
@@ -513,7 +366,7 @@ void STextureAuditSection::OnMinWidthChanged(const FText& NewText)
 	{
 		OnMinWidthChanged.Execute(FilterMinWidth);
 	}
-	ApplyFiltersAndSort();
+	SetMinWidth(FilterMinWidth);
 }
 
 void STextureAuditSection::OnMinHeightChanged(const FText& NewText)
@@ -523,7 +376,7 @@ void STextureAuditSection::OnMinHeightChanged(const FText& NewText)
 	{
 		OnMinHeightChanged.Execute(FilterMinHeight);
 	}
-	ApplyFiltersAndSort();
+	SetMinHeight(FilterMinHeight);
 }
 
 void STextureAuditSection::OnFormatFilterChanged(const FText& NewText)
@@ -533,7 +386,7 @@ void STextureAuditSection::OnFormatFilterChanged(const FText& NewText)
 	{
 		OnFormatFilterChanged.Execute(FormatFilter);
 	}
-	ApplyFiltersAndSort();
+	SetFormatFilter(FormatFilter);
 }
 
 FReply STextureAuditSection::OnClearFilters()
@@ -6,11 +6,14 @@
 #include "Widgets/Input/SButton.h"
 #include "Widgets/SBoxPanel.h"
 #include "Widgets/Views/SListView.h"
+#include "SAssetPagedList.h"
 #include "Widgets/Views/STableRow.h"
 #include "Widgets/Layout/SExpandableArea.h"
+#include "MagicOptimizerMemory.h"
 
 void STextureRecommendSection::Construct(const FArguments& InArgs)
 {
+	MAGICOPT_LLM_SCOPE(Views);
 	ChildSlot
 	[
 		SNew(SExpandableArea)
@@ -18,9 +21,8 @@ void STextureRecommendSection::Construct(const FArguments& InArgs)
 		.InitiallyCollapsed(false)
 		.BodyContent()
 		[
-			SAssignNew(RecommendationListView, SListView<FTextureRecRowPtr>)
+			SAssignNew(RecommendationListView, SAssetPagedList<FTextureRecRow>)
 			.ItemHeight(20)
-			.ListItemsSource(&RecommendationRows)
 			.OnGenerateRow(this, &STextureRecommendSection::OnGenerateRow)
 			.HeaderRow(
 				SAssignNew(RecommendationHeaderRow, SHeaderRow)
@@ -38,20 +40,29 @@ void STextureRecommendSection::Construct(const FArguments& InArgs)
 
 void STextureRecommendSection::SetRecommendationRows(const TArray<FTextureRecRowPtr>& InRows)
 {
-	RecommendationRows = InRows;
-	RefreshDisplay();
+	MAGICOPT_LLM_SCOPE(Views);
+	SetRecommendationSource(MakeShared<const TArrayRowSource<FTextureRecRow>, ESPMode::ThreadSafe>(InRows));
+}
+
+void STextureRecommendSection::SetRecommendationSource(TSharedPtr<const TAssetRowSource<FTextureRecRow>, ESPMode::ThreadSafe> InSource)
+{
+	if (RecommendationListView.IsValid())
+	{
+		RecommendationListView->SetSource(MoveTemp(InSource), /*bResetScroll*/ true);
+	}
 }
 
 void STextureRecommendSection::RefreshDisplay()
 {
 	if (RecommendationListView.IsValid())
 	{
-		RecommendationListView->RequestListRefresh();
+		RecommendationListView->RequestRefresh();
 	}
 }
 
 TSharedRef<class ITableRow> STextureRecommendSection::OnGenerateRow(FTextureRecRowPtr Item, const TSharedRef<class STableViewBase>& OwnerTable)
 {
+	MAGICOPT_LLM_SCOPE(Views);
 	return SNew(STableRow<FTextureRecRowPtr>, OwnerTable)
 	[
 		SNew(SHorizontalBox)
@@ -19,9 +19,11 @@
 #include "STextureAuditSection.h"
 #include "STextureRecommendSection.h"
 #include "ContentBrowserActions.h"
+#include "MagicOptimizerMemory.h"
 
 void STexturesTab::Construct(const FArguments& InArgs)
 {
+	MAGICOPT_LLM_SCOPE(Views);
 	// Initialize UI
 	InitializeUI();
 	
@@ -0,0 +1,207 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Images/SThrobber.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/STableRow.h"
+#include "ViewModels/AssetTableViewModel.h"
+#include "AuditThumbnailCache.h"
+
+// Slate builders that derive the filter bar, header and rows of an audit table from its view model schema
+namespace AssetTableWidgets
+{
+	inline FText GetColumnLabel(FName ColumnId)
+	{
+		return FText::FromString(FName::NameToDisplayString(ColumnId.ToString(), false));
+	}
+
+	// Free-text search box, one typed filter box per filterable column and a Clear button
+	template<typename RowType>
+	TSharedRef<SWidget> MakeFilterBar(const TSharedRef<TAssetTableViewModel<RowType>>& ViewModel, TFunction<void()> OnFiltersChanged)
+	{
+		typedef TAssetTableColumn<RowType> FColumn;
+
+		TSharedRef<SHorizontalBox> FilterBar = SNew(SHorizontalBox);
+
+		FilterBar->AddSlot().FillWidth(1.f).Padding(0,0,8,0)
+		[
+			SNew(SEditableTextBox)
+			.HintText(FText::FromString(TEXT("Search...")))
+			.Text_Lambda([ViewModel]() { return FText::FromString(ViewModel->GetTextFilter()); })
+			.OnTextChanged_Lambda([ViewModel, OnFiltersChanged](const FText& NewText)
+			{
+				ViewModel->SetTextFilter(NewText.ToString());
+				OnFiltersChanged();
+			})
+		];
+
+		for (const FColumn& Column : ViewModel->GetColumns())
+		{
+			const FName ColumnId = Column.Id;
+			if (Column.FilterKind == EAssetColumnFilterKind::MinValue)
+			{
+				FilterBar->AddSlot().AutoWidth().Padding(0,0,4,0)
+				[
+					SNew(SEditableTextBox)
+					.MinDesiredWidth(70)
+					.HintText(FText::Format(FText::FromString(TEXT("Min {0}")), GetColumnLabel(ColumnId)))
+					.Text_Lambda([ViewModel, ColumnId]()
+					{
+						const int64 MinValue = ViewModel->GetColumnMinFilter(ColumnId);
+						return MinValue > 0 ? FText::AsNumber(MinValue) : FText::GetEmpty();
+					})
+					.OnTextChanged_Lambda([ViewModel, OnFiltersChanged, ColumnId](const FText& NewText)
+					{
+						ViewModel->SetColumnMinFilter(ColumnId, FCString::Atoi64(*NewText.ToString()));
+						OnFiltersChanged();
+					})
+				];
+			}
+			else if (Column.FilterKind == EAssetColumnFilterKind::Contains)
+			{
+				FilterBar->AddSlot().AutoWidth().Padding(0,0,4,0)
+				[
+					SNew(SEditableTextBox)
+					.MinDesiredWidth(80)
+					.HintText(GetColumnLabel(ColumnId))
+					.Text_Lambda([ViewModel, ColumnId]() { return FText::FromString(ViewModel->GetColumnFilter(ColumnId)); })
+					.OnTextChanged_Lambda([ViewModel, OnFiltersChanged, ColumnId](const FText& NewText)
+					{
+						ViewModel->SetColumnFilter(ColumnId, NewText.ToString());
+						OnFiltersChanged();
+					})
+				];
+			}
+		}
+
+		FilterBar->AddSlot().AutoWidth()
+		[
+			SNew(SButton)
+			.Text(FText::FromString(TEXT("Clear")))
+			.OnClicked_Lambda([ViewModel, OnFiltersChanged]()
+			{
+				ViewModel->ClearAllFilters();
+				OnFiltersChanged();
+				return FReply::Handled();
+			})
+		];
+
+		return FilterBar;
+	}
+
+	// "Filtered N / M" line with a throbber shown while a background refresh is running
+	template<typename RowType>
+	TSharedRef<SWidget> MakeStatusLine(const TSharedRef<TAssetTableViewModel<RowType>>& ViewModel)
+	{
+		return SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text_Lambda([ViewModel]()
+				{
+					return FText::FromString(FString::Printf(TEXT("Filtered %d / %d"), ViewModel->GetFilteredCount(), ViewModel->GetTotalCount()));
+				})
+			]
+			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(6,0,0,0)
+			[
+				SNew(SCircularThrobber)
+				.Radius(6.f)
+				.Visibility_Lambda([ViewModel]() { return ViewModel->IsRefreshing() ? EVisibility::Visible : EVisibility::Collapsed; })
+			];
+	}
+
+	// Sortable header with one column per schema column
+	template<typename RowType>
+	TSharedRef<SHeaderRow> MakeHeaderRow(const TSharedRef<TAssetTableViewModel<RowType>>& ViewModel, TFunction<void()> OnSortChanged)
+	{
+		typedef TAssetTableColumn<RowType> FColumn;
+
+		TSharedRef<SHeaderRow> HeaderRow = SNew(SHeaderRow);
+		for (const FColumn& Column : ViewModel->GetColumns())
+		{
+			const FName ColumnId = Column.Id;
+			HeaderRow->AddColumn(
+				SHeaderRow::Column(ColumnId)
+				.DefaultLabel(GetColumnLabel(ColumnId))
+				.FillWidth(ColumnId == ViewModel->GetColumns()[0].Id ? 2.f : 1.f)
+				.HAlignCell(Column.IsNumeric() ? HAlign_Right : HAlign_Left)
+				.SortMode_Lambda([ViewModel, ColumnId]()
+				{
+					for (const FAssetTableSortKey& Key : ViewModel->GetSortColumns())
+					{
+						if (Key.ColumnId == ColumnId)
+						{
+							return Key.bAscending ? EColumnSortMode::Ascending : EColumnSortMode::Descending;
+						}
+					}
+					return EColumnSortMode::None;
+				})
+				.SortPriority_Lambda([ViewModel, ColumnId]()
+				{
+					const TArray<FAssetTableSortKey> Keys = ViewModel->GetSortColumns();
+					return Keys.Num() > 0 && Keys[0].ColumnId != ColumnId ? EColumnSortPriority::Secondary : EColumnSortPriority::Primary;
+				})
+				.OnSort_Lambda([ViewModel, OnSortChanged](const EColumnSortPriority::Type SortPriority, const FName& SortColumnId, const EColumnSortMode::Type NewSortMode)
+				{
+					// Shift-click adds the column as a tie-breaker
+					if (SortPriority == EColumnSortPriority::Secondary)
+					{
+						ViewModel->AddSortColumn(SortColumnId, NewSortMode != EColumnSortMode::Descending);
+					}
+					else
+					{
+						ViewModel->SetSortColumn(SortColumnId, NewSortMode != EColumnSortMode::Descending);
+					}
+					OnSortChanged();
+				})
+			);
+		}
+		return HeaderRow;
+	}
+
+	// Row widget with one cell per schema column, laid out to match MakeHeaderRow.
+	// With a thumbnail cache, the first column is taken as the asset path and gets an inline thumbnail.
+	template<typename RowType>
+	TSharedRef<ITableRow> MakeRow(const TAssetTableViewModel<RowType>& ViewModel, TSharedPtr<RowType> Item, const TSharedRef<STableViewBase>& OwnerTable,
+		const TSharedPtr<FAuditThumbnailCache>& Thumbnails = nullptr)
+	{
+		typedef TAssetTableColumn<RowType> FColumn;
+
+		TSharedRef<STableRow<TSharedPtr<RowType>>> Row = SNew(STableRow<TSharedPtr<RowType>>, OwnerTable);
+		TSharedRef<SHorizontalBox> Cells = SNew(SHorizontalBox);
+		const TArray<FColumn>& Columns = ViewModel.GetColumns();
+		for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+		{
+			const FColumn& Column = Columns[ColumnIndex];
+			const FText CellText = Column.IsNumeric() ? FText::AsNumber(Column.GetNumber(*Item)) : FText::FromString(Column.GetText(*Item));
+			TSharedRef<SWidget> Cell = SNew(STextBlock)
+				.Text(CellText)
+				.ToolTipText(CellText);
+			if (ColumnIndex == 0 && Thumbnails.IsValid() && !Column.IsNumeric())
+			{
+				Cell = SNew(SHorizontalBox)
+					+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(0,1,4,1)
+					[
+						Thumbnails->MakeRowThumbnail(Column.GetText(*Item), Row)
+					]
+					+ SHorizontalBox::Slot().FillWidth(1.f).VAlign(VAlign_Center)
+					[
+						Cell
+					];
+			}
+			Cells->AddSlot().FillWidth(ColumnIndex == 0 ? 2.f : 1.f).Padding(2,0).HAlign(Column.IsNumeric() ? HAlign_Right : HAlign_Left)
+			[
+				Cell
+			];
+		}
+
+		Row->SetContent(Cells);
+		return Row;
+	}
+}
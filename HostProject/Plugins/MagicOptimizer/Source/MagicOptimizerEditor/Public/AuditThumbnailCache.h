@@ -0,0 +1,91 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "Containers/Ticker.h"
+
+class ITableRow;
+class SWidget;
+struct FSlateBrush;
+struct FSlateDynamicImageBrush;
+
+/**
+ * FAuditThumbnailCache
+ * Small inline thumbnails for the audit lists, decoded from the thumbnail each package saves in its
+ * header. Assets are never loaded: a thumbnail comes from the in-memory package if that is already
+ * loaded, otherwise it is read from the package file on a worker task. Packages saved without a
+ * thumbnail get no image.
+ *
+ * Rows ask for their thumbnail while they are painted, so only visible rows generate requests.
+ * Pending requests are read top row first, a few at a time; a request whose row has not been painted
+ * for a couple of frames (scrolled away, list filtered) is dropped before it is read. Decoded
+ * thumbnails are downscaled and kept in an LRU of fixed capacity.
+ */
+class FAuditThumbnailCache : public TSharedFromThis<FAuditThumbnailCache>
+{
+public:
+	explicit FAuditThumbnailCache(int32 InCapacity = DefaultCapacity);
+	~FAuditThumbnailCache();
+
+	static constexpr int32 DefaultCapacity = 1024;
+	static constexpr int32 ThumbnailSize = 64;
+	static constexpr int32 MaxReadsInFlight = 4;
+
+	/**
+	 * Brush for an asset's thumbnail, or null while it is not available yet (or the package has none).
+	 * A miss queues a request with the given priority (lower is read first, e.g. the row's index in
+	 * the list); calling again every paint keeps the request alive.
+	 */
+	const FSlateBrush* GetBrush(const FString& AssetPath, int32 Priority);
+
+	// Inline thumbnail for a list row; it only requests while Row is painted
+	TSharedRef<SWidget> MakeRowThumbnail(const FString& AssetPath, const TSharedRef<ITableRow>& Row, float Size = 24.f);
+
+	int32 GetNumCached() const { return Brushes.Num(); }
+	int32 GetNumPending() const { return Pending.Num(); }
+
+private:
+	struct FRequest
+	{
+		int32 Priority = 0;
+		uint64 LastRequestedFrame = 0;
+		FString ObjectFullName;
+		FString PackageName;
+
+		// Pixels copied from an already loaded package, if any
+		int32 Width = 0;
+		int32 Height = 0;
+		TArray<uint8> Bgra;
+	};
+
+	// Worker results, handed back to the game thread
+	struct FDecoded
+	{
+		FString AssetPath;
+		int32 Width = 0;
+		int32 Height = 0;
+		TArray<uint8> Bgra;
+	};
+	struct FCompletionQueue
+	{
+		FCriticalSection Lock;
+		TArray<FDecoded> Items;
+	};
+
+	// Null brush entries remember packages without a thumbnail
+	TLruCache<FString, TSharedPtr<FSlateDynamicImageBrush>> Brushes;
+	TMap<FString, FRequest> Pending;
+	TSet<FString> InFlight;
+	TSharedRef<FCompletionQueue, ESPMode::ThreadSafe> Completed;
+	FTSTicker::FDelegateHandle TickHandle;
+	uint32 NextBrushId = 0;
+
+	bool Tick(float DeltaTime);
+	void EnsureTicking();
+	bool StartRequest(const FString& AssetPath, FRequest& OutRequest);
+	void LaunchRead(const FString& AssetPath, FRequest Request);
+	void AddBrush(const FString& AssetPath, int32 Width, int32 Height, const TArray<uint8>& Bgra);
+	static void Downscale(FDecoded& Decoded);
+};
@@ -0,0 +1,160 @@
+// Copyright (c) 2025 Perseus XR PTY LTD. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Layout/SScrollBar.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/SListView.h"
+#include "Services/Paging/AssetRowPager.h"
+
+/**
+ * SAssetPagedList
+ * List view over a TAssetRowSource that never materializes the whole table: the inner SListView only
+ * holds the rows currently on screen, fetched through a TAssetRowPager, and the scrollbar is driven
+ * by the source's row count instead of the item array. Suitable for tables of a million rows or more.
+ *
+ * Replacing the source (e.g. when a view model publishes new results) keeps the scroll position,
+ * clamped to the new row count. Selection only covers rows in the visible window.
+ */
+template<typename RowType>
+class SAssetPagedList : public SCompoundWidget
+{
+public:
+	typedef TSharedPtr<RowType> FRowPtr;
+	typedef TAssetRowPager<RowType> FPager;
+	typedef typename FPager::FSourcePtr FSourcePtr;
+	typedef typename SListView<FRowPtr>::FOnGenerateRow FOnGenerateRow;
+	typedef typename SListView<FRowPtr>::FOnSelectionChanged FOnSelectionChanged;
+
+	SLATE_BEGIN_ARGS(SAssetPagedList)
+		: _ItemHeight(20.f)
+		, _PrefetchRows(512)
+	{}
+		SLATE_ARGUMENT(float, ItemHeight)
+		// Rows read ahead on either side of the window, for sources that fetch asynchronously
+		SLATE_ARGUMENT(int32, PrefetchRows)
+		SLATE_ARGUMENT(TSharedPtr<SHeaderRow>, HeaderRow)
+		SLATE_EVENT(FOnGenerateRow, OnGenerateRow)
+		SLATE_EVENT(FOnSelectionChanged, OnSelectionChanged)
+	SLATE_END_ARGS()
+
+	static constexpr int32 WheelScrollRows = 3;
+
+	void Construct(const FArguments& InArgs)
+	{
+		ItemHeight = FMath::Max(1.f, InArgs._ItemHeight);
+		PrefetchRows = FMath::Max(0, InArgs._PrefetchRows);
+
+		// The inner list never scrolls itself; wheel and scrollbar move the window instead
+		ChildSlot
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot().FillWidth(1.f)
+			[
+				SAssignNew(ListView, SListView<FRowPtr>)
+				.ItemHeight(ItemHeight)
+				.ListItemsSource(&WindowRows)
+				.ScrollbarVisibility(EVisibility::Collapsed)
+				.ConsumeMouseWheel(EConsumeMouseWheel::Never)
+				.OnGenerateRow(InArgs._OnGenerateRow)
+				.OnSelectionChanged(InArgs._OnSelectionChanged)
+				.HeaderRow(InArgs._HeaderRow)
+			]
+			+ SHorizontalBox::Slot().AutoWidth()
+			[
+				SAssignNew(ScrollBar, SScrollBar)
+				.Orientation(Orient_Vertical)
+				.AlwaysShowScrollbar(true)
+				.OnUserScrolled(this, &SAssetPagedList::HandleUserScrolled)
+			]
+		];
+	}
+
+	// Shows another dataset; the scroll position is kept unless bResetScroll
+	void SetSource(FSourcePtr InSource, bool bResetScroll = false)
+	{
+		Pager.SetSource(MoveTemp(InSource));
+		if (bResetScroll)
+		{
+			FirstRow = 0;
+		}
+		RequestRefresh();
+	}
+
+	// Re-reads the visible window on the next tick
+	void RequestRefresh()
+	{
+		bWindowDirty = true;
+	}
+
+	void ScrollToRow(int32 RowIndex)
+	{
+		FirstRow = RowIndex;
+		RequestRefresh();
+	}
+
+	int32 Num() const { return Pager.Num(); }
+	int32 GetFirstVisibleRow() const { return FirstRow; }
+	TArray<FRowPtr> GetSelectedItems() const { return ListView->GetSelectedItems(); }
+	void ClearSelection() { ListView->ClearSelection(); }
+
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override
+	{
+		// One row's height is left for the header
+		const int32 NewVisibleRows = FMath::Max(1, FMath::FloorToInt(AllottedGeometry.GetLocalSize().Y / ItemHeight) - 1);
+		if (NewVisibleRows != VisibleRows)
+		{
+			VisibleRows = NewVisibleRows;
+			bWindowDirty = true;
+		}
+		if (bWindowDirty)
+		{
+			UpdateWindow();
+		}
+	}
+
+	virtual FReply OnMouseWheel(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override
+	{
+		if (Pager.Num() <= VisibleRows)
+		{
+			return FReply::Unhandled();
+		}
+		ScrollToRow(FirstRow - FMath::RoundToInt(MouseEvent.GetWheelDelta() * WheelScrollRows));
+		return FReply::Handled();
+	}
+
+private:
+	FPager Pager;
+	TArray<FRowPtr> WindowRows;
+	TSharedPtr<SListView<FRowPtr>> ListView;
+	TSharedPtr<SScrollBar> ScrollBar;
+	float ItemHeight = 20.f;
+	int32 PrefetchRows = 0;
+	int32 FirstRow = 0;
+	int32 VisibleRows = 1;
+	bool bWindowDirty = true;
+
+	void UpdateWindow()
+	{
+		bWindowDirty = false;
+		const int32 Total = Pager.Num();
+		FirstRow = FMath::Clamp(FirstRow, 0, FMath::Max(0, Total - VisibleRows));
+
+		// One extra row covers the partially visible one at the bottom
+		Pager.GetWindow(FirstRow, VisibleRows + 1, PrefetchRows, WindowRows);
+		ListView->RequestListRefresh();
+
+		const float ThumbSize = Total > 0 ? FMath::Min(1.f, (float)VisibleRows / (float)Total) : 1.f;
+		const float Offset = Total > 0 ? (float)FirstRow / (float)Total : 0.f;
+		ScrollBar->SetState(Offset, ThumbSize);
+	}
+
+	void HandleUserScrolled(float InScrollOffsetFraction)
+	{
+		ScrollToRow(FMath::RoundToInt(InScrollOffsetFraction * Pager.Num()));
+		UpdateWindow();
+	}
+};
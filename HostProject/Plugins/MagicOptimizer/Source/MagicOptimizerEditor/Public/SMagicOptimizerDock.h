@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
 #include "ViewModels/TextureModels.h"
+#include "Services/Scheduling/CancellationToken.h"
 
 class UOptimizerSettings;
 class UPythonBridge;
@@ -15,6 +16,7 @@ class SMeshesTab;
 class SMaterialsTab;
 class FTextureTableViewModel;
 class FAssetThumbnailPool;
+class FAuditThumbnailCache;
 struct FSlateBrush;
 template<typename ItemType> class SListView;
 class SHeaderRow;
@@ -67,6 +69,7 @@ private:
 	TSharedPtr<STextureRecommendSection> RecommendWidget;
 	TSharedPtr<class SBorder> RightQuickFixShelf;
 	TSharedPtr<class SVerticalBox> QuickFixChipsBox;
+	TSharedPtr<class SVerticalBox> FacetChipsBox;
 	// Recommend view list of human-readable proposed changes
 	TArray<TSharedPtr<FString>> ProposedChangeItems;
 	TSharedPtr<SListView<TSharedPtr<FString>>> ProposedListView;
@@ -88,13 +91,15 @@ private:
 	int32 ApplyProgressCurrent = 0;
 	int32 ApplyProgressTotal = 0;
 	FString ApplyCurrentPath;
+	// Shared by the snapshot, the Python apply and the native apply job of the running apply
+	FOptimizerCancellationTokenPtr ApplyCancelToken;
 
 	// Verify snapshot data
 	struct FTextureSnapshotItem { FString ObjectPath; bool bSRGB = false; };
 	TArray<FTextureSnapshotItem> LoadedSnapshot;
 
 	// Reports view state
-	struct FRunEntry { FString Name; FString Dir; FString Preset; FString Date; FString CsvPath; FString JsonPath; FString HtmlPath; };
+	struct FRunEntry { FString Name; FString Dir; FString Preset; FString Date; FString CsvPath; FString JsonPath; FString HtmlPath; FString StatsPath; FString PerfSummary; };
 	TArray<TSharedPtr<FRunEntry>> RunEntries;
 	TSharedPtr<FRunEntry> SelectedRun;
 	TSharedPtr<FRunEntry> CompareRunA;
@@ -125,6 +130,9 @@ private:
 	void LoadRecommendations();
 	void UpdateSourceControlHint();
 	void UpdateQuickFixShelf();
+	void RebuildFacetChips();
+	void HandleTextureResultsReady();
+	void AppendQueryTerm(const FString& Term);
 	void OnSearchTextChanged(const FText& NewText);
 	void SwitchView(EMainView NewView);
 	void SwitchAuditType(EAuditAssetType NewType);
@@ -190,11 +198,20 @@ private:
 	FString LastSnapshotPath;
 	FString LastReportDir;
 
-	// Apply/Verify helpers
+	// Apply/Verify helpers; snapshot, apply and revert are queued on the time-sliced game-thread
+	// executor and run in that order across frames, with the Python apply on a worker in between
 	static FString ToObjectPath(const FString& CsvPath);
-	bool SaveTextureSnapshot(const TArray<FString>& ObjectPaths, FString& OutSnapshotPath);
+	// OnDone gets each texture found with its SRGB value, and false if the snapshot was cancelled
+	void SaveTextureSnapshot(const TArray<FString>& ObjectPaths, TFunction<void(const TArray<TPair<FString, bool>>& Snapshot, bool bCompleted)> OnDone);
+	// Runs the Python apply off the game thread, then the native batch; a cancel rolls back to Snapshot
+	void RunPythonApply(const TArray<FString>& ObjectPaths, const TArray<TPair<FString, bool>>& Snapshot);
 	void ApplySrgbOffBatch(const TArray<FString>& ObjectPaths);
+	// Ends an apply that stopped before its native batch
+	void FinishApply(bool bSuccess, const FString& Message);
 	void LoadSnapshotFromPath(const FString& SnapshotPath);
+	void RevertTextures(const TArray<FTextureSnapshotItem>& Items);
+	// Stops the running apply; the textures it already changed are rolled back
+	FReply OnCancelApply();
 	FReply OnRevertOne(const FString ObjectPath);
 
 	// Slide-over panel
@@ -203,8 +220,11 @@ private:
 	TSharedPtr<FSlateBrush> SlideThumbBrush;
 	TSharedPtr<FAssetThumbnailPool> ThumbnailPool;
 
+	// Inline thumbnails for the audit lists
+	TSharedPtr<FAuditThumbnailCache> ThumbnailCache;
+
 	// Saved views (session-only)
-	struct FSavedView { FString Text; int32 MinW = 0; int32 MinH = 0; FString Format; int32 SortCol = 0; bool bAsc = true; };
+	struct FSavedView { FString Text; int32 MinW = 0; int32 MinH = 0; FString Format; int32 SortCol = 0; bool bAsc = true; FString Query; };
 	TMap<FString, FSavedView> SavedViews;
 	TArray<TSharedPtr<FString>> SavedViewNames;
 	TSharedPtr<FString> CurrentSavedView;
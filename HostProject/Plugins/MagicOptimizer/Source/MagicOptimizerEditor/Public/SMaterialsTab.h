@@ -4,20 +4,40 @@
 
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
+#include "ViewModels/MaterialModels.h"
+
+class FMaterialTableViewModel;
+class FAuditThumbnailCache;
+class ITableRow;
+class STableViewBase;
+template<typename RowType> class SAssetPagedList;
 
 /**
  * Dedicated tab widget for material optimization functionality
- * Provides a clean, focused interface for material-related operations
+ * Shows the material audit table through the shared asset table view model
  */
 class SMaterialsTab : public SCompoundWidget
 {
 public:
 	SLATE_BEGIN_ARGS(SMaterialsTab) {}
+		// Optional; rows show inline thumbnails when set
+		SLATE_ARGUMENT(TSharedPtr<FAuditThumbnailCache>, ThumbnailCache)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
 	~SMaterialsTab();
 
+	// Data interface
+	void SetMaterialRows(const TArray<FMaterialAuditRowPtr>& InRows);
+
+	// ViewModel access
+	TSharedPtr<FMaterialTableViewModel> GetViewModel() const { return ViewModel; }
+
 protected:
-	// TODO: Implement material optimization functionality
+	TSharedPtr<FMaterialTableViewModel> ViewModel;
+	TSharedPtr<SAssetPagedList<FMaterialAuditRow>> MaterialListView;
+	TSharedPtr<FAuditThumbnailCache> ThumbnailCache;
+
+	TSharedRef<ITableRow> OnGenerateRow(FMaterialAuditRowPtr Item, const TSharedRef<STableViewBase>& OwnerTable);
+	void RefreshList();
 };
@@ -4,20 +4,40 @@
 
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
+#include "ViewModels/MeshModels.h"
+
+class FMeshTableViewModel;
+class FAuditThumbnailCache;
+class ITableRow;
+class STableViewBase;
+template<typename RowType> class SAssetPagedList;
 
 /**
  * Dedicated tab widget for mesh optimization functionality
- * Provides a clean, focused interface for mesh-related operations
+ * Shows the mesh audit table through the shared asset table view model
  */
 class SMeshesTab : public SCompoundWidget
 {
 public:
 	SLATE_BEGIN_ARGS(SMeshesTab) {}
+		// Optional; rows show inline thumbnails when set
+		SLATE_ARGUMENT(TSharedPtr<FAuditThumbnailCache>, ThumbnailCache)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
 	~SMeshesTab();
 
+	// Data interface
+	void SetMeshRows(const TArray<FMeshAuditRowPtr>& InRows);
+
+	// ViewModel access
+	TSharedPtr<FMeshTableViewModel> GetViewModel() const { return ViewModel; }
+
 protected:
-	// TODO: Implement mesh optimization functionality
+	TSharedPtr<FMeshTableViewModel> ViewModel;
+	TSharedPtr<SAssetPagedList<FMeshAuditRow>> MeshListView;
+	TSharedPtr<FAuditThumbnailCache> ThumbnailCache;
+
+	TSharedRef<ITableRow> OnGenerateRow(FMeshAuditRowPtr Item, const TSharedRef<STableViewBase>& OwnerTable);
+	void RefreshList();
 };
@@ -87,6 +87,10 @@ protected:
 	// ViewModel for texture table state
 	TSharedPtr<FTextureTableViewModel> TextureTableViewModel;
 
+	// The legacy list's own filters and sort over the same rows, so it never changes the shared ViewModel
+	// or its saved settings
+	TSharedPtr<FTextureTableViewModel> LegacyTextureViewModel;
+
 	// Legacy data storage (will be removed after refactoring)
 	TArray<FTextureAuditRowPtr> TextureRows;
 	TArray<FTextureAuditRowPtr> AllTextureRows;
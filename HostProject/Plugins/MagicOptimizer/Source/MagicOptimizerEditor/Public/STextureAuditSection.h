@@ -12,14 +12,19 @@ class SHeaderRow;
 class SEditableTextBox;
 class SButton;
 class FTextureTableViewModel;
+class FAuditThumbnailCache;
+template<typename RowType> class SAssetPagedList;
 
 class STextureAuditSection : public SCompoundWidget
 {
 public:
 	SLATE_BEGIN_ARGS(STextureAuditSection) {}
+		// Optional; rows show inline thumbnails when set
+		SLATE_ARGUMENT(TSharedPtr<FAuditThumbnailCache>, ThumbnailCache)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
+	virtual ~STextureAuditSection();
 
 	// Data interface
 	void SetTextureRows(const TArray<FTextureAuditRowPtr>& InRows);
@@ -61,27 +66,25 @@ protected:
 	// ViewModel reference
 	TSharedPtr<FTextureTableViewModel> ViewModel;
 	
-	// Internal data (now managed by ViewModel)
+	// Rows received before a shared ViewModel is attached
 	TArray<FTextureAuditRowPtr> AllTextureRows;
-	TArray<FTextureAuditRowPtr> FilteredTextureRows;
 	
-	// UI components
-	TSharedPtr<SListView<FTextureAuditRowPtr>> TextureListView;
+	// UI components; the list pages through the ViewModel's filtered result
+	TSharedPtr<SAssetPagedList<FTextureAuditRow>> TextureListView;
 	TSharedPtr<SHeaderRow> TextureHeaderRow;
+	TSharedPtr<FAuditThumbnailCache> ThumbnailCache;
 	
-	// Filter state (now managed by ViewModel, kept for UI binding)
+	// Filter state (mirrored from ViewModel for UI binding)
 	FString FilterText;
 	int32 FilterMinWidth = 0;
 	int32 FilterMinHeight = 0;
 	FString FormatFilter;
 	
-	// Sort state (now managed by ViewModel, kept for UI binding)
+	// Sort state (mirrored from ViewModel for UI binding)
 	ETextureSortColumn CurrentSortColumn = ETextureSortColumn::Path;
 	bool bSortAscending = true;
 
 	// Internal methods
-	void ApplyFiltersAndSort();
-	void SortRows();
 	TSharedRef<class ITableRow> OnGenerateRow(FTextureAuditRowPtr Item, const TSharedRef<class STableViewBase>& OwnerTable);
 	FReply OnHeaderColumnSort(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type NewSortMode);
 	
@@ -90,5 +93,8 @@ protected:
 	FReply OnClearFilters();
 	
 	// Helper methods
+	void BindViewModel();
+	void HandleResultsReady();
 	void UpdateUIFromViewModel();
+	void NotifySettingsChanged();
 };
@@ -6,9 +6,10 @@
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/Views/SHeaderRow.h"
 #include "ViewModels/TextureModels.h"
+#include "Services/Paging/AssetRowSource.h"
 
-class SListViewBase;
 class SHeaderRow;
+template<typename RowType> class SAssetPagedList;
 
 class STextureRecommendSection : public SCompoundWidget
 {
@@ -20,6 +21,8 @@ public:
 
 	// Data interface
 	void SetRecommendationRows(const TArray<FTextureRecRowPtr>& InRows);
+	// Pages rows from a source (e.g. the CSV on disk) instead of holding them all
+	void SetRecommendationSource(TSharedPtr<const TAssetRowSource<FTextureRecRow>, ESPMode::ThreadSafe> InSource);
 	void RefreshDisplay();
 
 	// Event delegates
@@ -29,11 +32,8 @@ public:
 	FOnRowAction OnOpenInContentBrowser;
 
 protected:
-	// Internal data
-	TArray<FTextureRecRowPtr> RecommendationRows;
-	
 	// UI components
-	TSharedPtr<SListView<FTextureRecRowPtr>> RecommendationListView;
+	TSharedPtr<SAssetPagedList<FTextureRecRow>> RecommendationListView;
 	TSharedPtr<SHeaderRow> RecommendationHeaderRow;
 
 	// Internal methods